@@ -402,6 +402,12 @@ void eventlog_createCfmProgressEventString(const tCfmEventCnProgress* pProgress_
                             "SIZE:%05d DOWNLOADED:%04d ",
                             pProgress_p->totalNumberOfBytes,
                             pProgress_p->bytesDownloaded);
+            len += snprintf(message_p + len,
+                            messageSize_p - len,
+                            "OBJECTS:%04d/%04d TIME:%06d ",
+                            pProgress_p->objectsDownloaded,
+                            pProgress_p->totalNumberOfObjects,
+                            pProgress_p->elapsedTimeMs);
             len += snprintf(message_p + len,
                             messageSize_p - len,
                             "ABORTCODE:0x%08X ERROR:0x%04X ",
@@ -423,6 +429,13 @@ void eventlog_createCfmProgressEventString(const tCfmEventCnProgress* pProgress_
                             pProgress_p->bytesDownloaded,
                             pProgress_p->totalNumberOfBytes);
 
+            len += snprintf(message_p + len,
+                            messageSize_p - len,
+                            ", %u/%u Objects, %u ms",
+                            pProgress_p->objectsDownloaded,
+                            pProgress_p->totalNumberOfObjects,
+                            pProgress_p->elapsedTimeMs);
+
             if ((pProgress_p->sdoAbortCode != 0) ||
                 (pProgress_p->error != kErrorOk))
             {
@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <oplk/oplk.h>
 #include <oplk/debugstr.h>
+#include <oplk/histogram.h>
 
 #include <console/console.h>
 #include <eventlog/eventlog.h>
@@ -84,6 +85,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 static BOOL*    pfGsOff_l;
 
+static const char* const    aCycleHistogramName_l[kDllCycleHistogramCount] =
+{
+    "Cycle time",
+    "Used cycle time",
+    "Spare cycle time",
+    "SoC to first PReq",
+};
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
@@ -101,6 +110,12 @@ static tOplkError processCfmProgressEvent(const tCfmEventCnProgress* pCfmProgres
                                           void* pUserArg_p);
 static tOplkError processCfmResultEvent(const tOplkApiEventCfmResult* pCfmResult_p,
                                         void* pUserArg_p);
+static tOplkError processCycleHistogramEvent(const tOplkApiEventCycleHistogram* pCycleHistogram_p,
+                                             void* pUserArg_p);
+static tOplkError processEventStatisticsEvent(const tOplkApiEventEventStatistics* pEventStatistics_p,
+                                              void* pUserArg_p);
+static void       printEventStatistics(const char* pName_p,
+                                       const tEventCalStatistics* pStatistics_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -176,6 +191,14 @@ tOplkError processEvents(tOplkApiEventType eventType_p,
             ret = processCfmResultEvent(&pEventArg_p->cfmResult, pUserArg_p);
             break;
 
+        case kOplkApiEventCycleHistogram:
+            ret = processCycleHistogramEvent(&pEventArg_p->cycleHistogram, pUserArg_p);
+            break;
+
+        case kOplkApiEventEventStatistics:
+            ret = processEventStatisticsEvent(&pEventArg_p->eventStatistics, pUserArg_p);
+            break;
+
         default:
             break;
     }
@@ -466,4 +489,94 @@ static tOplkError processCfmResultEvent(const tOplkApiEventCfmResult* pCfmResult
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process cycle histogram events
+
+The function processes cycle histogram events. It prints the percentiles of
+the histogram in microseconds.
+
+\param[in]      pCycleHistogram_p   Pointer to the cycle histogram information
+\param[in]      pUserArg_p          User specific argument
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processCycleHistogramEvent(const tOplkApiEventCycleHistogram* pCycleHistogram_p,
+                                             void* pUserArg_p)
+{
+    const tHistogram*   pHistogram = pCycleHistogram_p->pHistogram;
+
+    UNUSED_PARAMETER(pUserArg_p);
+
+    if (pCycleHistogram_p->histogramId >= kDllCycleHistogramCount)
+        return kErrorOk;
+
+    if (pHistogram->count == 0)
+    {
+        printf("%-18s: no samples\n", aCycleHistogramName_l[pCycleHistogram_p->histogramId]);
+        return kErrorOk;
+    }
+
+    printf("%-18s: n=%u min=%.3f p50=%.3f p99=%.3f p99.9=%.3f p99.99=%.3f max=%.3f\n",
+           aCycleHistogramName_l[pCycleHistogram_p->histogramId],
+           pHistogram->count,
+           pHistogram->min / 1000.0,
+           histogram_getPercentile(pHistogram, 500000) / 1000.0,
+           histogram_getPercentile(pHistogram, 990000) / 1000.0,
+           histogram_getPercentile(pHistogram, 999000) / 1000.0,
+           histogram_getPercentile(pHistogram, 999900) / 1000.0,
+           pHistogram->max / 1000.0);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process event statistics events
+
+The function processes event statistics events. It prints the statistics of
+the kernel and user event threads.
+
+\param[in]      pEventStatistics_p  Pointer to the event statistics information
+\param[in]      pUserArg_p          User specific argument
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processEventStatisticsEvent(const tOplkApiEventEventStatistics* pEventStatistics_p,
+                                              void* pUserArg_p)
+{
+    UNUSED_PARAMETER(pUserArg_p);
+
+    printEventStatistics("Kernel events", &pEventStatistics_p->kernelStatistics);
+    printEventStatistics("User events", &pEventStatistics_p->userStatistics);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print event thread statistics
+
+The function prints the statistics of a single event thread. The latencies are
+printed in microseconds.
+
+\param[in]      pName_p             Name of the event thread
+\param[in]      pStatistics_p       Pointer to the event thread statistics
+*/
+//------------------------------------------------------------------------------
+static void printEventStatistics(const char* pName_p,
+                                 const tEventCalStatistics* pStatistics_p)
+{
+    printf("%-18s: wakeups=%u events=%u maxBatch=%u events/s=%u lastLatency=%.3f maxLatency=%.3f\n",
+           pName_p,
+           pStatistics_p->wakeupCount,
+           pStatistics_p->eventCount,
+           pStatistics_p->maxBatchSize,
+           pStatistics_p->eventsPerSecond,
+           pStatistics_p->lastWakeupLatency / 1000.0,
+           pStatistics_p->maxWakeupLatency / 1000.0);
+}
+
 /// \}
@@ -395,6 +395,8 @@ static void loopMain(void)
     printf("\n-------------------------------\n");
     printf("Press Esc to leave the program\n");
     printf("Press r to reset the node\n");
+    printf("Press h to print the cycle histograms (us)\n");
+    printf("Press e to print the event thread statistics\n");
     printf("-------------------------------\n\n");
 
     while (!fExit)
@@ -428,6 +430,28 @@ static void loopMain(void)
                     }
                     break;
 
+                case 'h':
+                    ret = oplk_triggerCycleHistogram();
+                    if (ret != kErrorOk)
+                    {
+                        fprintf(stderr,
+                                "oplk_triggerCycleHistogram() failed with \"%s\" (0x%04x)\n",
+                                debugstr_getRetValStr(ret),
+                                ret);
+                    }
+                    break;
+
+                case 'e':
+                    ret = oplk_triggerEventStatistics();
+                    if (ret != kErrorOk)
+                    {
+                        fprintf(stderr,
+                                "oplk_triggerEventStatistics() failed with \"%s\" (0x%04x)\n",
+                                debugstr_getRetValStr(ret),
+                                ret);
+                    }
+                    break;
+
                 case 0x1B:
                     fExit = TRUE;
                     break;
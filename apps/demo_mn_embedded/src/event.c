@@ -439,6 +439,11 @@ static tOplkError processCfmProgressEvent(const tCfmEventCnProgress* pCfmProgres
            (ULONG)pCfmProgress_p->bytesDownloaded,
            (ULONG)pCfmProgress_p->totalNumberOfBytes);
 
+    PRINTF(", %lu/%lu Objects, %lu ms",
+           (ULONG)pCfmProgress_p->objectsDownloaded,
+           (ULONG)pCfmProgress_p->totalNumberOfObjects,
+           (ULONG)pCfmProgress_p->elapsedTimeMs);
+
     if ((pCfmProgress_p->sdoAbortCode != 0) ||
         (pCfmProgress_p->error != kErrorOk))
     {
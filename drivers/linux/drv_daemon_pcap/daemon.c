@@ -181,10 +181,11 @@ int main(int argc, char* argv[])
     // initialize POWERLINK stack
     printf("Running...\n");
 
+    // ctrlk_process() blocks until a command is received or the heartbeat
+    // has to be updated
     fExit = FALSE;
     while (!fExit)
     {
-        target_msleep(1);
         if (console_kbhit())
         {
             cKey = (char)console_getch();
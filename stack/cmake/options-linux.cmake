@@ -41,6 +41,7 @@ OPTION (CFG_COMPILE_LIB_MNAPP_KERNELINTF        "Compile openPOWERLINK MN applic
 OPTION (CFG_COMPILE_LIB_MNAPP_PCIEINTF          "Compile openPOWERLINK MN application library for PCIe interface" ON)
 OPTION (CFG_COMPILE_LIB_MNAPP_ZYNQINTF          "Compile openPOWERLINK MN application library for zynq/FPGA interface" ON)
 OPTION (CFG_COMPILE_LIB_MNDRV_PCAP              "Compile openPOWERLINK MN driver library for linux userspace (pcap)" ON)
+OPTION (CFG_COMPILE_LIB_MNDRV_RAWSOCK           "Compile openPOWERLINK MN driver library for linux userspace (AF_PACKET)" ON)
 OPTION (CFG_COMPILE_LIB_MN_SIM                  "Compile openPOWERLINK MN library with simulation interface" ON)
 
 ################################################################################
@@ -50,6 +51,7 @@ OPTION (CFG_COMPILE_LIB_CN                      "Compile openPOWERLINK CN librar
 OPTION (CFG_COMPILE_LIB_CNAPP_USERINTF          "Compile openPOWERLINK CN application library for userspace" ON)
 OPTION (CFG_COMPILE_LIB_CNAPP_KERNELINTF        "Compile openPOWERLINK CN application library for kernel interface" ON)
 OPTION (CFG_COMPILE_LIB_CNDRV_PCAP              "Compile openPOWERLINK CN driver library for linux userspace (pcap)" ON)
+OPTION (CFG_COMPILE_LIB_CNDRV_RAWSOCK           "Compile openPOWERLINK CN driver library for linux userspace (AF_PACKET)" ON)
 OPTION (CFG_COMPILE_LIB_CN_SIM                  "Compile openPOWERLINK MN library with simulation interface" ON)
 
 ################################################################################
@@ -61,6 +63,8 @@ OPTION (CFG_COMPILE_SHARED_LIBRARY              "Build openPOWERLINK library as
 # Options for library features
 
 OPTION (CFG_INCLUDE_MN_REDUNDANCY               "Compile MN redundancy functions into MN libraries" OFF)
+CMAKE_DEPENDENT_OPTION (CFG_MNDRV_RAWSOCK_TXTIME "Send cyclic frames with SO_TXTIME launch times in the MN AF_PACKET driver library" OFF
+                                                "CFG_COMPILE_LIB_MNDRV_RAWSOCK" OFF)
 CMAKE_DEPENDENT_OPTION (CFG_STORE_RESTORE       "Support storing of OD in non-volatile memory (file system)" ON
                                                 "CFG_COMPILE_LIB_CN OR CFG_COMPILE_LIB_CNAPP_USERINTF OR CFG_COMPILE_LIB_CNAPP_KERNELINTF" OFF)
 
@@ -88,6 +92,10 @@ IF(CFG_COMPILE_LIB_MNDRV_PCAP)
     ADD_SUBDIRECTORY(proj/linux/liboplkmndrv-pcap)
 ENDIF()
 
+IF(CFG_COMPILE_LIB_MNDRV_RAWSOCK)
+    ADD_SUBDIRECTORY(proj/linux/liboplkmndrv-rawsock)
+ENDIF()
+
 IF(CFG_COMPILE_LIB_MN_SIM)
     ADD_SUBDIRECTORY(proj/linux/liboplkmn-sim)
 ENDIF()
@@ -109,6 +117,10 @@ IF(CFG_COMPILE_LIB_CNDRV_PCAP)
     ADD_SUBDIRECTORY(proj/linux/liboplkcndrv-pcap)
 ENDIF()
 
+IF(CFG_COMPILE_LIB_CNDRV_RAWSOCK)
+    ADD_SUBDIRECTORY(proj/linux/liboplkcndrv-rawsock)
+ENDIF()
+
 IF(CFG_COMPILE_LIB_CN_SIM)
     ADD_SUBDIRECTORY(proj/linux/liboplkcn-sim)
 ENDIF()
@@ -36,6 +36,7 @@
 
 SET(COMMON_SOURCES
     ${COMMON_SOURCE_DIR}/debugstr.c
+    ${COMMON_SOURCE_DIR}/histogram.c
     )
 
 SET(COMMON_WINDOWS_SOURCES
@@ -121,6 +122,12 @@ SET(OBD_CONF_WINDOWSUSER_SOURCES
     ${USER_SOURCE_DIR}/obd/obdconfcrc-generic.c
     )
 
+################################################################################
+# User CFM configuration cache archive sources
+SET(CFM_CACHE_LINUXUSER_SOURCES
+    ${USER_SOURCE_DIR}/cfmcache-fileio.c
+    )
+
 ################################################################################
 # SDO Stack Target specific sources
 
@@ -462,11 +469,18 @@ SET(PDO_KCAL_DUALPROCSHM_SOURCES
 
 SET(HARDWARE_DRIVER_LINUXUSER_SOURCES
     ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
-    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-timerfd.c
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
     ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
     )
 
+SET(HARDWARE_DRIVER_LINUXUSER_RAWSOCK_SOURCES
+    ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-timerfd.c
+    ${EDRV_SOURCE_DIR}/edrvcyclic.c
+    ${EDRV_SOURCE_DIR}/edrv-rawsock_linux.c
+    )
+
 SET(HARDWARE_DRIVER_WINDOWS_SOURCES
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
     ${EDRV_SOURCE_DIR}/edrv-pcap_win.c
@@ -620,6 +634,8 @@ SET(TARGET_WINDOWS_DUAL_SOURCES
 SET(TARGET_LINUX_SOURCES
     ${ARCH_SOURCE_DIR}/linux/target-linux.c
     ${ARCH_SOURCE_DIR}/linux/target-mutex.c
+    ${ARCH_SOURCE_DIR}/linux/doorbell-linux.c
+    ${ARCH_SOURCE_DIR}/linux/eventthread-linux.c
     )
 
 SET(TARGET_MICROBLAZE_SOURCES
@@ -698,6 +714,7 @@ SET(OPLK_HEADERS
     ${STACK_INCLUDE_DIR}/oplk/targetsystem.h
     ${STACK_INCLUDE_DIR}/oplk/version.h
     ${STACK_INCLUDE_DIR}/oplk/event.h
+    ${STACK_INCLUDE_DIR}/oplk/histogram.h
     ${STACK_INCLUDE_DIR}/oplk/basictypes.h
     ${STACK_INCLUDE_DIR}/oplk/nmt.h
     ${STACK_INCLUDE_DIR}/oplk/obd.h
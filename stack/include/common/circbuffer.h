@@ -45,6 +45,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define NR_OF_CIRC_BUFFERS              20
 #define CIRCBUF_BLOCK_ALIGNMENT         4
+#define CIRCBUF_CACHE_LINE_SIZE         64
+#define CIRCBUF_BATCH_ALIGNMENT         8       // Alignment of the data blocks returned by circbuf_readBatch()
+
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+#define CIRCBUF_LOCKFREE_SUPPORT                // Lock-free single consumer buffers are supported
+#endif
 
 #undef  DEBUG_CIRCBUF_SIZE_CHECK                // Add debug code for retrieving maximum used buffer size
 
@@ -74,6 +80,23 @@ Data type for the enumerator \ref eCircBufError.
 */
 typedef UINT32 tCircBufError;
 
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+/**
+*  \brief Lock-free circular buffer index
+*
+*  The struct defines an index of a lock-free circular buffer. The producer and
+*  the consumer own one index each, which is only written by the owner. The
+*  index is padded to a cache line to avoid false sharing between producer and
+*  consumer.
+*/
+typedef struct
+{
+    UINT32              position;           ///< Position in the range [0, 2 * bufferSize)
+    UINT32              count;              ///< Number of processed data blocks
+    UINT8               aPadding[CIRCBUF_CACHE_LINE_SIZE - (2 * sizeof(UINT32))];
+} tCircBufIndex;
+#endif
+
 /**
 *  \brief Header for circular buffer
 *
@@ -83,6 +106,12 @@ typedef UINT32 tCircBufError;
 */
 typedef struct
 {
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    tCircBufIndex       producer;           ///< Producer index of a lock-free buffer
+    tCircBufIndex       consumer;           ///< Consumer index of a lock-free buffer
+    BOOL                fLockFree;          ///< Buffer uses the lock-free indices, the consumer does not lock
+    BOOL                fSingleProducer;    ///< The producer of a lock-free buffer does not lock
+#endif
     UINT32              bufferSize;         ///< Total size of circular buffer
     UINT32              writeOffset;        ///< The write offset
     UINT32              readOffset;         ///< The read offset
@@ -129,6 +158,8 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p, const voi
 tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
                                size_t size_p, size_t* pDataBlockSize_p)
                                SECTION_CIRCBUF_READ_DATA;
+tCircBufError circbuf_readBatch(tCircBufInstance* pInstance_p, void* pData_p, size_t size_p,
+                                size_t* paBlockSize_p, UINT maxBlockCount_p, UINT* pBlockCount_p);
 UINT32        circbuf_getDataCount(const tCircBufInstance* pInstance_p);
 tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pfnSigCb_p);
 
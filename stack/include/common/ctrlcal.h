@@ -66,6 +66,10 @@ void       ctrlcal_writeData(UINT offset_p,
 tOplkError ctrlcal_readData(void* pDest_p,
                             UINT offset_p,
                             size_t length_p);
+void       ctrlcal_signalCommand(void);
+BOOL       ctrlcal_waitCommand(UINT32 timeoutMs_p);
+void       ctrlcal_signalReturn(void);
+BOOL       ctrlcal_waitReturn(UINT32 timeoutMs_p);
 
 #ifdef __cplusplus
 }
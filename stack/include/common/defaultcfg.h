@@ -64,12 +64,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_EVENT_SIZE_CIRCBUF_USER_INTERNAL         32768               // Default size for user-internal event queue
 #endif
 
-#ifndef CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT
-#define CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT           2048                // Default size for NMT request queue
-#endif
-
-#ifndef CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN
-#define CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN           2048                // Default size for generic request queue
+#ifndef CONFIG_EVENT_BATCH_SIZE
+#define CONFIG_EVENT_BATCH_SIZE                         32                  // Maximum number of events processed per event thread wakeup
 #endif
 
 #ifndef CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_IDENT
@@ -84,6 +80,33 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH               32768               // Default size for virtual Ethernet Tx queue
 #endif
 
+#ifndef CONFIG_DLLCAL_ASYNC_WEIGHT_NMT
+#define CONFIG_DLLCAL_ASYNC_WEIGHT_NMT                  4                   // Asynchronous slots per scheduling round for NMT traffic
+#endif
+
+#ifndef CONFIG_DLLCAL_ASYNC_WEIGHT_SDO
+#define CONFIG_DLLCAL_ASYNC_WEIGHT_SDO                  4                   // Asynchronous slots per scheduling round for generic (SDO) traffic
+#endif
+
+#ifndef CONFIG_DLLCAL_ASYNC_WEIGHT_VETH
+#define CONFIG_DLLCAL_ASYNC_WEIGHT_VETH                 2                   // Asynchronous slots per scheduling round for virtual Ethernet traffic
+#endif
+
+#ifndef CONFIG_DLLCAL_ASYNC_WEIGHT_SYNC
+#define CONFIG_DLLCAL_ASYNC_WEIGHT_SYNC                 1                   // Asynchronous slots per scheduling round for SyncRequests
+#endif
+
+#ifndef CONFIG_CIRCBUF_LOCKFREE_QUEUES
+#define CONFIG_CIRCBUF_LOCKFREE_QUEUES                  ((1 << CIRCBUF_USER_TO_KERNEL_QUEUE) | \
+                                                         (1 << CIRCBUF_KERNEL_TO_USER_QUEUE) | \
+                                                         (1 << CIRCBUF_KERNEL_INTERNAL_QUEUE) | \
+                                                         (1 << CIRCBUF_USER_INTERNAL_QUEUE))    // Circular buffers with a lock-free consumer (bit mask of buffer IDs)
+#endif
+
+#ifndef CONFIG_CIRCBUF_SINGLE_PRODUCER_QUEUES
+#define CONFIG_CIRCBUF_SINGLE_PRODUCER_QUEUES           0                   // Lock-free circular buffers with a single producer (bit mask of buffer IDs)
+#endif
+
 #ifndef CONFIG_CTRL_FILE_CHUNK_SIZE
 #define CONFIG_CTRL_FILE_CHUNK_SIZE                     1024
 #endif
@@ -201,6 +224,33 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define API_OBD_FORWARD_EVENT                           TRUE
 #endif
 
+// maximum number of connections of the SDO layers
+#ifndef CONFIG_SDO_MAX_CONNECTION_ASND
+#define CONFIG_SDO_MAX_CONNECTION_ASND                  5
+#endif
+
+#ifndef CONFIG_SDO_MAX_CONNECTION_UDP
+#define CONFIG_SDO_MAX_CONNECTION_UDP                   5
+#endif
+
+#ifndef CONFIG_SDO_MAX_CONNECTION_SEQ
+#define CONFIG_SDO_MAX_CONNECTION_SEQ                   5
+#endif
+
+#ifndef CONFIG_SDO_MAX_CONNECTION_COM
+#define CONFIG_SDO_MAX_CONNECTION_COM                   5
+#endif
+
+// default number of frames in the Tx history of an SDO sequence layer
+// connection, it limits the number of unacknowledged segments (window size)
+#ifndef CONFIG_SDO_SEQ_HISTORY_SIZE
+#define CONFIG_SDO_SEQ_HISTORY_SIZE                     5
+#endif
+
+#ifndef CONFIG_CFM_USE_CACHE
+#define CONFIG_CFM_USE_CACHE                            FALSE
+#endif
+
 #ifndef CONFIG_OBD_USE_STORE_RESTORE
 #define CONFIG_OBD_USE_STORE_RESTORE                    FALSE
 #endif
@@ -225,6 +275,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART          FALSE
 #endif
 
+#ifndef CONFIG_OBD_USE_INDEX_TABLE
+#define CONFIG_OBD_USE_INDEX_TABLE                      FALSE
+#endif
+
 #ifndef PLK_VETH_NAME
 #define PLK_VETH_NAME                                   "plk"               // name of net device in Linux
 #endif
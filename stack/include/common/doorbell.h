@@ -0,0 +1,80 @@
+/**
+********************************************************************************
+\file   common/doorbell.h
+
+\brief  Definitions for doorbell signaling library
+
+This file contains the definitions for the doorbell signaling library. A
+doorbell is a lightweight wakeup primitive shared between processes. It is
+used to notify a single waiting thread that new data is available.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_common_doorbell_H_
+#define _INC_common_doorbell_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  Doorbell instance
+
+The doorbell instance is an opaque type. It is created with doorbell_create()
+or doorbell_open() and must only be accessed by the doorbell functions.
+*/
+typedef struct sDoorbell tDoorbell;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError doorbell_create(const char* pName_p, tDoorbell** ppDoorbell_p);
+tOplkError doorbell_open(const char* pName_p, tDoorbell** ppDoorbell_p);
+void       doorbell_close(tDoorbell* pDoorbell_p);
+void       doorbell_ring(tDoorbell* pDoorbell_p);
+BOOL       doorbell_wait(tDoorbell* pDoorbell_p, UINT32 timeoutMs_p, UINT32* pLatency_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_common_doorbell_H_ */
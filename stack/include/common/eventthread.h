@@ -0,0 +1,106 @@
+/**
+********************************************************************************
+\file   common/eventthread.h
+
+\brief  Definitions for the Linux event thread library
+
+This file contains the definitions for the event thread library. It provides
+the event threads, the doorbells and the statistics which are shared by the
+kernel and the user event CAL modules on Linux userspace.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_common_eventthread_H_
+#define _INC_common_eventthread_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  Event thread types
+
+The enumeration lists the event threads. Each thread waits on its own doorbell.
+*/
+typedef enum
+{
+    kEventThreadKernel      = 0,        ///< Kernel event thread
+    kEventThreadUser        = 1,        ///< User event thread
+    kEventThreadCount       = 2,        ///< Number of event threads
+} eEventThread;
+
+/**
+\brief  Event thread data type
+
+Data type for the enumerator \ref eEventThread.
+*/
+typedef UINT8 tEventThread;
+
+/**
+\brief  Queue process function
+
+The function processes at most \p maxEventCount_p events of a queue and returns
+the number of processed events in \p pEventCount_p.
+*/
+typedef tOplkError (*tEventThreadProcessCb)(tEventQueue eventQueue_p,
+                                            UINT maxEventCount_p,
+                                            UINT* pEventCount_p);
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError eventthread_init(BOOL fCreate_p);
+void       eventthread_exit(void);
+tOplkError eventthread_start(tEventThread thread_p,
+                             tEventThreadProcessCb pfnProcessCb_p,
+                             tEventQueue highPrioQueue_p,
+                             tEventQueue lowPrioQueue_p);
+void       eventthread_stop(tEventThread thread_p);
+void       eventthread_getStatistics(tEventThread thread_p, tEventCalStatistics* pStatistics_p);
+void       eventthread_signalKernelEvent(void);
+void       eventthread_signalUserEvent(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_common_eventthread_H_ */
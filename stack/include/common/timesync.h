@@ -43,7 +43,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define TIMESYNC_SYNC_BSDSEM            "/semTimeSyncSync"
+#define TIMESYNC_SYNC_SHM               "/shmTimeSyncSync"
+#define TIMESYNC_SYNC_DOORBELL          "/dbTimeSyncSync"
 
 //------------------------------------------------------------------------------
 // typedef
@@ -79,6 +80,33 @@ typedef struct
     tTimesyncSocTime        aTripleBuf[3];  ///< Triple buffer
 } tTimesyncSocTimeTripleBuf;
 
+/**
+\brief  Sync event information
+
+This structure describes a sync event sent from the kernel to the user layer.
+*/
+typedef struct
+{
+    UINT32                  syncEventCount; ///< Sequence number of the sync event
+    UINT32                  cycleCount;     ///< Number of the POWERLINK cycle which triggered the sync event
+    tTimesyncSocTime        socTime;        ///< SoC time of the cycle (only valid with SoC time forwarding)
+} tTimesyncSyncInfo;
+
+/**
+\brief  Sync record
+
+This structure defines the sync record which is shared between the kernel and
+the user layer. The kernel layer overwrites the record on every sync event,
+so the user layer always reads the newest sync event. The sequence counter is
+odd while the record is written.
+*/
+typedef struct
+{
+    UINT32                  sequence;       ///< Sequence counter for consistent reading
+    UINT32                  padding1;       ///< Padding to achieve 64 bit alignment
+    tTimesyncSyncInfo       syncInfo;       ///< Information of the newest sync event
+} tTimesyncSyncRecord;
+
 /**
 \brief  Timesync shared memory
 
@@ -51,6 +51,29 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief Asynchronous traffic classes
+
+This enum lists the traffic classes the asynchronous scheduler of the DLLk CAL
+module distributes the asynchronous phases to. Generic requests of CNs are
+accounted to \ref kDllkCalAsyncClassSdo because the MN cannot see their content.
+*/
+typedef enum
+{
+    kDllkCalAsyncClassNmt   = 0,    ///< NMT requests, IdentRequests and StatusRequests
+    kDllkCalAsyncClassSdo   = 1,    ///< Generic priority POWERLINK frames (e.g. SDO)
+    kDllkCalAsyncClassVeth  = 2,    ///< Virtual Ethernet frames
+    kDllkCalAsyncClassSync  = 3,    ///< SyncRequests
+    kDllkCalAsyncClassCount,        ///< Dummy enum to get class count
+} eDllkCalAsyncClass;
+
+/**
+\brief Asynchronous traffic class data type
+
+Data type for the enumerator \ref eDllkCalAsyncClass.
+*/
+typedef UINT32 tDllkCalAsyncClass;
+
 /**
 \brief Structure defining statistics of the DLLk CAL module
 
@@ -65,6 +88,11 @@ typedef struct
     ULONG       maxTxFrameCountGen;                         ///< Max number of frames in the generic TX queue
     ULONG       maxTxFrameCountNmt;                         ///< Max number of frames in the NMT TX queue
     ULONG       maxRxFrameCount;                            ///< Max number of frames in the RX queue
+    ULONG       aAsyncSlotCount[kDllkCalAsyncClassCount];   ///< Number of asynchronous phases assigned per traffic class (MN only)
+    ULONG       asyncSlotIdleCount;                         ///< Number of asynchronous phases not assigned to any node (MN only)
+    ULONG       aCnNmtLatencyMax[254];                      ///< Worst-case number of cycles a CN waited for an asynchronous phase for NMT requests (MN only, index = node ID - 1)
+    ULONG       aCnGenLatencyMax[254];                      ///< Worst-case number of cycles a CN waited for an asynchronous phase for generic requests (MN only, index = node ID - 1)
+    ULONG       asyncLatencyMax;                            ///< Worst-case number of cycles any CN waited for an asynchronous phase (MN only)
 } tDllkCalStatistics;
 
 //------------------------------------------------------------------------------
@@ -82,6 +82,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define EDRV_USE_TTTX                                   FALSE
 #endif
 
+#ifndef EDRV_USE_TX_BATCH
+#define EDRV_USE_TX_BATCH                               FALSE
+#endif
+
 //------------------------------------------------------------------------------
 // Type definitions
 //------------------------------------------------------------------------------
@@ -237,6 +241,10 @@ tOplkError   edrv_releaseRxBuffer(tEdrvRxBuffer* pBuffer_p);
 tOplkError   edrv_updateTxBuffer(tEdrvTxBuffer* pBuffer_p);
 #endif
 
+#if (EDRV_USE_TX_BATCH == TRUE)
+tOplkError   edrv_sendTxBufferList(tEdrvTxBuffer* const* ppBuffer_p, UINT count_p, UINT* pSentCount_p);
+#endif
+
 #if (EDRV_USE_TTTX == TRUE)
 tOplkError   edrv_getMacTime(UINT64* pCurtime_p);
 #endif
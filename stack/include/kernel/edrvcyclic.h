@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <kernel/edrv.h>
+#include <oplk/histogram.h>
 
 //------------------------------------------------------------------------------
 // const defines
@@ -91,6 +92,13 @@ typedef struct
     UINT32      aCycleTime[EDRV_CYCLIC_SAMPLE_NUM];         ///< Array of cycle time values (until next SoC send)
     UINT32      aUsedCycleTime[EDRV_CYCLIC_SAMPLE_NUM];     ///< Array of used cycle time values
     UINT32      aSpareCycleTime[EDRV_CYCLIC_SAMPLE_NUM];    ///< Array of spare cycle time values
+    // distribution of all cycles
+    tHistogram  cycleTimeHistogram;                         ///< Histogram of the cycle time
+    tHistogram  usedCycleTimeHistogram;                     ///< Histogram of the utilized cycle time
+    tHistogram  spareCycleTimeHistogram;                    ///< Histogram of the spare cycle time
+    tHistogram  socToPreqHistogram;                         ///< Histogram of the latency from cycle start to the first PReq
+    // timer
+    UINT32      cycleTimerOverrunCount;                     ///< Number of missed cycle timer expirations (0 if not supported by the timer)
 } tEdrvCyclicDiagnostics;
 #endif
 
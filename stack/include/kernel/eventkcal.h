@@ -68,6 +68,11 @@ tOplkError eventkcal_postUserEvent(const tEvent* pEvent_p) SECTION_EVENTKCAL_POS
 tOplkError eventkcal_postKernelEvent(const tEvent* pEvent_p) SECTION_EVENTKCAL_POST;
 void       eventkcal_process(void);
 
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+/* functions used in eventkcal-linux.c */
+void       eventkcal_getStatistics(tEventCalStatistics* pStatistics_p);
+#endif
+
 #if ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
 /* functions used in eventkcal-linuxkernel.c */
 int        eventkcal_postEventFromUser(ULONG arg);
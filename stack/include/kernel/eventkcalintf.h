@@ -65,6 +65,7 @@ tOplkError eventkcal_initQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventkcal_exitQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventkcal_postEventCircbuf(tEventQueue eventQueue_p, const tEvent* pEvent_p) SECTION_EVENTKCAL_CIRCBUF_POST;
 tOplkError eventkcal_processEventCircbuf(tEventQueue eventQueue_p);
+tOplkError eventkcal_processEventsCircbuf(tEventQueue eventQueue_p, UINT maxEventCount_p, UINT* pEventCount_p);
 tOplkError eventkcal_getEventCircbuf(tEventQueue eventQueue_p, UINT8* pDataBuffer_p, size_t* pReadSize_p);
 UINT       eventkcal_getEventCountCircbuf(tEventQueue eventQueue_p);
 tOplkError eventkcal_setSignalingCircbuf(tEventQueue eventQueue_p, VOIDFUNCPTR pfnSignalCb_p);
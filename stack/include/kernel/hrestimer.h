@@ -87,6 +87,8 @@ tOplkError hrestimer_setAbsoluteTimer(tTimerHdl* pTimerHdl_p,
 tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p);
 void       hrestimer_controlExtSyncIrq(BOOL fEnable_p);
 void       hrestimer_setExtSyncIrqTime(tTimestamp time_p);
+tOplkError hrestimer_getOverrunCount(tTimerHdl timerHdl_p,
+                                     UINT32* pOverrunCount_p);
 
 #ifdef __cplusplus
 }
@@ -41,6 +41,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <common/pdo.h>
+#include <kernel/pdoklut.h>
 #include <oplk/event.h>
 
 //------------------------------------------------------------------------------
@@ -75,10 +76,10 @@ tOplkError pdokcal_initPdoMem(const tPdoChannelSetup* pPdoChannels,
                               size_t txPdoMemSize_p);
 void       pdokcal_cleanupPdoMem(void);
 tOplkError pdokcal_getPdoMemRegion(UINT8** ppPdoMemBase, size_t* pPdoMemSize_p);
-tOplkError pdokcal_writeRxPdo(UINT channelId_p,
-                              const UINT8* pPayload_p,
-                              UINT16 pdoSize_p)
-                              SECTION_PDOKCAL_WRITE_RPDO;
+tOplkError pdokcal_writeRxPdos(const UINT8* pPayload_p,
+                               const tPdoklutChannel* paRxPdo_p,
+                               UINT rxPdoCount_p)
+                               SECTION_PDOKCAL_WRITE_RPDO;
 tOplkError pdokcal_readTxPdo(UINT channelId_p,
                              UINT8* pPayload_p,
                              UINT16 pdoSize_p)
@@ -50,19 +50,39 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // require up to 1490 / 254 --> 6 PDO channels per frame.
 #define PDOKLUT_MAX_CHANNELS_PER_NODE       6
 #define PDOKLUT_INVALID_CHANNEL             0xff
+#define PDOKLUT_INVALID_VERSION             0xff
 
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
 
+/**
+\brief PDO lookup table channel descriptor
+
+The following structure describes a PDO channel of a node. It contains a copy
+of the channel information needed to transfer the channel in the frame.
+*/
+typedef struct
+{
+    UINT8               channelId;              ///< Channel ID of the PDO
+    UINT8               mappingVersion;         ///< Mapping version of the PDO
+    UINT16              offset;                 ///< Offset of the PDO in the frame payload
+    UINT16              pdoSize;                ///< Size of the PDO
+} tPdoklutChannel;
+
 /**
 \brief PDO lookup table entry
 
-The following structure defines a PDO lookup table entry.
+The following structure defines a PDO lookup table entry. The lookup table is
+directly indexed by the node ID. Each entry contains the descriptors of all PDO
+channels of the node and the values required to validate a frame at once.
 */
 typedef struct
 {
-    UINT8               channelId[PDOKLUT_MAX_CHANNELS_PER_NODE];       ///< Array to store PDO channel IDs for the node.
+    UINT8               channelCount;           ///< Number of PDO channels of the node
+    UINT8               mappingVersion;         ///< Main mapping version of all channels, PDOKLUT_INVALID_VERSION if they differ
+    UINT16              pdoSize;                ///< Expected PDO size (end of the last channel in the frame payload)
+    tPdoklutChannel     aChannel[PDOKLUT_MAX_CHANNELS_PER_NODE];        ///< Array of PDO channel descriptors of the node
 } tPdoklutEntry;
 
 
@@ -78,10 +98,9 @@ void       pdoklut_clear(tPdoklutEntry* pLut_p, UINT32 numEntries_p);
 tOplkError pdoklut_addChannel(tPdoklutEntry* pLut_p,
                               const tPdoChannel* pPdoChannel_p,
                               UINT channelId_p);
-UINT       pdoklut_getChannel(const tPdoklutEntry* pLut_p,
-                              UINT8 searchIndex_p,
-                              UINT8 nodeId_p)
-                              SECTION_PDOKLUT_GETCHANNEL;
+void       pdoklut_removeChannel(tPdoklutEntry* pLut_p,
+                                 UINT8 nodeId_p,
+                                 UINT channelId_p);
 
 #ifdef __cplusplus
 }
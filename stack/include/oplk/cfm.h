@@ -64,6 +64,9 @@ typedef struct
     tOplkError          error;                  ///< Error which occurred
     UINT32              totalNumberOfBytes;     ///< Total number of bytes to transfer
     UINT32              bytesDownloaded;        ///< Number of already downloaded bytes
+    UINT32              totalNumberOfObjects;   ///< Total number of ConciseDCF objects to transfer
+    UINT32              objectsDownloaded;      ///< Number of already downloaded ConciseDCF objects
+    UINT32              elapsedTimeMs;          ///< Time since the start of the configuration [ms]
 } tCfmEventCnProgress;
 
 #endif /* _INC_oplk_cfm_H_ */
@@ -43,6 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <oplk/oplkinc.h>
 #include <oplk/frame.h>
+#include <oplk/histogram.h>
 
 //------------------------------------------------------------------------------
 // const defines
@@ -320,4 +321,39 @@ typedef struct
     UINT8           frameBuf[MAX_PRES_FORWARD_BUFLEN];  ///< The received PRes frame.
 } tDllEventReceivedPres;
 
+/**
+\brief Enumeration for cycle histograms
+
+The enumeration contains all histograms which are recorded by the cyclic
+Ethernet driver on the MN.
+*/
+typedef enum
+{
+    kDllCycleHistogramCycleTime      = 0x00,            ///< Cycle time
+    kDllCycleHistogramUsedCycleTime  = 0x01,            ///< Utilized cycle time
+    kDllCycleHistogramSpareCycleTime = 0x02,            ///< Spare cycle time
+    kDllCycleHistogramSocToPreq      = 0x03,            ///< Latency from cycle start to the first PReq
+    kDllCycleHistogramCount          = 0x04,            ///< Number of cycle histograms
+} eDllCycleHistogram;
+
+/**
+\brief Cycle histogram data type
+
+Data type for the enumerator \ref eDllCycleHistogram.
+*/
+typedef UINT32 tDllCycleHistogram;
+
+/**
+\brief Structure for forwarded cycle histograms
+
+The structure describes a cycle histogram event which is used by the DLL to
+forward a histogram of the cyclic Ethernet driver to the application. All
+values are given in nanoseconds.
+*/
+typedef struct
+{
+    tDllCycleHistogram  histogramId;                    ///< Identifies the forwarded histogram
+    tHistogram          histogram;                      ///< The forwarded histogram
+} tDllEventCycleHistogram;
+
 #endif  /* _INC_oplk_dll_H_ */
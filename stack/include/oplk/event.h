@@ -103,6 +103,10 @@ typedef enum
     kEventTypeReceivedPres          = 0x30,     ///< Received a PRes frame, which shall be forwarded to application (arg is pointer to tEventReceivedPres)
     kEventTypeRequPresForward       = 0x31,     ///< Request forwarding of a PRes frame to API layer (e.g. for conformance test)
     kEventTypeSdoAsySend            = 0x32,     ///< SDO sequence layer event (for SDO command layer testing module)
+    kEventTypeRequCycleHistogram    = 0x33,     ///< Request forwarding of the cycle histograms to API layer (arg is pointer to nothing)
+    kEventTypeCycleHistogram        = 0x34,     ///< Cycle histogram, which shall be forwarded to application (arg is pointer to tDllEventCycleHistogram)
+    kEventTypeRequEventStatistics   = 0x35,     ///< Request forwarding of the kernel event CAL statistics to API layer (arg is pointer to nothing)
+    kEventTypeEventStatistics       = 0x36,     ///< Kernel event CAL statistics, which shall be forwarded to application (arg is pointer to tEventCalStatistics)
 } eEventType;
 
 /**
@@ -283,6 +287,22 @@ typedef struct
     tOplkError          oplkError;              ///< openPOWERLINK error code
 } tEventDllError;
 
+/**
+\brief  Event CAL statistics
+
+The structure contains the statistics of an event CAL thread which is woken up
+by posted events.
+*/
+typedef struct
+{
+    UINT32              wakeupCount;            ///< Number of thread wakeups caused by posted events
+    UINT32              eventCount;             ///< Number of processed events
+    UINT32              maxBatchSize;           ///< Maximum number of events processed in one batch
+    UINT32              eventsPerSecond;        ///< Number of events processed during the last second
+    UINT32              lastWakeupLatency;      ///< Latency between posting and wakeup of the last wakeup [ns]
+    UINT32              maxWakeupLatency;       ///< Maximum latency between posting and wakeup [ns]
+} tEventCalStatistics;
+
 /**
 \brief  Callback function to get informed about sync event
 
@@ -101,6 +101,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SDO_CMDL_HDR_VAR_SIZE               4       // size of variable header part
 #define SDO_CMDL_HDR_WRITEBYINDEX_SIZE      4       // size of write by index header (index + subindex + reserved)
 #define SDO_CMDL_HDR_READBYINDEX_SIZE       4       // size of read by index header (index + subindex + reserved)
+#define SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE  8       // size of write multiple parameter by index sub-header (offset + index + subindex + padding)
+#define SDO_CMDL_WRITEMULTBYINDEX_ABORT_SIZE    8   // size of an aborted sub-transfer in the write multiple parameter by index response
+#define SDO_CMDL_WRITEMULTBYINDEX_FLAG_ABORT    0x80    // flag of an aborted sub-transfer in the write multiple parameter by index response
+#define SDO_CMDL_WRITEMULTBYINDEX_PAD_MASK      0x03    // mask of the padding size in the write multiple parameter by index sub-header
 
 // defines for SDO command layer flags
 #define SDO_CMDL_FLAG_RESPONSE       0x80
@@ -0,0 +1,93 @@
+/**
+********************************************************************************
+\file   oplk/histogram.h
+
+\brief  Definitions for histogram module
+
+This file contains the definitions for the histogram module. It provides
+fixed-size log-linear histograms for recording timing values.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_oplk_histogram_H_
+#define _INC_oplk_histogram_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+// Each power of two range is split into 2^HISTOGRAM_SUB_BUCKET_BITS linear
+// sub-buckets, this limits the relative error of a value to 1/16.
+#define HISTOGRAM_SUB_BUCKET_BITS       4
+#define HISTOGRAM_SUB_BUCKET_COUNT      (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_BUCKET_COUNT          ((32 - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKET_COUNT)
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief Histogram
+
+The structure describes a log-linear histogram of 32 bit values. Values
+below \ref HISTOGRAM_SUB_BUCKET_COUNT are counted exactly, larger values are
+counted in buckets whose width grows with the magnitude of the value.
+The histogram stops counting if \p count reaches its maximum value.
+*/
+typedef struct
+{
+    UINT32          count;                              ///< Number of recorded values
+    UINT32          min;                                ///< Minimum recorded value
+    UINT32          max;                                ///< Maximum recorded value
+    UINT32          aBucket[HISTOGRAM_BUCKET_COUNT];    ///< Number of recorded values per bucket
+} tHistogram;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+OPLKDLLEXPORT void   histogram_clear(tHistogram* pHistogram_p);
+OPLKDLLEXPORT void   histogram_record(tHistogram* pHistogram_p, UINT32 value_p);
+OPLKDLLEXPORT UINT32 histogram_getPercentile(const tHistogram* pHistogram_p, UINT32 ppm_p);
+OPLKDLLEXPORT UINT32 histogram_getBucketLowerBound(UINT bucket_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_oplk_histogram_H_ */
@@ -48,6 +48,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/obdal.h>
 #include <oplk/cfm.h>
 #include <oplk/event.h>
+#include <oplk/dll.h>
 
 
 //------------------------------------------------------------------------------
@@ -169,6 +170,32 @@ typedef struct
     tPlkFrame*                  pFrame;         ///< Pointer to the received PRes frame
 } tOplkApiEventReceivedPres;
 
+/**
+\brief Cycle histogram event
+
+This structure specifies the event for forwarded cycle histograms. It is used to
+forward the cycle timing histograms of the MN to the application (e.g. for
+diagnosis). All values are given in nanoseconds.
+*/
+typedef struct
+{
+    tDllCycleHistogram          histogramId;    ///< Identifies the forwarded histogram (\ref eDllCycleHistogram)
+    const tHistogram*           pHistogram;     ///< Pointer to the forwarded histogram
+} tOplkApiEventCycleHistogram;
+
+/**
+\brief Event statistics event
+
+This structure specifies the event for forwarded event CAL statistics. It is
+used to forward the wakeup and throughput statistics of the kernel and user
+event threads to the application (e.g. for diagnosis).
+*/
+typedef struct
+{
+    tEventCalStatistics         kernelStatistics;   ///< Statistics of the kernel event thread
+    tEventCalStatistics         userStatistics;     ///< Statistics of the user event thread
+} tOplkApiEventEventStatistics;
+
 /**
 \brief Received non-POWERLINK Ethernet frame event
 
@@ -337,6 +364,18 @@ typedef enum
     event function call, or \ref kErrorReject has to be returned, whereas the
     processing must finish with a call to \ref oplk_finishUserObdAccess. */
     kOplkApiEventUserObdAccess       = 0x85,
+
+    /** Cycle histogram event. This event forwards a cycle timing histogram
+    of the MN to the application. It is posted for every histogram after a
+    request with \ref oplk_triggerCycleHistogram. The event argument contains
+    the histogram (\ref tOplkApiEventCycleHistogram). */
+    kOplkApiEventCycleHistogram      = 0x86,
+
+    /** Event statistics event. This event forwards the statistics of the
+    kernel and user event threads to the application. It is posted after a
+    request with \ref oplk_triggerEventStatistics. The event argument contains
+    the statistics (\ref tOplkApiEventEventStatistics). */
+    kOplkApiEventEventStatistics     = 0x87,
 } eOplkApiEventType;
 
 /**
@@ -373,6 +412,8 @@ typedef union
     tOplkApiEventReceivedSdoCom receivedSdoCom;     ///< Received SDO command layer (\ref kOplkApiEventReceivedSdoCom)
     tOplkApiEventReceivedSdoSeq receivedSdoSeq;     ///< Received SDO sequence layer (\ref kOplkApiEventReceivedSdoSeq)
     tOplkApiEventUserObdAccess  userObdAccess;      ///< Access to user specific object (\ref kOplkApiEventUserObdAccess)
+    tOplkApiEventCycleHistogram cycleHistogram;     ///< Cycle histogram (\ref kOplkApiEventCycleHistogram)
+    tOplkApiEventEventStatistics eventStatistics;   ///< Event thread statistics (\ref kOplkApiEventEventStatistics)
 } tOplkApiEventArg;
 
 /**
@@ -474,6 +515,19 @@ typedef struct
     UINT           imageSize;                       ///< Size of the process image
 } tOplkApiProcessImage;
 
+/**
+\brief  RXPDO buffer information structure
+
+This structure provides direct access to the buffer of a received PDO. It is
+used for exchanging the output process image without copying the data.
+*/
+typedef struct
+{
+    const void*     pPdo;                           ///< Pointer to the PDO data (little endian, frame layout)
+    UINT            offset;                         ///< Offset of the PDO data in the frame payload
+    UINT            size;                           ///< Size of the PDO data
+} tOplkApiRxPdoBuffer;
+
 /**
 \brief  File chunk descriptor
 
@@ -514,6 +568,23 @@ typedef struct
     BOOL            fValidRelTime;                  ///< TRUE if relative time is validated
 } tOplkApiSocTimeInfo;
 
+/**
+\brief  Sync event information structure
+
+This structure provides information about the sync event which was received
+by the last call of oplk_waitSyncEvent().
+*/
+typedef struct
+{
+    UINT32          syncEventCount;                 ///< Sequence number of the sync event
+    UINT32          cycleCount;                     ///< Number of the POWERLINK cycle which triggered the sync event
+    UINT32          missedSyncEvents;               ///< Number of sync events missed since the previous oplk_waitSyncEvent() call
+    UINT32          totalMissedSyncEvents;          ///< Total number of missed sync events
+    tNetTime        netTime;                        ///< SoC net time of the cycle given in IEEE 1588 format
+    UINT64          relTime;                        ///< SoC relative time of the cycle given in us
+    BOOL            fValidRelTime;                  ///< TRUE if relative time is validated
+} tOplkApiSyncInfo;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -579,12 +650,14 @@ OPLKDLLEXPORT tOplkError oplk_setCdcBuffer(const void* pbCdc_p,
                                            size_t cdcSize_p);
 OPLKDLLEXPORT tOplkError oplk_setCdcFilename(const char* pszCdcFilename_p);
 OPLKDLLEXPORT tOplkError oplk_setOdArchivePath(const char* pBackupPath_p);
+OPLKDLLEXPORT tOplkError oplk_setCfmCachePath(const char* pCachePath_p);
 OPLKDLLEXPORT tOplkError oplk_process(void);
 OPLKDLLEXPORT tOplkError oplk_getIdentResponse(UINT nodeId_p,
                                                const tIdentResponse** ppIdentResponse_p);
 OPLKDLLEXPORT tOplkError oplk_getEthMacAddr(UINT8* pMacAddr_p);
 OPLKDLLEXPORT BOOL oplk_checkKernelStack(void);
 OPLKDLLEXPORT tOplkError oplk_waitSyncEvent(ULONG timeout_p);
+OPLKDLLEXPORT tOplkError oplk_getSyncInfo(tOplkApiSyncInfo* pSyncInfo_p);
 OPLKDLLEXPORT UINT32 oplk_getVersion(void);
 OPLKDLLEXPORT const char* oplk_getVersionString(void);
 OPLKDLLEXPORT UINT32 oplk_getStackConfiguration(void);
@@ -607,6 +680,9 @@ OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageOut(void);
 OPLKDLLEXPORT void* oplk_getProcessImageIn(void);
 OPLKDLLEXPORT void* oplk_getProcessImageOut(void);
+OPLKDLLEXPORT tOplkError oplk_exchangeRxPdoBuffers(void);
+OPLKDLLEXPORT tOplkError oplk_getRxPdoBuffer(UINT mappParamIndex_p,
+                                             tOplkApiRxPdoBuffer* pRxPdoBuffer_p);
 
 // objdict specific process image functions
 OPLKDLLEXPORT OPLK_DEPRECATED tOplkError oplk_setupProcessImage(void);
@@ -614,6 +690,12 @@ OPLKDLLEXPORT OPLK_DEPRECATED tOplkError oplk_setupProcessImage(void);
 // Request forwarding of Pres frame from DLL -> API
 OPLKDLLEXPORT tOplkError oplk_triggerPresForward(UINT nodeId_p);
 
+// Request forwarding of cycle histograms from DLL -> API
+OPLKDLLEXPORT tOplkError oplk_triggerCycleHistogram(void);
+
+// Request forwarding of event thread statistics from kernel -> API
+OPLKDLLEXPORT tOplkError oplk_triggerEventStatistics(void);
+
 // SDO Test API functions
 OPLKDLLEXPORT void oplk_testSdoSetVal(const tOplkApiInitParam* pInitParam_p);
 OPLKDLLEXPORT tOplkError oplk_testSdoComInit(void);
@@ -170,8 +170,6 @@ These constants determine the different queue implementations.
 #define CIRCBUF_DLLCAL_TXGEN                            4                   ///< Queue for sending generic requests in the DLLCAL
 #define CIRCBUF_DLLCAL_TXNMT                            5                   ///< Queue for sending NMT requests in the DLLCAL
 #define CIRCBUF_DLLCAL_TXSYNC                           6                   ///< Queue for sending sync requests in the DLLCAL
-#define CIRCBUF_DLLCAL_CN_REQ_NMT                       7                   ///< NMT request queue for MN asynchronous scheduler
-#define CIRCBUF_DLLCAL_CN_REQ_GEN                       8                   ///< Generic request queue for MN asynchronous scheduler
 #define CIRCBUF_DLLCAL_CN_REQ_IDENT                     9                   ///< Ident request queue for MN asynchronous scheduler
 #define CIRCBUF_DLLCAL_CN_REQ_STATUS                    10                  ///< Status request queue for MN asynchronous scheduler
 #define CIRCBUF_DLLCAL_TXVETH                           11                  ///< Queue for sending virtual Ethernet frames in the DLLCAL
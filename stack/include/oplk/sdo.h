@@ -108,7 +108,9 @@ This enumeration lists all valid SDO access types.
 typedef enum
 {
     kSdoAccessTypeRead                  = 0x00,     ///< SDO read access
-    kSdoAccessTypeWrite                 = 0x01      ///< SDO write access
+    kSdoAccessTypeWrite                 = 0x01,     ///< SDO write access
+    kSdoAccessTypeWriteMultiple         = 0x02      /**< SDO write multiple parameters by index access.
+                                                         The data contains the list of sub-transfers. */
 } eSdoAccessType;
 
 /**
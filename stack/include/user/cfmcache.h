@@ -0,0 +1,95 @@
+/**
+********************************************************************************
+\file   user/cfmcache.h
+
+\brief  Definitions for the CFM configuration cache
+
+This file contains the definitions for the persistent configuration cache of
+the configuration manager (CFM). The cache stores per node the identity of the
+configuration which was last verified on the CN.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_user_cfmcache_H_
+#define _INC_user_cfmcache_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define CFMCACHE_HASH_INIT          0x811C9DC5      ///< Start value of the cache hash
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  CFM cache entry
+
+The structure describes the configuration which was last verified on a CN.
+An entry with \p cdcSize 0 is invalid.
+*/
+typedef struct
+{
+    UINT32              cdcHash;                ///< Hash of the ConciseDCF of the CN
+    UINT32              cdcSize;                ///< Size of the ConciseDCF of the CN
+    UINT32              vendorId;               ///< Vendor ID of the CN (0x1018/1)
+    UINT32              productCode;            ///< Product code of the CN (0x1018/2)
+    UINT32              revisionNumber;         ///< Revision number of the CN (0x1018/3)
+    UINT32              serialNumber;           ///< Serial number of the CN (0x1018/4)
+    UINT32              confDate;               ///< Configuration date reported by the CN (0x1020/1)
+    UINT32              confTime;               ///< Configuration time reported by the CN (0x1020/2)
+} tCfmCacheEntry;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError cfmcache_init(void);
+tOplkError cfmcache_exit(void);
+tOplkError cfmcache_setArchivePath(const char* pArchivePath_p);
+tOplkError cfmcache_load(tCfmCacheEntry* pEntries_p, UINT count_p);
+tOplkError cfmcache_store(const tCfmCacheEntry* pEntries_p, UINT count_p);
+UINT32     cfmcache_calculateHash(UINT32 hash_p,
+                                  const void* pData_p,
+                                  size_t size_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_user_cfmcache_H_ */
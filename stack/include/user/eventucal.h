@@ -68,6 +68,11 @@ tOplkError eventucal_postKernelEvent(const tEvent* pEvent_p);
 tOplkError eventucal_postUserEvent(const tEvent* pEvent_p);
 void       eventucal_process(void);
 
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+/* functions used in eventucal-linux.c */
+void       eventucal_getStatistics(tEventCalStatistics* pStatistics_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -66,6 +66,7 @@ tOplkError eventucal_initQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventucal_exitQueueCircbuf(tEventQueue eventQueue_p);
 tOplkError eventucal_postEventCircbuf(tEventQueue eventQueue_p, const tEvent* pEvent_p);
 tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p);
+tOplkError eventucal_processEventsCircbuf(tEventQueue eventQueue_p, UINT maxEventCount_p, UINT* pEventCount_p);
 UINT       eventucal_getEventCountCircbuf(tEventQueue eventQueue_p);
 tOplkError eventucal_setSignalingCircbuf(tEventQueue eventQueue_p, VOIDFUNCPTR pfnSignalCb_p);
 
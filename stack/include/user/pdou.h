@@ -89,6 +89,11 @@ tOplkError pdou_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p);
 
 tOplkError pdou_copyRxPdoToPi(void);
 tOplkError pdou_copyTxPdoFromPi(void);
+tOplkError pdou_exchangeRxPdoBuffers(void);
+tOplkError pdou_getRxPdoBuffer(UINT mappParamIndex_p,
+                               const void** ppPdo_p,
+                               UINT* pOffset_p,
+                               UINT* pSize_p);
 tOplkError pdou_registerEventPdoChangeCb(tPdoCbEventPdoChange pfnCbEventPdoChange_p);
 
 #ifdef __cplusplus
@@ -87,6 +87,7 @@ tOplkError pdoucal_setTxPdo(UINT channelId_p,
 tOplkError pdoucal_getRxPdo(UINT8** ppPdo_p,
                             UINT channelId_p,
                             WORD pdoSize_p);
+UINT8*     pdoucal_getRxPdoAdrs(UINT channelId_p);
 
 #ifdef __cplusplus
 }
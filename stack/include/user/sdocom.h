@@ -67,7 +67,7 @@ typedef struct
     void*               pData;                  ///< Pointer to data which should be transfered
     UINT                dataSize;               ///< Size of data to be transfered
     UINT                timeout;                ///< Timeout: not supported in this version of openPOWERLINK
-    tSdoAccessType      sdoAccessType;          ///< The SDO access type (Read or Write) for this transfer
+    tSdoAccessType      sdoAccessType;          ///< The SDO access type (Read, Write or WriteMultiple) for this transfer
     tSdoFinishedCb      pfnSdoFinishedCb;       ///< Pointer to callback function which will be called when transfer is finished.
     void*               pUserArg;               ///< User definable argument pointer
 } tSdoComTransParamByIndex;
@@ -116,6 +116,7 @@ tOplkError sdoseq_sendData(tSdoSeqConHdl sdoSeqConHdl_p,
 tOplkError sdoseq_processEvent(const tEvent* pEvent_p);
 tOplkError sdoseq_deleteCon(tSdoSeqConHdl sdoSeqConHdl_p);
 tOplkError sdoseq_setTimeout(UINT32 timeout_p);
+tOplkError sdoseq_setHistorySize(UINT historySize_p);
 
 #ifdef __cplusplus
 }
@@ -60,6 +60,7 @@ extern "C"
 tOplkError timesyncucal_init(tSyncCb pfnSyncCb_p);
 void       timesyncucal_exit(void);
 tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p);
+tOplkError timesyncucal_getSyncInfo(tOplkApiSyncInfo* pSyncInfo_p);
 tOplkError timesyncucal_callSyncCb(void);
 
 tTimesyncSharedMemory* timesyncucal_getSharedMemory(void);
@@ -125,12 +125,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if defined(CONFIG_INCLUDE_CFM)
 #define CONFIG_OBD_DEF_CONCISEDCF_FILENAME          "mnobd.cdc"
 #define CONFIG_CFM_CONFIGURE_CYCLE_LENGTH           TRUE
+#define CONFIG_CFM_USE_CACHE                        TRUE
 #endif
 
 // Configure if the range from 0xA000 is used for mapping client objects.
 // openCONFIGURATOR uses this range for mapping objects.
 #define CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART      TRUE
 
+// Switch this define to TRUE to look up OD indices in a direct index table
+#define CONFIG_OBD_USE_INDEX_TABLE                  TRUE
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
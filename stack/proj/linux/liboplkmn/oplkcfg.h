@@ -95,6 +95,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // switch this define to TRUE to include Edrv diagnostic functions
 #define CONFIG_EDRV_USE_DIAGNOSTICS                 FALSE
 
+// switch this define to TRUE to include cyclic Edrv diagnostics (e.g. cycle histograms)
+#define CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS          TRUE
+
 //==============================================================================
 // Data Link Layer (DLL) specific defines
 //==============================================================================
@@ -132,12 +135,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if defined(CONFIG_INCLUDE_CFM)
 #define CONFIG_OBD_DEF_CONCISEDCF_FILENAME          "mnobd.cdc"
 #define CONFIG_CFM_CONFIGURE_CYCLE_LENGTH           TRUE
+#define CONFIG_CFM_USE_CACHE                        TRUE
 #endif
 
 // Configure if the range from 0xA000 is used for mapping client objects.
 // openCONFIGURATOR uses this range for mapping objects.
 #define CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART      TRUE
 
+// Switch this define to TRUE to look up OD indices in a direct index table
+#define CONFIG_OBD_USE_INDEX_TABLE                  TRUE
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
@@ -150,9 +157,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //==============================================================================
 
 // increase the number of SDO channels, because we are master
-#define CONFIG_SDO_MAX_CONNECTION_ASND              100
-#define CONFIG_SDO_MAX_CONNECTION_SEQ               100
-#define CONFIG_SDO_MAX_CONNECTION_COM               100
+#define CONFIG_SDO_MAX_CONNECTION_ASND              254
+#define CONFIG_SDO_MAX_CONNECTION_SEQ               254
+#define CONFIG_SDO_MAX_CONNECTION_COM               254
 #define CONFIG_SDO_MAX_CONNECTION_UDP               50
 
 #endif // _INC_oplkcfg_H_
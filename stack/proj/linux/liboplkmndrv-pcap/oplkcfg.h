@@ -86,6 +86,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // switch this define to TRUE to include Edrv diagnostic functions
 #define CONFIG_EDRV_USE_DIAGNOSTICS                 FALSE
 
+// switch this define to TRUE to include cyclic Edrv diagnostics (e.g. cycle histograms)
+#define CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS          TRUE
+
 //==============================================================================
 // Data Link Layer (DLL) specific defines
 //==============================================================================
@@ -0,0 +1,375 @@
+/**
+********************************************************************************
+\file   linux/doorbell-linux.c
+
+\brief  Doorbell signaling implementation for Linux userspace
+
+This file contains the doorbell implementation for Linux userspace. A doorbell
+consists of a single futex word which is located in a POSIX shared memory
+object. Therefore, it can be used to signal threads in different processes.
+
+Ringing an already rung doorbell doesn't cause a further system call. Multiple
+rings are coalesced into a single wakeup of the waiting thread, which is then
+responsible for draining all pending work. Only a single thread may wait on a
+doorbell.
+
+\ingroup module_target
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/doorbell.h>
+
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>           /* For O_* constants */
+#include <sys/stat.h>        /* For mode constants */
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define DOORBELL_NAME_SIZE          32
+
+#define DOORBELL_STATE_RUNG         0x00000001  // The doorbell was rung since the last wakeup
+#define DOORBELL_STATE_WAITING      0x00000002  // A thread is sleeping on the futex word
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Shared doorbell memory
+
+The structure describes the doorbell data located in shared memory.
+*/
+typedef struct
+{
+    UINT32              state;                  ///< Doorbell state (futex word)
+    UINT32              reserved;               ///< Reserved for alignment
+    UINT64              ringTimestamp;          ///< Time of the first ring since the last wakeup [ns]
+} tDoorbellShm;
+
+/**
+\brief  Doorbell instance
+
+The structure contains the process local data of a doorbell.
+*/
+struct sDoorbell
+{
+    tDoorbellShm*       pShm;                   ///< Pointer to the shared doorbell memory
+    int                 fd;                     ///< Shared memory file descriptor
+    BOOL                fCreator;               ///< Doorbell was created by this instance
+    char                aName[DOORBELL_NAME_SIZE];  ///< Name of the shared memory object
+};
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError openDoorbell(const char* pName_p, BOOL fCreate_p, tDoorbell** ppDoorbell_p);
+static UINT64     getMonotonicTime(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create a doorbell
+
+The function creates a new doorbell. An existing doorbell with the same name
+is replaced.
+
+\param[in]      pName_p             Name of the doorbell. It must start with a
+                                    slash and must not contain further slashes.
+\param[out]     ppDoorbell_p        Pointer to store the doorbell instance.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError doorbell_create(const char* pName_p, tDoorbell** ppDoorbell_p)
+{
+    return openDoorbell(pName_p, TRUE, ppDoorbell_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open a doorbell
+
+The function connects to a doorbell which was created by doorbell_create().
+
+\param[in]      pName_p             Name of the doorbell.
+\param[out]     ppDoorbell_p        Pointer to store the doorbell instance.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError doorbell_open(const char* pName_p, tDoorbell** ppDoorbell_p)
+{
+    return openDoorbell(pName_p, FALSE, ppDoorbell_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close a doorbell
+
+The function closes a doorbell. If the doorbell was created by this instance,
+the shared memory object is removed.
+
+\param[in]      pDoorbell_p         Pointer to the doorbell instance.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void doorbell_close(tDoorbell* pDoorbell_p)
+{
+    if (pDoorbell_p == NULL)
+        return;
+
+    munmap(pDoorbell_p->pShm, sizeof(tDoorbellShm));
+    close(pDoorbell_p->fd);
+
+    if (pDoorbell_p->fCreator)
+        shm_unlink(pDoorbell_p->aName);
+
+    OPLK_FREE(pDoorbell_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Ring a doorbell
+
+The function rings a doorbell. The waiting thread is only woken up by a system
+call if it is actually sleeping. If the doorbell was already rung, the call
+is coalesced with the pending ring.
+
+\param[in]      pDoorbell_p         Pointer to the doorbell instance.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void doorbell_ring(tDoorbell* pDoorbell_p)
+{
+    tDoorbellShm*   pShm = pDoorbell_p->pShm;
+    UINT32          oldState;
+
+    if ((__atomic_load_n(&pShm->state, __ATOMIC_RELAXED) & DOORBELL_STATE_RUNG) == 0)
+        __atomic_store_n(&pShm->ringTimestamp, getMonotonicTime(), __ATOMIC_RELAXED);
+
+    // The sequentially consistent RMW orders the data published by the caller
+    // against the state exchange of the waiting thread.
+    oldState = __atomic_fetch_or(&pShm->state, DOORBELL_STATE_RUNG, __ATOMIC_SEQ_CST);
+    if ((oldState & DOORBELL_STATE_WAITING) != 0)
+        syscall(SYS_futex, &pShm->state, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a doorbell
+
+The function waits until the doorbell is rung or the timeout elapses. If the
+doorbell was already rung, the function returns immediately without a system
+call. The function consumes the pending ring, therefore the caller has to
+process all pending work before it waits again.
+
+\param[in]      pDoorbell_p         Pointer to the doorbell instance.
+\param[in]      timeoutMs_p         Timeout in milliseconds.
+\param[out]     pLatency_p          Pointer to store the time between the ring
+                                    and the wakeup in nanoseconds. May be NULL.
+
+\return The function returns TRUE if the doorbell was rung, otherwise FALSE.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+BOOL doorbell_wait(tDoorbell* pDoorbell_p, UINT32 timeoutMs_p, UINT32* pLatency_p)
+{
+    tDoorbellShm*   pShm = pDoorbell_p->pShm;
+    UINT32          state;
+    UINT64          latency;
+    struct timespec timeout;
+
+    state = __atomic_exchange_n(&pShm->state, 0, __ATOMIC_SEQ_CST);
+    if ((state & DOORBELL_STATE_RUNG) == 0)
+    {
+        state = 0;
+        // If the exchange fails, the doorbell was rung in the meantime
+        if (__atomic_compare_exchange_n(&pShm->state, &state, DOORBELL_STATE_WAITING, FALSE,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+        {
+            timeout.tv_sec = timeoutMs_p / 1000;
+            timeout.tv_nsec = (timeoutMs_p % 1000) * 1000000;
+            syscall(SYS_futex, &pShm->state, FUTEX_WAIT, DOORBELL_STATE_WAITING, &timeout, NULL, 0);
+        }
+
+        state = __atomic_exchange_n(&pShm->state, 0, __ATOMIC_SEQ_CST);
+        if ((state & DOORBELL_STATE_RUNG) == 0)
+            return FALSE;
+    }
+
+    if (pLatency_p != NULL)
+    {
+        latency = getMonotonicTime() - __atomic_load_n(&pShm->ringTimestamp, __ATOMIC_RELAXED);
+        *pLatency_p = (latency > 0xFFFFFFFFULL) ? 0xFFFFFFFF : (UINT32)latency;
+    }
+
+    return TRUE;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open or create a doorbell
+
+The function maps the shared memory of a doorbell into the address space of
+the calling process.
+
+\param[in]      pName_p             Name of the doorbell.
+\param[in]      fCreate_p           Determines if the doorbell shall be created
+                                    (TRUE) or if an existing doorbell shall be
+                                    opened (FALSE).
+\param[out]     ppDoorbell_p        Pointer to store the doorbell instance.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError openDoorbell(const char* pName_p, BOOL fCreate_p, tDoorbell** ppDoorbell_p)
+{
+    tDoorbell*  pDoorbell;
+    int         flags = O_RDWR;
+
+    if ((pName_p == NULL) || (ppDoorbell_p == NULL) ||
+        (strlen(pName_p) >= DOORBELL_NAME_SIZE))
+        return kErrorInvalidInstanceParam;
+
+    pDoorbell = (tDoorbell*)OPLK_MALLOC(sizeof(tDoorbell));
+    if (pDoorbell == NULL)
+        return kErrorNoResource;
+
+    OPLK_MEMSET(pDoorbell, 0, sizeof(tDoorbell));
+    strncpy(pDoorbell->aName, pName_p, DOORBELL_NAME_SIZE - 1);
+    pDoorbell->fCreator = fCreate_p;
+
+    if (fCreate_p)
+    {
+        shm_unlink(pName_p);
+        flags |= O_CREAT;
+    }
+
+    if ((pDoorbell->fd = shm_open(pName_p, flags, 0)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() shm_open %s failed!\n", __func__, pName_p);
+        goto Exit;
+    }
+
+    if (fCreate_p && (ftruncate(pDoorbell->fd, sizeof(tDoorbellShm)) == -1))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() ftruncate failed!\n", __func__);
+        goto ExitClose;
+    }
+
+    pDoorbell->pShm = (tDoorbellShm*)mmap(NULL, sizeof(tDoorbellShm), PROT_READ | PROT_WRITE,
+                                          MAP_SHARED, pDoorbell->fd, 0);
+    if (pDoorbell->pShm == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap failed! (%s)\n", __func__, strerror(errno));
+        goto ExitClose;
+    }
+
+    *ppDoorbell_p = pDoorbell;
+    return kErrorOk;
+
+ExitClose:
+    close(pDoorbell->fd);
+    if (fCreate_p)
+        shm_unlink(pName_p);
+
+Exit:
+    OPLK_FREE(pDoorbell);
+    return kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+The function returns the current time of the monotonic clock.
+
+\return The function returns the time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTime(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+/// \}
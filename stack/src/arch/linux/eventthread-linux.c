@@ -0,0 +1,480 @@
+/**
+********************************************************************************
+\file   linux/eventthread-linux.c
+
+\brief  Event thread implementation for Linux userspace
+
+This file contains the event threads of the kernel and the user event CAL
+modules on Linux userspace. Each event thread waits on its doorbell and
+processes all pending events of its queues up to a configurable batch size on
+every wakeup. The doorbells are shared by both CAL modules, therefore they are
+reference counted if both layers are located in the same process.
+
+\ingroup module_target
+*******************************************************************************/
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/eventthread.h>
+#include <common/doorbell.h>
+#include <common/target.h>
+
+#include <pthread.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EVENT_THREAD_TIMEOUT            50          // Wait timeout of the event threads [ms]
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Event thread parameters
+
+The structure contains the constant parameters of an event thread.
+*/
+typedef struct
+{
+    const char*             pDoorbellName;          ///< Name of the doorbell the thread waits on
+    const char*             pThreadName;            ///< Name of the thread
+    int                     priority;               ///< Scheduling priority of the thread
+} tEventThreadParam;
+
+/**
+\brief  Event thread instance
+
+The structure contains the data of an event thread.
+*/
+typedef struct
+{
+    pthread_t               threadId;               ///< ID of the thread
+    BOOL                    fRunning;               ///< The thread was started
+    BOOL                    fStopThread;            ///< Stop request, cleared by the thread on exit
+    tDoorbell*              pDoorbell;              ///< Doorbell of the thread
+    tEventThreadProcessCb   pfnProcessCb;           ///< Queue process function
+    tEventQueue             highPrioQueue;          ///< Queue which is processed first
+    tEventQueue             lowPrioQueue;           ///< Queue which is processed if the first one is empty
+    tEventCalStatistics     statistics;             ///< Statistics of the thread
+    UINT32                  rateStartTick;          ///< Start of the current events per second interval [ms]
+    UINT32                  rateEventCount;         ///< Events processed in the current interval
+} tEventThreadInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const tEventThreadParam  aThreadParam_l[kEventThreadCount] =
+{
+    {"/shmDoorbellKernelEvent", "oplk-eventk", 55},     // kEventThreadKernel
+    {"/shmDoorbellUserEvent",   "oplk-eventu", 45},     // kEventThreadUser
+};
+
+static tEventThreadInstance     aInstance_l[kEventThreadCount];
+static UINT                     refCount_l = 0;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void* eventThread(void* arg);
+static UINT  processEvents(tEventThreadInstance* pInstance_p);
+static void  updateStatistics(tEventThreadInstance* pInstance_p,
+                              BOOL fWakeup_p,
+                              UINT32 latency_p,
+                              UINT eventCount_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the event thread library
+
+The function creates or opens the doorbells of the event threads. If the
+library is already initialized in this process, only the reference count is
+incremented.
+
+\param[in]      fCreate_p           Determines if the doorbells shall be created
+                                    (TRUE) or if existing doorbells shall be
+                                    opened (FALSE).
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError eventthread_init(BOOL fCreate_p)
+{
+    tOplkError  ret = kErrorOk;
+    UINT        i;
+
+    if (refCount_l++ > 0)
+        return kErrorOk;
+
+    OPLK_MEMSET(aInstance_l, 0, sizeof(aInstance_l));
+
+    for (i = 0; i < kEventThreadCount; i++)
+    {
+        if (fCreate_p)
+            ret = doorbell_create(aThreadParam_l[i].pDoorbellName, &aInstance_l[i].pDoorbell);
+        else
+            ret = doorbell_open(aThreadParam_l[i].pDoorbellName, &aInstance_l[i].pDoorbell);
+
+        if (ret != kErrorOk)
+        {
+            eventthread_exit();
+            break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up the event thread library
+
+The function closes the doorbells of the event threads if the last user of the
+library exits. The event threads must be stopped before.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void eventthread_exit(void)
+{
+    UINT    i;
+
+    if ((refCount_l == 0) || (--refCount_l > 0))
+        return;
+
+    for (i = 0; i < kEventThreadCount; i++)
+    {
+        doorbell_close(aInstance_l[i].pDoorbell);
+        aInstance_l[i].pDoorbell = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start an event thread
+
+The function starts an event thread. On every wakeup, the thread processes the
+pending events of the high priority queue first. The low priority queue is only
+processed if the high priority queue is empty.
+
+\param[in]      thread_p            Event thread to be started.
+\param[in]      pfnProcessCb_p      Function which processes the events of a queue.
+\param[in]      highPrioQueue_p     Queue with the higher priority.
+\param[in]      lowPrioQueue_p      Queue with the lower priority.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError eventthread_start(tEventThread thread_p,
+                             tEventThreadProcessCb pfnProcessCb_p,
+                             tEventQueue highPrioQueue_p,
+                             tEventQueue lowPrioQueue_p)
+{
+    tEventThreadInstance*   pInstance;
+    struct sched_param      schedParam;
+
+    if ((thread_p >= kEventThreadCount) || (pfnProcessCb_p == NULL))
+        return kErrorInvalidInstanceParam;
+
+    pInstance = &aInstance_l[thread_p];
+    if ((pInstance->pDoorbell == NULL) || pInstance->fRunning)
+        return kErrorInvalidOperation;
+
+    OPLK_MEMSET(&pInstance->statistics, 0, sizeof(tEventCalStatistics));
+    pInstance->rateStartTick = target_getTickCount();
+    pInstance->rateEventCount = 0;
+    pInstance->pfnProcessCb = pfnProcessCb_p;
+    pInstance->highPrioQueue = highPrioQueue_p;
+    pInstance->lowPrioQueue = lowPrioQueue_p;
+    pInstance->fStopThread = FALSE;
+
+    if (pthread_create(&pInstance->threadId, NULL, eventThread, (void*)pInstance) != 0)
+        return kErrorNoResource;
+
+    pInstance->fRunning = TRUE;
+
+    schedParam.sched_priority = aThreadParam_l[thread_p].priority;
+    if (pthread_setschedparam(pInstance->threadId, SCHED_FIFO, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
+                              __func__,
+                              schedParam.sched_priority);
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(pInstance->threadId, aThreadParam_l[thread_p].pThreadName);
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop an event thread
+
+The function requests an event thread to stop and waits until it has exited.
+
+\param[in]      thread_p            Event thread to be stopped.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void eventthread_stop(tEventThread thread_p)
+{
+    tEventThreadInstance*   pInstance;
+    UINT                    i = 0;
+
+    if (thread_p >= kEventThreadCount)
+        return;
+
+    pInstance = &aInstance_l[thread_p];
+    if (!pInstance->fRunning)
+        return;
+
+    pInstance->fStopThread = TRUE;
+    doorbell_ring(pInstance->pDoorbell);
+    while (pInstance->fStopThread)
+    {
+        target_msleep(10);
+        if (i++ > 100)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): Event thread is not terminating, continue shutdown...!\n",
+                                  __func__);
+            break;
+        }
+    }
+
+    pInstance->fRunning = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get statistics of an event thread
+
+The function returns the wakeup and throughput statistics of an event thread.
+
+\param[in]      thread_p            Event thread.
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void eventthread_getStatistics(tEventThread thread_p, tEventCalStatistics* pStatistics_p)
+{
+    if ((thread_p < kEventThreadCount) && (pStatistics_p != NULL))
+    {
+        OPLK_MEMCPY(pStatistics_p,
+                    &aInstance_l[thread_p].statistics,
+                    sizeof(tEventCalStatistics));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal a kernel event
+
+This function signals that a kernel event was posted. It will be registered in
+the circular buffer library as signal callback function.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void eventthread_signalKernelEvent(void)
+{
+    doorbell_ring(aInstance_l[kEventThreadKernel].pDoorbell);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal a user event
+
+This function signals that a user event was posted. It will be registered in
+the circular buffer library as signal callback function.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void eventthread_signalUserEvent(void)
+{
+    doorbell_ring(aInstance_l[kEventThreadUser].pDoorbell);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Event handler thread function
+
+This function contains the main function for the event handler threads.
+
+\param[in,out]  arg                 Thread parameter. Used to access the thread instance.
+
+\return The function returns the thread exit code.
+*/
+//------------------------------------------------------------------------------
+static void* eventThread(void* arg)
+{
+    tEventThreadInstance*   pInstance = (tEventThreadInstance*)arg;
+    UINT                    eventCount = 0;
+    UINT32                  latency = 0;
+    BOOL                    fWakeup;
+
+    while (!pInstance->fStopThread)
+    {
+        // If the last batch was limited, further events are pending
+        if (eventCount < CONFIG_EVENT_BATCH_SIZE)
+            fWakeup = doorbell_wait(pInstance->pDoorbell, EVENT_THREAD_TIMEOUT, &latency);
+        else
+            fWakeup = FALSE;
+
+        eventCount = processEvents(pInstance);
+        updateStatistics(pInstance, fWakeup, latency, eventCount);
+    }
+
+    pInstance->fStopThread = FALSE;
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process pending events
+
+This function processes the pending events of the queues of an event thread.
+The events of the high priority queue are handled first. At most
+\ref CONFIG_EVENT_BATCH_SIZE events are processed to keep the thread responsive
+for the stop request. The events are read in batches and the high priority
+queue is checked again after each batch.
+
+\param[in]      pInstance_p         Pointer to the thread instance.
+
+\return The function returns the number of processed events.
+*/
+//------------------------------------------------------------------------------
+static UINT processEvents(tEventThreadInstance* pInstance_p)
+{
+    UINT    eventCount = 0;
+    UINT    batchCount;
+
+    while (eventCount < CONFIG_EVENT_BATCH_SIZE)
+    {
+        pInstance_p->pfnProcessCb(pInstance_p->highPrioQueue,
+                                  CONFIG_EVENT_BATCH_SIZE - eventCount,
+                                  &batchCount);
+        if (batchCount == 0)
+        {
+            pInstance_p->pfnProcessCb(pInstance_p->lowPrioQueue,
+                                      CONFIG_EVENT_BATCH_SIZE - eventCount,
+                                      &batchCount);
+        }
+
+        if (batchCount == 0)
+            break;
+
+        eventCount += batchCount;
+    }
+
+    return eventCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update statistics of an event thread
+
+\param[in,out]  pInstance_p         Pointer to the thread instance.
+\param[in]      fWakeup_p           TRUE if the thread was woken up by its doorbell.
+\param[in]      latency_p           Wakeup latency in nanoseconds.
+\param[in]      eventCount_p        Number of events processed in the batch.
+*/
+//------------------------------------------------------------------------------
+static void updateStatistics(tEventThreadInstance* pInstance_p,
+                             BOOL fWakeup_p,
+                             UINT32 latency_p,
+                             UINT eventCount_p)
+{
+    tEventCalStatistics*    pStatistics = &pInstance_p->statistics;
+    UINT32                  elapsed;
+
+    if (fWakeup_p)
+    {
+        pStatistics->wakeupCount++;
+        pStatistics->lastWakeupLatency = latency_p;
+        if (latency_p > pStatistics->maxWakeupLatency)
+            pStatistics->maxWakeupLatency = latency_p;
+    }
+
+    pStatistics->eventCount += eventCount_p;
+    if (eventCount_p > pStatistics->maxBatchSize)
+        pStatistics->maxBatchSize = eventCount_p;
+
+    pInstance_p->rateEventCount += eventCount_p;
+    elapsed = target_getTickCount() - pInstance_p->rateStartTick;
+    if (elapsed >= 1000)
+    {
+        pStatistics->eventsPerSecond = (UINT32)(((UINT64)pInstance_p->rateEventCount * 1000) / elapsed);
+        pInstance_p->rateEventCount = 0;
+        pInstance_p->rateStartTick += elapsed;
+    }
+}
+
+/// \}
@@ -61,6 +61,12 @@ calling circbuf_connect(). The same applies for deinitialization.
 After all connected instances are disconnected by calling circbuf_disconnect(),
 the main instance can clean up and free the buffer by calling circbuf_free().
 
+On platforms supporting it (CIRCBUF_LOCKFREE_SUPPORT), buffers selected by
+CONFIG_CIRCBUF_LOCKFREE_QUEUES are operated lock-free for the consumer. The
+producer and the consumer own a separate index, so the consumer never has to
+take the lock. The producers are still serialized by the lock unless the buffer
+is also selected by CONFIG_CIRCBUF_SINGLE_PRODUCER_QUEUES.
+
 *******************************************************************************/
 
 //------------------------------------------------------------------------------
@@ -92,10 +98,32 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define CIRCBUF_ALIGN_BLOCK(size_p)             (((size_p) + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1))
+#define CIRCBUF_ALIGN_BATCH(size_p)             (((size_p) + (CIRCBUF_BATCH_ALIGNMENT - 1)) & ~(CIRCBUF_BATCH_ALIGNMENT - 1))
+
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+#define CIRCBUF_LOAD_ACQUIRE(pVar_p)            __atomic_load_n(pVar_p, __ATOMIC_ACQUIRE)
+#define CIRCBUF_STORE_RELEASE(pVar_p, val_p)    __atomic_store_n(pVar_p, val_p, __ATOMIC_RELEASE)
+#endif
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+/**
+\brief Circular buffer data block
+
+The struct describes one data block written by the lock-free producer. The
+data block is composed of up to two source data segments.
+*/
+typedef struct
+{
+    const void*         pData;              ///< Pointer to the first data segment
+    size_t              size;               ///< Size of the first data segment
+    const void*         pData2;             ///< Pointer to the second data segment (NULL if unused)
+    size_t              size2;              ///< Size of the second data segment
+} tCircBufDataBlock;
+#endif
 
 //------------------------------------------------------------------------------
 // local vars
@@ -104,6 +132,22 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+static tCircBufError writeDataLockFree(tCircBufInstance* pInstance_p,
+                                       const tCircBufDataBlock* pBlock_p,
+                                       size_t fullBlockSize_p);
+static tCircBufError readDataLockFree(tCircBufInstance* pInstance_p, void* pData_p,
+                                      size_t size_p, size_t* pDataBlockSize_p);
+static tCircBufError readBatchLockFree(tCircBufInstance* pInstance_p, void* pData_p, size_t size_p,
+                                       size_t* paBlockSize_p, UINT maxBlockCount_p,
+                                       UINT* pBlockCount_p);
+static void          writeBlock(tCircBufInstance* pInstance_p, UINT32 offset_p,
+                                const tCircBufDataBlock* pBlock_p);
+static UINT32        copyToBuffer(tCircBufInstance* pInstance_p, UINT32 offset_p,
+                                  const void* pData_p, size_t size_p);
+#endif
+static UINT32        copyFromBuffer(const tCircBufInstance* pInstance_p, UINT32 offset_p,
+                                    void* pData_p, size_t size_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -158,6 +202,14 @@ tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInst
     pInstance->pCircBufHeader->dataCount = 0;
 #ifdef DEBUG_CIRCBUF_SIZE_CHECK
     pInstance->pCircBufHeader->maxSize = 0;
+#endif
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    pInstance->pCircBufHeader->producer.position = 0;
+    pInstance->pCircBufHeader->producer.count = 0;
+    pInstance->pCircBufHeader->consumer.position = 0;
+    pInstance->pCircBufHeader->consumer.count = 0;
+    pInstance->pCircBufHeader->fLockFree = ((CONFIG_CIRCBUF_LOCKFREE_QUEUES & (1UL << id_p)) != 0);
+    pInstance->pCircBufHeader->fSingleProducer = ((CONFIG_CIRCBUF_SINGLE_PRODUCER_QUEUES & (1UL << id_p)) != 0);
 #endif
     pInstance->pfnSigCb = NULL;
 
@@ -281,6 +333,12 @@ void circbuf_reset(tCircBufInstance* pInstance_p)
     pHeader->writeOffset = 0;
     pHeader->freeSize = pHeader->bufferSize;
     pHeader->dataCount = 0;
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    pHeader->producer.position = 0;
+    pHeader->producer.count = 0;
+    pHeader->consumer.position = 0;
+    pHeader->consumer.count = 0;
+#endif
 
     OPLK_DCACHE_FLUSH(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
     circbuf_unlock(pInstance_p);
@@ -320,6 +378,15 @@ tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p,
     blockSize     = (size_p + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
     fullBlockSize = blockSize + sizeof(UINT32);
 
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    if (pInstance_p->pCircBufHeader->fLockFree)
+    {
+        tCircBufDataBlock   block = {pData_p, size_p, NULL, 0};
+
+        return writeDataLockFree(pInstance_p, &block, fullBlockSize);
+    }
+#endif
+
     circbuf_lock(pInstance_p);
 
     pHeader = pInstance_p->pCircBufHeader;
@@ -420,6 +487,15 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p,
     blockSize = (size_p + size2_p + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
     fullBlockSize = blockSize + sizeof(UINT32);
 
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    if (pHeader->fLockFree)
+    {
+        tCircBufDataBlock   block = {pData_p, size_p, pData2_p, size2_p};
+
+        return writeDataLockFree(pInstance_p, &block, fullBlockSize);
+    }
+#endif
+
     //TRACE("%s() size:%d wroff:%d\n", __func__, pHeader->bufferSize, pHeader->writeOffset);
     //TRACE("%s() ptr1:%p size1:%d ptr2:%p size2:%d\n", __func__, pData_p, size_p, pData2_p, size2_p);
     circbuf_lock(pInstance_p);
@@ -527,6 +603,11 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     if ((pData_p == NULL) || (size_p == 0))
         return kCircBufOk;
 
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    if (pInstance_p->pCircBufHeader->fLockFree)
+        return readDataLockFree(pInstance_p, pData_p, size_p, pDataBlockSize_p);
+#endif
+
     pHeader = pInstance_p->pCircBufHeader;
     pCircBuf = pInstance_p->pCircBuf;
 
@@ -586,6 +667,102 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     return kCircBufOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read a batch of data blocks from a circular buffer
+
+The function reads as many data blocks from a circular buffer as fit into the
+destination buffer, but at most maxBlockCount_p blocks. The blocks are stored
+consecutively in the destination buffer, each starting at an offset aligned to
+\ref CIRCBUF_BATCH_ALIGNMENT. The buffer header is updated only once for the
+whole batch.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[out]     pData_p             Pointer to store the read data blocks.
+\param[in]      size_p              The size of the destination buffer.
+\param[out]     paBlockSize_p       Pointer to an array of maxBlockCount_p entries
+                                    to store the size of each read data block.
+\param[in]      maxBlockCount_p     Maximum number of data blocks to read.
+\param[out]     pBlockCount_p       Pointer to store the number of read data blocks.
+
+\return The function returns a tCircBufError error code.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufError circbuf_readBatch(tCircBufInstance* pInstance_p, void* pData_p, size_t size_p,
+                                size_t* paBlockSize_p, UINT maxBlockCount_p, UINT* pBlockCount_p)
+{
+    tCircBufHeader*     pHeader;
+    BYTE*               pCircBuf;
+    UINT32              offset;
+    UINT32              dataSize;
+    UINT32              fullBlockSize;
+    size_t              destOffset = 0;
+    UINT                blockCount = 0;
+
+    // Check parameter validity
+    ASSERT(pInstance_p != NULL);
+    ASSERT(paBlockSize_p != NULL);
+    ASSERT(pBlockCount_p != NULL);
+
+    *pBlockCount_p = 0;
+    if ((pData_p == NULL) || (size_p == 0) || (maxBlockCount_p == 0))
+        return kCircBufOk;
+
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    if (pInstance_p->pCircBufHeader->fLockFree)
+        return readBatchLockFree(pInstance_p, pData_p, size_p, paBlockSize_p, maxBlockCount_p, pBlockCount_p);
+#endif
+
+    pHeader = pInstance_p->pCircBufHeader;
+    pCircBuf = pInstance_p->pCircBuf;
+
+    circbuf_lock(pInstance_p);
+
+    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+    if (pHeader->freeSize == pHeader->bufferSize)
+    {
+        circbuf_unlock(pInstance_p);
+        return kCircBufNoReadableData;
+    }
+
+    while ((blockCount < maxBlockCount_p) && (pHeader->freeSize != pHeader->bufferSize))
+    {
+        offset = pHeader->readOffset;
+        OPLK_DCACHE_INVALIDATE((pCircBuf + offset), sizeof(UINT32));
+        dataSize = *(const UINT32*)(pCircBuf + offset);
+        if ((destOffset + dataSize) > size_p)
+            break;
+
+        // The block size is aligned, so the size field is never split
+        offset += sizeof(UINT32);
+        copyFromBuffer(pInstance_p, offset, (UINT8*)pData_p + destOffset, dataSize);
+
+        fullBlockSize = CIRCBUF_ALIGN_BLOCK(dataSize) + sizeof(UINT32);
+        offset = pHeader->readOffset + fullBlockSize;
+        if (offset >= pHeader->bufferSize)
+            offset -= pHeader->bufferSize;
+
+        pHeader->readOffset = offset;
+        pHeader->freeSize += fullBlockSize;
+        pHeader->dataCount--;
+
+        paBlockSize_p[blockCount++] = dataSize;
+        destOffset += CIRCBUF_ALIGN_BATCH(dataSize);
+    }
+
+    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+    circbuf_unlock(pInstance_p);
+
+    if (blockCount == 0)
+        return kCircBufReadsizeTooSmall;
+
+    *pBlockCount_p = blockCount;
+    return kCircBufOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get the available data count
@@ -607,6 +784,15 @@ UINT32 circbuf_getDataCount(const tCircBufInstance* pInstance_p)
     ASSERT(pInstance_p != NULL);
 
     pHeader = pInstance_p->pCircBufHeader;
+
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+    if (pHeader->fLockFree)
+    {
+        return CIRCBUF_LOAD_ACQUIRE(&pHeader->producer.count) -
+               CIRCBUF_LOAD_ACQUIRE(&pHeader->consumer.count);
+    }
+#endif
+
     OPLK_DCACHE_INVALIDATE(&pHeader->dataCount, sizeof(UINT32));
 
     return pHeader->dataCount;
@@ -664,4 +850,290 @@ tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pf
 /// \name Private Functions
 /// \{
 
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to a lock-free circular buffer
+
+The function writes a data block to a lock-free circular buffer. Only the
+producer index is modified. The block is published to the consumer by a
+release store of the producer position after the data has been written.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      pBlock_p            Pointer to the data block to be written.
+\param[in]      fullBlockSize_p     Buffer space needed by the data block.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError writeDataLockFree(tCircBufInstance* pInstance_p,
+                                       const tCircBufDataBlock* pBlock_p,
+                                       size_t fullBlockSize_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+    UINT32              writePos;
+    UINT32              readPos;
+    UINT32              usedSize;
+    UINT32              offset;
+    BOOL                fLock = !pHeader->fSingleProducer;
+
+    if (fLock)
+        circbuf_lock(pInstance_p);
+
+    writePos = pHeader->producer.position;
+    readPos = CIRCBUF_LOAD_ACQUIRE(&pHeader->consumer.position);
+
+    if (writePos >= readPos)
+        usedSize = writePos - readPos;
+    else
+        usedSize = writePos + (2 * pHeader->bufferSize) - readPos;
+
+    if (fullBlockSize_p > (pHeader->bufferSize - usedSize))
+    {
+        if (fLock)
+            circbuf_unlock(pInstance_p);
+        return kCircBufBufferFull;
+    }
+
+    offset = (writePos < pHeader->bufferSize) ? writePos : (writePos - pHeader->bufferSize);
+    writeBlock(pInstance_p, offset, pBlock_p);
+
+    writePos += (UINT32)fullBlockSize_p;
+    if (writePos >= (2 * pHeader->bufferSize))
+        writePos -= (2 * pHeader->bufferSize);
+
+    pHeader->producer.count++;
+    CIRCBUF_STORE_RELEASE(&pHeader->producer.position, writePos);
+
+#ifdef DEBUG_CIRCBUF_SIZE_CHECK
+    if ((usedSize + fullBlockSize_p) > pHeader->maxSize)
+        pHeader->maxSize = usedSize + fullBlockSize_p;
+#endif
+
+    if (fLock)
+        circbuf_unlock(pInstance_p);
+
+    if (pInstance_p->pfnSigCb != NULL)
+    {
+        pInstance_p->pfnSigCb();
+    }
+
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read data from a lock-free circular buffer
+
+The function reads a data block from a lock-free circular buffer. Only the
+consumer index is modified. The space of the block is released to the producer
+by a release store of the consumer position after the data has been read.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[out]     pData_p             Pointer to store the read data.
+\param[in]      size_p              The size of the destination buffer to store the data.
+\param[out]     pDataBlockSize_p    Pointer to store the size of the read data.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError readDataLockFree(tCircBufInstance* pInstance_p, void* pData_p,
+                                      size_t size_p, size_t* pDataBlockSize_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+    size_t              blockSize;
+    UINT32              readPos;
+    UINT32              offset;
+    UINT32              dataSize;
+
+    readPos = pHeader->consumer.position;
+    if (readPos == CIRCBUF_LOAD_ACQUIRE(&pHeader->producer.position))
+        return kCircBufNoReadableData;
+
+    offset = (readPos < pHeader->bufferSize) ? readPos : (readPos - pHeader->bufferSize);
+
+    dataSize = *(const UINT32*)(pInstance_p->pCircBuf + offset);
+    if (dataSize > size_p)
+        return kCircBufReadsizeTooSmall;
+
+    offset += sizeof(UINT32);
+    if (offset == pHeader->bufferSize)
+        offset = 0;
+    copyFromBuffer(pInstance_p, offset, pData_p, dataSize);
+
+    blockSize = (dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
+    readPos += (UINT32)(blockSize + sizeof(UINT32));
+    if (readPos >= (2 * pHeader->bufferSize))
+        readPos -= (2 * pHeader->bufferSize);
+
+    pHeader->consumer.count++;
+    CIRCBUF_STORE_RELEASE(&pHeader->consumer.position, readPos);
+
+    *pDataBlockSize_p = dataSize;
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a batch of data blocks from a lock-free circular buffer
+
+The function reads several data blocks from a lock-free circular buffer. Only
+the consumer index is modified. The space of all read blocks is released to the
+producer by a single release store of the consumer position.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[out]     pData_p             Pointer to store the read data blocks.
+\param[in]      size_p              The size of the destination buffer.
+\param[out]     paBlockSize_p       Pointer to store the size of each read data block.
+\param[in]      maxBlockCount_p     Maximum number of data blocks to read.
+\param[out]     pBlockCount_p       Pointer to store the number of read data blocks.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError readBatchLockFree(tCircBufInstance* pInstance_p, void* pData_p, size_t size_p,
+                                       size_t* paBlockSize_p, UINT maxBlockCount_p,
+                                       UINT* pBlockCount_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+    UINT32              readPos;
+    UINT32              writePos;
+    UINT32              offset;
+    UINT32              dataSize;
+    size_t              destOffset = 0;
+    UINT                blockCount = 0;
+
+    readPos = pHeader->consumer.position;
+    writePos = CIRCBUF_LOAD_ACQUIRE(&pHeader->producer.position);
+    if (readPos == writePos)
+        return kCircBufNoReadableData;
+
+    while ((blockCount < maxBlockCount_p) && (readPos != writePos))
+    {
+        offset = (readPos < pHeader->bufferSize) ? readPos : (readPos - pHeader->bufferSize);
+
+        dataSize = *(const UINT32*)(pInstance_p->pCircBuf + offset);
+        if ((destOffset + dataSize) > size_p)
+            break;
+
+        copyFromBuffer(pInstance_p, offset + sizeof(UINT32), (UINT8*)pData_p + destOffset, dataSize);
+
+        readPos += CIRCBUF_ALIGN_BLOCK(dataSize) + sizeof(UINT32);
+        if (readPos >= (2 * pHeader->bufferSize))
+            readPos -= (2 * pHeader->bufferSize);
+
+        paBlockSize_p[blockCount++] = dataSize;
+        destOffset += CIRCBUF_ALIGN_BATCH(dataSize);
+    }
+
+    if (blockCount == 0)
+        return kCircBufReadsizeTooSmall;
+
+    pHeader->consumer.count += blockCount;
+    CIRCBUF_STORE_RELEASE(&pHeader->consumer.position, readPos);
+
+    *pBlockCount_p = blockCount;
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write a data block into circular buffer
+
+The function writes a data block including its size field into the circular
+buffer. The caller must ensure that enough space is available.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      offset_p            Offset in the circular buffer to write the block to.
+\param[in]      pBlock_p            Pointer to the data block to be written.
+*/
+//------------------------------------------------------------------------------
+static void writeBlock(tCircBufInstance* pInstance_p, UINT32 offset_p,
+                       const tCircBufDataBlock* pBlock_p)
+{
+    UINT32  dataSize;
+    UINT32  offset;
+
+    dataSize = (UINT32)(pBlock_p->size + pBlock_p->size2);
+
+    // The block size is aligned, so the size field is never split
+    offset = copyToBuffer(pInstance_p, offset_p, &dataSize, sizeof(UINT32));
+    offset = copyToBuffer(pInstance_p, offset, pBlock_p->pData, pBlock_p->size);
+    if (pBlock_p->pData2 != NULL)
+        copyToBuffer(pInstance_p, offset, pBlock_p->pData2, pBlock_p->size2);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy data into circular buffer
+
+The function copies data into the circular buffer starting at the given offset
+and wraps around at the end of the buffer.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      offset_p            Offset in the circular buffer to copy to.
+\param[in]      pData_p             Pointer to the data to be copied.
+\param[in]      size_p              The size of the data to be copied.
+
+\return The function returns the offset following the copied data.
+*/
+//------------------------------------------------------------------------------
+static UINT32 copyToBuffer(tCircBufInstance* pInstance_p, UINT32 offset_p,
+                           const void* pData_p, size_t size_p)
+{
+    UINT32  bufferSize = pInstance_p->pCircBufHeader->bufferSize;
+    size_t  chunkSize;
+
+    chunkSize = bufferSize - offset_p;
+    if (size_p < chunkSize)
+    {
+        OPLK_MEMCPY(pInstance_p->pCircBuf + offset_p, pData_p, size_p);
+        OPLK_DCACHE_FLUSH(pInstance_p->pCircBuf + offset_p, size_p);
+        return offset_p + (UINT32)size_p;
+    }
+
+    OPLK_MEMCPY(pInstance_p->pCircBuf + offset_p, pData_p, chunkSize);
+    OPLK_DCACHE_FLUSH(pInstance_p->pCircBuf + offset_p, chunkSize);
+    OPLK_MEMCPY(pInstance_p->pCircBuf, (const UINT8*)pData_p + chunkSize, size_p - chunkSize);
+    OPLK_DCACHE_FLUSH(pInstance_p->pCircBuf, size_p - chunkSize);
+    return (UINT32)(size_p - chunkSize);
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy data from circular buffer
+
+The function copies data from the circular buffer starting at the given offset
+and wraps around at the end of the buffer.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      offset_p            Offset in the circular buffer to copy from.
+\param[out]     pData_p             Pointer to store the copied data.
+\param[in]      size_p              The size of the data to be copied.
+
+\return The function returns the offset following the copied data.
+*/
+//------------------------------------------------------------------------------
+static UINT32 copyFromBuffer(const tCircBufInstance* pInstance_p, UINT32 offset_p,
+                             void* pData_p, size_t size_p)
+{
+    UINT32  bufferSize = pInstance_p->pCircBufHeader->bufferSize;
+    size_t  chunkSize;
+
+    chunkSize = bufferSize - offset_p;
+    if (size_p < chunkSize)
+    {
+        OPLK_DCACHE_INVALIDATE(pInstance_p->pCircBuf + offset_p, size_p);
+        OPLK_MEMCPY(pData_p, pInstance_p->pCircBuf + offset_p, size_p);
+        return offset_p + (UINT32)size_p;
+    }
+
+    OPLK_DCACHE_INVALIDATE(pInstance_p->pCircBuf + offset_p, chunkSize);
+    OPLK_MEMCPY(pData_p, pInstance_p->pCircBuf + offset_p, chunkSize);
+    OPLK_DCACHE_INVALIDATE(pInstance_p->pCircBuf, size_p - chunkSize);
+    OPLK_MEMCPY((UINT8*)pData_p + chunkSize, pInstance_p->pCircBuf, size_p - chunkSize);
+    return (UINT32)(size_p - chunkSize);
+}
+
 /// \}
@@ -42,6 +42,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <common/ctrlcal.h>
+#include <common/doorbell.h>
+#include <common/target.h>
 
 #include <unistd.h>
 #include <sys/mman.h>
@@ -57,6 +59,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #define CTRL_SHM_NAME       "/shmCtrlCal"
+#define CTRL_CMD_DOORBELL   "/shmCtrlCalCmd"
+#define CTRL_RET_DOORBELL   "/shmCtrlCalRet"
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -73,6 +77,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define CTRL_POLL_INTERVAL  1           // Polling interval if no doorbell is available [ms]
 
 //------------------------------------------------------------------------------
 // local types
@@ -85,10 +90,14 @@ static int          fd_l;
 static UINT8*       pCtrlMem_l;
 static int          size_l;
 static BOOL         fCreator_l;
+static tDoorbell*   pCmdDoorbell_l;         // Rung by the user stack if a command was written
+static tDoorbell*   pRetDoorbell_l;         // Rung by the kernel stack if a return value was written
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static void openDoorbells(void);
+static BOOL waitDoorbell(tDoorbell* pDoorbell_p, UINT32 timeoutMs_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -152,6 +161,8 @@ tOplkError ctrlcal_init(UINT size_p)
     }
     size_l = size_p;
 
+    openDoorbells();
+
     return kErrorOk;
 }
 
@@ -170,6 +181,11 @@ tOplkError ctrlcal_exit(void)
 {
     tOplkError  ret = kErrorOk;
 
+    doorbell_close(pCmdDoorbell_l);
+    doorbell_close(pRetDoorbell_l);
+    pCmdDoorbell_l = NULL;
+    pRetDoorbell_l = NULL;
+
     if (pCtrlMem_l != NULL)
     {
         munmap(pCtrlMem_l, size_l);
@@ -246,10 +262,143 @@ tOplkError ctrlcal_readData(void* pDest_p,
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief Signal a new command
+
+The function notifies the kernel stack that a new command was written to the
+control block.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+void ctrlcal_signalCommand(void)
+{
+    if (pCmdDoorbell_l != NULL)
+        doorbell_ring(pCmdDoorbell_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Wait for a new command
+
+The function waits until the user stack signals a new command or the timeout
+elapses. The caller has to read the control block to check if a command is
+available.
+
+\param[in]      timeoutMs_p         Timeout in milliseconds.
+
+\return The function returns TRUE if a command was signaled, otherwise FALSE.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlcal_waitCommand(UINT32 timeoutMs_p)
+{
+    return waitDoorbell(pCmdDoorbell_l, timeoutMs_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Signal a return value
+
+The function notifies the user stack that the return value of a command was
+written to the control block.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+void ctrlcal_signalReturn(void)
+{
+    if (pRetDoorbell_l != NULL)
+        doorbell_ring(pRetDoorbell_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Wait for a return value
+
+The function waits until the kernel stack signals a return value or the
+timeout elapses. The caller has to read the control block to check if the
+command was completed.
+
+\param[in]      timeoutMs_p         Timeout in milliseconds.
+
+\return The function returns TRUE if a return value was signaled, otherwise
+        FALSE.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlcal_waitReturn(UINT32 timeoutMs_p)
+{
+    return waitDoorbell(pRetDoorbell_l, timeoutMs_p);
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief Open the control doorbells
+
+The function opens the doorbells used to signal commands and return values.
+The creator of the control block creates the doorbells, the other side
+connects to them. If a doorbell can't be opened, the waiting side falls back
+to polling the control block.
+*/
+//------------------------------------------------------------------------------
+static void openDoorbells(void)
+{
+    tOplkError  ret;
+
+    if (fCreator_l)
+    {
+        ret = doorbell_create(CTRL_CMD_DOORBELL, &pCmdDoorbell_l);
+        if (ret == kErrorOk)
+            ret = doorbell_create(CTRL_RET_DOORBELL, &pRetDoorbell_l);
+    }
+    else
+    {
+        ret = doorbell_open(CTRL_CMD_DOORBELL, &pCmdDoorbell_l);
+        if (ret == kErrorOk)
+            ret = doorbell_open(CTRL_RET_DOORBELL, &pRetDoorbell_l);
+    }
+
+    if (ret != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() doorbells not available, polling control block!\n", __func__);
+        doorbell_close(pCmdDoorbell_l);
+        pCmdDoorbell_l = NULL;
+        pRetDoorbell_l = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Wait for a control doorbell
+
+The function waits for a doorbell. If no doorbell is available, it sleeps for
+the polling interval instead.
+
+\param[in]      pDoorbell_p         Pointer to the doorbell instance, may be NULL.
+\param[in]      timeoutMs_p         Timeout in milliseconds.
+
+\return The function returns TRUE if the doorbell was rung, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL waitDoorbell(tDoorbell* pDoorbell_p, UINT32 timeoutMs_p)
+{
+    if (pDoorbell_p == NULL)
+    {
+        target_msleep(min(timeoutMs_p, CTRL_POLL_INTERVAL));
+        return FALSE;
+    }
+
+    return doorbell_wait(pDoorbell_p, timeoutMs_p, NULL);
+}
+
 /// \}
@@ -0,0 +1,284 @@
+/**
+********************************************************************************
+\file   histogram.c
+
+\brief  Histogram module
+
+This file implements the histogram module. A histogram uses a fixed amount of
+memory and records a value in constant time. Therefore, it can be used to
+collect timing statistics in time critical code paths (e.g. timer callbacks).
+
+The value range is split into power of two ranges which are divided into
+\ref HISTOGRAM_SUB_BUCKET_COUNT linear sub-buckets. This limits the relative
+error of all values to 1/\ref HISTOGRAM_SUB_BUCKET_COUNT.
+
+\ingroup module_histogram
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <oplk/histogram.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define HISTOGRAM_PPM_MAX               1000000UL
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static UINT getBucketIndex(UINT32 value_p);
+static UINT getMsb(UINT32 value_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear histogram
+
+The function resets all counters of the given histogram.
+
+\param[out]     pHistogram_p        Pointer to the histogram to clear.
+
+\ingroup module_histogram
+*/
+//------------------------------------------------------------------------------
+void histogram_clear(tHistogram* pHistogram_p)
+{
+    OPLK_MEMSET(pHistogram_p, 0, sizeof(*pHistogram_p));
+    pHistogram_p->min = 0xFFFFFFFF;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record value in histogram
+
+The function records a value in the given histogram. The execution time does
+not depend on the value.
+
+\param[in,out]  pHistogram_p        Pointer to the histogram.
+\param[in]      value_p             Value to record.
+
+\ingroup module_histogram
+*/
+//------------------------------------------------------------------------------
+void histogram_record(tHistogram* pHistogram_p, UINT32 value_p)
+{
+    if (pHistogram_p->count == 0xFFFFFFFF)
+        return;
+
+    pHistogram_p->aBucket[getBucketIndex(value_p)]++;
+    pHistogram_p->count++;
+
+    if (pHistogram_p->min > value_p)
+        pHistogram_p->min = value_p;
+    if (pHistogram_p->max < value_p)
+        pHistogram_p->max = value_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get percentile of histogram
+
+The function returns the value below or equal to which the given fraction of
+all recorded values lie. The result is the upper bound of the bucket containing
+the percentile, limited to the recorded maximum.
+
+\param[in]      pHistogram_p        Pointer to the histogram.
+\param[in]      ppm_p               Percentile in parts per million
+                                    (e.g. 999000 for the 99.9th percentile).
+
+\return The function returns the value of the percentile or 0 if the histogram
+        is empty.
+
+\ingroup module_histogram
+*/
+//------------------------------------------------------------------------------
+UINT32 histogram_getPercentile(const tHistogram* pHistogram_p, UINT32 ppm_p)
+{
+    ULONGLONG   rank;
+    UINT32      sum = 0;
+    UINT32      value = pHistogram_p->max;
+    UINT        bucket;
+
+    if (pHistogram_p->count == 0)
+        return 0;
+
+    if (ppm_p > HISTOGRAM_PPM_MAX)
+        ppm_p = HISTOGRAM_PPM_MAX;
+
+    // The rank is scaled by HISTOGRAM_PPM_MAX instead of divided by it, so no
+    // 64 bit division is needed (not available in 32 bit Linux kernel modules).
+    rank = (ULONGLONG)pHistogram_p->count * ppm_p;
+
+    for (bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; bucket++)
+    {
+        sum += pHistogram_p->aBucket[bucket];
+        if ((sum != 0) && ((ULONGLONG)sum * HISTOGRAM_PPM_MAX >= rank))
+        {
+            if (bucket < (HISTOGRAM_BUCKET_COUNT - 1))
+                value = histogram_getBucketLowerBound(bucket + 1) - 1;
+            break;
+        }
+    }
+
+    return (value < pHistogram_p->max) ? value : pHistogram_p->max;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get lower bound of histogram bucket
+
+The function returns the smallest value which is counted in the given bucket.
+
+\param[in]      bucket_p            Index of the bucket.
+
+\return The function returns the lower bound of the bucket.
+
+\ingroup module_histogram
+*/
+//------------------------------------------------------------------------------
+UINT32 histogram_getBucketLowerBound(UINT bucket_p)
+{
+    UINT    range = bucket_p >> HISTOGRAM_SUB_BUCKET_BITS;
+    UINT32  subBucket = bucket_p & (HISTOGRAM_SUB_BUCKET_COUNT - 1);
+
+    if (range == 0)
+        return subBucket;
+
+    return (HISTOGRAM_SUB_BUCKET_COUNT + subBucket) << (range - 1);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get bucket index of value
+
+The function calculates the index of the bucket which counts the given value.
+
+\param[in]      value_p             Value to look up.
+
+\return The function returns the bucket index.
+*/
+//------------------------------------------------------------------------------
+static UINT getBucketIndex(UINT32 value_p)
+{
+    UINT    shift;
+
+    if (value_p < HISTOGRAM_SUB_BUCKET_COUNT)
+        return value_p;
+
+    shift = getMsb(value_p) - HISTOGRAM_SUB_BUCKET_BITS;
+
+    return ((shift + 1) << HISTOGRAM_SUB_BUCKET_BITS) +
+           ((value_p >> shift) - HISTOGRAM_SUB_BUCKET_COUNT);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get most significant bit
+
+The function determines the position of the most significant bit set in the
+given value. It uses a fixed number of steps to be independent of compiler
+intrinsics.
+
+\param[in]      value_p             Value to examine, must not be zero.
+
+\return The function returns the bit position.
+*/
+//------------------------------------------------------------------------------
+static UINT getMsb(UINT32 value_p)
+{
+    UINT    msb = 0;
+
+    if (value_p >= (1UL << 16))
+    {
+        value_p >>= 16;
+        msb += 16;
+    }
+    if (value_p >= (1UL << 8))
+    {
+        value_p >>= 8;
+        msb += 8;
+    }
+    if (value_p >= (1UL << 4))
+    {
+        value_p >>= 4;
+        msb += 4;
+    }
+    if (value_p >= (1UL << 2))
+    {
+        value_p >>= 2;
+        msb += 2;
+    }
+    if (value_p >= (1UL << 1))
+        msb += 1;
+
+    return msb;
+}
+
+/// \}
@@ -70,6 +70,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// The wait time limits the period of the heartbeat updates while no command
+// is received, therefore it must be shorter than CONFIG_CHECK_HEARTBEAT_PERIOD
+// of the user stack.
+#ifndef CONFIG_CTRL_CMD_WAIT_TIME
+#define CONFIG_CTRL_CMD_WAIT_TIME       20      // [ms]
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -141,7 +147,9 @@ void ctrlkcal_exit(void)
 /**
 \brief  Process kernel control CAL module
 
-This function provides processing time for the CAL module.
+This function provides processing time for the CAL module. It blocks until
+the user stack signals a new command or CONFIG_CTRL_CMD_WAIT_TIME elapses,
+so the caller doesn't need to poll the control memory block.
 
 \return The function returns a tOplkError error code.
 
@@ -150,6 +158,8 @@ This function provides processing time for the CAL module.
 //------------------------------------------------------------------------------
 tOplkError ctrlkcal_process(void)
 {
+    ctrlcal_waitCommand(CONFIG_CTRL_CMD_WAIT_TIME);
+
     return kErrorOk;
 }
 
@@ -202,6 +212,7 @@ void ctrlkcal_sendReturn(UINT16 retval_p)
     ctrlCmd.retVal = retval_p;
 
     ctrlcal_writeData(offsetof(tCtrlBuf, ctrlCmd), &ctrlCmd, sizeof(tCtrlCmd));
+    ctrlcal_signalReturn();
 }
 
 //------------------------------------------------------------------------------
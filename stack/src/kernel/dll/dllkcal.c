@@ -51,6 +51,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifdef CONFIG_INCLUDE_NMT_MN
 #include <common/circbuffer.h>
+
+#if ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
+#include <linux/spinlock.h>
+#elif (TARGET_SYSTEM == _LINUX_)
+#include <pthread.h>
+#elif (TARGET_SYSTEM == _NO_OS_)
+#include <common/target.h>
+#endif
 #endif
 
 #if (defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_DLLCAL_QUEUE == DIRECT_QUEUE))
@@ -81,12 +89,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#if defined(CONFIG_INCLUDE_NMT_MN)
-#define DLLKCAL_MAX_QUEUES  6   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq, SyncReq
-#else
-#define DLLKCAL_MAX_QUEUES  5   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq
+#if ((CONFIG_DLLCAL_ASYNC_WEIGHT_NMT == 0) || (CONFIG_DLLCAL_ASYNC_WEIGHT_SDO == 0) || \
+     (CONFIG_DLLCAL_ASYNC_WEIGHT_VETH == 0) || (CONFIG_DLLCAL_ASYNC_WEIGHT_SYNC == 0))
+#error "The asynchronous scheduler weights must not be 0!"
 #endif
 
+#define DLLKCAL_NMT_SOURCES 4   // CnNmtReq, MnNmtReq, MnIdentReq, MnStatusReq
+#define DLLKCAL_SDO_SOURCES 2   // CnGenReq, MnGenReq
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -122,6 +132,37 @@ typedef struct
     UINT8                   extNmtCmdBitMask;       ///< Extended NMT command Bit mask
 } tDllkNodeInstance;
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+/**
+\brief CN asynchronous request entry
+
+This structure contains the asynchronous request state of a CN for one
+request priority.
+*/
+typedef struct
+{
+    UINT                    requestCnt;             ///< Number of requested frames of the CN
+    BOOL                    fPending;               ///< Flag indicating that the CN is in the pending list
+    UINT                    nextNodeId;             ///< Node ID of the next CN in the pending list (0 = end of list)
+    UINT32                  pendingSince;           ///< SoA count when the CN was added to the pending list
+} tDllkCalCnRequest;
+
+/**
+\brief CN asynchronous request table
+
+This structure contains the asynchronous request state of all CNs for one
+request priority. The CNs waiting for an asynchronous phase are linked in
+the order they started to wait, so the oldest request is always at the head
+of the pending list and each CN is contained only once.
+*/
+typedef struct
+{
+    tDllkCalCnRequest       aCnRequest[254];        ///< Request state of each CN
+    UINT                    firstNodeId;            ///< Node ID of the oldest pending CN (0 = list is empty)
+    UINT                    lastNodeId;             ///< Node ID of the newest pending CN
+} tDllkCalCnRequestTable;
+#endif
+
 /**
 \brief DLLk CAL instance type
 
@@ -136,6 +177,8 @@ typedef struct
 #endif
 
     tDllkCalTxQueueSelect   currentTxQueueSelect;   ///< Current Tx queue (TxGen vs. TxVeth)
+    UINT                    aTxQueueCredit[kDllkCalTxQueueSelectLast]; ///< Remaining frames of the current Tx queue in this round
+    tDllkCalAsyncClass      stagedGenClass;         ///< Traffic class of the last generic priority frame passed to the DLL
 
     tDllCalQueueInstance    dllCalQueueTxNmt;       ///< DLL CAL queue instance for NMT priority
     tDllCalFuncIntf*        pTxNmtFuncs;            ///< Function pointer to the TX functions for NMT priority
@@ -159,12 +202,26 @@ typedef struct
     tCircBufInstance*       pQueueIdentReq;         ///< IdentRequest queue with the CN node IDs
     tCircBufInstance*       pQueueStatusReq;        ///< StatusRequest queue with the CN node IDs
 
-    tCircBufInstance*       pQueueCnRequestNmt;     ///< Queue for NMT priority CN requests
-    UINT                    aCnRequestCntNmt[254];  ///< Array of requested frames in the NMT priority queues of each CN
-    tCircBufInstance*       pQueueCnRequestGen;     ///< Queue for generic priority CN requests
-    UINT                    aCnRequestCntGen[254];  ///< Array of requested frames in the generic priority queues of each CN
-
-    UINT                    nextRequestQueue;       ///< Number of next request queue to be scheduled
+    tDllkCalCnRequestTable  cnRequestNmt;           ///< Table of NMT priority CN requests
+    tDllkCalCnRequestTable  cnRequestGen;           ///< Table of generic priority CN requests
+    UINT32                  soaCount;               ///< Number of asynchronous phases scheduled so far
+
+    tDllkCalAsyncClass      curAsyncClass;          ///< Traffic class currently served by the asynchronous scheduler
+    UINT                    aAsyncDeficit[kDllkCalAsyncClassCount]; ///< Remaining asynchronous phases of each class in this round
+    UINT                    nextNmtSource;          ///< Next request source of the NMT class to be scheduled
+    UINT                    nextSdoSource;          ///< Next request source of the SDO class to be scheduled
+    BOOL                    fResetAsyncSched;       ///< Flag indicating that the scheduler shall reset its round state
+
+#if ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
+    spinlock_t              schedLock;              ///< Lock protecting the scheduler state shared with the Rx and event path
+    ULONG                   schedLockFlags;         ///< Saved interrupt flags of the scheduler lock
+#elif (TARGET_SYSTEM == _LINUX_)
+    pthread_mutex_t         schedLock;              ///< Lock protecting the scheduler state shared with the Rx and event path
+#elif ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE))
+    NDIS_SPIN_LOCK          schedLock;              ///< Lock protecting the scheduler state shared with the Rx and event path
+#elif ((TARGET_SYSTEM == _WIN32_) || (TARGET_SYSTEM == _WINCE_))
+    CRITICAL_SECTION        schedLock;              ///< Lock protecting the scheduler state shared with the Rx and event path
+#endif
 #endif
 
     tDllkNodeInstance       nodeInstance;           ///< Initialize the node instance
@@ -174,18 +231,64 @@ typedef struct
 //------------------------------------------------------------------------------
 static tDllkCalInstance     instance_l;
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+// Asynchronous phases per scheduling round of each traffic class. Generic
+// requests of CNs cannot be told apart, and the MN's own generic frames are
+// shared between SDO and virtual Ethernet when they are taken from the Tx
+// queues (see getGenericAsyncFrame()). Thus, both shares are scheduled
+// together in the SDO class.
+static const UINT           aAsyncWeight_l[kDllkCalAsyncClassCount] =
+{
+    CONFIG_DLLCAL_ASYNC_WEIGHT_NMT,
+    CONFIG_DLLCAL_ASYNC_WEIGHT_SDO + CONFIG_DLLCAL_ASYNC_WEIGHT_VETH,
+    0,
+    CONFIG_DLLCAL_ASYNC_WEIGHT_SYNC,
+};
+#endif
+
+#if defined(CONFIG_INCLUDE_VETH)
+// Frames per round of the generic priority Tx queues (TxGen vs. TxVeth)
+static const UINT           aTxQueueWeight_l[kDllkCalTxQueueSelectLast] =
+{
+    CONFIG_DLLCAL_ASYNC_WEIGHT_SDO,
+    CONFIG_DLLCAL_ASYNC_WEIGHT_VETH,
+};
+#endif
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
 #if defined(CONFIG_INCLUDE_NMT_MN)
-static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static BOOL getClassRequest(tDllkCalAsyncClass asyncClass_p,
+                            tDllReqServiceId* pReqServiceId_p,
+                            UINT* pNodeId_p,
+                            tSoaPayload* pSoaPayload_p,
+                            tDllReqServiceId mnReqServiceId_p);
+static BOOL getNmtClassRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tDllReqServiceId mnReqServiceId_p);
+static BOOL getSdoClassRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tDllReqServiceId mnReqServiceId_p);
+static void addPendingCn(tDllkCalCnRequestTable* pTable_p, UINT nodeId_p);
+static BOOL getCnRequest(tDllkCalCnRequestTable* pTable_p,
+                         tDllReqServiceId service_p,
+                         ULONG* pLatencyMax_p,
+                         tDllReqServiceId* pReqServiceId_p,
+                         UINT* pNodeId_p);
+static BOOL getMnRequest(tDllReqServiceId* pReqServiceId_p,
+                         UINT* pNodeId_p,
+                         tDllReqServiceId mnReqServiceId_p,
+                         tDllReqServiceId service_p);
 static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p,
                              UINT* pNodeId_p,
                              tSoaPayload* pSoaPayload_p);
+static void createCriticalSection(void);
+static void deleteCriticalSection(void);
+static void enterCriticalSection(void);
+static void leaveCriticalSection(void);
 #endif
 
 static tOplkError sendGenericAsyncFrame(tFrameInfo* pFrameInfo_p);
@@ -219,6 +322,10 @@ tOplkError dllkcal_init(void)
     // reset instance structure
     OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    createCriticalSection();
+#endif
+
     instance_l.pTxNmtFuncs = GET_DLLKCAL_INTERFACE();
     instance_l.pTxGenFuncs = GET_DLLKCAL_INTERFACE();
 #if defined(CONFIG_INCLUDE_NMT_MN)
@@ -252,24 +359,6 @@ tOplkError dllkcal_init(void)
         DEBUG_LVL_ERROR_TRACE("%s() TxSync failed\n", __func__);
         goto Exit;
     }
-    circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_NMT,
-                            CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT,
-                            &instance_l.pQueueCnRequestNmt);
-    if (circErr != kCircBufOk)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_NMT failed\n", __func__);
-        goto Exit;
-    }
-
-    circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_GEN,
-                            CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN,
-                            &instance_l.pQueueCnRequestGen);
-    if (circErr != kCircBufOk)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_GEN failed\n", __func__);
-        goto Exit;
-    }
-
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_IDENT,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_REQ_IDENT,
                             &instance_l.pQueueIdentReq);
@@ -299,6 +388,7 @@ tOplkError dllkcal_init(void)
 #endif
 
     instance_l.currentTxQueueSelect = kDllkCalTxQueueSelectGen;
+    instance_l.stagedGenClass = kDllkCalAsyncClassSdo;
 
 Exit:
     return ret;
@@ -320,17 +410,13 @@ tOplkError dllkcal_exit(void)
     tOplkError      ret = kErrorOk;
 
 #ifdef CONFIG_INCLUDE_NMT_MN
-    if (instance_l.pQueueCnRequestGen != NULL)
-        circbuf_free(instance_l.pQueueCnRequestGen);
-
-    if (instance_l.pQueueCnRequestNmt != NULL)
-        circbuf_free(instance_l.pQueueCnRequestNmt);
-
     if (instance_l.pQueueIdentReq != NULL)
         circbuf_free(instance_l.pQueueIdentReq);
 
     if (instance_l.pQueueStatusReq != NULL)
         circbuf_free(instance_l.pQueueStatusReq);
+
+    deleteCriticalSection();
 #endif
 
     if (instance_l.pTxNmtFuncs != NULL)
@@ -815,11 +901,13 @@ tOplkError dllkcal_clearAsyncQueues(void)
         DEBUG_LVL_ERROR_TRACE("%s() Reset Sync Tx queue returned 0x%X\n", __func__, ret);
     }
 
-    // clear MN asynchronous queues
-    instance_l.nextRequestQueue = 0;
-
-    circbuf_reset(instance_l.pQueueCnRequestGen);
-    circbuf_reset(instance_l.pQueueCnRequestNmt);
+    // clear MN asynchronous queues, the round state of the scheduler is
+    // reset by the cycle path at the next SoA
+    enterCriticalSection();
+    instance_l.fResetAsyncSched = TRUE;
+    OPLK_MEMSET(&instance_l.cnRequestGen, 0, sizeof(instance_l.cnRequestGen));
+    OPLK_MEMSET(&instance_l.cnRequestNmt, 0, sizeof(instance_l.cnRequestNmt));
+    leaveCriticalSection();
     circbuf_reset(instance_l.pQueueIdentReq);
     circbuf_reset(instance_l.pQueueStatusReq);
 
@@ -954,10 +1042,18 @@ Exit:
 The function returns the next request for SoA. It is called by the kernel
 DLL module.
 
+The asynchronous phases are distributed to the traffic classes
+(\ref eDllkCalAsyncClass) by a weighted round-robin scheduler. In each round a
+class may be assigned up to CONFIG_DLLCAL_ASYNC_WEIGHT_<class> asynchronous
+phases before the next class is served. A class without pending requests
+gives up the remainder of its share, so idle classes do not waste
+asynchronous phases. The virtual Ethernet share is scheduled together with
+the SDO class and applied to the MN's own frames in getGenericAsyncFrame().
+
 \param[out]     pReqServiceId_p     Pointer to the request service ID of available
                                     request for MN NMT or generic request queue
                                     (Flag2.PR) or kDllReqServiceNo if queues are
-                                    empty. The function store the next request at
+                                    empty. The function stores the next request at
                                     this location.
 \param[out]     pNodeId_p           Pointer to store the node ID of the next request.
                                     C_ADR_INVALID is stored if request is self
@@ -973,8 +1069,11 @@ tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
                                  UINT* pNodeId_p,
                                  tSoaPayload* pSoaPayload_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        count;
+    tOplkError          ret = kErrorOk;
+    UINT                count;
+    tDllkCalAsyncClass  asyncClass;
+    tDllkCalAsyncClass  stagedGenClass;
+    tDllReqServiceId    mnReqServiceId;
 
 #if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC == TRUE) && defined(CONFIG_EDRV_ASND_DEFERRED_RX_BUFFERS))
     UINT        rxCount = instance_l.asyncFrameReceived - instance_l.asyncFrameFreed;
@@ -991,43 +1090,56 @@ tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
     }
 #endif
 
-    for (count = DLLKCAL_MAX_QUEUES; count > 0; count--)
+    // the DLL passes the pending request of the MN itself
+    mnReqServiceId = *pReqServiceId_p;
+    *pReqServiceId_p = kDllReqServiceNo;
+
+    enterCriticalSection();
+    if (instance_l.fResetAsyncSched)
     {
-        switch (instance_l.nextRequestQueue)
-        {
-            case 0:
-                if (getCnGenRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
+        instance_l.curAsyncClass = kDllkCalAsyncClassNmt;
+        OPLK_MEMSET(instance_l.aAsyncDeficit, 0, sizeof(instance_l.aAsyncDeficit));
+        instance_l.nextNmtSource = 0;
+        instance_l.nextSdoSource = 0;
+        instance_l.fResetAsyncSched = FALSE;
+    }
+    stagedGenClass = instance_l.stagedGenClass;
+    leaveCriticalSection();
 
-            case 1:
-                if (getCnNmtRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
+    for (count = kDllkCalAsyncClassCount; count > 0; count--)
+    {
+        asyncClass = instance_l.curAsyncClass;
 
-            case 2:
-                if (getMnGenNmtRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
+        // start a new round of the class if its share is used up
+        if (instance_l.aAsyncDeficit[asyncClass] == 0)
+            instance_l.aAsyncDeficit[asyncClass] = aAsyncWeight_l[asyncClass];
 
-            case 3:
-                if (getMnIdentRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
+        if (getClassRequest(asyncClass, pReqServiceId_p, pNodeId_p, pSoaPayload_p, mnReqServiceId))
+        {
+            // the MN's own generic frame is accounted to the class it belongs to
+            if ((*pReqServiceId_p == kDllReqServiceUnspecified) && (*pNodeId_p == C_ADR_INVALID))
+                instance_l.statistics.aAsyncSlotCount[stagedGenClass]++;
+            else
+                instance_l.statistics.aAsyncSlotCount[asyncClass]++;
 
-            case 4:
-                if (getMnStatusRequest(pReqServiceId_p, pNodeId_p) == TRUE)
-                    goto Exit;
-                break;
+            instance_l.aAsyncDeficit[asyncClass]--;
+            if (instance_l.aAsyncDeficit[asyncClass] == 0)
+                instance_l.curAsyncClass = (asyncClass + 1) % kDllkCalAsyncClassCount;
 
-            case 5:
-                if (getMnSyncRequest(pReqServiceId_p, pNodeId_p, pSoaPayload_p) == TRUE)
-                    goto Exit;
-                break;
+            goto Exit;
         }
+
+        // an idle class must not save up asynchronous phases
+        instance_l.aAsyncDeficit[asyncClass] = 0;
+        instance_l.curAsyncClass = (asyncClass + 1) % kDllkCalAsyncClassCount;
     }
 
+    instance_l.statistics.asyncSlotIdleCount++;
+
 Exit:
+    // the SoA count is the time base for the age of CN requests
+    instance_l.soaCount++;
+
     return ret;
 }
 
@@ -1051,40 +1163,49 @@ tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p,
                                            tDllAsyncReqPriority asyncReqPrio_p,
                                            UINT count_p)
 {
-    tOplkError          ret = kErrorOk;
-    tCircBufError       err;
-    UINT*               pLocalRequestCnt;
-    tCircBufInstance*   pTargetQueue;
+    tOplkError                  ret = kErrorOk;
+    tDllkCalCnRequestTable*     pTable;
+    tDllkCalCnRequest*          pCnRequest;
 
-    // get local request count for the node and the target queue
+    if ((nodeId_p == C_ADR_INVALID) || (nodeId_p > 254))
+        return kErrorInvalidNodeId;
+
+    // get the request table of the priority
     switch (asyncReqPrio_p)
     {
         case kDllAsyncReqPrioNmt:
-            pLocalRequestCnt = &instance_l.aCnRequestCntNmt[nodeId_p-1];
-            pTargetQueue = instance_l.pQueueCnRequestNmt;
+            pTable = &instance_l.cnRequestNmt;
             break;
 
         default:
-            pLocalRequestCnt = &instance_l.aCnRequestCntGen[nodeId_p-1];
-            pTargetQueue = instance_l.pQueueCnRequestGen;
+            pTable = &instance_l.cnRequestGen;
             break;
     }
 
+    pCnRequest = &pTable->aCnRequest[nodeId_p - 1];
+
+    enterCriticalSection();
+
     // compare the node request count with the locally stored one
-    if (*pLocalRequestCnt < count_p)
+    if (pCnRequest->requestCnt < count_p)
     {
-        // The node has added some requests, but post only one for fair
-        // scheduling among the other nodes.
-        err = circbuf_writeData(pTargetQueue, &nodeId_p, sizeof(nodeId_p));
-        if (err == kCircBufOk)
-            (*pLocalRequestCnt)++; // increment locally only by successful post
+        // The node has added some requests, but it is added only once to
+        // the pending list. Thus, each node gets at most one asynchronous
+        // phase per round of the list, regardless of its number of requests.
+        if (!pCnRequest->fPending)
+        {
+            addPendingCn(pTable, nodeId_p);
+            pCnRequest->requestCnt++;
+        }
     }
     else
     {
         // the node's request count is equal or less the local one
-        *pLocalRequestCnt = count_p;
+        pCnRequest->requestCnt = count_p;
     }
 
+    leaveCriticalSection();
+
     return ret;
 }
 
@@ -1108,14 +1229,17 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p, tDllReqServiceId reqServiceId_
     tOplkError  ret = kErrorOk;
     UINT*       pLocalRequestCnt;
 
+    if ((nodeId_p == C_ADR_INVALID) || (nodeId_p > 254))
+        return ret;
+
     switch (reqServiceId_p)
     {
         case kDllReqServiceNmtRequest:
-            pLocalRequestCnt = &instance_l.aCnRequestCntNmt[nodeId_p-1];
+            pLocalRequestCnt = &instance_l.cnRequestNmt.aCnRequest[nodeId_p - 1].requestCnt;
             break;
 
         case kDllReqServiceUnspecified:
-            pLocalRequestCnt = &instance_l.aCnRequestCntGen[nodeId_p-1];
+            pLocalRequestCnt = &instance_l.cnRequestGen.aCnRequest[nodeId_p - 1].requestCnt;
             break;
 
         default:
@@ -1123,8 +1247,10 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p, tDllReqServiceId reqServiceId_
             return ret;
     }
 
+    enterCriticalSection();
     if (*pLocalRequestCnt > 0)
         (*pLocalRequestCnt)--;
+    leaveCriticalSection();
 
     return ret;
 }
@@ -1139,102 +1265,193 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p, tDllReqServiceId reqServiceId_
 #if defined(CONFIG_INCLUDE_NMT_MN)
 //------------------------------------------------------------------------------
 /**
-\brief Get CN Generic request
+\brief  Get request of traffic class
 
-The function returns the next CN generic request.
+The function returns the next request of the specified traffic class.
 
+\param[in]      asyncClass_p        Traffic class to get the request from.
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[out]     pSoaPayload_p       Pointer to SoA payload.
+\param[in]      mnReqServiceId_p    Pending request of the MN itself.
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getClassRequest(tDllkCalAsyncClass asyncClass_p,
+                            tDllReqServiceId* pReqServiceId_p,
+                            UINT* pNodeId_p,
+                            tSoaPayload* pSoaPayload_p,
+                            tDllReqServiceId mnReqServiceId_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
-    // next queue will be CnNmtReq queue
-    instance_l.nextRequestQueue = 1;
-
-    err = circbuf_readData(instance_l.pQueueCnRequestGen, &rxNodeId, size, &size);
-
-    switch (err)
+    switch (asyncClass_p)
     {
-        case kCircBufOk:
-            if (instance_l.aCnRequestCntGen[rxNodeId-1] > 0)
-            {
-                *pNodeId_p = rxNodeId;
-                *pReqServiceId_p = kDllReqServiceUnspecified;
-                // dllkcal_ackAsyncRequest() will decrement the request count!
+        case kDllkCalAsyncClassNmt:
+            return getNmtClassRequest(pReqServiceId_p, pNodeId_p, mnReqServiceId_p);
 
-                return TRUE;
-            }
-            // fall-trough
+        case kDllkCalAsyncClassSdo:
+            return getSdoClassRequest(pReqServiceId_p, pNodeId_p, mnReqServiceId_p);
+
+        case kDllkCalAsyncClassSync:
+            return getMnSyncRequest(pReqServiceId_p, pNodeId_p, pSoaPayload_p);
 
-        case kCircBufNoReadableData:
         default:
-            // an empty or faulty queue has no requests
             return FALSE;
     }
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get CN NMT request
+\brief  Get request of NMT traffic class
 
-The function returns the next CN NMT request.
+The function returns the next request of the NMT traffic class. The request
+sources of the class are served round-robin.
 
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[in]      mnReqServiceId_p    Pending request of the MN itself.
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getNmtClassRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tDllReqServiceId mnReqServiceId_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
+    UINT    count;
+    BOOL    fFound = FALSE;
 
-    // next queue will be MnGenReq queue
-    instance_l.nextRequestQueue = 2;
+    for (count = DLLKCAL_NMT_SOURCES; (count > 0) && !fFound; count--)
+    {
+        switch (instance_l.nextNmtSource)
+        {
+            case 0:
+                fFound = getCnRequest(&instance_l.cnRequestNmt,
+                                      kDllReqServiceNmtRequest,
+                                      instance_l.statistics.aCnNmtLatencyMax,
+                                      pReqServiceId_p,
+                                      pNodeId_p);
+                break;
 
-    err = circbuf_readData(instance_l.pQueueCnRequestNmt, &rxNodeId, size, &size);
+            case 1:
+                fFound = getMnRequest(pReqServiceId_p,
+                                      pNodeId_p,
+                                      mnReqServiceId_p,
+                                      kDllReqServiceNmtRequest);
+                break;
+
+            case 2:
+                fFound = getMnIdentRequest(pReqServiceId_p, pNodeId_p);
+                break;
+
+            case 3:
+                fFound = getMnStatusRequest(pReqServiceId_p, pNodeId_p);
+                break;
+        }
 
-    switch (err)
+        instance_l.nextNmtSource = (instance_l.nextNmtSource + 1) % DLLKCAL_NMT_SOURCES;
+    }
+
+    return fFound;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get request of SDO traffic class
+
+The function returns the next request of the SDO traffic class, i.e. generic
+requests of the CNs and generic priority frames (including virtual Ethernet
+frames) of the MN. The request sources of the class are served round-robin.
+
+\param[out]     pReqServiceId_p     Pointer to store the next request.
+\param[out]     pNodeId_p           Pointer to store the node ID for the next
+                                    request.
+\param[in]      mnReqServiceId_p    Pending request of the MN itself.
+
+\return Returns whether a request was found
+\retval TRUE                        A request was found
+\retval FALSE                       No request was found
+*/
+//------------------------------------------------------------------------------
+static BOOL getSdoClassRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tDllReqServiceId mnReqServiceId_p)
+{
+    UINT    count;
+    BOOL    fFound = FALSE;
+
+    for (count = DLLKCAL_SDO_SOURCES; (count > 0) && !fFound; count--)
     {
-        case kCircBufOk:
-            if (instance_l.aCnRequestCntNmt[rxNodeId-1] > 0)
-            {
-                *pNodeId_p = rxNodeId;
-                *pReqServiceId_p = kDllReqServiceNmtRequest;
-                // dllkcal_ackAsyncRequest() will decrement the request count!
+        switch (instance_l.nextSdoSource)
+        {
+            case 0:
+                fFound = getCnRequest(&instance_l.cnRequestGen,
+                                      kDllReqServiceUnspecified,
+                                      instance_l.statistics.aCnGenLatencyMax,
+                                      pReqServiceId_p,
+                                      pNodeId_p);
+                break;
 
-                return TRUE;
-            }
-            // fall-trough
+            case 1:
+                fFound = getMnRequest(pReqServiceId_p,
+                                      pNodeId_p,
+                                      mnReqServiceId_p,
+                                      kDllReqServiceUnspecified);
+                break;
+        }
 
-        case kCircBufNoReadableData:
-        default:
-            // an empty or faulty queue has no requests
-            return FALSE;
+        instance_l.nextSdoSource = (instance_l.nextSdoSource + 1) % DLLKCAL_SDO_SOURCES;
     }
+
+    return fFound;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get MN Generic or NMT request
+\brief Add CN to pending list
+
+The function appends a CN to the pending list of a request table and records
+the time it started to wait. The caller must be in the critical section.
+
+\param[in,out]  pTable_p            Pointer to the request table.
+\param[in]      nodeId_p            Node ID of the CN.
+*/
+//------------------------------------------------------------------------------
+static void addPendingCn(tDllkCalCnRequestTable* pTable_p, UINT nodeId_p)
+{
+    tDllkCalCnRequest*  pCnRequest = &pTable_p->aCnRequest[nodeId_p - 1];
+
+    pCnRequest->fPending = TRUE;
+    pCnRequest->nextNodeId = 0;
+    pCnRequest->pendingSince = instance_l.soaCount;
+
+    if (pTable_p->firstNodeId == 0)
+        pTable_p->firstNodeId = nodeId_p;
+    else
+        pTable_p->aCnRequest[pTable_p->lastNodeId - 1].nextNodeId = nodeId_p;
+
+    pTable_p->lastNodeId = nodeId_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Get CN request
 
-The function returns the next MN Generic/NMT request.
+The function returns the oldest pending CN request of a request table and
+removes the CN from the pending list. CNs whose requests were meanwhile
+withdrawn are skipped. The time the CN had to wait is recorded as its
+asynchronous service latency.
 
+\param[in,out]  pTable_p            Pointer to the request table.
+\param[in]      service_p           Request service ID of the table.
+\param[in,out]  pLatencyMax_p       Pointer to the worst-case latency array
+                                    of the table (index = node ID - 1).
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
@@ -1244,18 +1461,78 @@ The function returns the next MN Generic/NMT request.
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getCnRequest(tDllkCalCnRequestTable* pTable_p,
+                         tDllReqServiceId service_p,
+                         ULONG* pLatencyMax_p,
+                         tDllReqServiceId* pReqServiceId_p,
+                         UINT* pNodeId_p)
 {
-    // MnNmtReq and MnGenReq
-    // next queue will be MnIdentReq queue
-    instance_l.nextRequestQueue = 3;
-    if (*pReqServiceId_p != kDllReqServiceNo)
+    UINT                nodeId;
+    tDllkCalCnRequest*  pCnRequest;
+    UINT32              latency;
+    BOOL                fFound = FALSE;
+
+    enterCriticalSection();
+
+    while ((pTable_p->firstNodeId != 0) && !fFound)
     {
-        *pNodeId_p = C_ADR_INVALID;   // DLLk must exchange this with the actual node ID
-        return TRUE;
+        nodeId = pTable_p->firstNodeId;
+        pCnRequest = &pTable_p->aCnRequest[nodeId - 1];
+
+        pTable_p->firstNodeId = pCnRequest->nextNodeId;
+        pCnRequest->fPending = FALSE;
+
+        if (pCnRequest->requestCnt > 0)
+        {
+            latency = instance_l.soaCount - pCnRequest->pendingSince;
+            if (latency > pLatencyMax_p[nodeId - 1])
+                pLatencyMax_p[nodeId - 1] = latency;
+
+            if (latency > instance_l.statistics.asyncLatencyMax)
+                instance_l.statistics.asyncLatencyMax = latency;
+
+            *pNodeId_p = nodeId;
+            *pReqServiceId_p = service_p;
+            // dllkcal_ackAsyncRequest() will decrement the request count!
+            fFound = TRUE;
+        }
     }
 
-    return FALSE;
+    leaveCriticalSection();
+
+    return fFound;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get MN Generic or NMT request
+
+The function returns the pending Generic or NMT request of the MN itself if it
+matches the specified service.
+
+\param[out]     pReqServiceId_p     Pointer to store the next request.
+\param[out]     pNodeId_p           Pointer to store the node ID for the next
+                                    request.
+\param[in]      mnReqServiceId_p    Pending request of the MN itself.
+\param[in]      service_p           Requested service (kDllReqServiceNmtRequest
+                                    or kDllReqServiceUnspecified).
+
+\return Returns whether a request was found
+\retval TRUE                        A request was found
+\retval FALSE                       No request was found
+*/
+//------------------------------------------------------------------------------
+static BOOL getMnRequest(tDllReqServiceId* pReqServiceId_p,
+                         UINT* pNodeId_p,
+                         tDllReqServiceId mnReqServiceId_p,
+                         tDllReqServiceId service_p)
+{
+    if (mnReqServiceId_p != service_p)
+        return FALSE;
+
+    *pReqServiceId_p = service_p;
+    *pNodeId_p = C_ADR_INVALID;   // DLLk must exchange this with the actual node ID
+    return TRUE;
 }
 
 //------------------------------------------------------------------------------
@@ -1279,9 +1556,6 @@ static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p
     UINT            rxNodeId;
     size_t          size = sizeof(rxNodeId);
 
-    // next queue will be MnStatusReq queue
-    instance_l.nextRequestQueue = 4;
-
     err = circbuf_readData(instance_l.pQueueIdentReq, &rxNodeId, size, &size);
 
     if (err == kCircBufOk)
@@ -1315,8 +1589,6 @@ static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_
     UINT            rxNodeId;
     size_t          size = sizeof(rxNodeId);
 
-    // next queue will be MnSyncReq queue
-    instance_l.nextRequestQueue = 5;
     err = circbuf_readData(instance_l.pQueueStatusReq, &rxNodeId, size, &size);
 
     if (err == kCircBufOk)
@@ -1358,8 +1630,6 @@ static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p,
     tDllSyncRequest     syncRequest;
     tDllNodeOpParam     nodeOpParam;
 
-    // next queue will be CnGenReq queue
-    instance_l.nextRequestQueue = 0;
     ret = instance_l.pTxSyncFuncs->pfnGetDataBlockCount(instance_l.dllCalQueueTxSync,
                                                         &syncReqCount);
     if (ret != kErrorOk)
@@ -1425,6 +1695,90 @@ static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p,
     return FALSE;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Create critical section
+
+The function creates the critical section which protects the scheduler state
+shared between the cycle path, the Rx path and the event path.
+*/
+//------------------------------------------------------------------------------
+static void createCriticalSection(void)
+{
+#if ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
+    spin_lock_init(&instance_l.schedLock);
+#elif (TARGET_SYSTEM == _LINUX_)
+    pthread_mutex_init(&instance_l.schedLock, NULL);
+#elif ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE))
+    NdisAllocateSpinLock(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) || (TARGET_SYSTEM == _WINCE_))
+    InitializeCriticalSection(&instance_l.schedLock);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete critical section
+
+The function deletes the critical section of the scheduler state.
+*/
+//------------------------------------------------------------------------------
+static void deleteCriticalSection(void)
+{
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+    pthread_mutex_destroy(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE))
+    NdisFreeSpinLock(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) || (TARGET_SYSTEM == _WINCE_))
+    DeleteCriticalSection(&instance_l.schedLock);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Enter critical section
+
+The function enters the critical section of the scheduler state. On targets
+without an operating system the interrupts are disabled.
+*/
+//------------------------------------------------------------------------------
+static void enterCriticalSection(void)
+{
+#if (TARGET_SYSTEM == _NO_OS_)
+    target_enableGlobalInterrupt(FALSE);
+#elif ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
+    spin_lock_irqsave(&instance_l.schedLock, instance_l.schedLockFlags);
+#elif (TARGET_SYSTEM == _LINUX_)
+    pthread_mutex_lock(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE))
+    NdisAcquireSpinLock(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) || (TARGET_SYSTEM == _WINCE_))
+    EnterCriticalSection(&instance_l.schedLock);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Leave critical section
+
+The function leaves the critical section of the scheduler state.
+*/
+//------------------------------------------------------------------------------
+static void leaveCriticalSection(void)
+{
+#if (TARGET_SYSTEM == _NO_OS_)
+    target_enableGlobalInterrupt(TRUE);
+#elif ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
+    spin_unlock_irqrestore(&instance_l.schedLock, instance_l.schedLockFlags);
+#elif (TARGET_SYSTEM == _LINUX_)
+    pthread_mutex_unlock(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE))
+    NdisReleaseSpinLock(&instance_l.schedLock);
+#elif ((TARGET_SYSTEM == _WIN32_) || (TARGET_SYSTEM == _WINCE_))
+    LeaveCriticalSection(&instance_l.schedLock);
+#endif
+}
+
 #endif
 
 //------------------------------------------------------------------------------
@@ -1473,6 +1827,10 @@ static tOplkError sendGenericAsyncFrame(tFrameInfo* pFrameInfo_p)
 /**
 \brief  Get current asynchronous frame with generic priority
 
+The function returns the next frame of the generic priority Tx queues. The
+TxGen and TxVeth queues are served by weighted round-robin according to the
+SDO and virtual Ethernet scheduler weights.
+
 \param[out]     pFrame_p            Pointer to the asynchronous frame.
 \param[out]     pFrameSize_p        Size of the asynchronous frame.
 
@@ -1485,40 +1843,67 @@ static tOplkError getGenericAsyncFrame(UINT8* pFrame_p, UINT* pFrameSize_p)
 #if defined(CONFIG_INCLUDE_VETH)
     UINT        i;
 
+    tDllkCalTxQueueSelect   select;
+    tDllkCalAsyncClass      stagedGenClass = kDllkCalAsyncClassSdo;
+
     for (i = 0; i < kDllkCalTxQueueSelectLast; i++)
     {
-        switch (instance_l.currentTxQueueSelect)
+        select = instance_l.currentTxQueueSelect;
+        if (select >= kDllkCalTxQueueSelectLast)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s current selected Tx queue %d invalid!\n",
+                                  __func__,
+                                  select);
+            return kErrorDllInvalidParam;
+        }
+
+        if (instance_l.aTxQueueCredit[select] == 0)
+            instance_l.aTxQueueCredit[select] = aTxQueueWeight_l[select];
+
+        switch (select)
         {
             case kDllkCalTxQueueSelectGen:
                 ret = instance_l.pTxGenFuncs->pfnGetDataBlock(instance_l.dllCalQueueTxGen,
                                                               (UINT8*)pFrame_p,
                                                               pFrameSize_p);
-
-                // Set current queue select to next queue
-                instance_l.currentTxQueueSelect = kDllkCalTxQueueSelectVeth;
+                stagedGenClass = kDllkCalAsyncClassSdo;
                 break;
 
             case kDllkCalTxQueueSelectVeth:
                 ret = instance_l.pTxVethFuncs->pfnGetDataBlock(instance_l.dllCalQueueTxVeth,
                                                                (UINT8*)pFrame_p,
                                                                pFrameSize_p);
-
-                // Set current queue select to next queue
-                instance_l.currentTxQueueSelect = kDllkCalTxQueueSelectGen;
-                break;
-
-            default:
-                DEBUG_LVL_ERROR_TRACE("%s current selected Tx queue %d invalid!\n",
-                                      __func__,
-                                      instance_l.currentTxQueueSelect);
-                ret = kErrorDllInvalidParam;
+                stagedGenClass = kDllkCalAsyncClassVeth;
                 break;
         }
 
+        // An empty queue gives up the remainder of its share, otherwise
+        // the queue is kept until its share is used up.
+        if (ret == kErrorDllAsyncTxBufferEmpty)
+            instance_l.aTxQueueCredit[select] = 0;
+        else if (ret == kErrorOk)
+            instance_l.aTxQueueCredit[select]--;
+
+        // Set current queue select to next queue
+        if (instance_l.aTxQueueCredit[select] == 0)
+            instance_l.currentTxQueueSelect = (select + 1) % kDllkCalTxQueueSelectLast;
+
         // Break loop earlier if data is found or an error happens
         if (ret != kErrorDllAsyncTxBufferEmpty)
             break;
     }
+
+    if (ret == kErrorOk)
+    {
+#if defined(CONFIG_INCLUDE_NMT_MN)
+        // the staged class is read by the cycle path
+        enterCriticalSection();
+        instance_l.stagedGenClass = stagedGenClass;
+        leaveCriticalSection();
+#else
+        instance_l.stagedGenClass = stagedGenClass;
+#endif
+    }
 #else
     ret = instance_l.pTxGenFuncs->pfnGetDataBlock(instance_l.dllCalQueueTxGen,
                                                   (UINT8*)pFrame_p,
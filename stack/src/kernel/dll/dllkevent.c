@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <kernel/dllkcal.h>
 #include <kernel/eventk.h>
+#include <kernel/eventkcal.h>
 #include <kernel/errhndk.h>
 #include <common/ami.h>
 
@@ -96,6 +97,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+#if (defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE))
+// Event buffer for forwarding cycle histograms, kept off the stack due to its size
+static tDllEventCycleHistogram  histogramEvent_l;
+#endif
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -121,6 +126,14 @@ static tOplkError processFillTx(tDllAsyncReqPriority asyncReqPriority_p, tNmtSta
 static tOplkError requestPresForward(UINT node_p);
 #endif
 
+#if (defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE))
+static tOplkError forwardCycleHistograms(void);
+#endif
+
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+static tOplkError forwardEventStatistics(void);
+#endif
+
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
 //============================================================================//
@@ -187,7 +200,19 @@ tOplkError dllk_process(const tEvent* pEvent_p)
             break;
 #endif
 
+        case kEventTypeRequCycleHistogram:
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+            ret = forwardCycleHistograms();
 #endif
+            break;
+
+#endif
+
+        case kEventTypeRequEventStatistics:
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+            ret = forwardEventStatistics();
+#endif
+            break;
 
 #if (CONFIG_DLL_PRES_READY_AFTER_SOA != FALSE)
         case kEventTypeDllkPresReady:
@@ -1211,6 +1236,83 @@ static tOplkError requestPresForward(UINT node_p)
 }
 #endif
 
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Forward cycle histograms to the application
+
+The function forwards the cycle histograms of the cyclic Ethernet driver to the
+application. Each histogram is posted with a separate event due to the limited
+event argument size. The histograms are still updated by the cycle timer while
+they are copied, therefore the counters of a histogram may differ by one cycle.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError forwardCycleHistograms(void)
+{
+    tOplkError                      ret;
+    const tEdrvCyclicDiagnostics*   pDiagnostics;
+    const tHistogram*               apHistogram[kDllCycleHistogramCount];
+    UINT                            histogramId;
+    tEvent                          event;
+
+    ret = edrvcyclic_getDiagnostics(&pDiagnostics);
+    if (ret != kErrorOk)
+        return ret;
+
+    apHistogram[kDllCycleHistogramCycleTime] = &pDiagnostics->cycleTimeHistogram;
+    apHistogram[kDllCycleHistogramUsedCycleTime] = &pDiagnostics->usedCycleTimeHistogram;
+    apHistogram[kDllCycleHistogramSpareCycleTime] = &pDiagnostics->spareCycleTimeHistogram;
+    apHistogram[kDllCycleHistogramSocToPreq] = &pDiagnostics->socToPreqHistogram;
+
+    for (histogramId = 0; histogramId < kDllCycleHistogramCount; histogramId++)
+    {
+        histogramEvent_l.histogramId = histogramId;
+        OPLK_MEMCPY(&histogramEvent_l.histogram, apHistogram[histogramId], sizeof(tHistogram));
+
+        event.eventSink = kEventSinkApi;
+        event.eventType = kEventTypeCycleHistogram;
+        event.eventArgSize = sizeof(histogramEvent_l);
+        event.eventArg.pEventArg = &histogramEvent_l;
+
+        ret = eventk_postEvent(&event);
+        if (ret != kErrorOk)
+            break;
+    }
+
+    return ret;
+}
+#endif
+
+#endif
+
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+//------------------------------------------------------------------------------
+/**
+\brief  Forward kernel event statistics to the application
+
+The function forwards the statistics of the kernel event thread to the
+application. The user layer adds the statistics of the user event thread before
+the statistics are passed to the application.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError forwardEventStatistics(void)
+{
+    tEventCalStatistics statistics;
+    tEvent              event;
+
+    eventkcal_getStatistics(&statistics);
+
+    event.eventSink = kEventSinkApi;
+    event.eventType = kEventTypeEventStatistics;
+    event.eventArgSize = sizeof(statistics);
+    event.eventArg.pEventArg = &statistics;
+
+    return eventk_postEvent(&event);
+}
 #endif
 
 /// \}
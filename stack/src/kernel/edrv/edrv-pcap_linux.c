@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/edrv.h>
 
 #include <unistd.h>
+#include <errno.h>
 #include <pcap.h>
 #include <string.h>
 #include <semaphore.h>
@@ -55,6 +56,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/ioctl.h>
 #include <netinet/in.h>
 #include <net/if.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -80,6 +83,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #define EDRV_MAX_FRAME_SIZE     0x0600
+#define EDRV_NETLINK_BUFFER_SIZE    8192        // Receive buffer size for rtnetlink messages
+#define EDRV_NETLINK_TIMEOUT_MS     100         // Receive timeout of the link status thread
 
 //------------------------------------------------------------------------------
 // local types
@@ -99,6 +104,11 @@ typedef struct
     pcap_t*             pPcap;                              ///< Pointer to the pcap interface instance
     pcap_t*             pPcapThread;                        ///< Handle of the pcap packet handler thread
     pthread_t           hThread;                            ///< Handle of the worker thread
+    BOOL                fLinkUp;                            ///< Cached link status, updated by the link status thread
+    int                 ifIndex;                            ///< Interface index of the Ethernet interface
+    int                 netlinkFd;                          ///< rtnetlink socket for link change notifications
+    pthread_t           hLinkThread;                        ///< Handle of the link status thread
+    BOOL                fStopLinkThread;                    ///< Flag to stop the link status thread
 } tEdrvInstance;
 
 //------------------------------------------------------------------------------
@@ -114,6 +124,8 @@ static void*    workerThread(void* pArgument_p);
 static void     getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
 static pcap_t*  startPcap(void);
 static BOOL     getLinkStatus(const char* pIfName_p);
+static tOplkError startLinkMonitor(void);
+static void*    linkStatusThread(void* pArgument_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -207,6 +219,17 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
     /* wait until thread is started */
     sem_wait(&edrvInstance_l.syncSem);
 
+    // The link monitor is started last, so only the worker thread has to be
+    // shut down again if it fails
+    if (startLinkMonitor() != kErrorOk)
+    {
+        pcap_breakloop(edrvInstance_l.pPcapThread);
+        pthread_join(edrvInstance_l.hThread, NULL);
+        pcap_close(edrvInstance_l.pPcap);
+        pthread_mutex_destroy(&edrvInstance_l.mutex);
+        return kErrorEdrvInit;
+    }
+
     return kErrorOk;
 }
 
@@ -227,6 +250,11 @@ tOplkError edrv_exit(void)
     pcap_breakloop(edrvInstance_l.pPcapThread);
     pthread_join(edrvInstance_l.hThread, NULL);
 
+    // Stop the link status thread
+    __atomic_store_n(&edrvInstance_l.fStopLinkThread, TRUE, __ATOMIC_RELAXED);
+    pthread_join(edrvInstance_l.hLinkThread, NULL);
+    close(edrvInstance_l.netlinkFd);
+
     // Close pcap instance
     pcap_close(edrvInstance_l.pPcap);
 
@@ -280,7 +308,7 @@ tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
     if (pBuffer_p->txBufferNumber.pArg != NULL)
         return kErrorInvalidOperation;
 
-    if (getLinkStatus(edrvInstance_l.initParam.hwParam.pDevName) == FALSE)
+    if (__atomic_load_n(&edrvInstance_l.fLinkUp, __ATOMIC_RELAXED) == FALSE)
     {
         /* there's no link! We pretend that packet is sent and immediately call
          * tx handler! Otherwise the stack would hang! */
@@ -730,4 +758,127 @@ static BOOL getLinkStatus(const char* pIfName_p)
     return fRunning;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Start link status monitoring
+
+This function opens an rtnetlink socket subscribed to link change notifications,
+reads the initial link status and starts the link status thread. The transmit
+path then only reads the cached link status.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError startLinkMonitor(void)
+{
+    struct sockaddr_nl  netlinkAddr;
+    struct timeval      timeout;
+
+    edrvInstance_l.ifIndex = (int)if_nametoindex(edrvInstance_l.initParam.hwParam.pDevName);
+    if (edrvInstance_l.ifIndex == 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't get interface index of %s\n",
+                              __func__,
+                              edrvInstance_l.initParam.hwParam.pDevName);
+        return kErrorEdrvInit;
+    }
+
+    edrvInstance_l.netlinkFd = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    if (edrvInstance_l.netlinkFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open netlink socket\n", __func__);
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(&netlinkAddr, 0, sizeof(netlinkAddr));
+    netlinkAddr.nl_family = AF_NETLINK;
+    netlinkAddr.nl_groups = RTMGRP_LINK;
+    if (bind(edrvInstance_l.netlinkFd, (struct sockaddr*)&netlinkAddr, sizeof(netlinkAddr)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't bind netlink socket\n", __func__);
+        goto Exit;
+    }
+
+    // The receive timeout allows the thread to check its stop flag
+    timeout.tv_sec = 0;
+    timeout.tv_usec = EDRV_NETLINK_TIMEOUT_MS * 1000;
+    setsockopt(edrvInstance_l.netlinkFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Read the initial state after subscribing, so no change can be missed
+    edrvInstance_l.fLinkUp = getLinkStatus(edrvInstance_l.initParam.hwParam.pDevName);
+
+    edrvInstance_l.fStopLinkThread = FALSE;
+    if (pthread_create(&edrvInstance_l.hLinkThread, NULL, linkStatusThread, &edrvInstance_l) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't create link status thread!\n", __func__);
+        goto Exit;
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(edrvInstance_l.hLinkThread, "oplk-edrvlink");
+#endif
+
+    return kErrorOk;
+
+Exit:
+    close(edrvInstance_l.netlinkFd);
+    return kErrorEdrvInit;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link status thread
+
+This function implements the link status thread. It listens for rtnetlink link
+notifications of the used interface and updates the cached link status.
+
+\param[in,out]  pArgument_p         User specific pointer pointing to the instance structure
+
+\return The function returns a thread error code.
+*/
+//------------------------------------------------------------------------------
+static void* linkStatusThread(void* pArgument_p)
+{
+    tEdrvInstance*          pInstance = (tEdrvInstance*)pArgument_p;
+    UINT32                  aBuffer[EDRV_NETLINK_BUFFER_SIZE / sizeof(UINT32)];
+    struct nlmsghdr*        pMsg;
+    const struct ifinfomsg* pIfInfo;
+    ssize_t                 len;
+    BOOL                    fLinkUp;
+
+    while (!__atomic_load_n(&pInstance->fStopLinkThread, __ATOMIC_RELAXED))
+    {
+        len = recv(pInstance->netlinkFd, aBuffer, sizeof(aBuffer), 0);
+        if (len < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                // Notifications were lost, so read the current state directly
+                fLinkUp = getLinkStatus(pInstance->initParam.hwParam.pDevName);
+                __atomic_store_n(&pInstance->fLinkUp, fLinkUp, __ATOMIC_RELAXED);
+            }
+            continue;
+        }
+
+        for (pMsg = (struct nlmsghdr*)aBuffer; NLMSG_OK(pMsg, (size_t)len); pMsg = NLMSG_NEXT(pMsg, len))
+        {
+            if ((pMsg->nlmsg_type != RTM_NEWLINK) && (pMsg->nlmsg_type != RTM_DELLINK))
+                continue;
+
+            pIfInfo = (const struct ifinfomsg*)NLMSG_DATA(pMsg);
+            if (pIfInfo->ifi_index != pInstance->ifIndex)
+                continue;
+
+            fLinkUp = ((pMsg->nlmsg_type == RTM_NEWLINK) && ((pIfInfo->ifi_flags & IFF_RUNNING) != 0));
+            if (fLinkUp != __atomic_load_n(&pInstance->fLinkUp, __ATOMIC_RELAXED))
+            {
+                DEBUG_LVL_EDRV_TRACE("%s(): link %s\n", __func__, fLinkUp ? "up" : "down");
+                __atomic_store_n(&pInstance->fLinkUp, fLinkUp, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    return NULL;
+}
+
 /// \}
@@ -0,0 +1,1195 @@
+/**
+********************************************************************************
+\file   edrv-rawsock_linux.c
+
+\brief  Implementation of Linux AF_PACKET Ethernet driver
+
+This file contains the implementation of the Linux Ethernet driver based on
+AF_PACKET sockets with memory mapped rings. Frames are received through a
+TPACKET_V3 Rx ring which delivers them in blocks. Frames are transmitted through
+a TPACKET_V2 Tx ring. Several frames can be queued in the Tx ring and submitted
+to the kernel with a single system call. The completion of a frame is detected
+by its Tx ring status.
+
+If time triggered sending is enabled (EDRV_USE_TTTX), frames with a valid launch
+time are sent through a separate socket with SO_TXTIME. The launch time is
+passed with each frame, so the kernel paces the frames of a cycle, e.g. by an
+ETF queuing discipline on the queue selected by EDRV_LAUNCH_PRIORITY.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/ftracedebug.h>
+#include <kernel/edrv.h>
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <net/if.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#if (EDRV_USE_TTTX == TRUE)
+#include <linux/net_tstamp.h>
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRV_MAX_FRAME_SIZE         0x0600
+
+#define EDRV_RX_BLOCK_SIZE          (1 << 16)   // Size of a Rx ring block, multiple of the page size
+#define EDRV_RX_BLOCK_COUNT         16          // Number of Rx ring blocks
+#define EDRV_RX_FRAME_SIZE          2048        // Nominal Rx frame size used to size the Rx ring
+#define EDRV_RX_BLOCK_TIMEOUT_MS    1           // Time after which a partially filled Rx block is passed to the driver
+#define EDRV_RX_POLL_TIMEOUT_MS     100         // Poll timeout of the worker thread
+
+#define EDRV_TX_FRAME_SIZE          2048        // Size of a Tx ring frame including the frame header
+#define EDRV_TX_FRAME_COUNT         256         // Number of Tx ring frames
+#define EDRV_TX_SEND_TIMEOUT_MS     100         // Maximum time to wait for the transmission of the queued frames
+
+// Offset of the frame data in a Tx ring frame
+#define EDRV_TX_DATA_OFFSET         (TPACKET2_HDRLEN - sizeof(struct sockaddr_ll))
+
+#if (EDRV_USE_TTTX == TRUE)
+#define EDRV_LAUNCH_CLOCK           CLOCK_TAI   // Clock of the launch times, must match the ETF qdisc clock
+#define EDRV_LAUNCH_PRIORITY        6           // Socket priority of frames with launch time
+#define EDRV_LAUNCH_BATCH_SIZE      32          // Maximum number of frames passed in one system call
+
+#ifndef CLOCK_TAI
+#define CLOCK_TAI                   11
+#endif
+
+#ifndef SO_TXTIME
+#define SO_TXTIME                   61
+#define SCM_TXTIME                  SO_TXTIME
+#endif
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Structure describing an instance of the Edrv
+
+This structure describes an instance of the Ethernet driver.
+*/
+typedef struct
+{
+    tEdrvInitParam      initParam;                              ///< Init parameters
+    int                 ifIndex;                                ///< Interface index of the Ethernet interface
+    int                 rxSocket;                               ///< Packet socket with the Rx ring
+    UINT8*              pRxRing;                                ///< Mapped Rx ring
+    size_t              rxRingSize;                             ///< Size of the mapped Rx ring
+    UINT                curRxBlock;                             ///< Rx ring block to be processed next
+    int                 txSocket;                               ///< Packet socket with the Tx ring
+    UINT8*              pTxRing;                                ///< Mapped Tx ring
+    size_t              txRingSize;                             ///< Size of the mapped Tx ring
+    UINT                txHead;                                 ///< Tx ring frame to be filled next
+    UINT                txTail;                                 ///< Oldest Tx ring frame which is not completed yet
+    tEdrvTxBuffer*      apTxRingBuffer[EDRV_TX_FRAME_COUNT];    ///< Tx buffers queued in the Tx ring frames
+    pthread_mutex_t     txMutex;                                ///< Mutex for locking of the Tx ring
+#if (EDRV_USE_TTTX == TRUE)
+    int                 launchSocket;                           ///< Packet socket for frames with launch time
+#endif
+    pthread_t           hThread;                                ///< Handle of the worker thread
+    BOOL                fStopThread;                            ///< Flag to stop the worker thread
+} tEdrvInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvInstance edrvInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError sendTxBuffers(tEdrvTxBuffer* const* ppBuffer_p, UINT count_p, UINT* pSentCount_p);
+static UINT     reclaimTxFrames(tEdrvTxBuffer** ppCompleted_p);
+static UINT     discardTxFrames(tEdrvTxBuffer** ppCompleted_p);
+static void     processRxBlock(tEdrvInstance* pInstance_p, const struct tpacket_block_desc* pBlock_p);
+static void*    workerThread(void* pArgument_p);
+static tOplkError setupRxRing(void);
+static tOplkError setupTxRing(void);
+static void     closeRings(void);
+#if (EDRV_USE_TTTX == TRUE)
+static tOplkError setupLaunchSocket(void);
+static tOplkError sendLaunchTimeBuffers(tEdrvTxBuffer* const* ppBuffer_p, UINT count_p, UINT* pSentCount_p);
+#endif
+static void     getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Ethernet driver initialization
+
+This function initializes the Ethernet driver.
+
+\param[in]      pEdrvInitParam_p    Edrv initialization parameters
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
+{
+    struct sched_param  schedParam;
+
+    // Check parameter validity
+    ASSERT(pEdrvInitParam_p != NULL);
+
+    // clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+    edrvInstance_l.rxSocket = -1;
+    edrvInstance_l.txSocket = -1;
+#if (EDRV_USE_TTTX == TRUE)
+    edrvInstance_l.launchSocket = -1;
+#endif
+
+    if (pEdrvInitParam_p->hwParam.pDevName == NULL)
+        return kErrorEdrvInit;
+
+    // save the init data
+    edrvInstance_l.initParam = *pEdrvInitParam_p;
+
+    /* if no MAC address was specified read MAC address of used
+     * Ethernet interface
+     */
+    if ((edrvInstance_l.initParam.aMacAddr[0] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[1] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[2] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[3] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[4] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[5] == 0))
+    {   // read MAC address from controller
+        getMacAdrs(edrvInstance_l.initParam.hwParam.pDevName,
+                   edrvInstance_l.initParam.aMacAddr);
+    }
+
+    edrvInstance_l.ifIndex = (int)if_nametoindex(edrvInstance_l.initParam.hwParam.pDevName);
+    if (edrvInstance_l.ifIndex == 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't get interface index of %s\n",
+                              __func__,
+                              edrvInstance_l.initParam.hwParam.pDevName);
+        return kErrorEdrvInit;
+    }
+
+    if ((setupRxRing() != kErrorOk) || (setupTxRing() != kErrorOk))
+    {
+        closeRings();
+        return kErrorEdrvInit;
+    }
+
+#if (EDRV_USE_TTTX == TRUE)
+    if (setupLaunchSocket() != kErrorOk)
+    {
+        closeRings();
+        return kErrorEdrvInit;
+    }
+#endif
+
+    if (pthread_mutex_init(&edrvInstance_l.txMutex, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex\n", __func__);
+        closeRings();
+        return kErrorEdrvInit;
+    }
+
+    if (pthread_create(&edrvInstance_l.hThread, NULL,
+                       workerThread, &edrvInstance_l) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't create worker thread!\n", __func__);
+        pthread_mutex_destroy(&edrvInstance_l.txMutex);
+        closeRings();
+        return kErrorEdrvInit;
+    }
+
+    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
+    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvraw");
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down Ethernet driver
+
+This function shuts down the Ethernet driver.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_exit(void)
+{
+    // Stop the worker thread, it checks the flag at least once per poll timeout
+    __atomic_store_n(&edrvInstance_l.fStopThread, TRUE, __ATOMIC_RELAXED);
+    pthread_join(edrvInstance_l.hThread, NULL);
+
+    closeRings();
+
+    // Destroy the mutex
+    pthread_mutex_destroy(&edrvInstance_l.txMutex);
+
+    // Clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get MAC address
+
+This function returns the MAC address of the Ethernet controller
+
+\return The function returns a pointer to the MAC address.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+const UINT8* edrv_getMacAddr(void)
+{
+    return edrvInstance_l.initParam.aMacAddr;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffer
+
+This function sends the Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UINT    sentCount;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    FTRACE_MARKER("%s", __func__);
+
+    return sendTxBuffers(&pBuffer_p, 1, &sentCount);
+}
+
+#if (EDRV_USE_TX_BATCH == TRUE)
+//------------------------------------------------------------------------------
+/**
+\brief  Send list of Tx buffers
+
+This function sends several Tx buffers at once. The frames are queued in the
+Tx ring in the given order and handed to the kernel with a single system call.
+
+\param[in,out]  ppBuffer_p          Array of Tx buffer descriptors
+\param[in]      count_p             Number of Tx buffers in the array
+\param[out]     pSentCount_p        Number of leading Tx buffers of the array
+                                    which were handed over to the kernel
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_sendTxBufferList(tEdrvTxBuffer* const* ppBuffer_p, UINT count_p, UINT* pSentCount_p)
+{
+    // Check parameter validity
+    ASSERT(ppBuffer_p != NULL);
+    ASSERT(pSentCount_p != NULL);
+
+    FTRACE_MARKER("%s", __func__);
+
+    return sendTxBuffers(ppBuffer_p, count_p, pSentCount_p);
+}
+#endif
+
+#if (EDRV_USE_TTTX == TRUE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get MAC time
+
+This function returns the current time of the clock the launch times refer to.
+
+\param[out]     pCurtime_p          Pointer to store the current time in ns
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_getMacTime(UINT64* pCurtime_p)
+{
+    struct timespec currentTime;
+
+    // Check parameter validity
+    ASSERT(pCurtime_p != NULL);
+
+    if (clock_gettime(EDRV_LAUNCH_CLOCK, &currentTime) != 0)
+        return kErrorGeneralError;
+
+    *pCurtime_p = ((UINT64)currentTime.tv_sec * 1000000000ULL) + (UINT64)currentTime.tv_nsec;
+
+    return kErrorOk;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate Tx buffer
+
+This function allocates a Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_allocTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    if (pBuffer_p->maxBufferSize > EDRV_MAX_FRAME_SIZE)
+        return kErrorEdrvNoFreeBufEntry;
+
+    // allocate buffer with malloc
+    pBuffer_p->pBuffer = (UINT8*)OPLK_MALLOC(pBuffer_p->maxBufferSize);
+    if (pBuffer_p->pBuffer == NULL)
+        return kErrorEdrvNoFreeBufEntry;
+
+    pBuffer_p->txBufferNumber.pArg = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free Tx buffer
+
+This function releases the Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_freeTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UINT8* pBuffer;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    pBuffer = pBuffer_p->pBuffer;
+
+    // mark buffer as free, before actually freeing it
+    pBuffer_p->pBuffer = NULL;
+
+    OPLK_FREE(pBuffer);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change Rx filter setup
+
+This function changes the Rx filter setup. The parameter entryChanged_p
+selects the Rx filter entry that shall be changed and \p changeFlags_p determines
+the property.
+If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
+
+\note Rx filters are not supported by this driver!
+
+\param[in,out]  pFilter_p           Base pointer of Rx filter array
+\param[in]      count_p             Number of Rx filter array entries
+\param[in]      entryChanged_p      Index of Rx filter entry that shall be changed
+\param[in]      changeFlags_p       Bit mask that selects the changing Rx filter property
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
+                               UINT count_p,
+                               UINT entryChanged_p,
+                               UINT changeFlags_p)
+{
+    UNUSED_PARAMETER(pFilter_p);
+    UNUSED_PARAMETER(count_p);
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear multicast address entry
+
+This function removes the multicast entry from the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_clearRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set multicast address entry
+
+This function sets a multicast entry into the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffers
+
+This function copies the frames into the Tx ring and submits them to the kernel
+with a single blocking send call. The call returns after the kernel has
+transmitted the frames and released their Tx ring frames. The Tx handlers of
+all completed frames are called afterwards without holding the Tx ring lock.
+
+If the interface is down, the kernel does not take the frames. They are
+withdrawn from the Tx ring and reported as transmitted, otherwise the stack
+would hang.
+
+\param[in,out]  ppBuffer_p          Array of Tx buffer descriptors
+\param[in]      count_p             Number of Tx buffers in the array
+\param[out]     pSentCount_p        Number of leading Tx buffers of the array
+                                    which were handed over to the kernel
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sendTxBuffers(tEdrvTxBuffer* const* ppBuffer_p, UINT count_p, UINT* pSentCount_p)
+{
+    tOplkError              ret = kErrorOk;
+    tEdrvTxBuffer*          apCompleted[EDRV_TX_FRAME_COUNT];
+    UINT                    completedCount;
+    UINT                    queuedCount = 0;
+    UINT                    i;
+    tEdrvTxBuffer*          pBuffer;
+    struct tpacket2_hdr*    pHeader;
+
+#if (EDRV_USE_TTTX == TRUE)
+    if ((count_p > 0) && ppBuffer_p[0]->fLaunchTimeValid)
+        return sendLaunchTimeBuffers(ppBuffer_p, count_p, pSentCount_p);
+#endif
+
+    pthread_mutex_lock(&edrvInstance_l.txMutex);
+
+    for (i = 0; i < count_p; i++)
+    {
+        pBuffer = ppBuffer_p[i];
+
+        if ((pBuffer->txBufferNumber.pArg != NULL) ||
+            (pBuffer->txFrameSize > EDRV_MAX_FRAME_SIZE))
+        {
+            ret = kErrorInvalidOperation;
+            break;
+        }
+
+        pHeader = (struct tpacket2_hdr*)(edrvInstance_l.pTxRing +
+                                         (edrvInstance_l.txHead * EDRV_TX_FRAME_SIZE));
+        if (__atomic_load_n(&pHeader->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE)
+        {
+            ret = kErrorEdrvNoFreeTxDesc;
+            break;
+        }
+
+        OPLK_MEMCPY((UINT8*)pHeader + EDRV_TX_DATA_OFFSET, pBuffer->pBuffer, pBuffer->txFrameSize);
+        pHeader->tp_len = pBuffer->txFrameSize;
+
+        pBuffer->txBufferNumber.pArg = pHeader;
+        edrvInstance_l.apTxRingBuffer[edrvInstance_l.txHead] = pBuffer;
+
+        // Hand the frame over to the kernel after its content is complete
+        __atomic_store_n(&pHeader->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+
+        edrvInstance_l.txHead = (edrvInstance_l.txHead + 1) % EDRV_TX_FRAME_COUNT;
+        queuedCount++;
+    }
+
+    if (queuedCount > 0)
+    {
+        if (sendto(edrvInstance_l.txSocket, NULL, 0, 0, NULL, 0) < 0)
+        {
+            DEBUG_LVL_EDRV_TRACE("%s() sendto failed (%s)\n", __func__, strerror(errno));
+        }
+    }
+
+    completedCount = reclaimTxFrames(apCompleted);
+    completedCount += discardTxFrames(&apCompleted[completedCount]);
+
+    pthread_mutex_unlock(&edrvInstance_l.txMutex);
+
+    *pSentCount_p = queuedCount;
+
+    for (i = 0; i < completedCount; i++)
+    {
+        if (apCompleted[i]->pfnTxHandler != NULL)
+        {
+            apCompleted[i]->pfnTxHandler(apCompleted[i]);
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reclaim completed Tx ring frames
+
+This function walks the Tx ring from the oldest pending frame and reclaims all
+frames which were released by the kernel. The Tx ring lock must be held by the
+caller.
+
+\param[out]     ppCompleted_p       Array which receives the completed Tx buffers
+
+\return The function returns the number of completed Tx buffers.
+*/
+//------------------------------------------------------------------------------
+static UINT reclaimTxFrames(tEdrvTxBuffer** ppCompleted_p)
+{
+    UINT                    count = 0;
+    UINT32                  status;
+    struct tpacket2_hdr*    pHeader;
+    tEdrvTxBuffer*          pBuffer;
+
+    while (edrvInstance_l.txTail != edrvInstance_l.txHead)
+    {
+        pHeader = (struct tpacket2_hdr*)(edrvInstance_l.pTxRing +
+                                         (edrvInstance_l.txTail * EDRV_TX_FRAME_SIZE));
+        status = __atomic_load_n(&pHeader->tp_status, __ATOMIC_ACQUIRE);
+        if (status != TP_STATUS_AVAILABLE)
+            break;
+
+        pBuffer = edrvInstance_l.apTxRingBuffer[edrvInstance_l.txTail];
+        edrvInstance_l.apTxRingBuffer[edrvInstance_l.txTail] = NULL;
+        pBuffer->txBufferNumber.pArg = NULL;
+        ppCompleted_p[count++] = pBuffer;
+
+        edrvInstance_l.txTail = (edrvInstance_l.txTail + 1) % EDRV_TX_FRAME_COUNT;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Discard Tx ring frames not taken by the kernel
+
+This function withdraws the most recently queued frames which are still
+requested for sending, i.e. which the kernel refused to take. The Tx ring head
+is rewound, so that it stays aligned with the kernel's position in the ring.
+The Tx ring lock must be held by the caller.
+
+\param[out]     ppCompleted_p       Array which receives the discarded Tx buffers
+
+\return The function returns the number of discarded Tx buffers.
+*/
+//------------------------------------------------------------------------------
+static UINT discardTxFrames(tEdrvTxBuffer** ppCompleted_p)
+{
+    UINT                    count = 0;
+    UINT                    prevHead;
+    struct tpacket2_hdr*    pHeader;
+    tEdrvTxBuffer*          pBuffer;
+
+    while (edrvInstance_l.txHead != edrvInstance_l.txTail)
+    {
+        prevHead = (edrvInstance_l.txHead + EDRV_TX_FRAME_COUNT - 1) % EDRV_TX_FRAME_COUNT;
+        pHeader = (struct tpacket2_hdr*)(edrvInstance_l.pTxRing + (prevHead * EDRV_TX_FRAME_SIZE));
+        if (__atomic_load_n(&pHeader->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_SEND_REQUEST)
+            break;
+
+        __atomic_store_n(&pHeader->tp_status, TP_STATUS_AVAILABLE, __ATOMIC_RELEASE);
+
+        pBuffer = edrvInstance_l.apTxRingBuffer[prevHead];
+        edrvInstance_l.apTxRingBuffer[prevHead] = NULL;
+        pBuffer->txBufferNumber.pArg = NULL;
+        ppCompleted_p[count++] = pBuffer;
+
+        edrvInstance_l.txHead = prevHead;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process Rx ring block
+
+This function forwards all frames of a Rx ring block to the dllk. Frames sent
+by this node are filtered out.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+\param[in]      pBlock_p            Rx ring block to be processed
+*/
+//------------------------------------------------------------------------------
+static void processRxBlock(tEdrvInstance* pInstance_p, const struct tpacket_block_desc* pBlock_p)
+{
+    const struct tpacket3_hdr*  pFrame;
+    const struct sockaddr_ll*   pAddr;
+    tEdrvRxBuffer               rxBuffer;
+    UINT32                      i;
+
+    pFrame = (const struct tpacket3_hdr*)((const UINT8*)pBlock_p +
+                                          pBlock_p->hdr.bh1.offset_to_first_pkt);
+
+    for (i = 0; i < pBlock_p->hdr.bh1.num_pkts; i++)
+    {
+        pAddr = (const struct sockaddr_ll*)((const UINT8*)pFrame +
+                                            TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+
+        if (pAddr->sll_pkttype != PACKET_OUTGOING)
+        {   // filter out self generated traffic
+            rxBuffer.bufferInFrame = kEdrvBufferLastInFrame;
+            rxBuffer.rxFrameSize = pFrame->tp_snaplen;
+            rxBuffer.pBuffer = (UINT8*)pFrame + pFrame->tp_mac;
+            rxBuffer.pRxTimeStamp = NULL;
+
+            FTRACE_MARKER("%s RX", __func__);
+            pInstance_p->initParam.pfnRxHandler(&rxBuffer);
+        }
+
+        pFrame = (const struct tpacket3_hdr*)((const UINT8*)pFrame + pFrame->tp_next_offset);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Edrv worker thread
+
+This function implements the edrv worker thread. It processes the Rx ring
+blocks which were passed to user space and waits for new blocks otherwise.
+
+\param[in,out]  pArgument_p         User specific pointer pointing to the instance structure
+
+\return The function returns a thread error code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArgument_p)
+{
+    tEdrvInstance*              pInstance = (tEdrvInstance*)pArgument_p;
+    struct tpacket_block_desc*  pBlock;
+    struct pollfd               pollFd;
+
+    DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+    pollFd.fd = pInstance->rxSocket;
+    pollFd.events = POLLIN | POLLERR;
+    pollFd.revents = 0;
+
+    while (!__atomic_load_n(&pInstance->fStopThread, __ATOMIC_RELAXED))
+    {
+        pBlock = (struct tpacket_block_desc*)(pInstance->pRxRing +
+                                              (pInstance->curRxBlock * EDRV_RX_BLOCK_SIZE));
+
+        if ((__atomic_load_n(&pBlock->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+        {
+            poll(&pollFd, 1, EDRV_RX_POLL_TIMEOUT_MS);
+            continue;
+        }
+
+        processRxBlock(pInstance, pBlock);
+
+        // Return the block to the kernel
+        __atomic_store_n(&pBlock->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        pInstance->curRxBlock = (pInstance->curRxBlock + 1) % EDRV_RX_BLOCK_COUNT;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up Rx ring
+
+This function opens the packet socket for receiving, sets up its TPACKET_V3 Rx
+ring and binds it to the Ethernet interface in promiscuous mode.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupRxRing(void)
+{
+    int                 version = TPACKET_V3;
+    struct tpacket_req3 req;
+    struct sockaddr_ll  addr;
+    struct packet_mreq  mreq;
+    void*               pRing;
+#ifdef PACKET_IGNORE_OUTGOING
+    int                 ignoreOutgoing = 1;
+#endif
+
+    edrvInstance_l.rxSocket = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (edrvInstance_l.rxSocket < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    if (setsockopt(edrvInstance_l.rxSocket, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't select TPACKET_V3 (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(&req, 0, sizeof(req));
+    req.tp_block_size = EDRV_RX_BLOCK_SIZE;
+    req.tp_block_nr = EDRV_RX_BLOCK_COUNT;
+    req.tp_frame_size = EDRV_RX_FRAME_SIZE;
+    req.tp_frame_nr = (EDRV_RX_BLOCK_SIZE / EDRV_RX_FRAME_SIZE) * EDRV_RX_BLOCK_COUNT;
+    req.tp_retire_blk_tov = EDRV_RX_BLOCK_TIMEOUT_MS;
+    if (setsockopt(edrvInstance_l.rxSocket, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set up Rx ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    edrvInstance_l.rxRingSize = (size_t)req.tp_block_size * req.tp_block_nr;
+    pRing = mmap(NULL, edrvInstance_l.rxRingSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 edrvInstance_l.rxSocket, 0);
+    if (pRing == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't map Rx ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+    edrvInstance_l.pRxRing = (UINT8*)pRing;
+
+#ifdef PACKET_IGNORE_OUTGOING
+    // Frames sent by this node are not needed, the socket does not have to queue them
+    setsockopt(edrvInstance_l.rxSocket, SOL_PACKET, PACKET_IGNORE_OUTGOING,
+               &ignoreOutgoing, sizeof(ignoreOutgoing));
+#endif
+
+    OPLK_MEMSET(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = edrvInstance_l.ifIndex;
+    if (bind(edrvInstance_l.rxSocket, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't bind packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = edrvInstance_l.ifIndex;
+    mreq.mr_type = PACKET_MR_PROMISC;
+    if (setsockopt(edrvInstance_l.rxSocket, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set promiscuous mode\n", __func__);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up Tx ring
+
+This function opens the packet socket for transmitting and sets up its
+TPACKET_V2 Tx ring. The socket is bound to the Ethernet interface without a
+protocol, so it does not receive any frames.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupTxRing(void)
+{
+    int                 version = TPACKET_V2;
+    int                 discardMalformed = 1;
+    struct tpacket_req  req;
+    struct sockaddr_ll  addr;
+    struct timeval      timeout;
+    UINT                blockSize;
+    void*               pRing;
+
+    edrvInstance_l.txSocket = socket(AF_PACKET, SOCK_RAW, 0);
+    if (edrvInstance_l.txSocket < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    if (setsockopt(edrvInstance_l.txSocket, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't select TPACKET_V2 (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    // Skip malformed frames instead of stopping the Tx ring at them
+    setsockopt(edrvInstance_l.txSocket, SOL_PACKET, PACKET_LOSS, &discardMalformed, sizeof(discardMalformed));
+
+    // The blocks must be a multiple of the page size, the frames are contiguous
+    blockSize = (UINT)sysconf(_SC_PAGESIZE);
+    if (blockSize < EDRV_TX_FRAME_SIZE)
+        blockSize = EDRV_TX_FRAME_SIZE;
+
+    OPLK_MEMSET(&req, 0, sizeof(req));
+    req.tp_block_size = blockSize;
+    req.tp_block_nr = EDRV_TX_FRAME_COUNT / (blockSize / EDRV_TX_FRAME_SIZE);
+    req.tp_frame_size = EDRV_TX_FRAME_SIZE;
+    req.tp_frame_nr = EDRV_TX_FRAME_COUNT;
+    if (setsockopt(edrvInstance_l.txSocket, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set up Tx ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    edrvInstance_l.txRingSize = (size_t)req.tp_block_size * req.tp_block_nr;
+    pRing = mmap(NULL, edrvInstance_l.txRingSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 edrvInstance_l.txSocket, 0);
+    if (pRing == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't map Tx ring (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+    edrvInstance_l.pTxRing = (UINT8*)pRing;
+
+    // Limit the time a send call waits for the completion of the queued frames
+    timeout.tv_sec = 0;
+    timeout.tv_usec = EDRV_TX_SEND_TIMEOUT_MS * 1000;
+    setsockopt(edrvInstance_l.txSocket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    OPLK_MEMSET(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = 0;
+    addr.sll_ifindex = edrvInstance_l.ifIndex;
+    if (bind(edrvInstance_l.txSocket, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't bind packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close rings
+
+This function unmaps the Rx and Tx rings and closes the packet sockets.
+*/
+//------------------------------------------------------------------------------
+static void closeRings(void)
+{
+    if (edrvInstance_l.pRxRing != NULL)
+    {
+        munmap(edrvInstance_l.pRxRing, edrvInstance_l.rxRingSize);
+        edrvInstance_l.pRxRing = NULL;
+    }
+
+    if (edrvInstance_l.rxSocket >= 0)
+    {
+        close(edrvInstance_l.rxSocket);
+        edrvInstance_l.rxSocket = -1;
+    }
+
+    if (edrvInstance_l.pTxRing != NULL)
+    {
+        munmap(edrvInstance_l.pTxRing, edrvInstance_l.txRingSize);
+        edrvInstance_l.pTxRing = NULL;
+    }
+
+    if (edrvInstance_l.txSocket >= 0)
+    {
+        close(edrvInstance_l.txSocket);
+        edrvInstance_l.txSocket = -1;
+    }
+
+#if (EDRV_USE_TTTX == TRUE)
+    if (edrvInstance_l.launchSocket >= 0)
+    {
+        close(edrvInstance_l.launchSocket);
+        edrvInstance_l.launchSocket = -1;
+    }
+#endif
+}
+
+#if (EDRV_USE_TTTX == TRUE)
+//------------------------------------------------------------------------------
+/**
+\brief  Set up launch time socket
+
+This function opens the packet socket for frames with launch time. It enables
+SO_TXTIME and sets the socket priority, so that the frames can be directed to
+a transmit queue with an ETF queuing discipline.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupLaunchSocket(void)
+{
+    struct sock_txtime  txTime;
+    struct sockaddr_ll  addr;
+    int                 priority = EDRV_LAUNCH_PRIORITY;
+
+    edrvInstance_l.launchSocket = socket(AF_PACKET, SOCK_RAW, 0);
+    if (edrvInstance_l.launchSocket < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't open packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    OPLK_MEMSET(&txTime, 0, sizeof(txTime));
+    txTime.clockid = EDRV_LAUNCH_CLOCK;
+    txTime.flags = 0;
+    if (setsockopt(edrvInstance_l.launchSocket, SOL_SOCKET, SO_TXTIME, &txTime, sizeof(txTime)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't enable SO_TXTIME (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    if (setsockopt(edrvInstance_l.launchSocket, SOL_SOCKET, SO_PRIORITY, &priority, sizeof(priority)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set socket priority\n", __func__);
+    }
+
+    OPLK_MEMSET(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = 0;
+    addr.sll_ifindex = edrvInstance_l.ifIndex;
+    if (bind(edrvInstance_l.launchSocket, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't bind packet socket (%s)\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffers with launch time
+
+This function passes the frames together with their launch times to the kernel.
+Up to EDRV_LAUNCH_BATCH_SIZE frames are sent with a single system call. The Tx
+ring can't be used for these frames, because the kernel applies one launch time
+to all frames submitted with a single call.
+
+The frames are reported as transmitted as soon as they are queued in the
+kernel. If the kernel refuses a frame, sending stops at this frame, like with a
+full Tx ring. The refused frame and the following ones are not reported as
+transmitted.
+
+\param[in,out]  ppBuffer_p          Array of Tx buffer descriptors
+\param[in]      count_p             Number of Tx buffers in the array
+\param[out]     pSentCount_p        Number of leading Tx buffers of the array
+                                    which were queued in the kernel
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sendLaunchTimeBuffers(tEdrvTxBuffer* const* ppBuffer_p, UINT count_p, UINT* pSentCount_p)
+{
+    struct mmsghdr      aMsg[EDRV_LAUNCH_BATCH_SIZE];
+    struct iovec        aIov[EDRV_LAUNCH_BATCH_SIZE];
+    UINT64              aControl[EDRV_LAUNCH_BATCH_SIZE][CMSG_SPACE(sizeof(UINT64)) / sizeof(UINT64)];
+    struct cmsghdr*     pCmsg;
+    tEdrvTxBuffer*      pBuffer;
+    tOplkError          ret = kErrorOk;
+    UINT                batchCount;
+    UINT                sentCount;
+    UINT                i;
+    int                 result;
+
+    *pSentCount_p = 0;
+
+    while ((count_p > 0) && (ret == kErrorOk))
+    {
+        batchCount = (count_p < EDRV_LAUNCH_BATCH_SIZE) ? count_p : EDRV_LAUNCH_BATCH_SIZE;
+
+        OPLK_MEMSET(aMsg, 0, sizeof(aMsg[0]) * batchCount);
+        for (i = 0; i < batchCount; i++)
+        {
+            pBuffer = ppBuffer_p[i];
+
+            aIov[i].iov_base = pBuffer->pBuffer;
+            aIov[i].iov_len = pBuffer->txFrameSize;
+
+            aMsg[i].msg_hdr.msg_iov = &aIov[i];
+            aMsg[i].msg_hdr.msg_iovlen = 1;
+            aMsg[i].msg_hdr.msg_control = aControl[i];
+            aMsg[i].msg_hdr.msg_controllen = sizeof(aControl[i]);
+
+            pCmsg = CMSG_FIRSTHDR(&aMsg[i].msg_hdr);
+            pCmsg->cmsg_level = SOL_SOCKET;
+            pCmsg->cmsg_type = SCM_TXTIME;
+            pCmsg->cmsg_len = CMSG_LEN(sizeof(UINT64));
+            OPLK_MEMCPY(CMSG_DATA(pCmsg), &pBuffer->launchTime.nanoseconds, sizeof(UINT64));
+        }
+
+        sentCount = 0;
+        while (sentCount < batchCount)
+        {
+            result = sendmmsg(edrvInstance_l.launchSocket, &aMsg[sentCount], batchCount - sentCount, 0);
+            if (result <= 0)
+            {
+                DEBUG_LVL_EDRV_TRACE("%s() sendmmsg failed (%s)\n", __func__, strerror(errno));
+                ret = kErrorEdrvNoFreeTxDesc;
+                break;
+            }
+            sentCount += (UINT)result;
+        }
+
+        for (i = 0; i < sentCount; i++)
+        {
+            if (ppBuffer_p[i]->pfnTxHandler != NULL)
+            {
+                ppBuffer_p[i]->pfnTxHandler(ppBuffer_p[i]);
+            }
+        }
+
+        *pSentCount_p += sentCount;
+        ppBuffer_p += batchCount;
+        count_p -= batchCount;
+    }
+
+    return ret;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get Edrv MAC address
+
+This function gets the interface's MAC address.
+
+\param[in]      pIfName_p           Ethernet interface device name
+\param[out]     pMacAddr_p          Pointer to store MAC address
+*/
+//------------------------------------------------------------------------------
+static void getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p)
+{
+    INT             fd;
+    struct ifreq    ifr;
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    ifr.ifr_addr.sa_family = AF_INET;
+    strncpy(ifr.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    ioctl(fd, SIOCGIFHWADDR, &ifr);
+
+    close(fd);
+
+    OPLK_MEMCPY(pMacAddr_p, ifr.ifr_hwaddr.sa_data, 6);
+}
+
+/// \}
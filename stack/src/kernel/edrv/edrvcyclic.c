@@ -118,6 +118,7 @@ typedef struct
     UINT                    sampleCount;                    ///< Sample counter
     ULONGLONG               startCycleTimeStamp;            ///< Timestamp of the cycle start
     ULONGLONG               lastSlotTimeStamp;              ///< Timestamp of the last slot
+    ULONGLONG               firstPreqTimeStamp;             ///< Timestamp of the first PReq of the cycle
     tEdrvCyclicDiagnostics  diagnostics;                    ///< Diagnose data
 #endif
 } tEdrvcyclicInstance;
@@ -135,6 +136,9 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p);
 static tOplkError timerHdlSlotCb(const tTimerEventArg* pEventArg_p);
 #endif
 static tOplkError processTxBufferList(BOOL fCallSyncCb_p);
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+static void       checkFirstPreqSent(void);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -160,6 +164,10 @@ tOplkError edrvcyclic_init(void)
     edrvcyclicInstance_l.diagnostics.cycleTimeMin        = 0xFFFFFFFF;
     edrvcyclicInstance_l.diagnostics.usedCycleTimeMin    = 0xFFFFFFFF;
     edrvcyclicInstance_l.diagnostics.spareCycleTimeMin   = 0xFFFFFFFF;
+    histogram_clear(&edrvcyclicInstance_l.diagnostics.cycleTimeHistogram);
+    histogram_clear(&edrvcyclicInstance_l.diagnostics.usedCycleTimeHistogram);
+    histogram_clear(&edrvcyclicInstance_l.diagnostics.spareCycleTimeHistogram);
+    histogram_clear(&edrvcyclicInstance_l.diagnostics.socToPreqHistogram);
 #endif
 
     return kErrorOk;
@@ -345,6 +353,7 @@ tOplkError edrvcyclic_startCycle(BOOL fContinuousMode_p)
 
 #if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
     edrvcyclicInstance_l.lastSlotTimeStamp = 0;
+    edrvcyclicInstance_l.firstPreqTimeStamp = 0;
 #endif
 
 Exit:
@@ -460,6 +469,12 @@ tOplkError edrvcyclic_getDiagnostics(const tEdrvCyclicDiagnostics** ppDiagnostic
     // Check parameter validity
     ASSERT(ppDiagnostics_p != NULL);
 
+    // the overrun count is only valid while the cycle timer is running and
+    // if the timer implementation supports it
+    if (hrestimer_getOverrunCount(edrvcyclicInstance_l.timerHdlCycle,
+                                  &edrvcyclicInstance_l.diagnostics.cycleTimerOverrunCount) != kErrorOk)
+        edrvcyclicInstance_l.diagnostics.cycleTimerOverrunCount = 0;
+
     *ppDiagnostics_p = &edrvcyclicInstance_l.diagnostics;
 
     return kErrorOk;
@@ -491,6 +506,7 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
     UINT32          usedCycleTime;
     UINT32          spareCycleTime;
     ULONGLONG       startNewCycleTimeStamp;
+    ULONGLONG       firstPreqTimeStamp;
 #endif
 
     if (pEventArg_p->timerHdl.handle != edrvcyclicInstance_l.timerHdlCycle)
@@ -501,6 +517,10 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
 
 #if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
     startNewCycleTimeStamp = target_getCurrentTimestamp();
+
+    // the first PReq of the new cycle is sent below
+    firstPreqTimeStamp = edrvcyclicInstance_l.firstPreqTimeStamp;
+    edrvcyclicInstance_l.firstPreqTimeStamp = 0;
 #endif
 
     if (edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry] != NULL)
@@ -574,9 +594,18 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
         edrvcyclicInstance_l.diagnostics.spareCycleTimeMeanSum += spareCycleTime;
         edrvcyclicInstance_l.diagnostics.cycleCount++;
 
+        histogram_record(&edrvcyclicInstance_l.diagnostics.cycleTimeHistogram, cycleTime);
+        histogram_record(&edrvcyclicInstance_l.diagnostics.usedCycleTimeHistogram, usedCycleTime);
+        histogram_record(&edrvcyclicInstance_l.diagnostics.spareCycleTimeHistogram, spareCycleTime);
+        if (firstPreqTimeStamp != 0)
+        {
+            histogram_record(&edrvcyclicInstance_l.diagnostics.socToPreqHistogram,
+                             (UINT32)(firstPreqTimeStamp - edrvcyclicInstance_l.startCycleTimeStamp));
+        }
+
         // sample previous cycle if deviations exceed threshold
         if ((edrvcyclicInstance_l.diagnostics.sampleNum == 0) || /* sample first cycle for start time */
-            (abs(cycleTime - edrvcyclicInstance_l.cycleTimeUs * 1000) > EDRV_CYCLIC_SAMPLE_TH_CYCLE_TIME_DIFF_US * 1000) ||
+            (abs((INT32)(cycleTime - edrvcyclicInstance_l.cycleTimeUs * 1000)) > EDRV_CYCLIC_SAMPLE_TH_CYCLE_TIME_DIFF_US * 1000) ||
             (spareCycleTime < EDRV_CYCLIC_SAMPLE_TH_SPARE_TIME_US * 1000))
         {
             UINT uiSampleNo = edrvcyclicInstance_l.sampleCount;
@@ -656,6 +685,9 @@ static tOplkError timerHdlSlotCb(const tTimerEventArg* pEventArg_p)
     }
 
     edrvcyclicInstance_l.curTxBufferEntry++;
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+    checkFirstPreqSent();
+#endif
 
     ret = processTxBufferList(FALSE);
 
@@ -687,12 +719,21 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
     tOplkError          ret = kErrorOk;
     tEdrvTxBuffer*      pTxBuffer = NULL;
 #if (EDRV_USE_TTTX == TRUE)
+#if (EDRV_USE_TX_BATCH != TRUE)
     BOOL                fFirstPacket = TRUE;
+#else
+    UINT                index;
+#endif
     UINT64              launchTime;
     UINT64              cycleMin;
     UINT64              cycleMax;
     UINT64              currentMacTime = 0;
 #endif
+#if (EDRV_USE_TX_BATCH == TRUE)
+    tEdrvTxBuffer**     ppTxBuffer;
+    UINT                count;
+    UINT                sentCount;
+#endif
 
 #if (EDRV_USE_TTTX == TRUE)
     edrv_getMacTime(&currentMacTime);
@@ -715,6 +756,60 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
     cycleMin = launchTime;
     cycleMax = launchTime + (edrvcyclicInstance_l.cycleTimeUs * 1000ULL);
 
+#if (EDRV_USE_TX_BATCH == TRUE)
+    // Assign the launch times to the whole list and hand it over at once,
+    // the frames are paced by their launch times.
+    ppTxBuffer = &edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry];
+    for (count = 0; (pTxBuffer = ppTxBuffer[count]) != NULL; count++)
+    {
+        if (count > 0)
+            launchTime = launchTime + (UINT64)pTxBuffer->timeOffsetNs;
+
+        pTxBuffer->launchTime.nanoseconds = launchTime;
+
+        if ((pTxBuffer->launchTime.nanoseconds - cycleMin) > (cycleMax - cycleMin))
+        {
+            ret = kErrorEdrvTxListNotFinishedYet;
+            goto Exit;
+        }
+    }
+
+    if (count > 0)
+    {
+        // the launch times are only valid for this call
+        for (index = 0; index < count; index++)
+            ppTxBuffer[index]->fLaunchTimeValid = TRUE;
+
+        ret = edrv_sendTxBufferList(ppTxBuffer, count, &sentCount);
+
+        for (index = 0; index < count; index++)
+        {
+            ppTxBuffer[index]->launchTime.nanoseconds = 0;
+            ppTxBuffer[index]->fLaunchTimeValid = FALSE;
+        }
+
+        edrvcyclicInstance_l.curTxBufferEntry += sentCount;
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+        if (sentCount > 0)
+            checkFirstPreqSent();
+#endif
+
+        if (ret != kErrorOk)
+        {
+            // report the buffer which couldn't be sent
+            pTxBuffer = ppTxBuffer[sentCount];
+            goto Exit;
+        }
+
+        if (fCallSyncCb_p)
+        {
+            if (edrvcyclicInstance_l.pfnSyncCb != NULL)
+            {
+                ret = edrvcyclicInstance_l.pfnSyncCb();
+            }
+        }
+    }
+#else
     while ((pTxBuffer = edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry]) != NULL)
     {
         if (pTxBuffer == NULL)
@@ -738,18 +833,24 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
 
         if ((pTxBuffer->launchTime.nanoseconds - cycleMin) > (cycleMax - cycleMin))
         {
+            pTxBuffer->launchTime.nanoseconds = 0;
+            pTxBuffer->fLaunchTimeValid = FALSE;
             ret = kErrorEdrvTxListNotFinishedYet;
             goto Exit;
         }
 
         ret = edrv_sendTxBuffer(pTxBuffer);
-        if (ret != kErrorOk)
-            goto Exit;
 
         pTxBuffer->launchTime.nanoseconds = 0;
         pTxBuffer->fLaunchTimeValid = FALSE;
 
+        if (ret != kErrorOk)
+            goto Exit;
+
         edrvcyclicInstance_l.curTxBufferEntry++;
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+        checkFirstPreqSent();
+#endif
 
         if (fCallSyncCb_p)
         {
@@ -760,6 +861,7 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
             fCallSyncCb_p = FALSE;
         }
     }
+#endif
 
 #else /* (EDRV_USE_TTTX == TRUE) */
 
@@ -767,11 +869,34 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
     {
         if (pTxBuffer->timeOffsetNs == 0)
         {
+#if (EDRV_USE_TX_BATCH == TRUE)
+            // Submit all following frames without Tx delay at once. The first frame
+            // is sent alone if the sync callback has to be called right after it.
+            ppTxBuffer = &edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry];
+            count = 1;
+            if (!fCallSyncCb_p)
+            {
+                while ((ppTxBuffer[count] != NULL) && (ppTxBuffer[count]->timeOffsetNs == 0))
+                    count++;
+            }
+
+            ret = edrv_sendTxBufferList(ppTxBuffer, count, &sentCount);
+            if (ret != kErrorOk)
+            {
+                // report the buffer which couldn't be sent
+                pTxBuffer = ppTxBuffer[sentCount];
+                edrvcyclicInstance_l.curTxBufferEntry += sentCount;
+                goto Exit;
+            }
+
+            edrvcyclicInstance_l.curTxBufferEntry += count - 1;
+#else
             ret = edrv_sendTxBuffer(pTxBuffer);
             if (ret != kErrorOk)
             {
                 goto Exit;
             }
+#endif
         }
         else
         {
@@ -785,6 +910,9 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
         }
 
         edrvcyclicInstance_l.curTxBufferEntry++;
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+        checkFirstPreqSent();
+#endif
 
         if (fCallSyncCb_p)
         {
@@ -808,4 +936,24 @@ Exit:
     return ret;
 }
 
+#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Check if first PReq was sent
+
+This function stores the timestamp of the first PReq of the current cycle. The
+first PReq is the frame following the SoC in the Tx buffer list. It must be
+called after the current Tx buffer entry was advanced.
+*/
+//------------------------------------------------------------------------------
+static void checkFirstPreqSent(void)
+{
+    if ((edrvcyclicInstance_l.firstPreqTimeStamp == 0) &&
+        (edrvcyclicInstance_l.curTxBufferEntry > edrvcyclicInstance_l.curTxBufferList + 1))
+    {
+        edrvcyclicInstance_l.firstPreqTimeStamp = target_getCurrentTimestamp();
+    }
+}
+#endif
+
 /// \}
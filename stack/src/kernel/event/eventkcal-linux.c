@@ -6,6 +6,8 @@
 
 This file implements the kernel event handler CAL module for the Linux
 userspace platform. It uses the circular buffer interface for all event queues.
+The event thread, its doorbell and its statistics are provided by the Linux
+event thread library.
 
 \see eventkcalintf-circbuf.c
 
@@ -45,13 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <kernel/eventkcal.h>
 #include <kernel/eventkcalintf.h>
-#include <common/target.h>
-
-#include <time.h>
-#include <fcntl.h>
-#include <pthread.h>
-#include <semaphore.h>
-#include <common/target.h>
+#include <common/eventthread.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -60,7 +56,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define KERNEL_EVENT_THREAD_PRIORITY        55
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -90,10 +85,6 @@ CAL module.
 */
 typedef struct
 {
-    pthread_t               threadId;
-    BOOL                    fStopThread;
-    sem_t*                  semUserData;
-    sem_t*                  semKernelData;
     BOOL                    fInitialized;
 } tEventkCalInstance;
 
@@ -105,9 +96,6 @@ static tEventkCalInstance   instance_l;             ///< Instance variable of ke
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static void* eventThread(void* arg);
-static void  signalKernelEvent(void);
-static void  signalUserEvent(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -128,18 +116,10 @@ The function initializes the kernel event CAL module on Linux.
 //------------------------------------------------------------------------------
 tOplkError eventkcal_init(void)
 {
-    struct sched_param  schedParam;
-
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventkCalInstance));
 
-    sem_unlink("/semUserEvent");
-    sem_unlink("/semKernelEvent");
-
-    if ((instance_l.semUserData = sem_open("/semUserEvent", O_CREAT | O_RDWR, S_IRWXG, 0)) == SEM_FAILED)
-        goto Exit;
-
-    if ((instance_l.semKernelData = sem_open("/semKernelEvent", O_CREAT | O_RDWR, S_IRWXG, 0)) == SEM_FAILED)
-        goto Exit;
+    if (eventthread_init(TRUE) != kErrorOk)
+        return kErrorNoResource;
 
     if (eventkcal_initQueueCircbuf(kEventQueueK2U) != kErrorOk)
         goto Exit;
@@ -150,40 +130,26 @@ tOplkError eventkcal_init(void)
     if (eventkcal_initQueueCircbuf(kEventQueueKInt) != kErrorOk)
         goto Exit;
 
-    eventkcal_setSignalingCircbuf(kEventQueueK2U, signalUserEvent);
+    eventkcal_setSignalingCircbuf(kEventQueueK2U, eventthread_signalUserEvent);
 
-    eventkcal_setSignalingCircbuf(kEventQueueKInt, signalKernelEvent);
+    eventkcal_setSignalingCircbuf(kEventQueueKInt, eventthread_signalKernelEvent);
 
-    instance_l.fStopThread = FALSE;
-    if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
+    if (eventthread_start(kEventThreadKernel,
+                          eventkcal_processEventsCircbuf,
+                          kEventQueueKInt,
+                          kEventQueueU2K) != kErrorOk)
         goto Exit;
 
-    schedParam.sched_priority = KERNEL_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-                              __func__,
-                              schedParam.sched_priority);
-    }
-
-#if (defined(__GLIBC__) && __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12)
-    pthread_setname_np(instance_l.threadId, "oplk-eventk");
-#endif
-
     instance_l.fInitialized = TRUE;
     return kErrorOk;
 
 Exit:
-    if (instance_l.semUserData != SEM_FAILED)
-        sem_close(instance_l.semUserData);
-
-    if (instance_l.semKernelData != SEM_FAILED)
-        sem_close(instance_l.semKernelData);
-
     eventkcal_exitQueueCircbuf(kEventQueueK2U);
     eventkcal_exitQueueCircbuf(kEventQueueU2K);
     eventkcal_exitQueueCircbuf(kEventQueueKInt);
 
+    eventthread_exit();
+
     return kErrorNoResource;
 }
 
@@ -204,31 +170,15 @@ functions of the queue implementations for each used queue.
 //------------------------------------------------------------------------------
 tOplkError eventkcal_exit(void)
 {
-    UINT    i = 0;
-
     if (instance_l.fInitialized == TRUE)
     {
-        instance_l.fStopThread = TRUE;
-        while (instance_l.fStopThread == TRUE)
-        {
-            target_msleep(10);
-            if (i++ > 100)
-            {
-                DEBUG_LVL_EVENTK_TRACE("Event thread is not terminating, continue shutdown...!\n");
-                break;
-            }
-        }
+        eventthread_stop(kEventThreadKernel);
 
         eventkcal_exitQueueCircbuf(kEventQueueK2U);
         eventkcal_exitQueueCircbuf(kEventQueueU2K);
         eventkcal_exitQueueCircbuf(kEventQueueKInt);
 
-        sem_close(instance_l.semUserData);
-        sem_close(instance_l.semKernelData);
-
-        sem_unlink("/semUserEvent");
-        sem_unlink("/semKernelEvent");
-
+        eventthread_exit();
     }
     instance_l.fInitialized = FALSE;
 
@@ -297,80 +247,27 @@ void eventkcal_process(void)
     // Nothing to do, because we use threads
 }
 
-//============================================================================//
-//            P R I V A T E   F U N C T I O N S                               //
-//============================================================================//
-/// \name Private Functions
-/// \{
-
 //------------------------------------------------------------------------------
 /**
-\brief  Event handler thread function
+\brief  Get statistics of kernel event thread
 
-This function contains the main function for the event handler thread.
+The function returns the wakeup and throughput statistics of the kernel event
+thread.
 
-\param[in,out]  arg                 Thread parameter. Not used!
+\param[out]     pStatistics_p       Pointer to store the statistics.
 
-\return The function returns the thread exit code.
-*/
-//------------------------------------------------------------------------------
-static void* eventThread(void* arg)
-{
-    struct timespec         curTime, timeout;
-    tEventkCalInstance*     pInstance = (tEventkCalInstance*)arg;
-
-    while (!pInstance->fStopThread)
-    {
-        clock_gettime(CLOCK_REALTIME, &curTime);
-        timeout.tv_sec = 0;
-        timeout.tv_nsec = 50000 * 1000;
-        TIMESPECADD(&timeout, &curTime);
-
-        if (sem_timedwait(pInstance->semKernelData, &timeout) == 0)
-        {
-            /* first handle kernel internal events --> higher priority! */
-            if (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
-            {
-                eventkcal_processEventCircbuf(kEventQueueKInt);
-            }
-            else
-            {
-                if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
-                {
-                    eventkcal_processEventCircbuf(kEventQueueU2K);
-                }
-            }
-        }
-    }
-
-    pInstance->fStopThread = FALSE;
-    return 0;
-}
-
-//------------------------------------------------------------------------------
-/**
-\brief  Signal a user event
-
-This function signals that a user event was posted. It will be registered in
-the circular buffer library as signal callback function
+\ingroup module_eventkcal
 */
 //------------------------------------------------------------------------------
-static void signalUserEvent(void)
+void eventkcal_getStatistics(tEventCalStatistics* pStatistics_p)
 {
-    sem_post(instance_l.semUserData);
+    eventthread_getStatistics(kEventThreadKernel, pStatistics_p);
 }
 
-//------------------------------------------------------------------------------
-/**
-\brief  Signal a kernel event
-
-This function signals that a kernel event was posted. It will be registered in
-the circular buffer library as signal callback function
-*/
-//------------------------------------------------------------------------------
-static void signalKernelEvent(void)
-{
-    sem_post(instance_l.semKernelData);
-}
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
 
 /// \}
@@ -338,11 +338,19 @@ tOplkError pdok_configureChannel(const tPdoChannelConf* pChannelConf_p)
 
         pDestPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[pChannelConf_p->channelId];
 
+        // Remove the previous configuration of the channel from the lookup table
+        pdoklut_removeChannel(pdokInstance_g.aRxPdoLut, pDestPdoChannel->nodeId, pChannelConf_p->channelId);
+
         // copy channel configuration to local structure
         OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(pChannelConf_p->pdoChannel));
 
-        // Store channel ID for fast access
-        pdoklut_addChannel(pdokInstance_g.aRxPdoLut, pDestPdoChannel, pChannelConf_p->channelId);
+        // Store channel for fast access
+        if (pDestPdoChannel->nodeId != PDO_INVALID_NODE_ID)
+        {
+            ret = pdoklut_addChannel(pdokInstance_g.aRxPdoLut, pDestPdoChannel, pChannelConf_p->channelId);
+            if (ret != kErrorOk)
+                goto Exit;
+        }
 
 #if (NMT_MAX_NODE_ID > 0)
         if ((pDestPdoChannel->nodeId != PDO_INVALID_NODE_ID) &&
@@ -371,11 +379,19 @@ tOplkError pdok_configureChannel(const tPdoChannelConf* pChannelConf_p)
 
         pDestPdoChannel = &pdokInstance_g.pdoChannels.pTxPdoChannel[pChannelConf_p->channelId];
 
+        // Remove the previous configuration of the channel from the lookup table
+        pdoklut_removeChannel(pdokInstance_g.aTxPdoLut, pDestPdoChannel->nodeId, pChannelConf_p->channelId);
+
         // copy channel to local structure
         OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(pChannelConf_p->pdoChannel));
 
-        // Store channel ID for fast access
-        pdoklut_addChannel(pdokInstance_g.aTxPdoLut, pDestPdoChannel, pChannelConf_p->channelId);
+        // Store channel for fast access
+        if (pDestPdoChannel->nodeId != PDO_INVALID_NODE_ID)
+        {
+            ret = pdoklut_addChannel(pdokInstance_g.aTxPdoLut, pDestPdoChannel, pChannelConf_p->channelId);
+            if (ret != kErrorOk)
+                goto Exit;
+        }
     }
 
     pdokInstance_g.fRunning = FALSE;
@@ -400,14 +416,15 @@ The function processes a received RxPDO.
 //------------------------------------------------------------------------------
 tOplkError pdok_processRxPdo(const tPlkFrame* pFrame_p, UINT frameSize_p)
 {
-    tOplkError      ret = kErrorOk;
-    BYTE            frameData;
-    UINT            nodeId;
-    tMsgType        msgType;
-    tPdoChannel*    pPdoChannel;
-    UINT            channelId;
-    UINT8           index;
-    UINT16          pdoPayloadSize;
+    tOplkError              ret = kErrorOk;
+    BYTE                    frameData;
+    UINT                    nodeId;
+    tMsgType                msgType;
+    const tPdoklutEntry*    pLutEntry;
+    const tPdoklutChannel*  pChannel;
+    UINT                    rxPdoCount;
+    UINT16                  pdoPayloadSize;
+    UINT8                   pdoVersion;
 
     // Check parameter validity
     ASSERT(pFrame_p != NULL);
@@ -437,43 +454,43 @@ tOplkError pdok_processRxPdo(const tPlkFrame* pFrame_p, UINT frameSize_p)
 
     if (pdokInstance_g.fRunning)
     {
-        // Get PDO channel reference
-        index = 0;
-        while ((channelId = pdoklut_getChannel(pdokInstance_g.aRxPdoLut, index, nodeId)) != PDOKLUT_INVALID_CHANNEL)
-        {
-            index++;
-            pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[channelId];
-
-            // retrieve PDO version from frame
-            frameData = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
-            if ((pPdoChannel->mappingVersion & PLK_VERSION_MAIN) != (frameData & PLK_VERSION_MAIN))
-            {   // PDO versions do not match
-                // $$$ raise PDO error E_PDO_MAP_VERS
-                // terminate processing of this RPDO
-                goto Exit;
-            }
+        pLutEntry = &pdokInstance_g.aRxPdoLut[nodeId];
+        if (pLutEntry->channelCount == 0)
+            goto Exit;
 
-            // valid RPDO found
-            pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
-            if (pPdoChannel->nextChannelOffset > pdoPayloadSize)
-            {   // RPDO is too short
-                // $$$ raise PDO error E_PDO_SHORT_RX, set Ret
-                goto Exit;
-            }
+        // retrieve PDO version and size from frame
+        pdoVersion = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion) & PLK_VERSION_MAIN;
+        pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
 
-            /*
-            TRACE("%s() Channel:%d Node:%d MapObjectCnt:%d PdoSize:%d\n",
-                  __func__,
-                  channelId,
-                  nodeId,
-                  pPdoChannel->mappObjectCount,
-                  pPdoChannel->pdoSize);
-            */
-
-            pdokcal_writeRxPdo(channelId,
-                               &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset,
-                               pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+        if ((pdoVersion == pLutEntry->mappingVersion) &&
+            (pdoPayloadSize >= pLutEntry->pdoSize))
+        {   // all RPDOs of the frame are valid
+            rxPdoCount = pLutEntry->channelCount;
         }
+        else
+        {   // determine the valid RPDOs preceding the first invalid one
+            for (rxPdoCount = 0; rxPdoCount < pLutEntry->channelCount; rxPdoCount++)
+            {
+                pChannel = &pLutEntry->aChannel[rxPdoCount];
+
+                if ((pChannel->mappingVersion & PLK_VERSION_MAIN) != pdoVersion)
+                {   // PDO versions do not match
+                    // $$$ raise PDO error E_PDO_MAP_VERS
+                    // terminate processing of this RPDO
+                    break;
+                }
+
+                if ((pChannel->offset + pChannel->pdoSize) > pdoPayloadSize)
+                {   // RPDO is too short
+                    // $$$ raise PDO error E_PDO_SHORT_RX, set Ret
+                    break;
+                }
+            }
+        }
+
+        // Write all valid channels of this frame at once
+        if (rxPdoCount > 0)
+            pdokcal_writeRxPdos(&pFrame_p->data.pres.aPayload[0], pLutEntry->aChannel, rxPdoCount);
     }
 
 Exit:
@@ -580,14 +597,14 @@ This function copies a PDO into the specified frame.
 //---------------------------------------------------------------------------
 static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFlag_p)
 {
-    tOplkError          ret = kErrorOk;
-    BYTE                flag1;
-    UINT                nodeId;
-    tMsgType            msgType;
-    tPdoChannel*        pPdoChannel;
-    UINT                channelId;
-    UINT16              pdoSize;
-    UINT                index;
+    tOplkError              ret = kErrorOk;
+    BYTE                    flag1;
+    UINT                    nodeId;
+    tMsgType                msgType;
+    const tPdoklutEntry*    pLutEntry;
+    const tPdoklutChannel*  pChannel;
+    UINT16                  pdoSize;
+    UINT                    index;
 
     // set TPDO invalid, so that only fully processed TPDOs are sent as valid
     flag1 = ami_getUint8Le(&pFrame_p->data.pres.flag1);
@@ -608,40 +625,29 @@ static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFl
     if (pdokInstance_g.fRunning)
     {
         pdoSize = 0;
+        pLutEntry = &pdokInstance_g.aTxPdoLut[nodeId];
 
-        // Get PDO channel reference
-        index = 0;
-        while ((channelId = pdoklut_getChannel(pdokInstance_g.aTxPdoLut, index, nodeId)) != PDOKLUT_INVALID_CHANNEL)
+        if ((UINT32)(pLutEntry->pdoSize + 24) <= frameSize_p)
         {
-            index++;
-            pPdoChannel = &pdokInstance_g.pdoChannels.pTxPdoChannel[channelId];
-
-            // TRACE("%s() Channel:%d Node:%d MapObjectCnt:%d PdoSize:%d\n",
-            //      __func__,
-            //      channelId,
-            //      nodeId,
-            //      pPdoChannel->mappObjectCount,
-            //      pPdoChannel->pdoSize);
-
-            if ((UINT32)(pPdoChannel->nextChannelOffset + 24) <= frameSize_p)
+            for (index = 0; index < pLutEntry->channelCount; index++)
             {
-                // set PDO version in frame
-                ami_setUint8Le(&pFrame_p->data.pres.pdoVersion, pPdoChannel->mappingVersion);
+                pChannel = &pLutEntry->aChannel[index];
 
-                pdokcal_readTxPdo(channelId, &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset,
-                                  pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+                // set PDO version in frame
+                ami_setUint8Le(&pFrame_p->data.pres.pdoVersion, pChannel->mappingVersion);
 
-                // set PDO size in frame
-                pdoSize = pPdoChannel->nextChannelOffset;
-            }
-            else
-            {   // TPDO is too short or invalid
-                // $$$ raise PDO error, set ret
-                pdoSize = 0;
-                break;
+                pdokcal_readTxPdo(pChannel->channelId,
+                                  &pFrame_p->data.pres.aPayload[0] + pChannel->offset,
+                                  pChannel->pdoSize);
             }
-        }
 
+            // set PDO size in frame
+            pdoSize = pLutEntry->pdoSize;
+        }
+        else
+        {   // TPDO is too short or invalid
+            // $$$ raise PDO error, set ret
+        }
     }
     else
     {
@@ -207,51 +207,69 @@ void pdokcal_cleanupPdoMem(void)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Write RXPDO to PDO memory
+\brief  Write RXPDOs to PDO memory
 
-The function writes a received RXPDO into the PDO memory range.
+The function writes all RXPDO channels of a received frame into the PDO memory
+range. The data of all channels is copied into the write buffers first, then
+the buffers of all channels are published in a second pass. Thus, the channels
+of one frame become visible to the user layer together instead of interleaving
+the data copies with the buffer switches. The PDO lookup table lists each
+channel of a node only once, so each buffer is switched once per frame.
 
-\param[in]      channelId_p         Channel ID of PDO to write.
-\param[in]      pPayload_p          Pointer to received PDO payload.
-\param[in]      pdoSize_p           Size of received PDO.
+\param[in]      pPayload_p          Pointer to received frame payload.
+\param[in]      paRxPdo_p           Pointer to array of RXPDO channels to write.
+\param[in]      rxPdoCount_p        Number of RXPDO channels in the array.
 
 \return Returns an error code
 
 \ingroup module_pdokcal
 */
 //------------------------------------------------------------------------------
-tOplkError pdokcal_writeRxPdo(UINT channelId_p, const UINT8* pPayload_p, UINT16 pdoSize_p)
+tOplkError pdokcal_writeRxPdos(const UINT8* pPayload_p,
+                               const tPdoklutChannel* paRxPdo_p,
+                               UINT rxPdoCount_p)
 {
-    UINT8*          pPdo;
-    OPLK_ATOMIC_T   temp;
+    UINT8*              pPdo;
+    OPLK_ATOMIC_T       temp;
+    tPdoBufferInfo*     pChannelInfo;
+    UINT                i;
 
     // Check parameter validity
     ASSERT(pPayload_p != NULL);
+    ASSERT((paRxPdo_p != NULL) || (rxPdoCount_p == 0));
+
+    // Copy the data of all channels into their write buffers
+    for (i = 0; i < rxPdoCount_p; i++)
+    {
+        pChannelInfo = &pPdoMem_l->rxChannelInfo[paRxPdo_p[i].channelId];
+
+        // Invalidate data cache for addressed rxChannelInfo
+        OPLK_DCACHE_INVALIDATE(pChannelInfo, sizeof(tPdoBufferInfo));
 
-    // Invalidate data cache for addressed rxChannelInfo
-    OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->rxChannelInfo[channelId_p]), sizeof(tPdoBufferInfo));
+        pPdo = pTripleBuf_l[pChannelInfo->writeBuf] + pChannelInfo->channelOffset;
 
-    pPdo = pTripleBuf_l[pPdoMem_l->rxChannelInfo[channelId_p].writeBuf] +
-           pPdoMem_l->rxChannelInfo[channelId_p].channelOffset;
-    //TRACE("%s() chan:%d wi:%d\n", __func__, channelId_p, pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
+        OPLK_MEMCPY(pPdo, pPayload_p + paRxPdo_p[i].offset, paRxPdo_p[i].pdoSize);
 
-    OPLK_MEMCPY(pPdo, pPayload_p, pdoSize_p);
+        OPLK_DCACHE_FLUSH(pPdo, paRxPdo_p[i].pdoSize);
+    }
 
-    OPLK_DCACHE_FLUSH(pPdo, pdoSize_p);
+    // Publish the written buffers
+    for (i = 0; i < rxPdoCount_p; i++)
+    {
+        pChannelInfo = &pPdoMem_l->rxChannelInfo[paRxPdo_p[i].channelId];
 
-    temp = pPdoMem_l->rxChannelInfo[channelId_p].writeBuf;
-    OPLK_ATOMIC_EXCHANGE(&pPdoMem_l->rxChannelInfo[channelId_p].cleanBuf,
-                         temp,
-                         pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
+        temp = pChannelInfo->writeBuf;
+        OPLK_ATOMIC_EXCHANGE(&pChannelInfo->cleanBuf,
+                             temp,
+                             pChannelInfo->writeBuf);
 
-    pPdoMem_l->rxChannelInfo[channelId_p].newData = 1;
+        pChannelInfo->newData = 1;
 
-    // Flush data cache for variables changed in this function
-    OPLK_DCACHE_FLUSH(&(pPdoMem_l->rxChannelInfo[channelId_p].writeBuf), sizeof(OPLK_ATOMIC_T));
-    OPLK_DCACHE_FLUSH(&(pPdoMem_l->rxChannelInfo[channelId_p].newData), sizeof(UINT8));
+        // Flush data cache for variables changed in this function
+        OPLK_DCACHE_FLUSH(&pChannelInfo->writeBuf, sizeof(OPLK_ATOMIC_T));
+        OPLK_DCACHE_FLUSH(&pChannelInfo->newData, sizeof(UINT8));
+    }
 
-    //TRACE("%s() chan:%d new wi:%d\n", __func__, channelId_p, pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
-    //TRACE("%s() *pPayload_p:%02x\n", __func__, *pPayload_p);
     return kErrorOk;
 }
 
@@ -80,6 +80,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static UINT findChannel(const tPdoklutEntry* pEntry_p, UINT channelId_p);
+static void updateEntry(tPdoklutEntry* pEntry_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -107,18 +109,29 @@ void pdoklut_clear(tPdoklutEntry* pLut_p, UINT32 numEntries_p)
 
     for (i = 0; i < numEntries_p; ++i)
     {
+        pLut_p[i].channelCount = 0;
+        pLut_p[i].mappingVersion = PDOKLUT_INVALID_VERSION;
+        pLut_p[i].pdoSize = 0;
+
         for (j = 0; j < PDOKLUT_MAX_CHANNELS_PER_NODE; ++j)
         {
-            pLut_p[i].channelId[j] = PDOKLUT_INVALID_CHANNEL;
+            pLut_p[i].aChannel[j].channelId = PDOKLUT_INVALID_CHANNEL;
+            pLut_p[i].aChannel[j].mappingVersion = 0;
+            pLut_p[i].aChannel[j].offset = 0;
+            pLut_p[i].aChannel[j].pdoSize = 0;
         }
     }
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Add a new PDO channel to the lookup table
+\brief  Add a PDO channel to the lookup table
 
-This function adds a new PDO channel to the lookup table.
+This function adds a PDO channel to the lookup table. The channel information
+needed for transferring the channel is stored in the lookup table entry of the
+node and the expected PDO size and the common mapping version of the node are
+updated. If the channel is already contained in the entry of the node, its
+descriptor is replaced.
 
 \param[in,out]  pLut_p              Pointer to the PDO lookup table
 \param[in]      pPdoChannel_p       Pointer to the PDO channel which should be added to
@@ -126,6 +139,9 @@ This function adds a new PDO channel to the lookup table.
 \param[in]      channelId_p         Channel ID of the PDO channel to be added.
 
 \return The function returns a tOplkError error code.
+\retval kErrorOk                    The channel was added.
+\retval kErrorIllegalInstance       The node ID or the channel ID is invalid.
+\retval kErrorPdoTooManyPdos        The entry of the node is full.
 
 \ingroup module_pdoklut
 **/
@@ -134,64 +150,101 @@ tOplkError pdoklut_addChannel(tPdoklutEntry* pLut_p,
                               const tPdoChannel* pPdoChannel_p,
                               UINT channelId_p)
 {
-    tOplkError      ret = kErrorIllegalInstance;
-    int             i;
-    UINT8           nodeId;
+    tPdoklutEntry*      pEntry;
+    tPdoklutChannel*    pChannel;
+    UINT8               nodeId;
+    UINT                index;
 
     // Check parameter validity
     ASSERT(pLut_p != NULL);
     ASSERT(pPdoChannel_p != NULL);
 
     nodeId = pPdoChannel_p->nodeId;
-    if (nodeId == 255)
-        return ret;
+    if ((nodeId == PDO_INVALID_NODE_ID) || (channelId_p >= PDOKLUT_INVALID_CHANNEL))
+        return kErrorIllegalInstance;
+
+    pEntry = &pLut_p[nodeId];
 
-    for (i = 0; i < PDOKLUT_MAX_CHANNELS_PER_NODE; ++i)
+    index = findChannel(pEntry, channelId_p);
+    if (index == pEntry->channelCount)
     {
-        if (pLut_p[nodeId].channelId[i] == PDOKLUT_INVALID_CHANNEL)
+        if (pEntry->channelCount >= PDOKLUT_MAX_CHANNELS_PER_NODE)
         {
-            DEBUG_LVL_PDO_TRACE ("Adding PDO Lut channel:%d node:%d index:%d\n", channelId_p, nodeId, i);
-            pLut_p[nodeId].channelId[i] = channelId_p;
-            ret = kErrorOk;
-            break;
+            DEBUG_LVL_ERROR_TRACE("%s() Too many PDO channels for node %d, channel %d not added\n",
+                                  __func__,
+                                  nodeId,
+                                  channelId_p);
+            return kErrorPdoTooManyPdos;
         }
+
+        pEntry->channelCount++;
     }
 
-    return ret;
+    DEBUG_LVL_PDO_TRACE("Adding PDO Lut channel:%d node:%d index:%d\n",
+                        channelId_p,
+                        nodeId,
+                        index);
+
+    pChannel = &pEntry->aChannel[index];
+    pChannel->channelId = (UINT8)channelId_p;
+    pChannel->mappingVersion = pPdoChannel_p->mappingVersion;
+    pChannel->offset = pPdoChannel_p->offset;
+    pChannel->pdoSize = pPdoChannel_p->nextChannelOffset - pPdoChannel_p->offset;
+
+    updateEntry(pEntry);
+
+    return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get PDO channel from lookup table
-
-The function gets the PDO channel with index \p searchIndex_p from the
-PDO lookup table of node \p nodeId_p.
+\brief  Remove a PDO channel from the lookup table
 
-\param[in]      pLut_p              Pointer to the PDO lookup table.
-\param[in]      index_p             The index of the entry to get from the lookup table.
-\param[in]      nodeId_p            The node for which to get the channel.
+This function removes a PDO channel from the lookup table entry of a node. It
+is used if a channel is reconfigured for another node or disabled. The order
+of the remaining channels of the node is kept.
 
-\return The function returns the channel ID. If no more channel is found,
-        PDOKLUT_INVALID_CHANNEL is returned.
+\param[in,out]  pLut_p              Pointer to the PDO lookup table
+\param[in]      nodeId_p            Node ID the channel was configured for.
+\param[in]      channelId_p         Channel ID of the PDO channel to be removed.
 
 \ingroup module_pdoklut
 **/
 //------------------------------------------------------------------------------
-UINT pdoklut_getChannel(const tPdoklutEntry* pLut_p, UINT8 index_p, UINT8 nodeId_p)
+void pdoklut_removeChannel(tPdoklutEntry* pLut_p,
+                           UINT8 nodeId_p,
+                           UINT channelId_p)
 {
+    tPdoklutEntry*  pEntry;
+    UINT            index;
+
     // Check parameter validity
     ASSERT(pLut_p != NULL);
 
-    if (index_p >= PDOKLUT_MAX_CHANNELS_PER_NODE)
-    {
-        DEBUG_LVL_PDO_TRACE("%s() INVALID CHANNEL: index:%d nodeId:%d\n", __func__, index_p, nodeId_p);
-        return PDOKLUT_INVALID_CHANNEL;
-    }
+    if (nodeId_p == PDO_INVALID_NODE_ID)
+        return;
 
-    DEBUG_LVL_PDO_TRACE ("%s() channel:%d index:%d nodeId:%d\n",
-            __func__, pLut_p[nodeId_p].channelId[index_p], index_p, nodeId_p);
+    pEntry = &pLut_p[nodeId_p];
 
-   return pLut_p[nodeId_p].channelId[index_p];
+    index = findChannel(pEntry, channelId_p);
+    if (index == pEntry->channelCount)
+        return;
+
+    DEBUG_LVL_PDO_TRACE("Removing PDO Lut channel:%d node:%d index:%d\n",
+                        channelId_p,
+                        nodeId_p,
+                        index);
+
+    pEntry->channelCount--;
+    for (; index < pEntry->channelCount; index++)
+        pEntry->aChannel[index] = pEntry->aChannel[index + 1];
+
+    pEntry->aChannel[index].channelId = PDOKLUT_INVALID_CHANNEL;
+    pEntry->aChannel[index].mappingVersion = 0;
+    pEntry->aChannel[index].offset = 0;
+    pEntry->aChannel[index].pdoSize = 0;
+
+    updateEntry(pEntry);
 }
 
 //============================================================================//
@@ -200,4 +253,62 @@ UINT pdoklut_getChannel(const tPdoklutEntry* pLut_p, UINT8 index_p, UINT8 nodeId
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Find a PDO channel in a lookup table entry
+
+\param[in]      pEntry_p            Pointer to the lookup table entry of the node.
+\param[in]      channelId_p         Channel ID of the PDO channel.
+
+\return The function returns the index of the channel in the entry or the
+        channel count of the entry if the channel is not contained.
+**/
+//------------------------------------------------------------------------------
+static UINT findChannel(const tPdoklutEntry* pEntry_p, UINT channelId_p)
+{
+    UINT    index;
+
+    for (index = 0; index < pEntry_p->channelCount; index++)
+    {
+        if (pEntry_p->aChannel[index].channelId == channelId_p)
+            break;
+    }
+
+    return index;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update the frame validation values of a lookup table entry
+
+The function recalculates the expected PDO size and the common mapping version
+of a node from its channel descriptors.
+
+\param[in,out]  pEntry_p            Pointer to the lookup table entry of the node.
+**/
+//------------------------------------------------------------------------------
+static void updateEntry(tPdoklutEntry* pEntry_p)
+{
+    UINT                    index;
+    const tPdoklutChannel*  pChannel;
+    UINT8                   mainVersion;
+
+    pEntry_p->mappingVersion = PDOKLUT_INVALID_VERSION;
+    pEntry_p->pdoSize = 0;
+
+    for (index = 0; index < pEntry_p->channelCount; index++)
+    {
+        pChannel = &pEntry_p->aChannel[index];
+        mainVersion = pChannel->mappingVersion & PLK_VERSION_MAIN;
+
+        if (index == 0)
+            pEntry_p->mappingVersion = mainVersion;
+        else if (pEntry_p->mappingVersion != mainVersion)
+            pEntry_p->mappingVersion = PDOKLUT_INVALID_VERSION;
+
+        if ((pChannel->offset + pChannel->pdoSize) > pEntry_p->pdoSize)
+            pEntry_p->pdoSize = pChannel->offset + pChannel->pdoSize;
+    }
+}
+
 /// \}
@@ -419,6 +419,31 @@ void hrestimer_setExtSyncIrqTime(tTimestamp time_p)
 #endif //TIMER_USE_EXT_SYNC_INT
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get overrun count of a timer
+
+This function returns the number of expirations a running timer has missed.
+Missed expirations aren't counted by this timer implementation.
+
+\param[in]      timerHdl_p          Handle of the timer.
+\param[out]     pOverrunCount_p     Pointer to store the overrun count.
+
+\return Returns a tOplkError error code.
+\retval kErrorApiNotSupported       The overrun count is not supported.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_getOverrunCount(tTimerHdl timerHdl_p,
+                                     UINT32* pOverrunCount_p)
+{
+    UNUSED_PARAMETER(timerHdl_p);
+    UNUSED_PARAMETER(pOverrunCount_p);
+
+    return kErrorApiNotSupported;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
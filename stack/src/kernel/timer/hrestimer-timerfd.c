@@ -0,0 +1,713 @@
+/**
+********************************************************************************
+\file   hrestimer-timerfd.c
+
+\brief  High-resolution timer module for Linux using timerfd
+
+This module is the target specific implementation of the high-resolution
+timer module for Linux userspace. It uses one timerfd per timer which is armed
+with absolute expiration times on CLOCK_MONOTONIC. The deadlines of continuous
+timers are calculated from the start time of the timer, therefore the timer
+does not drift if the timer thread is woken up late.
+
+\ingroup module_hrestimer
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/hrestimer.h>
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/timerfd.h>
+#include <sys/syscall.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TIMER_COUNT             2           ///< number of high-resolution timers
+#define TIMER_MIN_VAL_SINGLE    20000       ///< minimum timer interval for single timeouts
+#define TIMER_MIN_VAL_CYCLE     100000      ///< minimum timer interval for continuous timeouts
+
+/* The timer thread is woken up HRESTIMER_BUSY_POLL_NS before the deadline
+ * and polls the clock for the remaining time. This hides the wakeup latency
+ * of the thread at the cost of CPU time. */
+#ifndef HRESTIMER_BUSY_POLL_NS
+#define HRESTIMER_BUSY_POLL_NS  0
+#endif
+
+/* macros for timer handles */
+#define TIMERHDL_MASK           0x0FFFFFFF
+#define TIMERHDL_SHIFT          28
+#define HDL_TO_IDX(hdl)         ((hdl >> TIMERHDL_SHIFT) - 1)
+#define HDL_INIT(idx)           ((idx + 1) << TIMERHDL_SHIFT)
+#define HDL_INC(hdl)            (((hdl + 1) & TIMERHDL_MASK) | (hdl & ~TIMERHDL_MASK))
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//          P R I V A T E   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  High-resolution timer information structure
+
+The structure contains all necessary information for a high-resolution timer.
+*/
+typedef struct
+{
+    tTimerEventArg      eventArg;           ///< Event argument
+    tTimerkCallback     pfnCallback;        ///< Pointer to timer callback function
+    int                 timerFd;            ///< File descriptor of the timerfd
+    UINT64              startTime;          ///< Start time of the timer in nanoseconds
+    UINT64              period;             ///< Timer period in nanoseconds
+    UINT64              expirationCount;    ///< Number of expirations since the timer was started
+    UINT32              overrunCount;       ///< Number of missed expirations since the timer was started
+    BOOL                fContinue;          ///< Flag determines if timer will be restarted continuously
+} tHresTimerInfo;
+
+/**
+\brief  High-resolution timer instance
+
+The structure defines a high-resolution timer module instance.
+*/
+typedef struct
+{
+    tHresTimerInfo      aTimerInfo[TIMER_COUNT];    ///< Array with timer information for a set of timers
+    pthread_t           threadId;                   ///< Timer thread Id
+    pthread_mutex_t     mutex;                      ///< Mutex protecting the timer information
+    BOOL                fTerminate;                 ///< Thread termination flag
+} tHresTimerInstance;
+
+//------------------------------------------------------------------------------
+// module local vars
+//------------------------------------------------------------------------------
+static tHresTimerInstance       hresTimerInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*  timerThread(void* pParm_p);
+static void   processTimer(tHresTimerInfo* pTimerInfo_p);
+static void   armTimer(tHresTimerInfo* pTimerInfo_p, UINT64 expirationTime_p);
+static void   closeTimers(void);
+static UINT64 getCurrentTime(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief    Initialize high-resolution timer module
+
+The function initializes the high-resolution timer module
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_init(void)
+{
+    UINT                index;
+    struct sched_param  schedParam;
+    tHresTimerInfo*     pTimerInfo;
+
+    OPLK_MEMSET(&hresTimerInstance_l, 0, sizeof(hresTimerInstance_l));
+
+    for (index = 0; index < TIMER_COUNT; index++)
+        hresTimerInstance_l.aTimerInfo[index].timerFd = -1;
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+
+        pTimerInfo->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (pTimerInfo->timerFd < 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() Couldn't create timerfd! (%d)\n", __func__, errno);
+            closeTimers();
+            return kErrorNoResource;
+        }
+    }
+
+    if (pthread_mutex_init(&hresTimerInstance_l.mutex, NULL) != 0)
+    {
+        closeTimers();
+        return kErrorNoResource;
+    }
+
+    if (pthread_create(&hresTimerInstance_l.threadId, NULL,
+                       timerThread, NULL) != 0)
+    {
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        closeTimers();
+        return kErrorNoResource;
+    }
+
+    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
+    if (pthread_setschedparam(hresTimerInstance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+        hrestimer_exit();
+        return kErrorNoResource;
+    }
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+    pthread_setname_np(hresTimerInstance_l.threadId, "oplk-hrtimer");
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Shut down high-resolution timer module
+
+The function shuts down the high-resolution timer module.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_exit(void)
+{
+    tHresTimerInfo*     pTimerInfo;
+    UINT                index;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+        pTimerInfo->eventArg.timerHdl.handle = 0;
+        pTimerInfo->pfnCallback = NULL;
+        pTimerInfo->fContinue = FALSE;
+    }
+
+    // wake up the thread with an immediate expiration
+    hresTimerInstance_l.fTerminate = TRUE;
+    armTimer(&hresTimerInstance_l.aTimerInfo[0], 1);
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    /* wait until thread terminates */
+    DEBUG_LVL_TIMERH_TRACE("%s() Waiting for thread to exit...\n", __func__);
+
+    pthread_join(hresTimerInstance_l.threadId, NULL);
+    DEBUG_LVL_TIMERH_TRACE("%s() Thread exited!\n", __func__);
+
+    pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+    closeTimers();
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Modify a high-resolution timer
+
+The function modifies the timeout of the timer with the specified handle.
+If the handle to which the pointer points to is zero, the timer must be created
+first. If it is not possible to stop the old timer, this function always assures
+that the old timer does not trigger the callback function with the same handle
+as the new timer. That means the callback function must check the passed handle
+with the one returned by this function. If these are unequal, the call can be
+discarded.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+\param[in]      time_p              Relative timeout in [ns].
+\param[in]      pfnCallback_p       Callback function, which is called when timer expires.
+                                    (The function is called mutually exclusive with
+                                    the Edrv callback functions (Rx and Tx)).
+\param[in]      argument_p          User-specific argument.
+\param[in]      fContinue_p         If TRUE, the callback function will be called continuously.
+                                    Otherwise, it is a one-shot timer.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_modifyTimer(tTimerHdl* pTimerHdl_p,
+                                 ULONGLONG time_p,
+                                 tTimerkCallback pfnCallback_p,
+                                 ULONG argument_p,
+                                 BOOL fContinue_p)
+{
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    // check pointer to handle
+    if (pTimerHdl_p == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Invalid timer handle\n", __func__);
+        return kErrorTimerInvalidHandle;
+    }
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet -> search free timer info structure
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[0];
+        for (index = 0; index < TIMER_COUNT; index++, pTimerInfo++)
+        {
+            if (pTimerInfo->eventArg.timerHdl.handle == 0)
+            {   // free structure found
+                break;
+            }
+        }
+        if (index >= TIMER_COUNT)
+        {   // no free structure found
+            pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid timer index:%d\n", __func__, index);
+            return kErrorTimerNoTimerCreated;
+        }
+        pTimerInfo->eventArg.timerHdl.handle = HDL_INIT(index);
+    }
+    else
+    {
+        index = HDL_TO_IDX(*pTimerHdl_p);
+        if (index >= TIMER_COUNT)
+        {   // invalid handle
+            pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid timer index:%d\n", __func__, index);
+            return kErrorTimerInvalidHandle;
+        }
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    }
+
+    // increase too small time values
+    if (fContinue_p != FALSE)
+    {
+        if (time_p < TIMER_MIN_VAL_CYCLE)
+            time_p = TIMER_MIN_VAL_CYCLE;
+    }
+    else
+    {
+        if (time_p < TIMER_MIN_VAL_SINGLE)
+            time_p = TIMER_MIN_VAL_SINGLE;
+    }
+
+    /* increment timer handle
+     * (if timer expires right after this statement, the user
+     * would detect an unknown timer handle and discard it) */
+    pTimerInfo->eventArg.timerHdl.handle = HDL_INC(pTimerInfo->eventArg.timerHdl.handle);
+    *pTimerHdl_p = pTimerInfo->eventArg.timerHdl.handle;
+
+    /* initialize timer info */
+    pTimerInfo->eventArg.argument.value = argument_p;
+    pTimerInfo->pfnCallback = pfnCallback_p;
+    pTimerInfo->fContinue = fContinue_p;
+    pTimerInfo->period = time_p;
+    pTimerInfo->startTime = getCurrentTime();
+    pTimerInfo->expirationCount = 0;
+    pTimerInfo->overrunCount = 0;
+
+    DEBUG_LVL_TIMERH_TRACE("%s() timer:%lx timeout=%llu\n", __func__,
+                           pTimerInfo->eventArg.timerHdl.handle,
+                           time_p);
+
+    armTimer(pTimerInfo, pTimerInfo->startTime + time_p);
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Delete a high-resolution timer
+
+The function deletes a created high-resolution timer. The timer is specified
+by its timer handle. After deleting, the handle is reset to zero.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet
+        return kErrorOk;
+    }
+
+    index = HDL_TO_IDX(*pTimerHdl_p);
+    if (index >= TIMER_COUNT)
+    {   // invalid handle
+        return kErrorTimerInvalidHandle;
+    }
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Deleting timer:%lx\n", __func__, *pTimerHdl_p);
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    if (pTimerInfo->eventArg.timerHdl.handle != *pTimerHdl_p)
+    {   // invalid handle
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+        return kErrorOk;
+    }
+
+    if (pTimerInfo->overrunCount != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Timer %lx missed %u of %llu expirations!\n",
+                              __func__,
+                              pTimerInfo->eventArg.timerHdl.handle,
+                              pTimerInfo->overrunCount,
+                              pTimerInfo->expirationCount);
+    }
+
+    // a value of 0 disarms the timer
+    armTimer(pTimerInfo, 0);
+
+    *pTimerHdl_p = 0;
+    pTimerInfo->eventArg.timerHdl.handle = 0;
+    pTimerInfo->pfnCallback = NULL;
+    pTimerInfo->fContinue = FALSE;
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get overrun count of a high-resolution timer
+
+The function returns the number of expirations a running timer has missed
+since it was started with hrestimer_modifyTimer(). Missed expirations occur if
+the timer thread is not scheduled in time and the callback function is called
+only once for several expirations.
+
+\param[in]      timerHdl_p          Handle of the timer.
+\param[out]     pOverrunCount_p     Pointer to store the overrun count.
+
+\return Returns a tOplkError error code.
+\retval kErrorOk                    The overrun count is returned.
+\retval kErrorTimerInvalidHandle    The timer handle is invalid or the timer
+                                    is not running.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_getOverrunCount(tTimerHdl timerHdl_p,
+                                     UINT32* pOverrunCount_p)
+{
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+    tOplkError          ret = kErrorOk;
+
+    if (pOverrunCount_p == NULL)
+        return kErrorInvalidInstanceParam;
+
+    index = HDL_TO_IDX(timerHdl_p);
+    if ((timerHdl_p == 0) || (index >= TIMER_COUNT))
+        return kErrorTimerInvalidHandle;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    if (pTimerInfo->eventArg.timerHdl.handle == timerHdl_p)
+        *pOverrunCount_p = pTimerInfo->overrunCount;
+    else
+        ret = kErrorTimerInvalidHandle;
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Control external synchronization interrupt
+
+This function enables/disables the external synchronization interrupt. If the
+external synchronization interrupt is not supported, the call is ignored.
+
+\param[in]      fEnable_p           Flag determines if sync should be enabled or disabled.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_controlExtSyncIrq(BOOL fEnable_p)
+{
+    UNUSED_PARAMETER(fEnable_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set external synchronization interrupt time
+
+This function sets the time when the external synchronization interrupt shall
+be triggered to synchronize the host processor. If the external synchronization
+interrupt is not supported, the call is ignored.
+
+\param[in]      time_p              Time when the sync shall be triggered
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_setExtSyncIrqTime(tTimestamp time_p)
+{
+    UNUSED_PARAMETER(time_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief    Timer thread function
+
+The function provides the main function of the timer thread. It waits until
+one of the timerfds expires and processes the expired timers. All timer
+callbacks are called from this thread, so they are mutually exclusive.
+
+\param[in,out]  pParm_p             Thread parameter (unused!)
+
+\return Returns a void* as specified by the pthread interface but it is not used!
+*/
+//------------------------------------------------------------------------------
+static void* timerThread(void* pParm_p)
+{
+    struct pollfd   aPollFd[TIMER_COUNT];
+    UINT            index;
+    int             ret;
+
+    UNUSED_PARAMETER(pParm_p);
+
+    DEBUG_LVL_TIMERH_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        aPollFd[index].fd = hresTimerInstance_l.aTimerInfo[index].timerFd;
+        aPollFd[index].events = POLLIN;
+    }
+
+    while (!hresTimerInstance_l.fTerminate)
+    {
+        ret = poll(aPollFd, TIMER_COUNT, -1);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            DEBUG_LVL_ERROR_TRACE("%s() poll() failed (%d)\n", __func__, errno);
+            break;
+        }
+
+        for (index = 0; index < TIMER_COUNT; index++)
+        {
+            if ((aPollFd[index].revents & POLLIN) != 0)
+                processTimer(&hresTimerInstance_l.aTimerInfo[index]);
+        }
+    }
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Exiting!\n", __func__);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Process an expired timer
+
+The function reads the expiration count of the timerfd and calculates the
+deadline of the current expiration from the start time of the timer. If
+expirations were missed, they are counted as overruns and the callback
+function is only called once. If busy polling is enabled, the function waits
+for the deadline before the callback function is called.
+
+\param[in,out]  pTimerInfo_p        Pointer to the timer information structure.
+*/
+//------------------------------------------------------------------------------
+static void processTimer(tHresTimerInfo* pTimerInfo_p)
+{
+    UINT64              expirations;
+    UINT64              deadline;
+    tTimerEventArg      eventArg;
+    tTimerkCallback     pfnCallback;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    // the timer may have been modified or deleted since poll() returned
+    if (read(pTimerInfo_p->timerFd, &expirations, sizeof(expirations)) != sizeof(expirations))
+    {
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+        return;
+    }
+
+    if (expirations > 1)
+    {
+        pTimerInfo_p->overrunCount += (UINT32)(expirations - 1);
+        DEBUG_LVL_TIMERH_TRACE("%s() Timer %lx missed %llu expirations\n",
+                               __func__,
+                               pTimerInfo_p->eventArg.timerHdl.handle,
+                               expirations - 1);
+    }
+
+    pTimerInfo_p->expirationCount += expirations;
+    deadline = pTimerInfo_p->startTime + (pTimerInfo_p->expirationCount * pTimerInfo_p->period);
+
+    pfnCallback = pTimerInfo_p->pfnCallback;
+    eventArg = pTimerInfo_p->eventArg;
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+#if (HRESTIMER_BUSY_POLL_NS != 0)
+    while (getCurrentTime() < deadline)
+        ;
+#else
+    UNUSED_PARAMETER(deadline);
+#endif
+
+    if (pfnCallback != NULL)
+        pfnCallback(&eventArg);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Arm timerfd
+
+The function arms the timerfd of a timer with an absolute expiration time. The
+first expiration is advanced by the busy poll time. Continuous timers are
+armed with their period, so the kernel calculates all further expirations from
+the first one. The mutex must be locked by the caller.
+
+\param[in,out]  pTimerInfo_p        Pointer to the timer information structure.
+\param[in]      expirationTime_p    Absolute expiration time in nanoseconds. If
+                                    it is 0, the timerfd is disarmed.
+*/
+//------------------------------------------------------------------------------
+static void armTimer(tHresTimerInfo* pTimerInfo_p, UINT64 expirationTime_p)
+{
+    struct itimerspec   absTime;
+
+    OPLK_MEMSET(&absTime, 0, sizeof(absTime));
+
+    if (expirationTime_p != 0)
+    {
+        if (expirationTime_p > HRESTIMER_BUSY_POLL_NS)
+            expirationTime_p -= HRESTIMER_BUSY_POLL_NS;
+
+        absTime.it_value.tv_sec = (time_t)(expirationTime_p / 1000000000ULL);
+        absTime.it_value.tv_nsec = (long)(expirationTime_p % 1000000000ULL);
+
+        if (pTimerInfo_p->fContinue)
+        {
+            absTime.it_interval.tv_sec = (time_t)(pTimerInfo_p->period / 1000000000ULL);
+            absTime.it_interval.tv_nsec = (long)(pTimerInfo_p->period % 1000000000ULL);
+        }
+    }
+
+    if (timerfd_settime(pTimerInfo_p->timerFd, TFD_TIMER_ABSTIME, &absTime, NULL) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() timerfd_settime() failed (%d)\n", __func__, errno);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Close timerfds
+
+The function closes the timerfds of all timers.
+*/
+//------------------------------------------------------------------------------
+static void closeTimers(void)
+{
+    UINT    index;
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        if (hresTimerInstance_l.aTimerInfo[index].timerFd >= 0)
+        {
+            close(hresTimerInstance_l.aTimerInfo[index].timerFd);
+            hresTimerInstance_l.aTimerInfo[index].timerFd = -1;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get current time
+
+The function returns the current time of the monotonic clock.
+
+\return The function returns the time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getCurrentTime(void)
+{
+    struct timespec currentTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    return ((UINT64)currentTime.tv_sec * 1000000000ULL) + (UINT64)currentTime.tv_nsec;
+}
+
+/// \}
@@ -79,6 +79,7 @@ The following structure defines the instance variable of the kernel timesync mod
 typedef struct
 {
     UINT32                  syncEventCycle;     ///< Synchronization event cycle
+    tTimesyncSyncInfo       syncInfo;           ///< Information of the current sync event
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     tTimesyncSharedMemory*  pSharedMemory;      ///< Time sync shared memory
 #endif
@@ -205,8 +206,11 @@ tOplkError timesynck_sendSyncEvent(void)
     tOplkError      ret = kErrorOk;
     static UINT32   cycleCnt = 0;
 
+    timesynckInstance_l.syncInfo.cycleCount++;
+
     if ((++cycleCnt == timesynckInstance_l.syncEventCycle))
     {
+        timesynckInstance_l.syncInfo.syncEventCount++;
         ret = timesynckcal_sendSyncEvent();
 
         cycleCnt = 0;
@@ -253,6 +257,26 @@ tOplkError timesynck_process(const tEvent* pEvent_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get sync event information
+
+The function returns the information of the current sync event. It is used by
+the CAL to forward the cycle counter and the SoC time with the sync event.
+
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+
+\ingroup module_timesynck
+*/
+//------------------------------------------------------------------------------
+void timesynck_getSyncInfo(tTimesyncSyncInfo* pSyncInfo_p)
+{
+    // Check parameter validity
+    ASSERT(pSyncInfo_p != NULL);
+
+    OPLK_MEMCPY(pSyncInfo_p, &timesynckInstance_l.syncInfo, sizeof(tTimesyncSyncInfo));
+}
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 //------------------------------------------------------------------------------
 /**
@@ -276,6 +300,9 @@ tOplkError timesynck_setSocTime(const tTimesyncSocTime* pSocTime_p)
     // Check parameter validity
     ASSERT(pSocTime_p != NULL);
 
+    // Keep the SoC time for the sync event information
+    OPLK_MEMCPY(&timesynckInstance_l.syncInfo.socTime, pSocTime_p, sizeof(tTimesyncSocTime));
+
     if (timesynckInstance_l.pSharedMemory == NULL)
     {
         // Looks like the CAL has no SoC time forward support, but feature is
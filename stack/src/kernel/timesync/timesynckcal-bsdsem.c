@@ -2,10 +2,13 @@
 ********************************************************************************
 \file   timesynckcal-bsdsem.c
 
-\brief  CAL kernel timesync module using BSD semaphores
+\brief  CAL kernel timesync module using POSIX shared memory
 
 This file contains an implementation for the kernel CAL timesync module which
-uses BSD semaphores for synchronization.
+uses POSIX shared memory and a doorbell for synchronization. On every sync
+event the newest sync information is written to a shared sync record and the
+doorbell is rung. Sync events which are not consumed by the user layer in time
+are coalesced instead of being queued.
 
 The sync module is responsible to synchronize the user layer.
 
@@ -44,11 +47,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <common/timesync.h>
+#include <common/doorbell.h>
 #include <kernel/timesynckcal.h>
+#include <kernel/timesynck.h>
 
+#include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
-#include <semaphore.h>
+#include <sys/mman.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -82,7 +88,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static sem_t*           syncSem_l;
+static int                      fd_l = -1;
+static tTimesyncSyncRecord*     pSyncRecord_l = NULL;
+static tDoorbell*               pDoorbell_l = NULL;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -105,16 +113,45 @@ The function initializes the kernel CAL timesync module.
 //------------------------------------------------------------------------------
 tOplkError timesynckcal_init(void)
 {
-    sem_unlink(TIMESYNC_SYNC_BSDSEM);
+    tOplkError  ret;
 
-    syncSem_l = sem_open(TIMESYNC_SYNC_BSDSEM, O_CREAT, S_IRWXG, 1);
-    if (syncSem_l == SEM_FAILED)
+    shm_unlink(TIMESYNC_SYNC_SHM);
+
+    fd_l = shm_open(TIMESYNC_SYNC_SHM, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (fd_l < 0)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() creating sem failed!\n", __func__);
+        DEBUG_LVL_ERROR_TRACE("%s() shm_open failed!\n", __func__);
         return kErrorNoResource;
     }
 
+    if (ftruncate(fd_l, sizeof(tTimesyncSyncRecord)) == -1)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() ftruncate failed!\n", __func__);
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    pSyncRecord_l = (tTimesyncSyncRecord*)mmap(NULL, sizeof(tTimesyncSyncRecord),
+                                               PROT_READ | PROT_WRITE, MAP_SHARED, fd_l, 0);
+    if (pSyncRecord_l == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap failed!\n", __func__);
+        pSyncRecord_l = NULL;
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    OPLK_MEMSET(pSyncRecord_l, 0, sizeof(tTimesyncSyncRecord));
+
+    ret = doorbell_create(TIMESYNC_SYNC_DOORBELL, &pDoorbell_l);
+    if (ret != kErrorOk)
+        goto Exit;
+
     return kErrorOk;
+
+Exit:
+    timesynckcal_exit();
+    return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -128,15 +165,29 @@ The function cleans up the CAL timesync module
 //------------------------------------------------------------------------------
 void timesynckcal_exit(void)
 {
-    sem_close(syncSem_l);
-    sem_unlink(TIMESYNC_SYNC_BSDSEM);
+    doorbell_close(pDoorbell_l);
+    pDoorbell_l = NULL;
+
+    if (pSyncRecord_l != NULL)
+    {
+        munmap(pSyncRecord_l, sizeof(tTimesyncSyncRecord));
+        pSyncRecord_l = NULL;
+    }
+
+    if (fd_l >= 0)
+    {
+        close(fd_l);
+        shm_unlink(TIMESYNC_SYNC_SHM);
+        fd_l = -1;
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Send a sync event
 
-The function sends a sync event.
+The function sends a sync event. It overwrites the sync record with the
+information of the current sync event and rings the doorbell.
 
 \return The function returns a tOplkError error code.
 
@@ -145,7 +196,22 @@ The function sends a sync event.
 //------------------------------------------------------------------------------
 tOplkError timesynckcal_sendSyncEvent(void)
 {
-    sem_post(syncSem_l);
+    UINT32  sequence;
+
+    if ((pSyncRecord_l == NULL) || (pDoorbell_l == NULL))
+        return kErrorNoResource;
+
+    // The sequence counter is odd while the record is written, so that the
+    // user layer can detect a torn read and retry.
+    sequence = pSyncRecord_l->sequence;
+    __atomic_store_n(&pSyncRecord_l->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    timesynck_getSyncInfo(&pSyncRecord_l->syncInfo);
+
+    __atomic_store_n(&pSyncRecord_l->sequence, sequence + 2, __ATOMIC_RELEASE);
+
+    doorbell_ring(pDoorbell_l);
 
     return kErrorOk;
 }
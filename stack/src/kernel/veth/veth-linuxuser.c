@@ -7,6 +7,11 @@
 This file contains the the virtual Ethernet driver for the Linux userspace
 implementation. It uses a TUN/TAP device as virtual Ethernet driver.
 
+Frames received by the DLL are handed over to the virtual Ethernet thread by
+a lock-free single producer/single consumer queue, so the DLL receive path
+never blocks on the TAP device. The thread waits with epoll on the TAP device
+and the queue's eventfd and handles all pending frames per wakeup.
+
 \ingroup module_veth
 *******************************************************************************/
 
@@ -57,8 +62,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/types.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
-#include <sys/select.h>
-#include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/if_tun.h>
@@ -72,6 +77,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define TUN_DEV_NAME        "/dev/net/tun"
 
+#ifndef CONFIG_VETH_RX_QUEUE_SIZE
+#define CONFIG_VETH_RX_QUEUE_SIZE           64      // Frames waiting to be written to the TAP device (power of 2)
+#endif
+
+#ifndef CONFIG_VETH_TAP_READ_BATCH
+#define CONFIG_VETH_TAP_READ_BATCH          16      // Maximum number of frames read from the TAP device per wakeup
+#endif
+
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -87,11 +100,46 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#if ((CONFIG_VETH_RX_QUEUE_SIZE & (CONFIG_VETH_RX_QUEUE_SIZE - 1)) != 0)
+#error "CONFIG_VETH_RX_QUEUE_SIZE must be a power of 2!"
+#endif
 
+#define VETH_RX_QUEUE_MASK      (CONFIG_VETH_RX_QUEUE_SIZE - 1)
+#define VETH_EPOLL_TAP          0
+#define VETH_EPOLL_EVENT        1
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Frame queue entry
+
+The structure contains a frame which was received from the POWERLINK network
+and waits to be written to the TAP device.
+*/
+typedef struct
+{
+    UINT                frameSize;                              ///< Size of the frame
+    UINT8               aFrame[C_DLL_MAX_ETH_FRAME];            ///< Frame data
+} tVethQueueEntry;
+
+/**
+\brief Frame queue
+
+The structure describes the single producer/single consumer queue which hands
+frames over from the DLL receive callback to the virtual Ethernet thread. The
+write index is only changed by the producer, the read index is only changed
+by the consumer.
+*/
+typedef struct
+{
+    UINT32              writeIndex;                             ///< Number of frames put into the queue
+    UINT32              readIndex;                              ///< Number of frames taken from the queue
+    BOOL                fConsumerWaiting;                       ///< Flag indicating that the consumer waits for frames
+    UINT32              droppedFrames;                          ///< Number of frames dropped because the queue was full
+    tVethQueueEntry     aEntry[CONFIG_VETH_RX_QUEUE_SIZE];      ///< Queue entries
+} tVethQueue;
+
 /**
 \brief Structure describing an instance of the Virtual Ethernet driver
 
@@ -100,11 +148,15 @@ userspace.
 */
 typedef struct
 {
-    UINT8               macAdrs[6];         ///< MAC address of the VEth interface
-    UINT8               tapMacAdrs[6];      ///< MAC address of the TAP device
-    int                 fd;                 ///< File descriptor of the tunnel device
-    BOOL                fStop;              ///< Flag indicating whether the receive thread shall be stopped
-    pthread_t           threadHandle;       ///< Handle of the receive thread
+    UINT8               macAdrs[6];                             ///< MAC address of the VEth interface
+    UINT8               tapMacAdrs[6];                          ///< MAC address of the TAP device
+    int                 fd;                                     ///< File descriptor of the tunnel device
+    int                 eventFd;                                ///< Eventfd used to wake up the thread
+    int                 epollFd;                                ///< Epoll instance of the thread
+    BOOL                fStop;                                  ///< Flag indicating whether the thread shall be stopped
+    pthread_t           threadHandle;                           ///< Handle of the thread
+    tVethQueue*         pRxQueue;                               ///< Queue of frames to be written to the TAP device
+    UINT8               aReadBuffer[C_DLL_MAX_ETH_FRAME];       ///< Buffer for frames read from the TAP device
 } tVethInstance;
 
 //------------------------------------------------------------------------------
@@ -118,7 +170,11 @@ static tVethInstance        vethInstance_l;
 static void       getMacAdrs(UINT8* pMac_p);
 static tOplkError receiveFrameCb(tFrameInfo* pFrameInfo_p,
                                  tEdrvReleaseRxBuffer* pReleaseRxBuffer_p);
-static void*      vethRecvThread(void* pArg_p);
+static void       signalThread(tVethInstance* pInstance_p);
+static void       writeQueuedFrames(tVethInstance* pInstance_p);
+static void       readTapFrames(tVethInstance* pInstance_p);
+static void*      vethThread(void* pArg_p);
+static void       cleanupInstance(tVethInstance* pInstance_p);
 
 //------------------------------------------------------------------------------
 // local vars
@@ -143,11 +199,16 @@ The function initializes the virtual Ethernet module.
 //------------------------------------------------------------------------------
 tOplkError veth_init(const UINT8 aSrcMac_p[6])
 {
-    tOplkError      ret;
-    struct ifreq    ifr;
-    int             err;
+    tOplkError          ret;
+    struct ifreq        ifr;
+    int                 err;
+    struct epoll_event  event;
+
+    OPLK_MEMSET(&vethInstance_l, 0, sizeof(vethInstance_l));
+    vethInstance_l.eventFd = -1;
+    vethInstance_l.epollFd = -1;
 
-    if ((vethInstance_l.fd = open(TUN_DEV_NAME, O_RDWR)) < 0)
+    if ((vethInstance_l.fd = open(TUN_DEV_NAME, O_RDWR | O_NONBLOCK)) < 0)
     {
         DEBUG_LVL_VETH_TRACE("Error opening %s\n", TUN_DEV_NAME);
         return kErrorNoFreeInstance;
@@ -169,10 +230,47 @@ tOplkError veth_init(const UINT8 aSrcMac_p[6])
     OPLK_MEMCPY(vethInstance_l.macAdrs, aSrcMac_p, 6);
     getMacAdrs(vethInstance_l.tapMacAdrs);
 
-    // start tap receive thread
+    vethInstance_l.pRxQueue = (tVethQueue*)OPLK_MALLOC(sizeof(tVethQueue));
+    if (vethInstance_l.pRxQueue == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Allocation of frame queue failed!\n", __func__);
+        cleanupInstance(&vethInstance_l);
+        return kErrorNoResource;
+    }
+    OPLK_MEMSET(vethInstance_l.pRxQueue, 0, sizeof(tVethQueue));
+
+    vethInstance_l.eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    vethInstance_l.epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if ((vethInstance_l.eventFd < 0) || (vethInstance_l.epollFd < 0))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Creating eventfd/epoll failed: %s\n", __func__, strerror(errno));
+        cleanupInstance(&vethInstance_l);
+        return kErrorNoResource;
+    }
+
+    OPLK_MEMSET(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = VETH_EPOLL_TAP;
+    if (epoll_ctl(vethInstance_l.epollFd, EPOLL_CTL_ADD, vethInstance_l.fd, &event) < 0)
+    {
+        cleanupInstance(&vethInstance_l);
+        return kErrorNoResource;
+    }
+
+    event.data.u32 = VETH_EPOLL_EVENT;
+    if (epoll_ctl(vethInstance_l.epollFd, EPOLL_CTL_ADD, vethInstance_l.eventFd, &event) < 0)
+    {
+        cleanupInstance(&vethInstance_l);
+        return kErrorNoResource;
+    }
+
+    // start virtual Ethernet thread
     vethInstance_l.fStop = FALSE;
-    if (pthread_create(&vethInstance_l.threadHandle, NULL, vethRecvThread, (void*)&vethInstance_l) != 0)
+    if (pthread_create(&vethInstance_l.threadHandle, NULL, vethThread, (void*)&vethInstance_l) != 0)
+    {
+        cleanupInstance(&vethInstance_l);
         return kErrorNoFreeInstance;
+    }
 
 #if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
     pthread_setname_np(vethInstance_l.threadHandle, "oplk-veth");
@@ -202,10 +300,19 @@ tOplkError veth_exit(void)
     // Unregister the receive callback function
     ret = dllk_deregAsyncHandler(receiveFrameCb);
 
-    // stop receive thread by setting its stop flag
-    vethInstance_l.fStop = TRUE;
+    // stop thread by setting its stop flag and waking it up
+    __atomic_store_n(&vethInstance_l.fStop, TRUE, __ATOMIC_SEQ_CST);
+    signalThread(&vethInstance_l);
     pthread_join(vethInstance_l.threadHandle, NULL);
-    close(vethInstance_l.fd);
+
+    if (vethInstance_l.pRxQueue->droppedFrames != 0)
+    {
+        DEBUG_LVL_VETH_TRACE("%s(): %u frames dropped due to full queue\n",
+                             __func__,
+                             vethInstance_l.pRxQueue->droppedFrames);
+    }
+
+    cleanupInstance(&vethInstance_l);
 
     return ret;
 }
@@ -265,7 +372,10 @@ static void getMacAdrs(UINT8* pMac_p)
 /**
 \brief  Receive frame from virtual Ethernet interface
 
-The function receives a frame from the virtual Ethernet interface.
+The function receives a frame from the POWERLINK network which shall be
+forwarded to the virtual Ethernet interface. It is called by the DLL and puts
+the frame into the frame queue of the virtual Ethernet thread. If the queue is
+full, the frame is dropped.
 
 \param[in]      pFrameInfo_p        Pointer to frame information of received frame.
 \param[out]     pReleaseRxBuffer_p  Pointer to buffer release flag. The function must
@@ -278,99 +388,221 @@ The function receives a frame from the virtual Ethernet interface.
 static tOplkError receiveFrameCb(tFrameInfo* pFrameInfo_p,
                                  tEdrvReleaseRxBuffer* pReleaseRxBuffer_p)
 {
-    UINT    nwrite;
+    tVethQueue*         pQueue = vethInstance_l.pRxQueue;
+    tVethQueueEntry*    pEntry;
+    UINT32              writeIndex;
+
+    *pReleaseRxBuffer_p = kEdrvReleaseRxBufferImmediately;
+
+    writeIndex = pQueue->writeIndex;
+    if (((writeIndex - __atomic_load_n(&pQueue->readIndex, __ATOMIC_ACQUIRE)) >= CONFIG_VETH_RX_QUEUE_SIZE) ||
+        (pFrameInfo_p->frameSize > C_DLL_MAX_ETH_FRAME))
+    {
+        pQueue->droppedFrames++;
+        return kErrorOk;
+    }
+
+    pEntry = &pQueue->aEntry[writeIndex & VETH_RX_QUEUE_MASK];
+    OPLK_MEMCPY(pEntry->aFrame, pFrameInfo_p->frame.pBuffer, pFrameInfo_p->frameSize);
+    pEntry->frameSize = pFrameInfo_p->frameSize;
 
     // replace the MAC address of the POWERLINK Ethernet interface with virtual
     // Ethernet MAC address before forwarding it into the virtual Ethernet interface
-    if (OPLK_MEMCMP(pFrameInfo_p->frame.pBuffer->aDstMac, vethInstance_l.macAdrs, ETH_ALEN) == 0)
+    if (OPLK_MEMCMP(pEntry->aFrame, vethInstance_l.macAdrs, ETH_ALEN) == 0)
     {
-        OPLK_MEMCPY(pFrameInfo_p->frame.pBuffer->aDstMac, vethInstance_l.tapMacAdrs, ETH_ALEN);
+        OPLK_MEMCPY(pEntry->aFrame, vethInstance_l.tapMacAdrs, ETH_ALEN);
     }
 
-    nwrite = write(vethInstance_l.fd, pFrameInfo_p->frame.pBuffer, pFrameInfo_p->frameSize);
-    if (nwrite != pFrameInfo_p->frameSize)
+    // Publish the frame. The thread is only woken up if it announced that it
+    // waits for frames, otherwise it picks the frame up in its current pass.
+    __atomic_store_n(&pQueue->writeIndex, writeIndex + 1, __ATOMIC_SEQ_CST);
+    if (__atomic_exchange_n(&pQueue->fConsumerWaiting, FALSE, __ATOMIC_SEQ_CST))
+        signalThread(&vethInstance_l);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wake up virtual Ethernet thread
+
+The function wakes up the virtual Ethernet thread by signaling its eventfd.
+
+\param[in]      pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void signalThread(tVethInstance* pInstance_p)
+{
+    UINT64  value = 1;
+
+    if (write(pInstance_p->eventFd, &value, sizeof(value)) != sizeof(value))
     {
-        DEBUG_LVL_VETH_TRACE("Error writing data to virtual Ethernet interface!\n");
+        // The eventfd counter only overflows if the thread does not run,
+        // in this case it is signaled anyway.
     }
+}
 
-    *pReleaseRxBuffer_p = kEdrvReleaseRxBufferImmediately;
+//------------------------------------------------------------------------------
+/**
+\brief  Write queued frames to the TAP device
 
-    return kErrorOk;
+The function writes all frames of the frame queue to the TAP device.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void writeQueuedFrames(tVethInstance* pInstance_p)
+{
+    tVethQueue*         pQueue = pInstance_p->pRxQueue;
+    tVethQueueEntry*    pEntry;
+    UINT32              readIndex;
+    UINT32              writeIndex;
+    ssize_t             nwrite;
+
+    readIndex = pQueue->readIndex;
+    writeIndex = __atomic_load_n(&pQueue->writeIndex, __ATOMIC_ACQUIRE);
+
+    while (readIndex != writeIndex)
+    {
+        pEntry = &pQueue->aEntry[readIndex & VETH_RX_QUEUE_MASK];
+        nwrite = write(pInstance_p->fd, pEntry->aFrame, pEntry->frameSize);
+        if (nwrite != (ssize_t)pEntry->frameSize)
+        {
+            DEBUG_LVL_VETH_TRACE("Error writing data to virtual Ethernet interface!\n");
+        }
+
+        readIndex++;
+        __atomic_store_n(&pQueue->readIndex, readIndex, __ATOMIC_RELEASE);
+
+        if (readIndex == writeIndex)
+            writeIndex = __atomic_load_n(&pQueue->writeIndex, __ATOMIC_ACQUIRE);
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Receive frame from virtual Ethernet interface
+\brief  Read frames from the TAP device
+
+The function reads the frames pending on the TAP device and sends them to
+the POWERLINK network. At most \ref CONFIG_VETH_TAP_READ_BATCH frames are
+read per call so that the frame queue is not starved by a busy TAP device.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void readTapFrames(tVethInstance* pInstance_p)
+{
+    UINT8*          pBuffer = pInstance_p->aReadBuffer;
+    ssize_t         nread;
+    tFrameInfo      frameInfo;
+    tOplkError      ret;
+    UINT            count;
+
+    for (count = 0; count < CONFIG_VETH_TAP_READ_BATCH; count++)
+    {
+        nread = read(pInstance_p->fd, pBuffer, C_DLL_MAX_ETH_FRAME);
+        if (nread <= 0)
+        {
+            if ((nread < 0) && (errno != EAGAIN) && (errno != EINTR))
+            {
+                DEBUG_LVL_VETH_TRACE("%s(): read error: %s\n", __func__, strerror(errno));
+            }
+            break;
+        }
+
+        DEBUG_LVL_VETH_TRACE("VETH: Read %d bytes from the tap interface\n", (int)nread);
+        DEBUG_LVL_VETH_TRACE("SRC MAC: %02X:%02X:%02x:%02X:%02X:%02x\n",
+                             pBuffer[6],
+                             pBuffer[7],
+                             pBuffer[8],
+                             pBuffer[9],
+                             pBuffer[10],
+                             pBuffer[11]);
+        DEBUG_LVL_VETH_TRACE("DST MAC: %02X:%02X:%02x:%02X:%02X:%02x\n",
+                             pBuffer[0],
+                             pBuffer[1],
+                             pBuffer[2],
+                             pBuffer[3],
+                             pBuffer[4],
+                             pBuffer[5]);
+        // replace src MAC address with MAC address of virtual Ethernet interface
+        OPLK_MEMCPY(&pBuffer[6], pInstance_p->macAdrs, ETH_ALEN);
+
+        frameInfo.frame.pBuffer = (tPlkFrame*)pBuffer;
+        frameInfo.frameSize = (UINT)nread;
+        ret = dllkcal_sendAsyncFrame(&frameInfo, kDllAsyncReqPrioGeneric);
+        if (ret != kErrorOk)
+        {
+            DEBUG_LVL_VETH_TRACE("%s(): dllkcal_sendAsyncFrame returned 0x%04X\n", __func__, ret);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Virtual Ethernet thread
 
-The function receives a frame from the virtual Ethernet interface. It is implemented
-to be used as a thread which does a blocking read in a while loop.
+The function implements the virtual Ethernet thread. It waits for frames on
+the TAP device and in the frame queue and handles all pending frames on each
+wakeup.
 
 \param[in,out]  pArg_p              Thread argument. Pointer to virtual Ethernet instance.
 
-\return The function returns a tOplkError error code.
+\return The function returns NULL.
 */
 //------------------------------------------------------------------------------
-static void* vethRecvThread(void* pArg_p)
+static void* vethThread(void* pArg_p)
 {
-    UINT8               buffer[ETH_DATA_LEN];
-    UINT                nread;
-    tFrameInfo          frameInfo;
-    tOplkError          ret = kErrorOk;
     tVethInstance*      pInstance = (tVethInstance*)pArg_p;
-    fd_set              readFds;
-    int                 result;
-    struct timeval      timeout;
-
-    while (!pInstance->fStop)
+    tVethQueue*         pQueue = pInstance->pRxQueue;
+    struct epoll_event  aEvents[2];
+    int                 numEvents;
+    int                 timeout;
+    int                 i;
+    UINT64              value;
+
+    while (!__atomic_load_n(&pInstance->fStop, __ATOMIC_SEQ_CST))
     {
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 400000;
+        writeQueuedFrames(pInstance);
 
-        FD_ZERO(&readFds);
-        FD_SET(pInstance->fd, &readFds);
+        // Announce that we wait for frames. If a frame was queued in the
+        // meantime, the producer might not have seen the flag, so poll only.
+        __atomic_store_n(&pQueue->fConsumerWaiting, TRUE, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&pQueue->writeIndex, __ATOMIC_SEQ_CST) != pQueue->readIndex)
+            timeout = 0;
+        else
+            timeout = -1;
 
-        result = select(pInstance->fd + 1, &readFds, NULL, NULL, &timeout);
-        switch (result)
+        numEvents = epoll_wait(pInstance->epollFd, aEvents, 2, timeout);
+        __atomic_store_n(&pQueue->fConsumerWaiting, FALSE, __ATOMIC_SEQ_CST);
+
+        if (numEvents < 0)
         {
-            case 0:     // timeout
-                //DEBUG_LVL_VETH_TRACE("select timeout\n");
-                break;
-
-            case -1:    // error
-                DEBUG_LVL_VETH_TRACE("select error: %s\n", strerror(errno));
-                break;
-
-            default:    // data from tun/tap ready for read
-                nread = read(pInstance->fd, buffer, ETH_DATA_LEN);
-                if (nread > 0)
-                {
-                    DEBUG_LVL_VETH_TRACE("VETH: Read %d bytes from the tap interface\n", nread);
-                    DEBUG_LVL_VETH_TRACE("SRC MAC: %02X:%02X:%02x:%02X:%02X:%02x\n",
-                                         buffer[6],
-                                         buffer[7],
-                                         buffer[8],
-                                         buffer[9],
-                                         buffer[10],
-                                         buffer[11]);
-                    DEBUG_LVL_VETH_TRACE("DST MAC: %02X:%02X:%02x:%02X:%02X:%02x\n",
-                                         buffer[0],
-                                         buffer[1],
-                                         buffer[2],
-                                         buffer[3],
-                                         buffer[4],
-                                         buffer[5]);
-                    // replace src MAC address with MAC address of virtual Ethernet interface
-                    OPLK_MEMCPY(&buffer[6], pInstance->macAdrs, ETH_ALEN);
-
-                    frameInfo.frame.pBuffer = (tPlkFrame*)buffer;
-                    frameInfo.frameSize = nread;
-                    ret = dllkcal_sendAsyncFrame(&frameInfo, kDllAsyncReqPrioGeneric);
-                    if (ret != kErrorOk)
+            if (errno != EINTR)
+            {
+                DEBUG_LVL_VETH_TRACE("epoll error: %s\n", strerror(errno));
+            }
+            continue;
+        }
+
+        for (i = 0; i < numEvents; i++)
+        {
+            switch (aEvents[i].data.u32)
+            {
+                case VETH_EPOLL_EVENT:
+                    if (read(pInstance->eventFd, &value, sizeof(value)) < 0)
                     {
-                        DEBUG_LVL_VETH_TRACE("%s(): dllkcal_sendAsyncFrame returned 0x%04X\n", __func__, ret);
+                        // Nothing to do, eventfd was already cleared
                     }
-                }
-                break;
+                    break;
+
+                case VETH_EPOLL_TAP:
+                    readTapFrames(pInstance);
+                    break;
+
+                default:
+                    break;
+            }
         }
     }
 
@@ -379,6 +611,38 @@ static void* vethRecvThread(void* pArg_p)
     return NULL;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up virtual Ethernet instance
+
+The function frees the resources of the virtual Ethernet instance.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void cleanupInstance(tVethInstance* pInstance_p)
+{
+    if (pInstance_p->epollFd >= 0)
+    {
+        close(pInstance_p->epollFd);
+        pInstance_p->epollFd = -1;
+    }
+
+    if (pInstance_p->eventFd >= 0)
+    {
+        close(pInstance_p->eventFd);
+        pInstance_p->eventFd = -1;
+    }
+
+    if (pInstance_p->pRxQueue != NULL)
+    {
+        OPLK_FREE(pInstance_p->pRxQueue);
+        pInstance_p->pRxQueue = NULL;
+    }
+
+    close(pInstance_p->fd);
+}
+
 /// \}
 
 #endif // CONFIG_INCLUDE_VETH
@@ -1313,6 +1313,41 @@ tOplkError oplk_setOdArchivePath(const char* pBackupPath_p)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set CFM cache path
+
+The function sets the directory of the configuration manager (CFM) cache and
+loads the cache. The cache allows the CFM to skip the configuration download
+to CNs whose stored configuration is unchanged since the last run of the MN.
+
+\param[in]      pCachePath_p        Directory to be used for the CFM cache.
+
+\note   The function is only used if the CFM and its configuration cache are
+        included in the openPOWERLINK stack.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The path has successfully been set.
+\retval kErrorApiInvalidParam       The function is not available due to missing
+                                    CFM cache module.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_setCfmCachePath(const char* pCachePath_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_CFM)
+    return cfmu_setCachePath(pCachePath_p);
+#else
+    UNUSED_PARAMETER(pCachePath_p);
+
+    return kErrorApiInvalidParam;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Stack process function
@@ -1565,6 +1600,41 @@ tOplkError oplk_waitSyncEvent(ULONG timeout_p)
     return timesyncucal_waitSyncEvent(timeout_p);
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief Get sync event information
+
+The function returns information about the sync event which was received by the
+last call of oplk_waitSyncEvent(). It contains the cycle counter of the sync
+event and the number of sync events which were missed by the application
+because it didn't call oplk_waitSyncEvent() in time. Missed sync events are not
+queued, oplk_waitSyncEvent() always returns the newest one.
+
+\note The SoC time information is only valid if the stack supports forwarding
+      the SoC time (see oplk_getSocTime()).
+
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The sync event information is returned.
+\retval kErrorInvalidOperation      No sync event was received yet.
+\retval kErrorApiNotSupported       The sync event information is not supported by
+                                    the used stack.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getSyncInfo(tOplkApiSyncInfo* pSyncInfo_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (pSyncInfo_p == NULL)
+        return kErrorApiInvalidParam;
+
+    return timesyncucal_getSyncInfo(pSyncInfo_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get IdentResponse of node
@@ -1670,6 +1740,73 @@ tOplkError oplk_triggerPresForward(UINT nodeId_p)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Trigger cycle histogram forward
+
+The function triggers the forwarding of the cycle timing histograms of the MN
+to the application. It can be used by the application for diagnosis purpose.
+Each histogram is forwarded by a \ref kOplkApiEventCycleHistogram event. The
+application has to handle this event to get the histograms.
+
+The histograms are only recorded if the kernel stack was built with
+CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS enabled. Otherwise, the request is ignored.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_triggerCycleHistogram(void)
+{
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    tEvent  event;
+
+    event.eventSink = kEventSinkDllk;
+    event.netTime.nsec = 0;
+    event.netTime.sec = 0;
+    event.eventType = kEventTypeRequCycleHistogram;
+    event.eventArg.pEventArg = NULL;
+    event.eventArgSize = 0;
+
+    return eventu_postEvent(&event);
+#else
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Trigger event statistics forward
+
+The function triggers the forwarding of the wakeup and throughput statistics of
+the kernel and user event threads to the application. It can be used by the
+application for diagnosis purpose. The statistics are forwarded by a
+\ref kOplkApiEventEventStatistics event. The application has to handle this
+event to get the statistics.
+
+The statistics are only recorded by the event threads of the Linux userspace
+stack. On other targets, the request is ignored by the kernel stack.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_triggerEventStatistics(void)
+{
+    tEvent  event;
+
+    event.eventSink = kEventSinkDllk;
+    event.netTime.nsec = 0;
+    event.netTime.sec = 0;
+    event.eventType = kEventTypeRequEventStatistics;
+    event.eventArg.pEventArg = NULL;
+    event.eventArgSize = 0;
+
+    return eventu_postEvent(&event);
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -389,6 +389,74 @@ void* oplk_getProcessImageOut(void)
     return instance_l.outputImage.pImage;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange RXPDO buffers
+
+The function exchanges the output data without copying it into the output
+process image. It switches the triple buffers of all received PDOs, so that the
+newest received data can be accessed directly with oplk_getRxPdoBuffer().
+Therefore, the exchange only costs an atomic buffer switch per PDO channel.
+
+This zero-copy mode is an alternative to oplk_exchangeProcessImageOut(). Both
+functions consume the received PDOs, so an application must only use one of
+them.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    RXPDO buffers are successfully exchanged.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_exchangeRxPdoBuffers(void)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return pdou_exchangeRxPdoBuffers();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get RXPDO buffer
+
+The function provides direct access to the data of a received PDO which was
+made current by the last call of oplk_exchangeRxPdoBuffers(). The data is
+stored in the same layout as in the frame, i.e. a mapped object is located at
+its mapped byte offset minus the offset returned in the buffer information.
+The buffer stays valid until the next call of oplk_exchangeRxPdoBuffers() or
+until the PDO mapping is changed.
+
+\param[in]      mappParamIndex_p    Object index of the RXPDO mapping parameter
+                                    (0x1600 - 0x16FF).
+\param[out]     pRxPdoBuffer_p      Pointer to store the RXPDO buffer information.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The buffer information is returned successfully.
+\retval kErrorApiInvalidParam       Invalid parameters specified.
+\retval kErrorPdoInvalidObjIndex    The specified RXPDO does not exist.
+\retval kErrorPdoNotExist           The specified RXPDO is not enabled.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getRxPdoBuffer(UINT mappParamIndex_p,
+                               tOplkApiRxPdoBuffer* pRxPdoBuffer_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (pRxPdoBuffer_p == NULL)
+        return kErrorApiInvalidParam;
+
+    return pdou_getRxPdoBuffer(mappParamIndex_p,
+                               &pRxPdoBuffer_p->pPdo,
+                               &pRxPdoBuffer_p->offset,
+                               &pRxPdoBuffer_p->size);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Setup process image
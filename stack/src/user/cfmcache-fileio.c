@@ -0,0 +1,417 @@
+/**
+********************************************************************************
+\file   cfmcache-fileio.c
+
+\brief  Implementation of the CFM configuration cache archive
+
+The file contains the file based archive of the configuration manager (CFM)
+cache. The archive allows the MN to recognize CNs whose configuration is
+unchanged since the last download across restarts of the MN.
+
+\ingroup module_cfmu
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <user/cfmcache.h>
+
+#include <stdio.h>
+#include <fcntl.h>
+
+#if (TARGET_SYSTEM == _WIN32_)
+
+#pragma warning(disable:4996)   // Disable error on strcpy
+#include <io.h>
+#include <string.h>
+
+#elif (TARGET_SYSTEM == _LINUX_)
+
+#include <unistd.h>
+#include <limits.h>
+
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#if (TARGET_SYSTEM == _WIN32_)
+
+#define MAX_PATH_LEN    _MAX_PATH
+#define flush           _commit
+
+#elif (TARGET_SYSTEM == _LINUX_)
+
+#define O_BINARY        0
+#define MAX_PATH_LEN    PATH_MAX
+#define flush           fsync
+
+#endif
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef CFM_CACHE_FILENAME
+#define CFM_CACHE_FILENAME              "oplkCfmCache.bin"
+#endif
+
+#define CFM_CACHE_SIGNATURE             0x46434C50      // Signature PLCF
+#define CFM_CACHE_FNV_PRIME             0x01000193
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  CFM cache archive instance
+*/
+typedef struct
+{
+    const char* pArchivePath;           ///< The parent directory for the archive
+} tCfmCacheInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tCfmCacheInstance    cfmCacheInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void getArchivePath(const char* pSuffix_p, char* pFilePathName_p);
+
+/***************************************************************************/
+/*          C L A S S  <Store/Load>                                        */
+/***************************************************************************/
+/**
+  Description:
+
+  File oplkCfmCache.bin:
+          +----------------------+
+  0x0000  | cache signature      | (4 Bytes)
+          +----------------------+
+  0x0004  | number of entries    | (4 Bytes)
+          +----------------------+
+  0x0008  | cache entries        | (n * 32 Bytes)
+          |  (node ID 1 .. n)    |
+          +----------------------+
+  0xNNNN  | hash of all data     | (4 Bytes)
+          +----------------------+
+
+  The archive is written to a temporary file which replaces the archive
+  afterwards. Therefore, a power loss during the store operation leaves
+  either the old or the new archive.
+*/
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize CFM cache archive module
+
+The function initializes the CFM cache archive module.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmcache_init(void)
+{
+    OPLK_MEMSET(&cfmCacheInstance_l, 0, sizeof(cfmCacheInstance_l));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up CFM cache archive module
+
+The function cleans up the CFM cache archive module.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmcache_exit(void)
+{
+    OPLK_MEMSET(&cfmCacheInstance_l, 0, sizeof(cfmCacheInstance_l));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set CFM cache archive path
+
+The function sets the directory which contains the CFM cache archive.
+
+\param[in]      pArchivePath_p      Directory of the CFM cache archive.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmcache_setArchivePath(const char* pArchivePath_p)
+{
+    if (pArchivePath_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if ((strlen(pArchivePath_p) + sizeof(CFM_CACHE_FILENAME) + 8) > MAX_PATH_LEN)
+        return kErrorApiInvalidParam;
+
+    cfmCacheInstance_l.pArchivePath = pArchivePath_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load the CFM cache
+
+The function reads the cache entries from the archive. If the archive does
+not exist or is invalid, all entries are cleared.
+
+\param[out]     pEntries_p          Pointer to the array which receives the
+                                    cache entries.
+\param[in]      count_p             Number of entries in the array.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The cache has been loaded.
+\retval kErrorObdStoreDataObsolete  The archive does not match the cache layout.
+\retval kErrorObdStoreHwError       The archive could not be read or is corrupted.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmcache_load(tCfmCacheEntry* pEntries_p, UINT count_p)
+{
+    tOplkError  ret = kErrorOk;
+    char        aFilePath[MAX_PATH_LEN];
+    int         hFile;
+    UINT32      aHeader[2];
+    UINT32      readHash;
+    UINT32      hash;
+    size_t      size = sizeof(tCfmCacheEntry) * count_p;
+
+    OPLK_MEMSET(pEntries_p, 0, size);
+
+    if (cfmCacheInstance_l.pArchivePath == NULL)
+        return kErrorObdStoreHwError;
+
+    getArchivePath("", aFilePath);
+    hFile = open(aFilePath, O_RDONLY | O_BINARY, 0666);
+    if (hFile < 0)
+        return kErrorObdStoreHwError;
+
+    if ((read(hFile, aHeader, sizeof(aHeader)) != (int)sizeof(aHeader)) ||
+        (read(hFile, pEntries_p, size) != (int)size) ||
+        (read(hFile, &readHash, sizeof(readHash)) != (int)sizeof(readHash)))
+    {
+        ret = kErrorObdStoreHwError;
+        goto Exit;
+    }
+
+    if ((aHeader[0] != CFM_CACHE_SIGNATURE) || (aHeader[1] != count_p))
+    {
+        ret = kErrorObdStoreDataObsolete;
+        goto Exit;
+    }
+
+    hash = cfmcache_calculateHash(CFMCACHE_HASH_INIT, aHeader, sizeof(aHeader));
+    hash = cfmcache_calculateHash(hash, pEntries_p, size);
+    if (hash != readHash)
+        ret = kErrorObdStoreHwError;
+
+Exit:
+    close(hFile);
+
+    if (ret != kErrorOk)
+        OPLK_MEMSET(pEntries_p, 0, size);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store the CFM cache
+
+The function writes the cache entries to the archive.
+
+\param[in]      pEntries_p          Pointer to the array of cache entries.
+\param[in]      count_p             Number of entries in the array.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmcache_store(const tCfmCacheEntry* pEntries_p, UINT count_p)
+{
+    tOplkError  ret = kErrorOk;
+    char        aFilePath[MAX_PATH_LEN];
+    char        aTempPath[MAX_PATH_LEN];
+    int         hFile;
+    UINT32      aHeader[2];
+    UINT32      hash;
+    size_t      size = sizeof(tCfmCacheEntry) * count_p;
+
+    if (cfmCacheInstance_l.pArchivePath == NULL)
+        return kErrorObdStoreHwError;
+
+    getArchivePath("", aFilePath);
+    getArchivePath(".tmp", aTempPath);
+
+    aHeader[0] = CFM_CACHE_SIGNATURE;
+    aHeader[1] = count_p;
+    hash = cfmcache_calculateHash(CFMCACHE_HASH_INIT, aHeader, sizeof(aHeader));
+    hash = cfmcache_calculateHash(hash, pEntries_p, size);
+
+    hFile = open(aTempPath, O_CREAT | O_TRUNC | O_WRONLY | O_BINARY, 0666);
+    if (hFile < 0)
+        return kErrorObdStoreHwError;
+
+    if ((write(hFile, aHeader, sizeof(aHeader)) != (int)sizeof(aHeader)) ||
+        (write(hFile, pEntries_p, size) != (int)size) ||
+        (write(hFile, &hash, sizeof(hash)) != (int)sizeof(hash)))
+    {
+        ret = kErrorObdStoreHwError;
+    }
+
+    // Sync file to disc before it replaces the archive
+    flush(hFile);
+    close(hFile);
+
+    if (ret != kErrorOk)
+    {
+        remove(aTempPath);
+        return ret;
+    }
+
+#if (TARGET_SYSTEM == _WIN32_)
+    remove(aFilePath);
+#endif
+    if (rename(aTempPath, aFilePath) != 0)
+    {
+        remove(aTempPath);
+        ret = kErrorObdStoreHwError;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate cache hash
+
+The function calculates the 32 bit FNV-1a hash over the given data. It can be
+called several times to hash data in pieces.
+
+\param[in]      hash_p              Hash of the previous data or
+                                    \ref CFMCACHE_HASH_INIT.
+\param[in]      pData_p             Pointer to the data.
+\param[in]      size_p              Size of the data.
+
+\return The function returns the hash value.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+UINT32 cfmcache_calculateHash(UINT32 hash_p,
+                              const void* pData_p,
+                              size_t size_p)
+{
+    const UINT8*    pData = (const UINT8*)pData_p;
+
+    while (size_p-- > 0)
+    {
+        hash_p ^= *pData++;
+        hash_p *= CFM_CACHE_FNV_PRIME;
+    }
+
+    return hash_p;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get complete path to the CFM cache archive
+
+The functions returns the complete path to the CFM cache archive.
+
+\param[in]      pSuffix_p           Suffix which is appended to the filename.
+\param[out]     pFilePathName_p     String pointer to hold the archive file path.
+*/
+//------------------------------------------------------------------------------
+static void getArchivePath(const char* pSuffix_p, char* pFilePathName_p)
+{
+    size_t  len;
+
+    strcpy(pFilePathName_p, cfmCacheInstance_l.pArchivePath);
+
+    len = strlen(pFilePathName_p);
+    if ((len > 0) &&
+        (pFilePathName_p[len - 1] != '\\') &&
+        (pFilePathName_p[len - 1] != '/'))
+    {
+        strcat(pFilePathName_p, "/");
+    }
+
+    strcat(pFilePathName_p, CFM_CACHE_FILENAME);
+    strcat(pFilePathName_p, pSuffix_p);
+}
+
+/// \}
@@ -45,11 +45,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <common/oplkinc.h>
 #include <common/ami.h>
+#include <common/target.h>
 #include <user/cfmu.h>
 #include <user/sdocom.h>
 #include <user/identu.h>
 #include <user/nmtu.h>
 #include <user/obdu.h>
+#include <user/cfmcache.h>
 
 #if !defined(CONFIG_INCLUDE_SDOC)
 #error "CFM module needs openPOWERLINK module SDO client!"
@@ -70,6 +72,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_CFM_CONFIGURE_CYCLE_LENGTH   FALSE
 #endif
 
+// maximum number of CNs which are configured at the same time, further CNs
+// wait until the configuration of another CN is finished
+#ifndef CONFIG_CFM_MAX_CONCURRENT_NODES
+#define CONFIG_CFM_MAX_CONCURRENT_NODES     CONFIG_SDO_MAX_CONNECTION_COM
+#endif
+
+// maximum size of a write multiple parameter by index transfer, 0 disables
+// the transfer of multiple ConciseDCF entries with one SDO transfer
+#ifndef CONFIG_CFM_MAX_BATCH_SIZE
+#define CONFIG_CFM_MAX_BATCH_SIZE           1024
+#endif
+
 // return pointer to node info structure for specified node ID
 // d.k. may be replaced by special (hash) function if node ID array is smaller than 254
 #define CFM_GET_NODEINFO(nodeId_p)  (cfmInstance_g.apNodeInfo[nodeId_p - 1])
@@ -123,7 +137,8 @@ typedef UINT32 tCfmState;
 The following structure defines the node information that is needed by the
 configuration manager.
 */
-typedef struct
+typedef struct sCfmNodeInfo tCfmNodeInfo;
+struct sCfmNodeInfo
 {
     tCfmEventCnProgress     eventCnProgress;                ///< Event arguments to report the CFM progress on a specific CN
     UINT8*                  pObdBufferConciseDcf;           ///< Pointer of the CDC buffer in the object dictionary
@@ -133,8 +148,21 @@ typedef struct
     tSdoComConHdl           sdoComConHdl;                   ///< SDO Command Layer connection handle
     tCfmState               cfmState;                       ///< Current CFM state for the CN
     UINT                    curDataSize;                    ///< Size of the current entry to be written via SDO
+    UINT                    curEntryCount;                  ///< Number of CDC entries written by the current SDO transfer
     BOOL                    fDoStore;                       ///< Flag indicating whether a store command shall be issued
-} tCfmNodeInfo;
+    UINT32                  startTime;                      ///< Tick count at the start of the configuration [ms]
+    BOOL                    fWriteMultiple;                 ///< Flag indicating whether the CN supports write multiple parameter by index
+    UINT8*                  pBatchBuffer;                   ///< Buffer for write multiple parameter by index transfers
+    UINT                    batchDataSize;                  ///< Size of the object data of the current write multiple parameter transfer
+    const void*             pPendingData;                   ///< Data of the SDO transfer which waits for a free download slot
+    UINT                    pendingSize;                    ///< Size of the SDO transfer which waits for a free download slot
+    tSdoAccessType          pendingAccessType;              ///< Access type of the SDO transfer which waits for a free download slot
+    BOOL                    fWaiting;                       ///< Flag indicating whether the CN waits for a free download slot
+    tCfmNodeInfo*           pNextWaiting;                   ///< Next CN which waits for a free download slot
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+    tCfmCacheEntry          cacheEntry;                     ///< Cache entry of the configuration which is verified or downloaded
+#endif
+};
 
 /**
 \brief CFM instance
@@ -150,6 +178,13 @@ typedef struct
 #endif
     tCfmCbEventCnProgress   pfnCbEventCnProgress;           ///< Pointer to the CN progress callback function
     tCfmCbEventCnResult     pfnCbEventCnResult;             ///< Pointer to the CN result callback function
+    UINT                    activeNodeCount;                ///< Number of CNs with an open SDO connection
+    tCfmNodeInfo*           pFirstWaiting;                  ///< First CN which waits for a free download slot
+    tCfmNodeInfo*           pLastWaiting;                   ///< Last CN which waits for a free download slot
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+    BOOL                    fCacheEnabled;                  ///< Flag indicating whether the configuration cache is used
+    tCfmCacheEntry          aCacheEntry[NMT_MAX_NODE_ID];   ///< Verified configurations of the CNs
+#endif
 } tCfmInstance;
 
 //------------------------------------------------------------------------------
@@ -167,11 +202,29 @@ static tOplkError    finishConfig(tCfmNodeInfo* pNodeInfo_p,
                                   tNmtNodeCommand nmtNodeCommand_p);
 static tOplkError    downloadCycleLength(tCfmNodeInfo* pNodeInfo_p);
 static tOplkError    downloadObject(tCfmNodeInfo* pNodeInfo_p);
+static tOplkError    downloadObjectBatch(tCfmNodeInfo* pNodeInfo_p);
 static tOplkError    sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                     const void* pLeSrcData_p,
-                                    UINT size_p);
+                                    UINT size_p,
+                                    tSdoAccessType sdoAccessType_p);
 static tOplkError    cbSdoCon(const tSdoComFinished* pSdoComFinished_p);
 static tOplkError    finishDownload(tCfmNodeInfo* pNodeInfo_p);
+static tOplkError    closeConnection(tCfmNodeInfo* pNodeInfo_p);
+static void          removeWaitingNode(tCfmNodeInfo* pNodeInfo_p);
+static void          startWaitingNodes(void);
+
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+static void          verifyCache(tCfmNodeInfo* pNodeInfo_p,
+                                 const tIdentResponse* pIdentResponse_p,
+                                 UINT32 expConfDate_p,
+                                 UINT32 expConfTime_p,
+                                 BOOL* pfDoUpdate_p);
+static void          updateCache(tCfmNodeInfo* pNodeInfo_p);
+static void          getCdcConfId(const UINT8* pCdc_p,
+                                  UINT32 size_p,
+                                  UINT32* pConfDate_p,
+                                  UINT32* pConfTime_p);
+#endif
 
 #if defined(CONFIG_INCLUDE_NMT_RMN)
 static tOplkError    downloadNetConf(tCfmNodeInfo* pNodeInfo_p);
@@ -210,6 +263,12 @@ tOplkError cfmu_init(tCfmCbEventCnProgress pfnCbEventCnProgress_p,
     cfmInstance_g.pfnCbEventCnProgress = pfnCbEventCnProgress_p;
     cfmInstance_g.pfnCbEventCnResult = pfnCbEventCnResult_p;
 
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+    ret = cfmcache_init();
+    if (ret != kErrorOk)
+        return ret;
+#endif
+
     // link domain with 4 zero-bytes to object 0x1F22 CFM_ConciseDcfList_ADOM
     varParam.pData = &cfmInstance_g.leDomainSizeNull;
     varParam.size = (tObdSize)sizeof(cfmInstance_g.leDomainSizeNull);
@@ -260,6 +319,9 @@ tOplkError cfmu_exit(void)
             if (pNodeInfo->sdoComConHdl != UINT_MAX)
                 sdocom_abortTransfer(pNodeInfo->sdoComConHdl, SDO_AC_DATA_NOT_TRANSF_DUE_DEVICE_STATE);
 
+            if (pNodeInfo->pBatchBuffer != NULL)
+                OPLK_FREE(pNodeInfo->pBatchBuffer);
+
             pBuffer = pNodeInfo->pObdBufferConciseDcf;
             if (pBuffer != NULL)
             {
@@ -276,7 +338,61 @@ tOplkError cfmu_exit(void)
         }
     }
 
+    cfmInstance_g.pFirstWaiting = NULL;
+    cfmInstance_g.pLastWaiting = NULL;
+    cfmInstance_g.activeNodeCount = 0;
+
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+    cfmInstance_g.fCacheEnabled = FALSE;
+    cfmcache_exit();
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set path of configuration cache
+
+The function sets the directory of the configuration cache and loads the
+cache. The cache records per CN the ConciseDCF and the identity of the
+configuration which was last verified on the CN. It allows the CFM to skip the
+download to CNs whose stored configuration is unchanged and to detect
+ConciseDCF changes which were not accompanied by a new configuration date or
+time.
+
+\param[in]      pCachePath_p        Directory of the configuration cache.
+
+\return The function returns a tOplkError error code.
+\retval kErrorApiInvalidParam       The path is invalid or the configuration
+                                    cache is not available.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmu_setCachePath(const char* pCachePath_p)
+{
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+    tOplkError  ret;
+
+    ret = cfmcache_setArchivePath(pCachePath_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = cfmcache_load(cfmInstance_g.aCacheEntry, NMT_MAX_NODE_ID);
+    if (ret != kErrorOk)
+    {
+        DEBUG_LVL_CFM_TRACE("No valid configuration cache found (0x%X)\n", ret);
+    }
+
+    cfmInstance_g.fCacheEnabled = TRUE;
+
     return kErrorOk;
+#else
+    UNUSED_PARAMETER(pCachePath_p);
+
+    return kErrorApiInvalidParam;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -336,14 +452,12 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
                 return ret;
 
             // close connection
-            ret = sdocom_undefineConnection(pNodeInfo->sdoComConHdl);
-            pNodeInfo->sdoComConHdl = UINT_MAX;
+            ret = closeConnection(pNodeInfo);
             if (ret != kErrorOk)
-            {
-                DEBUG_LVL_CFM_TRACE("SDO Free Error!\n");
                 return ret;
-            }
         }
+        else
+            removeWaitingNode(pNodeInfo);
 
         // Set node CFM state to idle
         pNodeInfo->cfmState = kCfmStateIdle;
@@ -356,6 +470,13 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
     }
 
     pNodeInfo->curDataSize = 0;
+    pNodeInfo->curEntryCount = 0;
+    pNodeInfo->startTime = target_getTickCount();
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+    OPLK_MEMSET(&pNodeInfo->cacheEntry, 0, sizeof(tCfmCacheEntry));
+#endif
+    pNodeInfo->eventCnProgress.totalNumberOfObjects = 0;
+    pNodeInfo->eventCnProgress.objectsDownloaded = 0;
 
     // fetch pointer to ConciseDCF from object 0x1F22
     // (this allows the application to link its own memory to this object)
@@ -387,6 +508,10 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
         return kErrorInvalidNodeId;
     }
 
+    // several ConciseDCF entries are transferred at once if the CN supports it
+    pNodeInfo->fWriteMultiple = ((CONFIG_CFM_MAX_BATCH_SIZE != 0) &&
+                                 ((ami_getUint32Le(&pIdentResponse->featureFlagsLe) & NMT_FEATUREFLAGS_SDO_RW_MULTIPLE) != 0));
+
 #if defined(CONFIG_INCLUDE_NMT_RMN)
     if (ami_getUint32Le(&pIdentResponse->featureFlagsLe) & NMT_FEATUREFLAGS_CFM)
     {
@@ -406,6 +531,7 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
 #endif
 
     pNodeInfo->entriesRemaining = ami_getUint32Le(pNodeInfo->pDataConciseDcf);
+    pNodeInfo->eventCnProgress.totalNumberOfObjects = pNodeInfo->entriesRemaining;
     pNodeInfo->pDataConciseDcf += sizeof(UINT32);
     pNodeInfo->bytesRemaining -= sizeof(UINT32);
     pNodeInfo->eventCnProgress.bytesDownloaded += sizeof(UINT32);
@@ -452,6 +578,10 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
             // do not store configuration in CN at the end of the download
             pNodeInfo->fDoStore = FALSE;
         }
+
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+        verifyCache(pNodeInfo, pIdentResponse, expConfDate, expConfTime, &fDoUpdate);
+#endif
     }
 
 #if (CONFIG_CFM_CONFIGURE_CYCLE_LENGTH != FALSE)
@@ -472,6 +602,10 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
         // current version is already available on the CN, no need to write new values, we can continue
         DEBUG_LVL_CFM_TRACE("CN%x - Configuration up to date\n", nodeId_p);
 
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+        updateCache(pNodeInfo);
+#endif
+
         ret = downloadCycleLength(pNodeInfo);
         if (ret == kErrorReject)
             pNodeInfo->cfmState = kCfmStateUpToDate;
@@ -509,7 +643,7 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
 
         pNodeInfo->eventCnProgress.objectIndex = 0x1011;
         pNodeInfo->eventCnProgress.objectSubIndex = 0x01;
-        ret = sdoWriteObject(pNodeInfo, &leSignature, sizeof(leSignature));
+        ret = sdoWriteObject(pNodeInfo, &leSignature, sizeof(leSignature), kSdoAccessTypeWrite);
         if (ret == kErrorOk)
         {   // SDO transfer started
             ret = kErrorReject;
@@ -584,9 +718,13 @@ tOplkError cfmu_cbObdAccess(tObdCbParam* pParam_p)
     if ((pNodeInfo != NULL) && (pNodeInfo->sdoComConHdl != UINT_MAX))
         ret = sdocom_abortTransfer(pNodeInfo->sdoComConHdl, SDO_AC_DATA_NOT_TRANSF_DUE_DEVICE_STATE);
 
+    // the data is only written in place if it is a buffer of the CFM,
+    // e.g. a ConciseDCF linked to a mapped CDC file is read-only
     pMemVStringDomain = (tObdVStringDomain*)pParam_p->pArg;
     if ((pMemVStringDomain->objSize != pMemVStringDomain->downloadSize) ||
-        (pMemVStringDomain->pData == NULL))
+        (pMemVStringDomain->pData == NULL) ||
+        (pNodeInfo == NULL) ||
+        (pMemVStringDomain->pData != pNodeInfo->pObdBufferConciseDcf))
     {
         pNodeInfo = allocNodeInfo(pParam_p->subIndex);
         if (pNodeInfo == NULL)
@@ -670,6 +808,8 @@ static tOplkError callCbProgress(tCfmNodeInfo* pNodeInfo_p)
 {
     tOplkError  ret = kErrorOk;
 
+    pNodeInfo_p->eventCnProgress.elapsedTimeMs = target_getTickCount() - pNodeInfo_p->startTime;
+
     if (cfmInstance_g.pfnCbEventCnProgress != NULL)
         ret = cfmInstance_g.pfnCbEventCnProgress(&pNodeInfo_p->eventCnProgress);
 
@@ -696,19 +836,21 @@ The function calls the result callback function of the specified node.
 static tOplkError finishConfig(tCfmNodeInfo* pNodeInfo_p,
                                tNmtNodeCommand nmtNodeCommand_p)
 {
-    tOplkError  ret = kErrorOk;
+    tOplkError  ret;
 
-    if (pNodeInfo_p->sdoComConHdl != UINT_MAX)
+    removeWaitingNode(pNodeInfo_p);
+
+    // the batch buffer is only needed during the download
+    if (pNodeInfo_p->pBatchBuffer != NULL)
     {
-        ret = sdocom_undefineConnection(pNodeInfo_p->sdoComConHdl);
-        pNodeInfo_p->sdoComConHdl = UINT_MAX;
-        if (ret != kErrorOk)
-        {
-            DEBUG_LVL_CFM_TRACE("SDO Free Error!\n");
-            return ret;
-        }
+        OPLK_FREE(pNodeInfo_p->pBatchBuffer);
+        pNodeInfo_p->pBatchBuffer = NULL;
     }
 
+    ret = closeConnection(pNodeInfo_p);
+    if (ret != kErrorOk)
+        return ret;
+
     pNodeInfo_p->cfmState = kCfmStateIdle;
     if (cfmInstance_g.pfnCbEventCnResult != NULL)
         ret = cfmInstance_g.pfnCbEventCnResult(pNodeInfo_p->eventCnProgress.nodeId, nmtNodeCommand_p);
@@ -738,7 +880,34 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
         return kErrorInvalidNodeId;
 
     pNodeInfo->eventCnProgress.sdoAbortCode = pSdoComFinished_p->abortCode;
-    pNodeInfo->eventCnProgress.bytesDownloaded += pSdoComFinished_p->transferredBytes;
+
+    if (pSdoComFinished_p->sdoAccessType == kSdoAccessTypeWriteMultiple)
+    {
+        if (pSdoComFinished_p->sdoComConState == kSdoComTransferFinished)
+        {   // the transferred bytes contain the sub-transfer headers
+            pNodeInfo->eventCnProgress.bytesDownloaded += pNodeInfo->batchDataSize;
+        }
+        else if ((pNodeInfo->cfmState == kCfmStateDownload) &&
+                 (pSdoComFinished_p->abortCode == SDO_AC_UNKNOWN_COMMAND_SPECIFIER))
+        {   // CN does not support the service -> rewind and write the entries one by one
+            DEBUG_LVL_CFM_TRACE("CN%x - Write multiple parameter by index not supported\n",
+                                pNodeInfo->eventCnProgress.nodeId);
+            pNodeInfo->fWriteMultiple = FALSE;
+            pNodeInfo->entriesRemaining += pNodeInfo->curEntryCount;
+            pNodeInfo->eventCnProgress.bytesDownloaded -= pNodeInfo->curEntryCount * CDC_OFFSET_DATA;
+            pNodeInfo->eventCnProgress.sdoAbortCode = 0;
+            pNodeInfo->curEntryCount = 0;
+            pNodeInfo->curDataSize = 0;
+            return downloadObject(pNodeInfo);
+        }
+        else
+        {   // report the object which failed
+            pNodeInfo->eventCnProgress.objectIndex = pSdoComFinished_p->targetIndex;
+            pNodeInfo->eventCnProgress.objectSubIndex = pSdoComFinished_p->targetSubIndex;
+        }
+    }
+    else
+        pNodeInfo->eventCnProgress.bytesDownloaded += pSdoComFinished_p->transferredBytes;
 
     ret = callCbProgress(pNodeInfo);
     if (ret != kErrorOk)
@@ -796,6 +965,12 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
             break;
 
         case kCfmStateWaitStore:
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+            // the CN keeps the downloaded configuration from now on
+            if (pSdoComFinished_p->sdoComConState == kSdoComTransferFinished)
+                updateCache(pNodeInfo);
+#endif
+
             ret = downloadCycleLength(pNodeInfo);
             if (ret == kErrorReject)
             {
@@ -835,7 +1010,7 @@ static tOplkError downloadCycleLength(tCfmNodeInfo* pNodeInfo_p)
     pNodeInfo_p->eventCnProgress.objectIndex = 0x1006;
     pNodeInfo_p->eventCnProgress.objectSubIndex = 0x00;
 
-    ret = sdoWriteObject(pNodeInfo_p, &cfmInstance_g.leCycleLength, sizeof(UINT32));
+    ret = sdoWriteObject(pNodeInfo_p, &cfmInstance_g.leCycleLength, sizeof(UINT32), kSdoAccessTypeWrite);
     if (ret == kErrorOk)
     {   // SDO transfer started
         ret = kErrorReject;
@@ -871,9 +1046,22 @@ static tOplkError downloadObject(tCfmNodeInfo* pNodeInfo_p)
     // forward data pointer for last transfer
     pNodeInfo_p->pDataConciseDcf += pNodeInfo_p->curDataSize;
     pNodeInfo_p->bytesRemaining -= pNodeInfo_p->curDataSize;
+    pNodeInfo_p->curDataSize = 0;
+    pNodeInfo_p->eventCnProgress.objectsDownloaded += pNodeInfo_p->curEntryCount;
+    pNodeInfo_p->curEntryCount = 0;
 
     if (pNodeInfo_p->entriesRemaining > 0)
     {
+        if (pNodeInfo_p->fWriteMultiple && (pNodeInfo_p->entriesRemaining > 1))
+        {
+            ret = downloadObjectBatch(pNodeInfo_p);
+            if (ret != kErrorRetry)
+                return ret;
+
+            // no batch possible -> write the next entry with a single transfer
+            ret = kErrorOk;
+        }
+
         if (pNodeInfo_p->bytesRemaining < CDC_OFFSET_DATA)
         {
             // not enough bytes left in ConciseDCF
@@ -908,7 +1096,8 @@ static tOplkError downloadObject(tCfmNodeInfo* pNodeInfo_p)
         }
 
         pNodeInfo_p->entriesRemaining--;
-        ret = sdoWriteObject(pNodeInfo_p, pNodeInfo_p->pDataConciseDcf, pNodeInfo_p->curDataSize);
+        pNodeInfo_p->curEntryCount = 1;
+        ret = sdoWriteObject(pNodeInfo_p, pNodeInfo_p->pDataConciseDcf, pNodeInfo_p->curDataSize, kSdoAccessTypeWrite);
         if (ret != kErrorOk)
             return ret;
     }
@@ -926,6 +1115,90 @@ static tOplkError downloadObject(tCfmNodeInfo* pNodeInfo_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Download several objects with one SDO transfer
+
+The function packs the next ConciseDCF entries into a write multiple parameter
+by index transfer and starts it. Entries with invalid sizes are left for the
+single object download which reports the error.
+
+\param[in,out]  pNodeInfo_p         Node info of the node for which to download
+                                    the next objects.
+
+\return The function returns a tOplkError error code.
+\retval kErrorRetry                 Less than two entries fit into the transfer,
+                                    the next entry must be written by a single
+                                    transfer.
+*/
+//------------------------------------------------------------------------------
+static tOplkError downloadObjectBatch(tCfmNodeInfo* pNodeInfo_p)
+{
+    const UINT8*    pEntry = pNodeInfo_p->pDataConciseDcf;
+    UINT32          bytesLeft = pNodeInfo_p->bytesRemaining;
+    UINT8*          pSubHdr = NULL;
+    UINT            batchSize = 0;
+    UINT            entryCount = 0;
+    UINT            cdcSize = 0;
+    UINT            dataBytes = 0;
+    UINT            dataSize;
+    UINT            padSize;
+
+    if (pNodeInfo_p->pBatchBuffer == NULL)
+    {
+        pNodeInfo_p->pBatchBuffer = (UINT8*)OPLK_MALLOC(CONFIG_CFM_MAX_BATCH_SIZE);
+        if (pNodeInfo_p->pBatchBuffer == NULL)
+            return kErrorRetry;
+    }
+
+    while (entryCount < pNodeInfo_p->entriesRemaining)
+    {
+        if (bytesLeft < CDC_OFFSET_DATA)
+            break;
+
+        dataSize = (UINT)ami_getUint32Le(&pEntry[CDC_OFFSET_SIZE]);
+        if ((dataSize == 0) || ((bytesLeft - CDC_OFFSET_DATA) < dataSize))
+            break;
+
+        padSize = (4 - (dataSize & SDO_CMDL_WRITEMULTBYINDEX_PAD_MASK)) & SDO_CMDL_WRITEMULTBYINDEX_PAD_MASK;
+        if ((batchSize + SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE + dataSize + padSize) > CONFIG_CFM_MAX_BATCH_SIZE)
+            break;
+
+        // link the previous sub-transfer to this one
+        if (pSubHdr != NULL)
+            ami_setUint32Le(pSubHdr, batchSize);
+
+        pSubHdr = &pNodeInfo_p->pBatchBuffer[batchSize];
+        ami_setUint32Le(&pSubHdr[0], 0);
+        ami_setUint16Le(&pSubHdr[4], ami_getUint16Le(&pEntry[CDC_OFFSET_INDEX]));
+        ami_setUint8Le(&pSubHdr[6], ami_getUint8Le(&pEntry[CDC_OFFSET_SUBINDEX]));
+        ami_setUint8Le(&pSubHdr[7], (UINT8)padSize);
+        OPLK_MEMCPY(&pSubHdr[SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE], &pEntry[CDC_OFFSET_DATA], dataSize);
+        OPLK_MEMSET(&pSubHdr[SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE + dataSize], 0, padSize);
+
+        batchSize += SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE + dataSize + padSize;
+        cdcSize += CDC_OFFSET_DATA + dataSize;
+        dataBytes += dataSize;
+        bytesLeft -= CDC_OFFSET_DATA + dataSize;
+        pEntry += CDC_OFFSET_DATA + dataSize;
+        entryCount++;
+    }
+
+    if (entryCount < 2)
+        return kErrorRetry;
+
+    // the data pointer is forwarded when the transfer has finished successfully
+    pNodeInfo_p->eventCnProgress.objectIndex = ami_getUint16Le(&pNodeInfo_p->pDataConciseDcf[CDC_OFFSET_INDEX]);
+    pNodeInfo_p->eventCnProgress.objectSubIndex = ami_getUint8Le(&pNodeInfo_p->pDataConciseDcf[CDC_OFFSET_SUBINDEX]);
+    pNodeInfo_p->eventCnProgress.bytesDownloaded += entryCount * CDC_OFFSET_DATA;
+    pNodeInfo_p->entriesRemaining -= entryCount;
+    pNodeInfo_p->curEntryCount = entryCount;
+    pNodeInfo_p->curDataSize = cdcSize;
+    pNodeInfo_p->batchDataSize = dataBytes;
+
+    return sdoWriteObject(pNodeInfo_p, pNodeInfo_p->pBatchBuffer, batchSize, kSdoAccessTypeWriteMultiple);
+}
+
 #if defined(CONFIG_INCLUDE_NMT_RMN)
 //------------------------------------------------------------------------------
 /**
@@ -983,7 +1256,7 @@ static tOplkError downloadNetConf(tCfmNodeInfo* pNodeInfo_p)
 
         pNodeInfo_p->entriesRemaining--;
         pNodeInfo_p->eventCnProgress.objectSubIndex = subindex;
-        ret = sdoWriteObject(pNodeInfo_p, pData, (UINT)obdSize);
+        ret = sdoWriteObject(pNodeInfo_p, pData, (UINT)obdSize, kSdoAccessTypeWrite);
         return ret;
     }
 
@@ -1024,7 +1297,7 @@ static tOplkError finishDownload(tCfmNodeInfo* pNodeInfo_p)
             pNodeInfo_p->eventCnProgress.objectIndex = 0x1010;
             pNodeInfo_p->eventCnProgress.objectSubIndex = 0x01;
 
-            ret = sdoWriteObject(pNodeInfo_p, &leSignature, sizeof(leSignature));
+            ret = sdoWriteObject(pNodeInfo_p, &leSignature, sizeof(leSignature), kSdoAccessTypeWrite);
             if (ret != kErrorOk)
                 return ret;
         }
@@ -1052,16 +1325,22 @@ static tOplkError finishDownload(tCfmNodeInfo* pNodeInfo_p)
 
 The function writes the specified entry to the OD of the specified node.
 
+If the maximum number of concurrently configured CNs is reached and the node
+has no open SDO connection, the transfer is deferred until another node
+finishes its configuration.
+
 \param[in,out]  pNodeInfo_p         Node info of the node to write to.
 \param[in]      pLeSrcData_p        Pointer to data in little endian byte order.
 \param[in]      size_p              Size of data.
+\param[in]      sdoAccessType_p     SDO access type (Write or WriteMultiple).
 
 \return The function returns a tOplkError error code.
 */
 //------------------------------------------------------------------------------
 static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                  const void* pLeSrcData_p,
-                                 UINT size_p)
+                                 UINT size_p,
+                                 tSdoAccessType sdoAccessType_p)
 {
     tOplkError                  ret = kErrorOk;
     tSdoComTransParamByIndex    transParamByIndex;
@@ -1071,16 +1350,38 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
 
     if (pNodeInfo_p->sdoComConHdl == UINT_MAX)
     {
+        if (cfmInstance_g.activeNodeCount >= CONFIG_CFM_MAX_CONCURRENT_NODES)
+        {   // wait until the configuration of another node is finished
+            pNodeInfo_p->pPendingData = pLeSrcData_p;
+            pNodeInfo_p->pendingSize = size_p;
+            pNodeInfo_p->pendingAccessType = sdoAccessType_p;
+            if (!pNodeInfo_p->fWaiting)
+            {
+                pNodeInfo_p->fWaiting = TRUE;
+                pNodeInfo_p->pNextWaiting = NULL;
+                if (cfmInstance_g.pLastWaiting != NULL)
+                    cfmInstance_g.pLastWaiting->pNextWaiting = pNodeInfo_p;
+                else
+                    cfmInstance_g.pFirstWaiting = pNodeInfo_p;
+                cfmInstance_g.pLastWaiting = pNodeInfo_p;
+            }
+
+            DEBUG_LVL_CFM_TRACE("CN%x - Waiting for download slot\n", pNodeInfo_p->eventCnProgress.nodeId);
+            return kErrorOk;
+        }
+
         // init command layer connection
         ret = sdocom_defineConnection(&pNodeInfo_p->sdoComConHdl,
                                       pNodeInfo_p->eventCnProgress.nodeId,
                                       kSdoTypeAsnd);
         if ((ret != kErrorOk) && (ret != kErrorSdoComHandleExists))
             return ret;
+
+        cfmInstance_g.activeNodeCount++;
     }
 
     transParamByIndex.pData = (void*)pLeSrcData_p;
-    transParamByIndex.sdoAccessType = kSdoAccessTypeWrite;
+    transParamByIndex.sdoAccessType = sdoAccessType_p;
     transParamByIndex.sdoComConHdl = pNodeInfo_p->sdoComConHdl;
     transParamByIndex.dataSize = size_p;
     transParamByIndex.index = pNodeInfo_p->eventCnProgress.objectIndex;
@@ -1111,7 +1412,11 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                       pNodeInfo_p->eventCnProgress.nodeId,
                                       kSdoTypeAsnd);
         if ((ret != kErrorOk) && (ret != kErrorSdoComHandleExists))
+        {
+            pNodeInfo_p->sdoComConHdl = UINT_MAX;
+            cfmInstance_g.activeNodeCount--;
             return ret;
+        }
 
         // retry transfer
         transParamByIndex.sdoComConHdl = pNodeInfo_p->sdoComConHdl;
@@ -1121,4 +1426,277 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Close SDO connection of node
+
+The function closes the SDO connection of the specified node and passes the
+freed download slot to the nodes waiting for it.
+
+\param[in,out]  pNodeInfo_p         Node info of the node whose connection
+                                    should be closed.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError closeConnection(tCfmNodeInfo* pNodeInfo_p)
+{
+    tOplkError  ret;
+
+    if (pNodeInfo_p->sdoComConHdl == UINT_MAX)
+        return kErrorOk;
+
+    ret = sdocom_undefineConnection(pNodeInfo_p->sdoComConHdl);
+    pNodeInfo_p->sdoComConHdl = UINT_MAX;
+    cfmInstance_g.activeNodeCount--;
+    if (ret != kErrorOk)
+    {
+        DEBUG_LVL_CFM_TRACE("SDO Free Error!\n");
+        return ret;
+    }
+
+    startWaitingNodes();
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove node from download slot queue
+
+The function removes the specified node from the queue of nodes which wait for
+a free download slot.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to remove.
+*/
+//------------------------------------------------------------------------------
+static void removeWaitingNode(tCfmNodeInfo* pNodeInfo_p)
+{
+    tCfmNodeInfo*   pPrev = NULL;
+    tCfmNodeInfo*   pCur;
+
+    if (!pNodeInfo_p->fWaiting)
+        return;
+
+    for (pCur = cfmInstance_g.pFirstWaiting; pCur != NULL; pCur = pCur->pNextWaiting)
+    {
+        if (pCur == pNodeInfo_p)
+        {
+            if (pPrev != NULL)
+                pPrev->pNextWaiting = pCur->pNextWaiting;
+            else
+                cfmInstance_g.pFirstWaiting = pCur->pNextWaiting;
+
+            if (cfmInstance_g.pLastWaiting == pCur)
+                cfmInstance_g.pLastWaiting = pPrev;
+            break;
+        }
+        pPrev = pCur;
+    }
+
+    pNodeInfo_p->fWaiting = FALSE;
+    pNodeInfo_p->pNextWaiting = NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start waiting nodes
+
+The function starts the deferred SDO transfers of the nodes waiting for a
+download slot as long as free slots are available.
+*/
+//------------------------------------------------------------------------------
+static void startWaitingNodes(void)
+{
+    tOplkError      ret;
+    tCfmNodeInfo*   pNodeInfo;
+
+    while ((cfmInstance_g.activeNodeCount < CONFIG_CFM_MAX_CONCURRENT_NODES) &&
+           (cfmInstance_g.pFirstWaiting != NULL))
+    {
+        pNodeInfo = cfmInstance_g.pFirstWaiting;
+        removeWaitingNode(pNodeInfo);
+
+        ret = sdoWriteObject(pNodeInfo,
+                             pNodeInfo->pPendingData,
+                             pNodeInfo->pendingSize,
+                             pNodeInfo->pendingAccessType);
+        if (ret != kErrorOk)
+        {
+            DEBUG_LVL_CFM_TRACE("CN%x - Starting deferred download failed with 0x%X\n",
+                                pNodeInfo->eventCnProgress.nodeId,
+                                ret);
+            pNodeInfo->eventCnProgress.error = ret;
+            callCbProgress(pNodeInfo);
+            finishConfig(pNodeInfo, kNmtNodeCommandConfErr);
+        }
+    }
+}
+
+#if (CONFIG_CFM_USE_CACHE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Verify configuration of node against cache
+
+The function compares the configuration of the specified node with the
+configuration cache. The download is skipped if the CN still holds the
+configuration which was verified last time. It is forced if the ConciseDCF
+was changed since the last verification.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to verify.
+\param[in]      pIdentResponse_p    IdentResponse of the node.
+\param[in]      expConfDate_p       Expected configuration date (0x1F26).
+\param[in]      expConfTime_p       Expected configuration time (0x1F27).
+\param[in,out]  pfDoUpdate_p        Flag indicating whether the configuration
+                                    has to be downloaded.
+*/
+//------------------------------------------------------------------------------
+static void verifyCache(tCfmNodeInfo* pNodeInfo_p,
+                        const tIdentResponse* pIdentResponse_p,
+                        UINT32 expConfDate_p,
+                        UINT32 expConfTime_p,
+                        BOOL* pfDoUpdate_p)
+{
+    UINT                    nodeId = pNodeInfo_p->eventCnProgress.nodeId;
+    tCfmCacheEntry*         pEntry = &pNodeInfo_p->cacheEntry;
+    const tCfmCacheEntry*   pCached = &cfmInstance_g.aCacheEntry[nodeId - 1];
+    const UINT8*            pCdc;
+
+    OPLK_MEMSET(pEntry, 0, sizeof(tCfmCacheEntry));
+    if (!cfmInstance_g.fCacheEnabled)
+        return;
+
+    pCdc = (const UINT8*)obdu_getObjectDataPtr(0x1F22, nodeId);
+    pEntry->cdcSize = (UINT32)obdu_getDataSize(0x1F22, nodeId);
+    pEntry->cdcHash = cfmcache_calculateHash(CFMCACHE_HASH_INIT, pCdc, pEntry->cdcSize);
+    pEntry->vendorId = ami_getUint32Le(&pIdentResponse_p->vendorIdLe);
+    pEntry->productCode = ami_getUint32Le(&pIdentResponse_p->productCodeLe);
+    pEntry->revisionNumber = ami_getUint32Le(&pIdentResponse_p->revisionNumberLe);
+    pEntry->serialNumber = ami_getUint32Le(&pIdentResponse_p->serialNumberLe);
+
+    // the CN reports the configuration date and time written by the ConciseDCF
+    getCdcConfId(pCdc, pEntry->cdcSize, &pEntry->confDate, &pEntry->confTime);
+    if ((pEntry->confDate == 0) && (pEntry->confTime == 0))
+    {
+        pEntry->confDate = expConfDate_p;
+        pEntry->confTime = expConfTime_p;
+    }
+
+    if ((pCached->cdcSize != 0) &&
+        (pCached->vendorId == pEntry->vendorId) &&
+        (pCached->productCode == pEntry->productCode) &&
+        (pCached->revisionNumber == pEntry->revisionNumber) &&
+        (pCached->serialNumber == pEntry->serialNumber))
+    {
+        if ((pCached->cdcHash != pEntry->cdcHash) || (pCached->cdcSize != pEntry->cdcSize))
+        {
+            DEBUG_LVL_CFM_TRACE("CN%x - ConciseDCF changed since last verification\n", nodeId);
+            *pfDoUpdate_p = TRUE;
+        }
+        else if ((OPLK_MEMCMP(pCached, pEntry, sizeof(tCfmCacheEntry)) == 0) &&
+                 ((pEntry->confDate != 0) || (pEntry->confTime != 0)) &&
+                 (ami_getUint32Le(&pIdentResponse_p->verifyConfigurationDateLe) == pEntry->confDate) &&
+                 (ami_getUint32Le(&pIdentResponse_p->verifyConfigurationTimeLe) == pEntry->confTime))
+        {
+            DEBUG_LVL_CFM_TRACE("CN%x - Configuration verified by cache\n", nodeId);
+            *pfDoUpdate_p = FALSE;
+        }
+    }
+
+    // store a configuration with a known identity on the CN, so it can be
+    // verified after the next restart
+    if (*pfDoUpdate_p && !pNodeInfo_p->fDoStore &&
+        ((pEntry->confDate != 0) || (pEntry->confTime != 0)))
+    {
+        pNodeInfo_p->fDoStore = TRUE;
+        pNodeInfo_p->eventCnProgress.totalNumberOfBytes += sizeof(UINT32);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update cache entry of node
+
+The function records the verified configuration of the specified node in the
+configuration cache and writes the cache if the entry has changed.
+
+\param[in]      pNodeInfo_p         Node info of the node whose configuration
+                                    was verified.
+*/
+//------------------------------------------------------------------------------
+static void updateCache(tCfmNodeInfo* pNodeInfo_p)
+{
+    tOplkError          ret;
+    tCfmCacheEntry*     pCached;
+
+    if (!cfmInstance_g.fCacheEnabled || (pNodeInfo_p->cacheEntry.cdcSize == 0))
+        return;
+
+    pCached = &cfmInstance_g.aCacheEntry[pNodeInfo_p->eventCnProgress.nodeId - 1];
+    if (OPLK_MEMCMP(pCached, &pNodeInfo_p->cacheEntry, sizeof(tCfmCacheEntry)) == 0)
+        return;
+
+    OPLK_MEMCPY(pCached, &pNodeInfo_p->cacheEntry, sizeof(tCfmCacheEntry));
+
+    ret = cfmcache_store(cfmInstance_g.aCacheEntry, NMT_MAX_NODE_ID);
+    if (ret != kErrorOk)
+    {
+        DEBUG_LVL_CFM_TRACE("CN%x - Storing configuration cache failed (0x%X)\n",
+                            pNodeInfo_p->eventCnProgress.nodeId,
+                            ret);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get configuration identity from ConciseDCF
+
+The function searches the ConciseDCF for the configuration date and time
+(object 0x1020).
+
+\param[in]      pCdc_p              Pointer to the ConciseDCF.
+\param[in]      size_p              Size of the ConciseDCF.
+\param[out]     pConfDate_p         Configuration date, 0 if not found.
+\param[out]     pConfTime_p         Configuration time, 0 if not found.
+*/
+//------------------------------------------------------------------------------
+static void getCdcConfId(const UINT8* pCdc_p,
+                         UINT32 size_p,
+                         UINT32* pConfDate_p,
+                         UINT32* pConfTime_p)
+{
+    UINT32  entries;
+    UINT32  dataSize;
+
+    *pConfDate_p = 0;
+    *pConfTime_p = 0;
+
+    if ((pCdc_p == NULL) || (size_p < sizeof(UINT32)))
+        return;
+
+    entries = ami_getUint32Le(pCdc_p);
+    pCdc_p += sizeof(UINT32);
+    size_p -= sizeof(UINT32);
+
+    for (; (entries > 0) && (size_p >= CDC_OFFSET_DATA); entries--)
+    {
+        dataSize = ami_getUint32Le(&pCdc_p[CDC_OFFSET_SIZE]);
+        if ((size_p - CDC_OFFSET_DATA) < dataSize)
+            break;
+
+        if ((ami_getUint16Le(&pCdc_p[CDC_OFFSET_INDEX]) == 0x1020) &&
+            (dataSize == sizeof(UINT32)))
+        {
+            if (ami_getUint8Le(&pCdc_p[CDC_OFFSET_SUBINDEX]) == 0x01)
+                *pConfDate_p = ami_getUint32Le(&pCdc_p[CDC_OFFSET_DATA]);
+            else if (ami_getUint8Le(&pCdc_p[CDC_OFFSET_SUBINDEX]) == 0x02)
+                *pConfTime_p = ami_getUint32Le(&pCdc_p[CDC_OFFSET_DATA]);
+        }
+
+        pCdc_p += CDC_OFFSET_DATA + dataSize;
+        size_p -= CDC_OFFSET_DATA + dataSize;
+    }
+}
+#endif
+
 /// \}
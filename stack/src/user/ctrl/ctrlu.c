@@ -1252,6 +1252,36 @@ static tOplkError processUserEvent(const tEvent* pEvent_p)
             break;
 #endif
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+        case kEventTypeCycleHistogram:
+            {
+                const tDllEventCycleHistogram*  pDllData;
+
+                pDllData = (const tDllEventCycleHistogram*)pEvent_p->eventArg.pEventArg;
+
+                apiEventArg.cycleHistogram.histogramId = pDllData->histogramId;
+                apiEventArg.cycleHistogram.pHistogram = &pDllData->histogram;
+
+                eventType = kOplkApiEventCycleHistogram;
+                ret = ctrlu_callUserEventCallback(eventType, &apiEventArg);
+            }
+            break;
+#endif
+
+        case kEventTypeEventStatistics:
+            OPLK_MEMCPY(&apiEventArg.eventStatistics.kernelStatistics,
+                        pEvent_p->eventArg.pEventArg,
+                        sizeof(tEventCalStatistics));
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+            eventucal_getStatistics(&apiEventArg.eventStatistics.userStatistics);
+#else
+            OPLK_MEMSET(&apiEventArg.eventStatistics.userStatistics, 0, sizeof(tEventCalStatistics));
+#endif
+
+            eventType = kOplkApiEventEventStatistics;
+            ret = ctrlu_callUserEventCallback(eventType, &apiEventArg);
+            break;
+
         // at present, there are no other events for this module
         default:
             ret = kErrorInvalidEvent;
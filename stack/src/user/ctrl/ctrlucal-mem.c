@@ -55,7 +55,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define CMD_TIMEOUT_CNT     100     // loop counter for command timeout
+#define CMD_TIMEOUT         1000    // command timeout [ms]
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -154,7 +154,8 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
                                UINT16* pRetVal_p)
 {
     tCtrlCmd    ctrlCmd;
-    int         timeout;
+    UINT32      startTime;
+    UINT32      elapsedTime;
 
     // Check parameter validity
     ASSERT(pRetVal_p != NULL);
@@ -166,11 +167,14 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
     ctrlcal_writeData(offsetof(tCtrlBuf, ctrlCmd),
                       &ctrlCmd,
                       sizeof(tCtrlCmd));
+    ctrlcal_signalCommand();
 
     /* wait for response */
-    for (timeout = 0; timeout < CMD_TIMEOUT_CNT; timeout++)
+    startTime = target_getTickCount();
+    elapsedTime = 0;
+    do
     {
-        target_msleep(10);
+        ctrlcal_waitReturn(CMD_TIMEOUT - elapsedTime);
         ctrlcal_readData(&ctrlCmd,
                          offsetof(tCtrlBuf, ctrlCmd),
                          sizeof(tCtrlCmd));
@@ -179,7 +183,9 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
             *pRetVal_p = ctrlCmd.retVal;
             return kErrorOk;
         }
-    }
+
+        elapsedTime = target_getTickCount() - startTime;
+    } while (elapsedTime < CMD_TIMEOUT);
 
     DEBUG_LVL_ERROR_TRACE("%s() Timeout waiting for return!\n", __func__);
     return kErrorGeneralError;
@@ -6,6 +6,8 @@
 
 This file implements the user event handler CAL module for the Linux
 userspace platform. It uses the circular buffer interface for all event queues.
+The event thread, its doorbell and its statistics are provided by the Linux
+event thread library.
 
 \see eventucalintf-circbuf.c
 
@@ -45,13 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <user/eventucal.h>
 #include <user/eventucalintf.h>
-#include <common/target.h>
-
-#include <time.h>
-#include <fcntl.h>
-#include <pthread.h>
-#include <semaphore.h>
-#include <common/target.h>
+#include <common/eventthread.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -60,7 +56,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define USER_EVENT_THREAD_PRIORITY        45
 
 //------------------------------------------------------------------------------
 // module global vars
@@ -89,10 +84,6 @@ CAL module.
 */
 typedef struct
 {
-    pthread_t               threadId;
-    BOOL                    fStopThread;
-    sem_t*                  semUserData;
-    sem_t*                  semKernelData;
     BOOL                    fInitialized;
 } tEventuCalInstance;
 
@@ -104,9 +95,6 @@ static tEventuCalInstance       instance_l;             ///< Instance variable o
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static void* eventThread(void* arg);
-static void  signalUserEvent(void);
-static void  signalKernelEvent(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -128,15 +116,10 @@ CAL module.
 //------------------------------------------------------------------------------
 tOplkError eventucal_init(void)
 {
-    struct sched_param  schedParam;
-
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
-    if ((instance_l.semUserData = sem_open("/semUserEvent", O_RDWR)) == SEM_FAILED)
-        goto Exit;
-
-    if ((instance_l.semKernelData = sem_open("/semKernelEvent", O_RDWR)) == SEM_FAILED)
-        goto Exit;
+    if (eventthread_init(FALSE) != kErrorOk)
+        return kErrorNoResource;
 
     if (eventucal_initQueueCircbuf(kEventQueueK2U) != kErrorOk)
         goto Exit;
@@ -144,43 +127,29 @@ tOplkError eventucal_init(void)
     if (eventucal_initQueueCircbuf(kEventQueueU2K) != kErrorOk)
         goto Exit;
 
-    eventucal_setSignalingCircbuf(kEventQueueU2K, signalKernelEvent);
-
     if (eventucal_initQueueCircbuf(kEventQueueUInt) != kErrorOk)
         goto Exit;
 
-    eventucal_setSignalingCircbuf(kEventQueueUInt, signalUserEvent);
+    eventucal_setSignalingCircbuf(kEventQueueU2K, eventthread_signalKernelEvent);
 
-    instance_l.fStopThread = FALSE;
-    if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
-        goto Exit;
-
-    schedParam.sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-                              __func__,
-                              schedParam.sched_priority);
-    }
+    eventucal_setSignalingCircbuf(kEventQueueUInt, eventthread_signalUserEvent);
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadId, "oplk-eventu");
-#endif
+    if (eventthread_start(kEventThreadUser,
+                          eventucal_processEventsCircbuf,
+                          kEventQueueK2U,
+                          kEventQueueUInt) != kErrorOk)
+        goto Exit;
 
     instance_l.fInitialized = TRUE;
     return kErrorOk;
 
 Exit:
-    if (instance_l.semUserData != SEM_FAILED)
-        sem_close(instance_l.semUserData);
-
-    if (instance_l.semKernelData != SEM_FAILED)
-        sem_close(instance_l.semKernelData);
-
     eventucal_exitQueueCircbuf(kEventQueueK2U);
     eventucal_exitQueueCircbuf(kEventQueueU2K);
     eventucal_exitQueueCircbuf(kEventQueueUInt);
 
+    eventthread_exit();
+
     return kErrorNoResource;
 }
 
@@ -200,28 +169,15 @@ functions of the queue implementations for each used queue.
 //------------------------------------------------------------------------------
 tOplkError eventucal_exit(void)
 {
-    UINT    i = 0;
-
     if (instance_l.fInitialized == TRUE)
     {
-        instance_l.fStopThread = TRUE;
-        while (instance_l.fStopThread == TRUE)
-        {
-            target_msleep(10);
-            if (i++ > 100)
-            {
-                DEBUG_LVL_EVENTU_TRACE("%s(): Event thread is not terminating, continue shutdown...!\n",
-                                       __func__);
-                break;
-            }
-        }
+        eventthread_stop(kEventThreadUser);
 
         eventucal_exitQueueCircbuf(kEventQueueK2U);
         eventucal_exitQueueCircbuf(kEventQueueU2K);
         eventucal_exitQueueCircbuf(kEventQueueUInt);
 
-        sem_close(instance_l.semUserData);
-        sem_close(instance_l.semKernelData);
+        eventthread_exit();
     }
     instance_l.fInitialized = FALSE;
 
@@ -300,76 +256,27 @@ void eventucal_process(void)
     // Nothing to do, because we use threads
 }
 
-//============================================================================//
-//            P R I V A T E   F U N C T I O N S                               //
-//============================================================================//
-/// \name Private Functions
-/// \{
-
 //------------------------------------------------------------------------------
 /**
-\brief  Event handler thread function
-
-This function contains the main function for the event handler thread.
-
-\param[in,out]  arg                 Thread parameter. Used to access the module instance.
+\brief  Get statistics of user event thread
 
-\return The function returns the thread exit code.
-*/
-//------------------------------------------------------------------------------
-static void* eventThread(void* arg)
-{
-    struct timespec         curTime, timeout;
-    tEventuCalInstance*     pInstance = (tEventuCalInstance*)arg;
-
-    while (!pInstance->fStopThread)
-    {
-        clock_gettime(CLOCK_REALTIME, &curTime);
-        timeout.tv_sec = 0;
-        timeout.tv_nsec = 50000 * 1000;
-        TIMESPECADD(&timeout, &curTime);
-
-        if (sem_timedwait(pInstance->semUserData, &timeout) == 0)
-        {
-            /* first handle all user to kernel events --> higher priority! */
-            if (eventucal_getEventCountCircbuf(kEventQueueK2U) > 0)
-                eventucal_processEventCircbuf(kEventQueueK2U);
-            else
-            {
-                if (eventucal_getEventCountCircbuf(kEventQueueUInt) > 0)
-                    eventucal_processEventCircbuf(kEventQueueUInt);
-            }
-        }
-    }
-    pInstance->fStopThread = FALSE;
+The function returns the wakeup and throughput statistics of the user event
+thread.
 
-    return 0;
-}
-
-//------------------------------------------------------------------------------
-/**
-\brief  Signal a user event
+\param[out]     pStatistics_p       Pointer to store the statistics.
 
-This function signals that a user event has been posted. It will be registered
-in the circular buffer library as signal callback function.
+\ingroup module_eventucal
 */
 //------------------------------------------------------------------------------
-static void signalUserEvent(void)
+void eventucal_getStatistics(tEventCalStatistics* pStatistics_p)
 {
-    sem_post(instance_l.semUserData);
+    eventthread_getStatistics(kEventThreadUser, pStatistics_p);
 }
 
-//------------------------------------------------------------------------------
-/**
-\brief  Signal a kernel event
-
-This function signals that a kernel event has been posted. It will be registered
-in the circular buffer library as signal callback function.
-*/
-//------------------------------------------------------------------------------
-static void signalKernelEvent(void)
-{
-    sem_post(instance_l.semKernelData);
-}
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
 
 /// \}
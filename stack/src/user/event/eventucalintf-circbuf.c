@@ -300,6 +300,95 @@ tOplkError eventucal_processEventCircbuf(tEventQueue eventQueue_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Process several events using circular buffers
+
+This function reads a batch of events from a circular buffer event queue and
+processes them by calling the event handlers process function. The events are
+read with a single batch read, therefore the queue is updated only once per
+batch.
+
+\param[in]      eventQueue_p        Event queue used for reading the events.
+\param[in]      maxEventCount_p     Maximum number of events to be processed.
+\param[out]     pEventCount_p       Pointer to store the number of processed events.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    Function executes correctly
+\retval other                       Error
+
+\ingroup module_eventucal
+*/
+//------------------------------------------------------------------------------
+tOplkError eventucal_processEventsCircbuf(tEventQueue eventQueue_p,
+                                          UINT maxEventCount_p,
+                                          UINT* pEventCount_p)
+{
+    tEvent*             pEvent;
+    tCircBufError       error;
+    tOplkError          ret = kErrorOk;
+    tOplkError          processRet;
+    size_t              aReadSize[CONFIG_EVENT_BATCH_SIZE];
+    size_t              offset = 0;
+    UINT                eventCount;
+    UINT                i;
+    ULONGLONG           aRxBuffer[(sizeof(tEvent) + MAX_EVENT_ARG_SIZE + sizeof(ULONGLONG) - 1) / sizeof(ULONGLONG)];
+
+    // Check parameter validity
+    ASSERT(pEventCount_p != NULL);
+
+    *pEventCount_p = 0;
+
+    if (eventQueue_p > kEventQueueNum)
+        return kErrorInvalidInstanceParam;
+
+    if (instance_l[eventQueue_p] == NULL)
+        return kErrorInvalidInstanceParam;
+
+    if (maxEventCount_p > CONFIG_EVENT_BATCH_SIZE)
+        maxEventCount_p = CONFIG_EVENT_BATCH_SIZE;
+
+    error = circbuf_readBatch(instance_l[eventQueue_p],
+                              aRxBuffer,
+                              sizeof(aRxBuffer),
+                              aReadSize,
+                              maxEventCount_p,
+                              &eventCount);
+    if (error != kCircBufOk)
+    {
+        if (error == kCircBufNoReadableData)
+            return kErrorOk;
+
+        eventu_postError(kEventSourceEventk,
+                         kErrorEventReadError,
+                         sizeof(tCircBufError),
+                         &error);
+
+        return kErrorGeneralError;
+    }
+
+    for (i = 0; i < eventCount; i++)
+    {
+        pEvent = (tEvent*)((UINT8*)aRxBuffer + offset);
+        pEvent->eventArgSize = (aReadSize[i] - sizeof(tEvent));
+
+        if (pEvent->eventArgSize > 0)
+            pEvent->eventArg.pEventArg = (UINT8*)aRxBuffer + offset + sizeof(tEvent);
+        else
+            pEvent->eventArg.pEventArg = NULL;
+
+        // The events are already removed from the queue, so all of them are processed
+        processRet = eventu_process(pEvent);
+        if (ret == kErrorOk)
+            ret = processRet;
+
+        offset += (aReadSize[i] + (CIRCBUF_BATCH_ALIGNMENT - 1)) & ~(CIRCBUF_BATCH_ALIGNMENT - 1);
+    }
+
+    *pEventCount_p = eventCount;
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief Get number of active events
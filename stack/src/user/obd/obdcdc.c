@@ -74,6 +74,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/timeb.h>
 #include <utime.h>
 #include <limits.h>
+#include <sys/mman.h>
 
 #elif (TARGET_SYSTEM == _VXWORKS_)
 
@@ -150,6 +151,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OBDCDC_DISABLE_FILE_SUPPORT     FALSE
 #endif
 
+// CDC files are mapped into memory and the ConciseDCFs of the CNs are linked
+// to object 0x1F22 without copying them
+#ifndef OBDCDC_USE_MMAP
+#if ((TARGET_SYSTEM == _LINUX_) && (OBDCDC_DISABLE_FILE_SUPPORT == FALSE))
+#define OBDCDC_USE_MMAP                 TRUE
+#else
+#define OBDCDC_USE_MMAP                 FALSE
+#endif
+#endif
+
+#define OBDCDC_CONCISEDCF_INDEX         0x1F22  // CFM_ConciseDcfList_ADOM
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -182,13 +195,30 @@ typedef struct
     size_t              cdcSize;
     size_t              bufferSize;
     UINT8*              pCurBuffer;
+    BOOL                fLinkConciseDcf;    ///< Link ConciseDCFs to object 0x1F22 instead of copying them
 } tObdCdcInfo;
 
+#if (OBDCDC_USE_MMAP != FALSE)
+/**
+\brief Range of a ConciseDCF in the mapped CDC
+*/
+typedef struct
+{
+    size_t              offset;             ///< Offset of the ConciseDCF in the mapped CDC
+    size_t              size;               ///< Size of the ConciseDCF, 0 if the CDC contains none
+} tObdCdcRange;
+#endif
+
 typedef struct
 {
     const void*         pCdcBuffer;
     size_t              cdcBufSize;
     const char*         pCdcFilename;
+#if (OBDCDC_USE_MMAP != FALSE)
+    UINT8*              pMappedCdc;                         ///< Mapped CDC file
+    size_t              mappedSize;                         ///< Size of the mapped CDC file
+    tObdCdcRange        aConciseDcf[NMT_MAX_NODE_ID];       ///< ConciseDCFs of the CNs in the mapped CDC
+#endif
 } tObdCdcInstance;
 
 //------------------------------------------------------------------------------
@@ -203,6 +233,11 @@ static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p);
 static tOplkError loadNextBuffer(tObdCdcInfo* pCdcInfo_p, size_t bufferSize);
 static tOplkError loadCdcBuffer(const void* pCdc_p, size_t cdcSize_p);
 static tOplkError loadCdcFile(const char* pCdcFilename_p);
+#if (OBDCDC_USE_MMAP != FALSE)
+static tOplkError mapCdcFile(const char* pCdcFilename_p);
+static void       unmapCdcFile(void);
+static tOplkError linkConciseDcf(UINT nodeId_p, const UINT8* pData_p, size_t size_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -237,6 +272,10 @@ The function exits and cleans up the OBD CDC module.
 //------------------------------------------------------------------------------
 void obdcdc_exit(void)
 {
+#if (OBDCDC_USE_MMAP != FALSE)
+    unmapCdcFile();
+#endif
+
     OPLK_MEMSET(&cdcInstance_l, 0, sizeof(tObdCdcInstance));
 }
 
@@ -330,6 +369,22 @@ static tOplkError loadCdcFile(const char* pCdcFilename_p)
     tObdCdcInfo cdcInfo;
     UINT32      error;
 
+#if (OBDCDC_USE_MMAP != FALSE)
+    if (mapCdcFile(pCdcFilename_p) == kErrorOk)
+    {   // parse the CDC in place
+        OPLK_MEMSET(&cdcInfo, 0, sizeof(tObdCdcInfo));
+        cdcInfo.type = kObdCdcTypeBuffer;
+        cdcInfo.handle.pNextBuffer = cdcInstance_l.pMappedCdc;
+        cdcInfo.cdcSize = cdcInstance_l.mappedSize;
+        cdcInfo.bufferSize = cdcInstance_l.mappedSize;
+        cdcInfo.fLinkConciseDcf = TRUE;
+
+        return processCdc(&cdcInfo);
+    }
+
+    // fall back to reading the file
+#endif
+
     OPLK_MEMSET(&cdcInfo, 0, sizeof(tObdCdcInfo));
     cdcInfo.type = kObdCdcTypeFile;
     cdcInfo.handle.fdCdcFile = open(pCdcFilename_p, O_RDONLY | O_BINARY, 0666);
@@ -454,10 +509,18 @@ static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p)
             return ret;
         }
 
-        ret = obdu_writeEntryFromLe(objectIndex,
-                                    objectSubIndex,
-                                    pCdcInfo_p->pCurBuffer,
-                                    (tObdSize)curDataSize);
+#if (OBDCDC_USE_MMAP != FALSE)
+        if (pCdcInfo_p->fLinkConciseDcf && (objectIndex == OBDCDC_CONCISEDCF_INDEX))
+            ret = linkConciseDcf(objectSubIndex, pCdcInfo_p->pCurBuffer, curDataSize);
+        else
+#endif
+        {
+            ret = obdu_writeEntryFromLe(objectIndex,
+                                        objectSubIndex,
+                                        pCdcInfo_p->pCurBuffer,
+                                        (tObdSize)curDataSize);
+        }
+
         if (ret != kErrorOk)
         {
             tEventObdError  obdError;
@@ -560,6 +623,137 @@ static tOplkError loadNextBuffer(tObdCdcInfo* pCdcInfo_p, size_t bufferSize)
     return ret;
 }
 
+#if (OBDCDC_USE_MMAP != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Map Concise Device Configuration file
+
+The function maps the specified CDC file into memory. A previous mapping is
+released first, so every load reflects the current content of the file. The
+mapping is kept until the module is cleaned up or the CDC is loaded again,
+because the ConciseDCFs of the CNs are linked to the mapped data. The mapping is
+read-only, a write to a linked object relinks it to a buffer of its own.
+
+\param[in]      pCdcFilename_p      The filename of the CDC file to map.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError mapCdcFile(const char* pCdcFilename_p)
+{
+    int         fd;
+    struct stat fileStat;
+    void*       pMap;
+
+    unmapCdcFile();
+
+    fd = open(pCdcFilename_p, O_RDONLY | O_BINARY, 0666);
+    if (fd < 0)
+        return kErrorNoResource;
+
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0))
+    {
+        close(fd);
+        return kErrorNoResource;
+    }
+
+    pMap = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pMap == MAP_FAILED)
+    {
+        DEBUG_LVL_OBD_TRACE("%s: mapping '%s' failed with errno %d\n", __func__, pCdcFilename_p, errno);
+        return kErrorNoResource;
+    }
+
+    // the CDC is parsed sequentially once, the ConciseDCFs are read on demand
+    madvise(pMap, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+    cdcInstance_l.pMappedCdc = (UINT8*)pMap;
+    cdcInstance_l.mappedSize = (size_t)fileStat.st_size;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unmap Concise Device Configuration file
+
+The function unlinks all ConciseDCFs which still point into the mapped CDC file
+and unmaps the file.
+*/
+//------------------------------------------------------------------------------
+static void unmapCdcFile(void)
+{
+    UINT            nodeId;
+    tVarParam       varParam;
+    const UINT8*    pData;
+
+    if (cdcInstance_l.pMappedCdc == NULL)
+        return;
+
+    varParam.pData = NULL;
+    varParam.size = 0;
+    varParam.index = OBDCDC_CONCISEDCF_INDEX;
+    varParam.validFlag = kVarValidAll;
+    for (nodeId = 1; nodeId <= NMT_MAX_NODE_ID; nodeId++)
+    {
+        if (cdcInstance_l.aConciseDcf[nodeId - 1].size == 0)
+            continue;
+
+        // skip objects which were relinked, e.g. by an SDO write
+        pData = (const UINT8*)obdu_getObjectDataPtr(OBDCDC_CONCISEDCF_INDEX, nodeId);
+        if (pData != cdcInstance_l.pMappedCdc + cdcInstance_l.aConciseDcf[nodeId - 1].offset)
+            continue;
+
+        varParam.subindex = nodeId;
+        obdu_defineVar(&varParam);
+        // ignore return code, because the mapping is released anyway
+    }
+
+    munmap(cdcInstance_l.pMappedCdc, cdcInstance_l.mappedSize);
+    cdcInstance_l.pMappedCdc = NULL;
+    cdcInstance_l.mappedSize = 0;
+    OPLK_MEMSET(cdcInstance_l.aConciseDcf, 0, sizeof(cdcInstance_l.aConciseDcf));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link ConciseDCF of CN
+
+The function links the ConciseDCF of the specified CN in the mapped CDC to
+object 0x1F22 and records its range.
+
+\param[in]      nodeId_p            Node ID of the CN.
+\param[in]      pData_p             Pointer to the ConciseDCF in the mapped CDC.
+\param[in]      size_p              Size of the ConciseDCF.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError linkConciseDcf(UINT nodeId_p, const UINT8* pData_p, size_t size_p)
+{
+    tOplkError  ret;
+    tVarParam   varParam;
+
+    if ((nodeId_p == 0) || (nodeId_p > NMT_MAX_NODE_ID))
+        return kErrorObdSubindexNotExist;
+
+    varParam.pData = (void*)pData_p;
+    varParam.size = (tObdSize)size_p;
+    varParam.index = OBDCDC_CONCISEDCF_INDEX;
+    varParam.subindex = nodeId_p;
+    varParam.validFlag = kVarValidAll;
+    ret = obdu_defineVar(&varParam);
+    if (ret != kErrorOk)
+        return ret;
+
+    cdcInstance_l.aConciseDcf[nodeId_p - 1].offset = (size_t)(pData_p - cdcInstance_l.pMappedCdc);
+    cdcInstance_l.aConciseDcf[nodeId_p - 1].size = size_p;
+
+    return kErrorOk;
+}
+#endif
+
 /// \}
 
 #endif
@@ -71,6 +71,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+// the index table is split into pages of 256 indices
+#define OBD_INDEX_TABLE_PAGE_BITS       8
+#define OBD_INDEX_TABLE_PAGE_SIZE       (1 << OBD_INDEX_TABLE_PAGE_BITS)
+#define OBD_INDEX_TABLE_PAGE_COUNT      (0x10000 >> OBD_INDEX_TABLE_PAGE_BITS)
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -88,6 +94,32 @@ typedef struct
     tObdSize        (*pfnGetObjSize)(const tObdSubEntry* pSubIndexEntry_p);
 } tObdDataTypeSize;
 
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+/**
+\brief Page of the OD index table
+
+A page covers 256 consecutive indices. A slot contains the position of the
+index entry in the entry table plus one, or 0 if the index does not exist.
+*/
+typedef struct
+{
+    UINT16                          aSlot[OBD_INDEX_TABLE_PAGE_SIZE];
+} tObdIndexPage;
+
+/**
+\brief OD index table
+
+The index table maps an object index to its index entry with two table
+lookups. Pages are only allocated for index ranges which contain objects.
+*/
+typedef struct
+{
+    tObdIndexPage*                  apPage[OBD_INDEX_TABLE_PAGE_COUNT];     ///< Pages of the table, NULL if a page contains no index
+    const tObdEntry**               ppEntry;                                ///< Index entries referenced by the pages
+    UINT                            numEntries;                             ///< Number of index entries in the table
+} tObdIndexTable;
+#endif
+
 typedef struct
 {
     tObdInitParam                   initParam;
@@ -95,6 +127,9 @@ typedef struct
     tObdStoreLoadCallback           pfnStoreLoadObjectCb;
 #if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
     UINT32                          aOdSignature[3];
+#endif
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+    tObdIndexTable                  indexTable;
 #endif
     UINT8                           obdTrashObject[8];
 } tObdInstance;
@@ -187,6 +222,15 @@ static tOplkError   isNumerical(const tObdSubEntry* pObdSubEntry_p,
 static UINT32       calcPartitionIndexNum(const tObdEntry* pObdEntry_p);
 static void         calcOdIndexNum(tObdInitParam* pInitParam_p);
 
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+static tOplkError   buildIndexTable(const tObdInitParam* pInitParam_p);
+static tOplkError   addPartToIndexTable(const tObdEntry* pObdEntry_p,
+                                        UINT32 numEntries_p,
+                                        UINT firstIndex_p,
+                                        UINT lastIndex_p);
+static void         freeIndexTable(void);
+#endif
+
 #if (CONFIG_OBD_CHECK_OBJECT_RANGE != FALSE)
 static tOplkError   checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
                                      const void* pData_p);
@@ -286,6 +330,12 @@ tOplkError obdu_init(const tObdInitParam* pInitParam_p,
 
     calcOdIndexNum(&obdInstance_l.initParam);
 
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+    ret = buildIndexTable(&obdInstance_l.initParam);
+    if (ret != kErrorOk)
+        return ret;
+#endif
+
     // initialize object dictionary
     // so all all VarEntries will be initialized to trash object and default values will be set to current data
     ret = obdu_accessOdPart(kObdPartAll, kObdDirInit);
@@ -306,6 +356,10 @@ The function shuts down the OD module.
 //------------------------------------------------------------------------------
 tOplkError obdu_exit(void)
 {
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+    freeIndexTable();
+#endif
+
     return kErrorOk;
 }
 
@@ -613,9 +667,14 @@ The function registers a user object dictionary.
 //------------------------------------------------------------------------------
 tOplkError obdu_registerUserOd(const tObdEntry* pUserOd_p)
 {
-    obdInitParam_l.pUserPart = (tObdEntry*)pUserOd_p;
+    obdInstance_l.initParam.pUserPart = (tObdEntry*)pUserOd_p;
+    obdInstance_l.initParam.numUser = (pUserOd_p != NULL) ? calcPartitionIndexNum(pUserOd_p) : 0;
 
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+    return buildIndexTable(&obdInstance_l.initParam);
+#else
     return kErrorOk;
+#endif
 }
 #endif
 
@@ -2382,8 +2441,10 @@ static tObdEntry* searchIndex(const tObdEntry* pObdEntry_p,
             return (tObdEntry*)&pObdEntry_p[middle];
         else if (pObdEntry_p[middle].index < index_p)
             first = middle + 1;
-        else
+        else if (middle > 0)
             last = middle - 1;
+        else
+            break;      // index is lower than the first index of the part
     }
 
     return NULL;
@@ -2445,6 +2506,159 @@ static void calcOdIndexNum(tObdInitParam* pInitParam_p)
 #endif
 }
 
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Build OD index table
+
+The function builds the index table for all OD parts. The table reflects the
+search order of getIndex(): an index is taken from the static OD part which
+covers its range, the user OD part is only used for indices which do not exist
+in the static OD parts.
+
+\param[in]      pInitParam_p        Pointer to the OD initialization parameters.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError buildIndexTable(const tObdInitParam* pInitParam_p)
+{
+    tOplkError  ret;
+    UINT32      numEntries;
+
+    freeIndexTable();
+
+    numEntries = pInitParam_p->numGeneric +
+                 pInitParam_p->numManufacturer +
+                 pInitParam_p->numDevice;
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
+    numEntries += pInitParam_p->numUser;
+#endif
+
+    // the slots of a page can only address 0xFFFF entries
+    if ((numEntries == 0) || (numEntries >= 0xFFFF))
+        return kErrorOk;
+
+    obdInstance_l.indexTable.ppEntry = (const tObdEntry**)OPLK_MALLOC(sizeof(tObdEntry*) * numEntries);
+    if (obdInstance_l.indexTable.ppEntry == NULL)
+        return kErrorNoResource;
+
+    ret = addPartToIndexTable(pInitParam_p->pGenericPart, pInitParam_p->numGeneric, 0x1000, 0x2000);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    ret = addPartToIndexTable(pInitParam_p->pManufacturerPart, pInitParam_p->numManufacturer, 0x2000, 0x6000);
+    if (ret != kErrorOk)
+        goto Exit;
+
+#if (CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART == FALSE)
+    ret = addPartToIndexTable(pInitParam_p->pDevicePart, pInitParam_p->numDevice, 0x6000, 0x9FFF);
+#else
+    ret = addPartToIndexTable(pInitParam_p->pDevicePart, pInitParam_p->numDevice, 0x6000, 0xFFFF);
+#endif
+    if (ret != kErrorOk)
+        goto Exit;
+
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
+    ret = addPartToIndexTable(pInitParam_p->pUserPart, pInitParam_p->numUser, 0x0000, 0x10000);
+#endif
+
+Exit:
+    if (ret != kErrorOk)
+        freeIndexTable();
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add OD part to index table
+
+The function adds the index entries of an OD part whose index is within the
+specified range to the index table. Indices which are already in the table are
+not changed.
+
+\param[in]      pObdEntry_p         Pointer to the first index entry of the part.
+\param[in]      numEntries_p        Number of index entries in the part.
+\param[in]      firstIndex_p        First index of the range.
+\param[in]      lastIndex_p         First index after the range.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError addPartToIndexTable(const tObdEntry* pObdEntry_p,
+                                      UINT32 numEntries_p,
+                                      UINT firstIndex_p,
+                                      UINT lastIndex_p)
+{
+    tObdIndexTable* pTable = &obdInstance_l.indexTable;
+    tObdIndexPage*  pPage;
+    UINT            index;
+    UINT16*         pSlot;
+
+    if (pObdEntry_p == NULL)
+        return kErrorOk;
+
+    for (; numEntries_p > 0; numEntries_p--, pObdEntry_p++)
+    {
+        index = pObdEntry_p->index;
+        if ((index < firstIndex_p) || (index >= lastIndex_p))
+            continue;
+
+        pPage = pTable->apPage[index >> OBD_INDEX_TABLE_PAGE_BITS];
+        if (pPage == NULL)
+        {
+            pPage = (tObdIndexPage*)OPLK_MALLOC(sizeof(tObdIndexPage));
+            if (pPage == NULL)
+                return kErrorNoResource;
+
+            OPLK_MEMSET(pPage, 0, sizeof(tObdIndexPage));
+            pTable->apPage[index >> OBD_INDEX_TABLE_PAGE_BITS] = pPage;
+        }
+
+        pSlot = &pPage->aSlot[index & (OBD_INDEX_TABLE_PAGE_SIZE - 1)];
+        if (*pSlot == 0)
+        {
+            pTable->ppEntry[pTable->numEntries] = pObdEntry_p;
+            pTable->numEntries++;
+            *pSlot = (UINT16)pTable->numEntries;
+        }
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free OD index table
+
+The function frees the memory of the index table.
+*/
+//------------------------------------------------------------------------------
+static void freeIndexTable(void)
+{
+    tObdIndexTable* pTable = &obdInstance_l.indexTable;
+    UINT            page;
+
+    for (page = 0; page < OBD_INDEX_TABLE_PAGE_COUNT; page++)
+    {
+        if (pTable->apPage[page] != NULL)
+        {
+            OPLK_FREE(pTable->apPage[page]);
+            pTable->apPage[page] = NULL;
+        }
+    }
+
+    if (pTable->ppEntry != NULL)
+    {
+        OPLK_FREE(pTable->ppEntry);
+        pTable->ppEntry = NULL;
+    }
+
+    pTable->numEntries = 0;
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get an index entry from the OD
@@ -2467,6 +2681,27 @@ static tOplkError getIndex(const tObdInitParam* pInitParam_p,
 
 #if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
     UINT            nLoop;
+#endif
+
+#if (CONFIG_OBD_USE_INDEX_TABLE != FALSE)
+    const tObdIndexPage*    pPage;
+    UINT                    slot;
+
+    // look up the index in the index table, the search below is only
+    // needed for unknown indices to determine the error code
+    pPage = obdInstance_l.indexTable.apPage[(index_p >> OBD_INDEX_TABLE_PAGE_BITS) & (OBD_INDEX_TABLE_PAGE_COUNT - 1)];
+    if (pPage != NULL)
+    {
+        slot = pPage->aSlot[index_p & (OBD_INDEX_TABLE_PAGE_SIZE - 1)];
+        if (slot != 0)
+        {
+            *ppObdEntry_p = obdInstance_l.indexTable.ppEntry[slot - 1];
+            return kErrorOk;
+        }
+    }
+#endif
+
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
 
     // if user OD is used then objects also has to be searched in user OD
     // there is less code need if we do this in a loop
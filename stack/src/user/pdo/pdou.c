@@ -54,6 +54,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <limits.h>
 
+// Select vectorized kernels for packing and unpacking BOOL runs
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define PDOU_BITS_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define PDOU_BITS_NEON
+#include <arm_neon.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -118,6 +127,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                 pPdoMappObject_p->byteSizeOrType = obdType_p; \
             }
 
+#define PDO_COPYSTEP_BITS_START         0x8000
+
+#define PDO_COPYSTEP_IS_MEMCPY(pCopyStep_p) \
+            ((pCopyStep_p->byteSizeOrType >= PDO_COMMUNICATION_PROFILE_START) && \
+             (pCopyStep_p->byteSizeOrType < PDO_COPYSTEP_BITS_START))
+
+#define PDO_COPYSTEP_IS_BITS(pCopyStep_p) \
+            (pCopyStep_p->byteSizeOrType >= PDO_COPYSTEP_BITS_START)
+
+#define PDO_COPYSTEP_GET_BITCOUNT(pCopyStep_p) \
+            (pCopyStep_p->byteSizeOrType - PDO_COPYSTEP_BITS_START)
+
+#define PDO_COPYSTEP_GET_BYTESIZE(pCopyStep_p) \
+            (pCopyStep_p->byteSizeOrType - PDO_COMMUNICATION_PROFILE_START)
+
+#define PDO_COPYSTEP_GET_TYPE(pCopyStep_p) \
+            ((tObdType)pCopyStep_p->byteSizeOrType)
 
 //------------------------------------------------------------------------------
 // local types
@@ -134,6 +160,23 @@ typedef struct
     UINT16                  byteSizeOrType;         ///< The size of the data in bytes
 } tPdoMappObject;
 
+/**
+\brief PDO copy step
+
+This structure specifies a single step of a compiled PDO copy program. The copy
+program of a PDO channel is built from its mapping objects when the channel is
+configured. Adjacent objects which can be copied without conversion are merged
+into a single memcpy step and adjacent BOOLEAN objects are merged into a single
+bit step, all other objects get a typed conversion step.
+The program is terminated by a step with a NULL variable pointer.
+*/
+typedef struct
+{
+    void*                   pVar;                   ///< Pointer to the (first) variable
+    UINT16                  pdoOffset;              ///< Offset in the PDO channel buffer in bytes (in bits for bit steps)
+    UINT16                  byteSizeOrType;         ///< Size of a memcpy step, bit count of a bit step or type of a conversion step
+} tPdoCopyStep;
+
 /**
 \brief User PDO module instance
 
@@ -143,9 +186,12 @@ typedef struct
 {
     BYTE                    aPdoIdToChannelIdRx[(PDOU_PDO_ID_MASK + 1)]; ///< RXPDO to channel ID conversion table
     BYTE                    aPdoIdToChannelIdTx[(PDOU_PDO_ID_MASK + 1)]; ///< TXPDO to channel ID conversion table
+    BYTE                    aChannelIdToPdoIdRx[D_PDO_RPDOChannels_U16]; ///< RX channel ID to RXPDO conversion table
     tPdoChannelSetup        pdoChannels;                ///< PDO channel setup
     tPdoMappObject*         paRxObject;                 ///< Pointer to RX channel objects
     tPdoMappObject*         paTxObject;                 ///< Pointer to TX channel objects
+    tPdoCopyStep*           paRxCopyStep;               ///< Pointer to RX channel copy programs
+    tPdoCopyStep*           paTxCopyStep;               ///< Pointer to TX channel copy programs
     BOOL                    fAllocated;                 ///< Flag determines if PDOs are allocated
     BOOL                    fRunning;                   ///< Flag determines if PDO engine is running
     BOOL                    fInitialized;               ///< Flag determines if PDO module is initialized
@@ -193,6 +239,7 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
                                            UINT* pOffset_p,
                                            UINT* pNextObjectOffset_p);
 static tOplkError setupMappingObjects(tPdoMappObject* pMappObject_p,
+                                      tPdoCopyStep* pCopyStep_p,
                                       UINT mappParamIndex_p,
                                       BYTE mappObjectCount_p,
                                       UINT16 maxPdoSize_p,
@@ -200,6 +247,11 @@ static tOplkError setupMappingObjects(tPdoMappObject* pMappObject_p,
                                       UINT16* pOffset_p,
                                       UINT16* pNextChannelOffset_p,
                                       UINT16* pCount_p);
+static BOOL getRawCopySize(const tPdoMappObject* pMappObject_p, UINT* pByteSize_p);
+static void compileCopyProgram(const tPdoMappObject* pMappObject_p,
+                               UINT mappObjectCount_p,
+                               UINT16 channelOffset_p,
+                               tPdoCopyStep* pCopyStep_p);
 static tOplkError configurePdoChannel(const tPdoChannelConf* pChannelConf_p);
 static tOplkError getMaxPdoSize(BYTE nodeId_p,
                                 BOOL fTxPdo_p,
@@ -209,12 +261,12 @@ static tOplkError getPdoChannelId(UINT pdoId_p, BOOL fTxPdo_p, UINT* pChannelId_
 static UINT calcPdoMemSize(const tPdoChannelSetup* pPdoChannels_p,
                            size_t* pRxPdoMemSize_p,
                            size_t* pTxPdoMemSize_p);
-static tOplkError copyVarToPdo(BYTE* pPayload_p,
-                               const tPdoMappObject* pMappObject_p,
-                               UINT16 offsetInFrame_p);
-static tOplkError copyVarFromPdo(const BYTE* pPayload_p,
-                                 const tPdoMappObject* pMappObject_p,
-                                 UINT16 offsetInFrame_p);
+static void copyProgramToPdo(BYTE* pPdo_p, const tPdoCopyStep* pCopyStep_p);
+static void copyProgramFromPdo(const BYTE* pPdo_p, const tPdoCopyStep* pCopyStep_p);
+static void copyVarToPdo(BYTE* pPayload_p, const tPdoCopyStep* pCopyStep_p);
+static void copyVarFromPdo(const BYTE* pPayload_p, const tPdoCopyStep* pCopyStep_p);
+static void packBitsToPdo(BYTE* pPdo_p, UINT bitOffset_p, const UINT8* pVar_p, UINT bitCount_p);
+static void unpackBitsFromPdo(const BYTE* pPdo_p, UINT bitOffset_p, UINT8* pVar_p, UINT bitCount_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -480,9 +532,7 @@ The function copies RXPDOs into the process image
 tOplkError pdou_copyRxPdoToPi(void)
 {
     tOplkError              ret;
-    UINT                    mappObjectCount;
     const tPdoChannel*      pPdoChannel;
-    const tPdoMappObject*   pMappObject;
     UINT                    channelId;
     UINT8*                  pPdo;
 
@@ -519,18 +569,8 @@ tOplkError pdou_copyRxPdoToPi(void)
                             pPdoChannel->nodeId,
                             pPdo);
 
-        for (mappObjectCount = pPdoChannel->mappObjectCount,
-             pMappObject = pdouInstance_g.paRxObject + (channelId * D_PDO_RPDOChannelObjects_U8);
-             mappObjectCount > 0;
-             mappObjectCount--, pMappObject++)
-        {
-            ret = copyVarFromPdo(pPdo, pMappObject, pPdoChannel->offset);
-            if (ret != kErrorOk)
-            {   // other fatal error occurred
-                target_unlockMutex(pdouInstance_g.lockMutex);
-                return ret;
-            }
-        }
+        copyProgramFromPdo(pPdo,
+                           pdouInstance_g.paRxCopyStep + (channelId * (D_PDO_RPDOChannelObjects_U8 + 1)));
     }
 
     target_unlockMutex(pdouInstance_g.lockMutex);
@@ -553,9 +593,7 @@ The function copies the TXPDOs from the process image into the PDO buffers.
 tOplkError pdou_copyTxPdoFromPi(void)
 {
     tOplkError              ret = kErrorOk;
-    UINT                    mappObjectCount;
     const tPdoChannel*      pPdoChannel;
-    const tPdoMappObject*   pMappObject;
     UINT                    channelId;
     BYTE*                   pPdo;
 
@@ -587,18 +625,8 @@ tOplkError pdou_copyTxPdoFromPi(void)
                             channelId,
                             pPdo);
 
-        for (mappObjectCount = pPdoChannel->mappObjectCount,
-             pMappObject = pdouInstance_g.paTxObject + (channelId * D_PDO_TPDOChannelObjects_U8);
-             mappObjectCount > 0;
-             mappObjectCount--, pMappObject++)
-        {
-            ret = copyVarToPdo(pPdo, pMappObject, pPdoChannel->offset);
-            if (ret != kErrorOk)
-            {   // other fatal error occurred
-                target_unlockMutex(pdouInstance_g.lockMutex);
-                return ret;
-            }
-        }
+        copyProgramToPdo(pPdo,
+                         pdouInstance_g.paTxCopyStep + (channelId * (D_PDO_TPDOChannelObjects_U8 + 1)));
 
         // send PDO data to kernel layer
         ret = pdoucal_setTxPdo(channelId,
@@ -611,6 +639,128 @@ tOplkError pdou_copyTxPdoFromPi(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange RXPDO buffers
+
+The function switches the buffers of all active RXPDO channels, so that the
+most recently received data of each channel can be accessed directly via
+pdou_getRxPdoBuffer(). In contrast to pdou_copyRxPdoToPi() no data is copied.
+Both functions consume the received PDOs and must therefore not be mixed.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_exchangeRxPdoBuffers(void)
+{
+    tOplkError              ret = kErrorOk;
+    const tPdoChannel*      pPdoChannel;
+    UINT                    channelId;
+    UINT8*                  pPdo;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    if (!pdouInstance_g.fRunning)
+    {
+        target_unlockMutex(pdouInstance_g.lockMutex);
+        return kErrorOk;
+    }
+
+    for (channelId = 0;
+         channelId < pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++)
+    {
+        pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[channelId];
+
+        if (pPdoChannel->nodeId == PDO_INVALID_NODE_ID)
+            continue;
+
+        ret = pdoucal_getRxPdo(&pPdo, channelId, pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+        if (ret != kErrorOk)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s pdoucal_getRxPdo failed with 0x%X\n",
+                                  __func__,
+                                  ret);
+            break;
+        }
+    }
+
+    target_unlockMutex(pdouInstance_g.lockMutex);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get RXPDO buffer
+
+The function returns the address of the buffer containing the RXPDO data
+which was made current by the last call of pdou_exchangeRxPdoBuffers(). The
+buffer contains the PDO payload of the channel in frame layout (little endian)
+starting at the offset of the first mapped object. The address stays valid until
+the next call of pdou_exchangeRxPdoBuffers() or until the PDO is reconfigured.
+
+\param[in]      mappParamIndex_p    Object index of RXPDO mapping parameter.
+\param[out]     ppPdo_p             Pointer to store the address of the buffer.
+\param[out]     pOffset_p           Pointer to store the offset of the buffer
+                                    data in the frame payload.
+\param[out]     pSize_p             Pointer to store the size of the buffer.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The buffer is returned successfully.
+\retval kErrorPdoInvalidObjIndex    The specified RXPDO does not exist.
+\retval kErrorPdoNotExist           The specified RXPDO is not enabled.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_getRxPdoBuffer(UINT mappParamIndex_p,
+                               const void** ppPdo_p,
+                               UINT* pOffset_p,
+                               UINT* pSize_p)
+{
+    tOplkError          ret = kErrorOk;
+    const tPdoChannel*  pPdoChannel;
+    UINT                pdoId;
+    UINT                channelId;
+
+    if ((mappParamIndex_p & PDOU_OBD_IDX_MASK) != PDOU_OBD_IDX_RX_MAPP_PARAM)
+        return kErrorPdoInvalidObjIndex;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    pdoId = mappParamIndex_p & PDOU_PDO_ID_MASK;
+    channelId = pdouInstance_g.aPdoIdToChannelIdRx[pdoId];
+
+    if (!pdouInstance_g.fRunning ||
+        (channelId >= pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount) ||
+        (pdouInstance_g.aChannelIdToPdoIdRx[channelId] != pdoId))
+    {
+        ret = kErrorPdoInvalidObjIndex;
+        goto Exit;
+    }
+
+    pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[channelId];
+    if (pPdoChannel->nodeId == PDO_INVALID_NODE_ID)
+    {
+        ret = kErrorPdoNotExist;
+        goto Exit;
+    }
+
+    *ppPdo_p = pdoucal_getRxPdoAdrs(channelId);
+    *pOffset_p = pPdoChannel->offset;
+    *pSize_p = pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+
+Exit:
+    target_unlockMutex(pdouInstance_g.lockMutex);
+
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Register PDO change callback function
@@ -862,6 +1012,12 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paRxObject = NULL;
         }
 
+        if (pdouInstance_g.paRxCopyStep != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paRxCopyStep);
+            pdouInstance_g.paRxCopyStep = NULL;
+        }
+
         if (pAllocationParam_p->rxPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pRxPdoChannel =
@@ -883,6 +1039,17 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+            // each copy program is terminated by an additional step
+            pdouInstance_g.paRxCopyStep =
+                    (tPdoCopyStep*)OPLK_MALLOC(sizeof(tPdoCopyStep)
+                               * pAllocationParam_p->rxPdoChannelCount
+                               * (D_PDO_RPDOChannelObjects_U8 + 1));
+            if (pdouInstance_g.paRxCopyStep == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
         }
     }
 
@@ -908,6 +1075,12 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paTxObject = NULL;
         }
 
+        if (pdouInstance_g.paTxCopyStep != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paTxCopyStep);
+            pdouInstance_g.paTxCopyStep = NULL;
+        }
+
         if (pAllocationParam_p->txPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pTxPdoChannel =
@@ -927,6 +1100,17 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+            // each copy program is terminated by an additional step
+            pdouInstance_g.paTxCopyStep =
+                    (tPdoCopyStep*)OPLK_MALLOC(sizeof(tPdoCopyStep)
+                               * pAllocationParam_p->txPdoChannelCount
+                               * (D_PDO_TPDOChannelObjects_U8 + 1));
+            if (pdouInstance_g.paTxCopyStep == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
         }
     }
 
@@ -966,6 +1150,12 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paRxObject = NULL;
     }
 
+    if (pdouInstance_g.paRxCopyStep != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paRxCopyStep);
+        pdouInstance_g.paRxCopyStep = NULL;
+    }
+
     if (pdouInstance_g.pdoChannels.pTxPdoChannel != NULL)
     {
         OPLK_FREE(pdouInstance_g.pdoChannels.pTxPdoChannel);
@@ -978,6 +1168,12 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paTxObject = NULL;
     }
 
+    if (pdouInstance_g.paTxCopyStep != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paTxCopyStep);
+        pdouInstance_g.paTxCopyStep = NULL;
+    }
+
     return ret;
 }
 
@@ -993,14 +1189,14 @@ The function configures the whole PDO mapping information in the pdok module.
 static tOplkError configureAllPdos(void)
 {
     tOplkError          ret = kErrorOk;
-    BYTE                aChannelIdToPdoIdRx[D_PDO_RPDOChannels_U16];
     BYTE                aChannelIdToPdoIdTx[D_PDO_TPDOChannels_U16];
     tPdoAllocationParam allocParam;
     UINT32              abortCode = 0;
     size_t              txPdoMemSize;
     size_t              rxPdoMemSize;
 
-    ret = setupRxPdoChannelTables(aChannelIdToPdoIdRx, &allocParam.rxPdoChannelCount);
+    ret = setupRxPdoChannelTables(pdouInstance_g.aChannelIdToPdoIdRx,
+                                  &allocParam.rxPdoChannelCount);
     if (ret != kErrorOk)
         goto Exit;
 
@@ -1021,7 +1217,7 @@ static tOplkError configureAllPdos(void)
     // configure the PDOs
     ret = checkAndConfigurePdos(PDOU_OBD_IDX_RX_MAPP_PARAM,
                                 allocParam.rxPdoChannelCount,
-                                aChannelIdToPdoIdRx,
+                                pdouInstance_g.aChannelIdToPdoIdRx,
                                 &abortCode);
     if (ret != kErrorOk)
         goto Exit;
@@ -1117,6 +1313,7 @@ static tOplkError checkAndConfigurePdo(UINT16 mappParamIndex_p,
     tPdoChannelConf pdoChannelConf;
     BOOL            fTxPdo;
     tPdoMappObject* pMappObject;
+    tPdoCopyStep*   pCopyStep;
     UINT16          offset;
     UINT16          nextChannelOffset;
     UINT16          count;
@@ -1212,13 +1409,22 @@ static tOplkError checkAndConfigurePdo(UINT16 mappParamIndex_p,
     }
 
     if (fTxPdo)
+    {
         pMappObject = &pdouInstance_g.paTxObject[pdoChannelConf.channelId *
                                                  D_PDO_TPDOChannelObjects_U8];
+        pCopyStep = &pdouInstance_g.paTxCopyStep[pdoChannelConf.channelId *
+                                                 (D_PDO_TPDOChannelObjects_U8 + 1)];
+    }
     else
+    {
         pMappObject = &pdouInstance_g.paRxObject[pdoChannelConf.channelId *
                                                  D_PDO_RPDOChannelObjects_U8];
+        pCopyStep = &pdouInstance_g.paRxCopyStep[pdoChannelConf.channelId *
+                                                 (D_PDO_RPDOChannelObjects_U8 + 1)];
+    }
 
     ret = setupMappingObjects(pMappObject,
+                              pCopyStep,
                               mappParamIndex_p,
                               mappObjectCount_p,
                               maxPdoSize,
@@ -1515,13 +1721,6 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
     // decode object mapping
     decodeObjectMapping(objectMapping_p, &index, &subIndex, &bitOffset, &bitSize);
 
-    if ((bitOffset & 0x7) != 0x0)
-    {   // bit mapping is not supported
-        *pAbortCode_p = SDO_AC_GENERAL_ERROR;
-        ret = kErrorPdoGranularityMismatch;
-        goto Exit;
-    }
-
     ret = obdu_getType(index, subIndex, &obdType);
     if (ret != kErrorOk)
     {   // entry doesn't exist
@@ -1530,9 +1729,23 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
         goto Exit;
     }
 
-    if (((bitSize & 0x7) != 0x0) &&
-        ((bitSize != 1) || (obdType != kObdTypeBool)))
-    {   // bit mapping is not supported, except for BOOLEAN objects on byte boundaries
+    if (obdType == kObdTypeBool)
+    {
+        if (bitSize == 8)
+        {   // byte-sized BOOLEAN objects are copied like UNSIGNED8 values
+            obdType = kObdTypeUInt8;
+        }
+        else if (bitSize != 1)
+        {   // BOOLEAN objects are mapped as single bit or as byte
+            *pAbortCode_p = SDO_AC_GENERAL_ERROR;
+            ret = kErrorPdoGranularityMismatch;
+            goto Exit;
+        }
+    }
+
+    if ((obdType != kObdTypeBool) &&
+        (((bitOffset & 0x7) != 0x0) || ((bitSize & 0x7) != 0x0)))
+    {   // bit mapping is not supported, except for BOOLEAN objects
         *pAbortCode_p = SDO_AC_GENERAL_ERROR;
         ret = kErrorPdoGranularityMismatch;
         goto Exit;
@@ -1562,7 +1775,7 @@ static tOplkError checkAndSetObjectMapping(QWORD objectMapping_p,
     }
 
     if (obdType == kObdTypeBool)
-    {   // bit size of BOOLEAN object was checked above
+    {   // bit-packed BOOLEAN objects occupy a single bit in the PDO but a byte in the OD
         byteSize = 1;
     }
     else
@@ -1627,9 +1840,12 @@ Exit:
 /**
 \brief  setup mapping objects in PDO channel configuration
 
-The function sets up the mapping objects of a PDO channel.
+The function sets up the mapping objects of a PDO channel and compiles them
+into the copy program of the channel.
 
 \param[in,out]  pMappObject_p           Pointer to PDO mapping object.
+\param[out]     pCopyStep_p             Pointer to store the copy program of
+                                        the PDO channel.
 \param[in]      mappParamIndex_p        ID of mapping parameter object.
 \param[in]      mappObjectCount_p       Number of mapping objects.
 \param[in]      maxPdoSize_p            Maximum PDO size.
@@ -1644,6 +1860,7 @@ The function sets up the mapping objects of a PDO channel.
 */
 //------------------------------------------------------------------------------
 static tOplkError setupMappingObjects(tPdoMappObject* pMappObject_p,
+                                      tPdoCopyStep* pCopyStep_p,
                                       UINT mappParamIndex_p,
                                       BYTE mappObjectCount_p,
                                       UINT16 maxPdoSize_p,
@@ -1652,16 +1869,17 @@ static tOplkError setupMappingObjects(tPdoMappObject* pMappObject_p,
                                       UINT16* pNextChannelOffset_p,
                                       UINT16* pCount_p)
 {
-    tOplkError  ret = kErrorOk;
-    tObdSize    obdSize;
-    QWORD       objectMapping;
-    UINT        count = 0;
-    BYTE        mappSubindex;
-    UINT        offset;
-    UINT        nextObjectOffset;
-    UINT16      calcNextObjectOffset = 0;
-    UINT16      calcOffset = USHRT_MAX;
-    tObdAccess  neededAccessType;
+    tOplkError              ret = kErrorOk;
+    tObdSize                obdSize;
+    QWORD                   objectMapping;
+    UINT                    count = 0;
+    BYTE                    mappSubindex;
+    UINT                    offset;
+    UINT                    nextObjectOffset;
+    UINT16                  calcNextObjectOffset = 0;
+    UINT16                  calcOffset = USHRT_MAX;
+    tObdAccess              neededAccessType;
+    const tPdoMappObject*   pFirstMappObject = pMappObject_p;
 
     for (mappSubindex = 1; mappSubindex <= mappObjectCount_p; mappSubindex++)
     {
@@ -1711,6 +1929,8 @@ static tOplkError setupMappingObjects(tPdoMappObject* pMappObject_p,
         count ++;
     }
 
+    compileCopyProgram(pFirstMappObject, count, calcOffset, pCopyStep_p);
+
     *pOffset_p = calcOffset;
     *pNextChannelOffset_p = calcNextObjectOffset;
     *pCount_p = count;
@@ -1747,46 +1967,253 @@ static void decodeObjectMapping(QWORD objectMapping_p,
 
 //------------------------------------------------------------------------------
 /**
-\brief  Copy variable to PDO
+\brief  Get raw copy size of mapping object
 
-This function copies a variable specified by the mapping object to the PDO
-payload.
+The function determines whether the given mapping object can be exchanged by a
+plain memory copy, i.e. its representation in the PDO equals the one of the
+variable. This applies to strings and domains on all platforms and to 8, 16,
+32 and 64 bit numerical types on little endian platforms.
 
-\param[in,out]  pPayload_p          Pointer to PDO payload in destination frame.
 \param[in]      pMappObject_p       Pointer to mapping object.
-\param[in]      offsetInFrame_p     Offset of the PDO data in the frame.
+\param[out]     pByteSize_p         Pointer to store the size of the object in bytes.
 
-\return The function returns a tOplkError error code.
-**/
+\return The function returns TRUE if the object can be copied without conversion.
+*/
 //------------------------------------------------------------------------------
-static tOplkError copyVarToPdo(BYTE* pPayload_p,
-                               const tPdoMappObject* pMappObject_p,
-                               UINT16 offsetInFrame_p)
+static BOOL getRawCopySize(const tPdoMappObject* pMappObject_p, UINT* pByteSize_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        byteOffset;
-    void*       pVar;
-
-    byteOffset = PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) >> 3;
-    pPayload_p = pPayload_p + byteOffset - offsetInFrame_p;
-    pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+    UINT    byteSize;
 
     switch (PDO_MAPPOBJECT_GET_TYPE(pMappObject_p))
     {
-        //-----------------------------------------------
-        // types without ami
+        case kObdTypeInt8:
+        case kObdTypeUInt8:
+            *pByteSize_p = 1;
+            return TRUE;
+
+        case kObdTypeInt16:
+        case kObdTypeUInt16:
+            byteSize = 2;
+            break;
+
+        case kObdTypeInt32:
+        case kObdTypeUInt32:
+        case kObdTypeReal32:
+            byteSize = 4;
+            break;
+
+        case kObdTypeInt64:
+        case kObdTypeUInt64:
+        case kObdTypeReal64:
+            byteSize = 8;
+            break;
+
+        // BOOLEAN values are packed into bits, 24, 40, 48 and 56 bit values
+        // are stored in larger variables and time values have a different
+        // layout, so they always need conversion
+        case kObdTypeBool:
+        case kObdTypeInt24:
+        case kObdTypeUInt24:
+        case kObdTypeInt40:
+        case kObdTypeUInt40:
+        case kObdTypeInt48:
+        case kObdTypeUInt48:
+        case kObdTypeInt56:
+        case kObdTypeUInt56:
+        case kObdTypeTimeOfDay:
+        case kObdTypeTimeDiff:
+            return FALSE;
+
         case kObdTypeVString:
         case kObdTypeOString:
         case kObdTypeDomain:
         default:
-            // read value from object
-            OPLK_MEMCPY(pPayload_p, pVar, PDO_MAPPOBJECT_GET_BYTESIZE(pMappObject_p));
+            *pByteSize_p = PDO_MAPPOBJECT_GET_BYTESIZE(pMappObject_p);
+            return TRUE;
+    }
+
+    if (CHECK_IF_BIG_ENDIAN())
+        return FALSE;
+
+    *pByteSize_p = byteSize;
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compile copy program of a PDO channel
+
+The function compiles the mapping objects of a PDO channel into a copy program.
+An object which can be copied without conversion is merged into the previous
+memcpy step if it directly follows that step in the PDO as well as in memory.
+In the same way, BOOLEAN objects are merged into bit steps which are packed and
+unpacked as a whole. The resulting program is terminated by a step with a NULL
+variable pointer.
+
+\param[in]      pMappObject_p       Pointer to the first mapping object of the
+                                    channel.
+\param[in]      mappObjectCount_p   Number of mapping objects.
+\param[in]      channelOffset_p     Offset of the PDO channel in the frame.
+\param[out]     pCopyStep_p         Pointer to store the copy program. It must
+                                    provide space for mappObjectCount_p + 1
+                                    steps.
+*/
+//------------------------------------------------------------------------------
+static void compileCopyProgram(const tPdoMappObject* pMappObject_p,
+                               UINT mappObjectCount_p,
+                               UINT16 channelOffset_p,
+                               tPdoCopyStep* pCopyStep_p)
+{
+    tPdoCopyStep*   pPrevStep = NULL;
+    UINT            byteSize;
+    UINT16          pdoOffset;
+    UINT16          pdoBitOffset;
+
+    for (; mappObjectCount_p > 0; mappObjectCount_p--, pMappObject_p++)
+    {
+        pdoOffset = (UINT16)((PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) >> 3) - channelOffset_p);
+
+        if (PDO_MAPPOBJECT_GET_TYPE(pMappObject_p) == kObdTypeBool)
+        {
+            pdoBitOffset = (UINT16)(PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) - (channelOffset_p << 3));
+
+            if ((pPrevStep != NULL) &&
+                PDO_COPYSTEP_IS_BITS(pPrevStep) &&
+                ((pPrevStep->pdoOffset + PDO_COPYSTEP_GET_BITCOUNT(pPrevStep)) == pdoBitOffset) &&
+                (((BYTE*)pPrevStep->pVar + PDO_COPYSTEP_GET_BITCOUNT(pPrevStep)) ==
+                 (BYTE*)PDO_MAPPOBJECT_GET_VAR(pMappObject_p)))
+            {   // bit directly follows the previous bit step -> extend it
+                pPrevStep->byteSizeOrType++;
+                continue;
+            }
+
+            pCopyStep_p->pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+            pCopyStep_p->pdoOffset = pdoBitOffset;
+            pCopyStep_p->byteSizeOrType = PDO_COPYSTEP_BITS_START + 1;
+            pPrevStep = pCopyStep_p++;
+            continue;
+        }
+
+        if (!getRawCopySize(pMappObject_p, &byteSize))
+        {   // object needs a typed conversion
+            pCopyStep_p->pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+            pCopyStep_p->pdoOffset = pdoOffset;
+            pCopyStep_p->byteSizeOrType = PDO_MAPPOBJECT_GET_TYPE(pMappObject_p);
+            pPrevStep = pCopyStep_p++;
+            continue;
+        }
+
+        if ((pPrevStep != NULL) &&
+            PDO_COPYSTEP_IS_MEMCPY(pPrevStep) &&
+            ((pPrevStep->pdoOffset + PDO_COPYSTEP_GET_BYTESIZE(pPrevStep)) == pdoOffset) &&
+            (((BYTE*)pPrevStep->pVar + PDO_COPYSTEP_GET_BYTESIZE(pPrevStep)) ==
+             (BYTE*)PDO_MAPPOBJECT_GET_VAR(pMappObject_p)))
+        {   // object directly follows the previous memcpy step -> extend it
+            pPrevStep->byteSizeOrType += (UINT16)byteSize;
+            continue;
+        }
+
+        pCopyStep_p->pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+        pCopyStep_p->pdoOffset = pdoOffset;
+        pCopyStep_p->byteSizeOrType = (UINT16)(byteSize + PDO_COMMUNICATION_PROFILE_START);
+        pPrevStep = pCopyStep_p++;
+    }
+
+    pCopyStep_p->pVar = NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run copy program to PDO
+
+This function runs the copy program of a PDO channel to copy the mapped
+variables into the PDO buffer of the channel.
+
+\param[out]     pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      pCopyStep_p         Pointer to copy program of the channel.
+**/
+//------------------------------------------------------------------------------
+static void copyProgramToPdo(BYTE* pPdo_p, const tPdoCopyStep* pCopyStep_p)
+{
+    for (; pCopyStep_p->pVar != NULL; pCopyStep_p++)
+    {
+        if (PDO_COPYSTEP_IS_MEMCPY(pCopyStep_p))
+        {
+            OPLK_MEMCPY(pPdo_p + pCopyStep_p->pdoOffset,
+                        pCopyStep_p->pVar,
+                        PDO_COPYSTEP_GET_BYTESIZE(pCopyStep_p));
+        }
+        else if (PDO_COPYSTEP_IS_BITS(pCopyStep_p))
+        {
+            packBitsToPdo(pPdo_p,
+                          pCopyStep_p->pdoOffset,
+                          (const UINT8*)pCopyStep_p->pVar,
+                          PDO_COPYSTEP_GET_BITCOUNT(pCopyStep_p));
+        }
+        else
+            copyVarToPdo(pPdo_p + pCopyStep_p->pdoOffset, pCopyStep_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run copy program from PDO
+
+This function runs the copy program of a PDO channel to copy the PDO buffer of
+the channel into the mapped variables.
+
+\param[in]      pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      pCopyStep_p         Pointer to copy program of the channel.
+**/
+//------------------------------------------------------------------------------
+static void copyProgramFromPdo(const BYTE* pPdo_p, const tPdoCopyStep* pCopyStep_p)
+{
+    for (; pCopyStep_p->pVar != NULL; pCopyStep_p++)
+    {
+        if (PDO_COPYSTEP_IS_MEMCPY(pCopyStep_p))
+        {
+            OPLK_MEMCPY(pCopyStep_p->pVar,
+                        pPdo_p + pCopyStep_p->pdoOffset,
+                        PDO_COPYSTEP_GET_BYTESIZE(pCopyStep_p));
+        }
+        else if (PDO_COPYSTEP_IS_BITS(pCopyStep_p))
+        {
+            unpackBitsFromPdo(pPdo_p,
+                              pCopyStep_p->pdoOffset,
+                              (UINT8*)pCopyStep_p->pVar,
+                              PDO_COPYSTEP_GET_BITCOUNT(pCopyStep_p));
+        }
+        else
+            copyVarFromPdo(pPdo_p + pCopyStep_p->pdoOffset, pCopyStep_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy variable to PDO
+
+This function copies a variable specified by a conversion step of a copy
+program to the PDO payload.
+
+\param[out]     pPayload_p          Pointer to the position of the variable in
+                                    the PDO payload.
+\param[in]      pCopyStep_p         Pointer to copy step.
+**/
+//------------------------------------------------------------------------------
+static void copyVarToPdo(BYTE* pPayload_p, const tPdoCopyStep* pCopyStep_p)
+{
+    const void* pVar = pCopyStep_p->pVar;
+
+    switch (PDO_COPYSTEP_GET_TYPE(pCopyStep_p))
+    {
+        //-----------------------------------------------
+        // types without ami are copied by memcpy steps
+        default:
             break;
 
         //-----------------------------------------------
         // numerical type which needs ami-write
-        // 8 bit or smaller values
-        case kObdTypeBool:
+        // 8 bit values
         case kObdTypeInt8:
         case kObdTypeUInt8:
             ami_setUint8Le(pPayload_p, *((const UINT8*)pVar));
@@ -1842,52 +2269,34 @@ static tOplkError copyVarToPdo(BYTE* pPayload_p,
             ami_setTimeOfDay(pPayload_p, (const tTimeOfDay*)pVar);
             break;
     }
-
-    return ret;
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Copy variable from PDO
 
-This function copies a variable specified by the mapping object from the PDO
-payload.
-
-\param[in]      pPayload_p          Pointer to PDO payload in destination frame.
-\param[in]      pMappObject_p       Pointer to mapping object.
-\param[in]      offsetInFrame_p     Offset of the PDO data in the frame.
+This function copies a variable specified by a conversion step of a copy
+program from the PDO payload.
 
-\return The function returns a tOplkError error code.
+\param[in]      pPayload_p          Pointer to the position of the variable in
+                                    the PDO payload.
+\param[in]      pCopyStep_p         Pointer to copy step.
 **/
 //------------------------------------------------------------------------------
-static tOplkError copyVarFromPdo(const BYTE* pPayload_p,
-                                 const tPdoMappObject* pMappObject_p,
-                                 UINT16 offsetInFrame_p)
+static void copyVarFromPdo(const BYTE* pPayload_p, const tPdoCopyStep* pCopyStep_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        byteOffset;
-    void*       pVar;
+    void*   pVar = pCopyStep_p->pVar;
 
-    byteOffset = PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) >> 3;
-    pPayload_p = pPayload_p + byteOffset - offsetInFrame_p;
-    pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
-
-    switch (PDO_MAPPOBJECT_GET_TYPE(pMappObject_p))
+    switch (PDO_COPYSTEP_GET_TYPE(pCopyStep_p))
     {
         //-----------------------------------------------
-        // types without ami
-        case kObdTypeVString:
-        case kObdTypeOString:
-        case kObdTypeDomain:
+        // types without ami are copied by memcpy steps
         default:
-            // read value from object
-            OPLK_MEMCPY(pVar, pPayload_p, PDO_MAPPOBJECT_GET_BYTESIZE(pMappObject_p));
             break;
 
         //-----------------------------------------------
         // numerical type which needs ami-write
-        // 8 bit or smaller values
-        case kObdTypeBool:
+        // 8 bit values
         case kObdTypeInt8:
         case kObdTypeUInt8:
             *((UINT8*)pVar) = ami_getUint8Le(pPayload_p);
@@ -1943,8 +2352,163 @@ static tOplkError copyVarFromPdo(const BYTE* pPayload_p,
             ami_getTimeOfDay(pPayload_p, (tTimeOfDay*)pVar);
             break;
     }
+}
 
-    return ret;
+//------------------------------------------------------------------------------
+/**
+\brief  Pack BOOLEAN variables into PDO
+
+This function packs a run of consecutive BOOLEAN variables into consecutive bits
+of the PDO buffer. Bits which share a byte with other objects are updated
+individually, whole bytes are packed 16 variables at a time with SSE2 or NEON
+instructions if available.
+
+\param[out]     pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      bitOffset_p         Offset of the first bit in the PDO buffer.
+\param[in]      pVar_p              Pointer to the first BOOLEAN variable.
+\param[in]      bitCount_p          Number of variables to pack.
+**/
+//------------------------------------------------------------------------------
+static void packBitsToPdo(BYTE* pPdo_p, UINT bitOffset_p, const UINT8* pVar_p, UINT bitCount_p)
+{
+    BYTE*       pDest = pPdo_p + (bitOffset_p >> 3);
+    UINT        bitPos = bitOffset_p & 0x7;
+    BYTE        value;
+#if defined(PDOU_BITS_SSE2)
+    const __m128i       zero = _mm_setzero_si128();
+    int                 mask;
+#elif defined(PDOU_BITS_NEON)
+    static const UINT8  aBitMask[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    const uint8x16_t    bitMask = vld1q_u8(aBitMask);
+    uint8x16_t          vars;
+    uint8x8_t           sum;
+#endif
+
+    // Pack leading bits up to the next byte boundary
+    if (bitPos != 0)
+    {
+        for (; (bitPos < 8) && (bitCount_p > 0); bitPos++, bitCount_p--, pVar_p++)
+        {
+            if (*pVar_p != 0)
+                *pDest |= (BYTE)(1 << bitPos);
+            else
+                *pDest &= (BYTE)~(1 << bitPos);
+        }
+        pDest++;
+    }
+
+#if defined(PDOU_BITS_SSE2)
+    for (; bitCount_p >= 16; bitCount_p -= 16, pVar_p += 16, pDest += 2)
+    {
+        mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)pVar_p), zero));
+        pDest[0] = (BYTE)mask;
+        pDest[1] = (BYTE)(mask >> 8);
+    }
+#elif defined(PDOU_BITS_NEON)
+    for (; bitCount_p >= 16; bitCount_p -= 16, pVar_p += 16, pDest += 2)
+    {
+        vars = vld1q_u8(pVar_p);
+        vars = vandq_u8(vtstq_u8(vars, vars), bitMask);
+        sum = vpadd_u8(vget_low_u8(vars), vget_high_u8(vars));
+        sum = vpadd_u8(sum, sum);
+        sum = vpadd_u8(sum, sum);
+        pDest[0] = vget_lane_u8(sum, 0);
+        pDest[1] = vget_lane_u8(sum, 1);
+    }
+#endif
+
+    // Pack remaining whole bytes
+    for (; bitCount_p >= 8; bitCount_p -= 8, pVar_p += 8)
+    {
+        value = 0;
+        for (bitPos = 0; bitPos < 8; bitPos++)
+        {
+            if (pVar_p[bitPos] != 0)
+                value |= (BYTE)(1 << bitPos);
+        }
+        *pDest++ = value;
+    }
+
+    // Pack trailing bits
+    for (bitPos = 0; bitPos < bitCount_p; bitPos++)
+    {
+        if (pVar_p[bitPos] != 0)
+            *pDest |= (BYTE)(1 << bitPos);
+        else
+            *pDest &= (BYTE)~(1 << bitPos);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unpack BOOLEAN variables from PDO
+
+This function unpacks consecutive bits of the PDO buffer into a run of
+consecutive BOOLEAN variables. Whole bytes are unpacked 16 bits at a time with
+SSE2 or NEON instructions if available.
+
+\param[in]      pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      bitOffset_p         Offset of the first bit in the PDO buffer.
+\param[out]     pVar_p              Pointer to the first BOOLEAN variable.
+\param[in]      bitCount_p          Number of variables to unpack.
+**/
+//------------------------------------------------------------------------------
+static void unpackBitsFromPdo(const BYTE* pPdo_p, UINT bitOffset_p, UINT8* pVar_p, UINT bitCount_p)
+{
+    const BYTE* pSrc = pPdo_p + (bitOffset_p >> 3);
+    UINT        bitPos = bitOffset_p & 0x7;
+#if defined(PDOU_BITS_SSE2)
+    const __m128i       bitMask = _mm_set_epi8((char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                               (char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i       one = _mm_set1_epi8(1);
+    __m128i             bits;
+#elif defined(PDOU_BITS_NEON)
+    static const UINT8  aBitMask[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    const uint8x16_t    bitMask = vld1q_u8(aBitMask);
+    const uint8x16_t    one = vdupq_n_u8(1);
+    uint8x16_t          bits;
+#endif
+
+    // Unpack leading bits up to the next byte boundary
+    if (bitPos != 0)
+    {
+        for (; (bitPos < 8) && (bitCount_p > 0); bitPos++, bitCount_p--)
+            *pVar_p++ = (*pSrc >> bitPos) & 0x01;
+        pSrc++;
+    }
+
+#if defined(PDOU_BITS_SSE2)
+    for (; bitCount_p >= 16; bitCount_p -= 16, pVar_p += 16, pSrc += 2)
+    {
+        // Replicate each of the two bytes eight times
+        bits = _mm_cvtsi32_si128(pSrc[0] | (pSrc[1] << 8));
+        bits = _mm_unpacklo_epi8(bits, bits);
+        bits = _mm_unpacklo_epi16(bits, bits);
+        bits = _mm_unpacklo_epi32(bits, bits);
+        bits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(bits, bitMask), bitMask), one);
+        _mm_storeu_si128((__m128i*)pVar_p, bits);
+    }
+#elif defined(PDOU_BITS_NEON)
+    for (; bitCount_p >= 16; bitCount_p -= 16, pVar_p += 16, pSrc += 2)
+    {
+        bits = vcombine_u8(vdup_n_u8(pSrc[0]), vdup_n_u8(pSrc[1]));
+        bits = vandq_u8(vtstq_u8(bits, bitMask), one);
+        vst1q_u8(pVar_p, bits);
+    }
+#endif
+
+    // Unpack remaining bits
+    for (bitPos = 0; bitCount_p > 0; bitCount_p--, pVar_p++)
+    {
+        *pVar_p = (*pSrc >> bitPos) & 0x01;
+        if (++bitPos == 8)
+        {
+            bitPos = 0;
+            pSrc++;
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -309,6 +309,31 @@ tOplkError pdoucal_getRxPdo(UINT8** ppPdo_p,
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get address of RX PDO buffer
+
+The function returns the address of the RXPDO buffer which is currently used
+for consuming data of the specified channel. In contrast to pdoucal_getRxPdo()
+the buffers are not switched, i.e. the address stays the same until the next
+call of pdoucal_getRxPdo() for this channel.
+
+\param[in]      channelId_p         The PDO channel ID of the PDO to get the address.
+
+\return Returns the address of the specified PDO buffer.
+
+\ingroup module_pdoucal
+*/
+//------------------------------------------------------------------------------
+UINT8* pdoucal_getRxPdoAdrs(UINT channelId_p)
+{
+    OPLK_ATOMIC_T   readBuf;
+
+    readBuf = pPdoMem_l->rxChannelInfo[channelId_p].readBuf;
+
+    return pTripleBuf_l[readBuf] + pPdoMem_l->rxChannelInfo[channelId_p].channelOffset;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
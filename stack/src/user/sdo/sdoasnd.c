@@ -54,10 +54,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
-#ifndef CONFIG_SDO_MAX_CONNECTION_ASND
-#define CONFIG_SDO_MAX_CONNECTION_ASND     5
-#endif
-
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -82,6 +78,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef struct
 {
     UINT                aSdoAsndConnection[CONFIG_SDO_MAX_CONNECTION_ASND];
+    UINT16              aNodeIdToConnection[C_ADR_BROADCAST];               // connection index + 1 per node ID, 0 if none
+    UINT16              aFreeConnection[CONFIG_SDO_MAX_CONNECTION_ASND];    // stack of free connection indices
+    UINT                freeConnectionCount;
     tSequLayerReceiveCb pfnSdoAsySeqCb;
 } tSdoAsndInstance;
 
@@ -95,6 +94,7 @@ static tSdoAsndInstance  sdoAsndInstance_l;
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p);
+static UINT       allocConnection(UINT nodeId_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -116,9 +116,14 @@ The function initializes a first instance of the SDO over ASnd module.
 tOplkError sdoasnd_init(tSequLayerReceiveCb pfnReceiveCb_p)
 {
     tOplkError  ret;
+    UINT        count;
 
     OPLK_MEMSET(&sdoAsndInstance_l, 0x00, sizeof(sdoAsndInstance_l));
 
+    // the lowest connection index is allocated first
+    for (count = CONFIG_SDO_MAX_CONNECTION_ASND; count > 0; count--)
+        sdoAsndInstance_l.aFreeConnection[sdoAsndInstance_l.freeConnectionCount++] = (UINT16)(count - 1);
+
     if (pfnReceiveCb_p != NULL)
         sdoAsndInstance_l.pfnSdoAsySeqCb = pfnReceiveCb_p;
     else
@@ -168,10 +173,7 @@ The function initializes a SDO over ASnd connection to a node.
 //------------------------------------------------------------------------------
 tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        count;
-    UINT        freeCon;
-    UINT*       pConnection;
+    UINT        array;
 
     // Check parameter validity
     ASSERT(pSdoConHandle_p != NULL);
@@ -180,41 +182,15 @@ tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
         (targetNodeId_p >= C_ADR_BROADCAST))
         return kErrorSdoAsndInvalidNodeId;
 
-    // get free entry in control structure
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_ASND;
-    pConnection = &sdoAsndInstance_l.aSdoAsndConnection[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_ASND)
-    {
-        if (*pConnection == targetNodeId_p)
-        {   // existing connection to target node found
-            // save handle for higher layer
-            *pSdoConHandle_p = (count | SDO_ASND_HANDLE);
-            return ret;
-        }
-        else if (*pConnection == 0)
-        {   // free entry-> save target nodeId
-            freeCon = count;
-        }
-
-        count++;
-        pConnection++;
-    }
+    // reuse an existing connection to the target node or get a free one
+    array = allocConnection(targetNodeId_p);
+    if (array == CONFIG_SDO_MAX_CONNECTION_ASND)
+        return kErrorSdoAsndNoFreeHandle;
 
-    if (freeCon == CONFIG_SDO_MAX_CONNECTION_ASND)
-    {
-        // no free connection
-        ret = kErrorSdoAsndNoFreeHandle;
-    }
-    else
-    {
-        pConnection = &sdoAsndInstance_l.aSdoAsndConnection[freeCon];
-        *pConnection = targetNodeId_p;
-        // save handle for higher layer
-        *pSdoConHandle_p = (freeCon | SDO_ASND_HANDLE);
-    }
+    // save handle for higher layer
+    *pSdoConHandle_p = (array | SDO_ASND_HANDLE);
 
-    return ret;
+    return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
@@ -242,7 +218,7 @@ tOplkError sdoasnd_sendData(tSdoConHdl sdoConHandle_p,
 
     array = (sdoConHandle_p & ~SDO_ASY_HANDLE_MASK);
 
-    if (array > CONFIG_SDO_MAX_CONNECTION_ASND)
+    if (array >= CONFIG_SDO_MAX_CONNECTION_ASND)
         return kErrorSdoAsndInvalidHandle;
 
     // fill Asnd header
@@ -277,18 +253,27 @@ The function deletes an existing SDO over ASnd connection.
 //------------------------------------------------------------------------------
 tOplkError sdoasnd_deleteCon(tSdoConHdl sdoConHandle_p)
 {
-    tOplkError  ret = kErrorOk;
     UINT        array;
+    UINT        nodeId;
 
     array = (sdoConHandle_p & ~SDO_ASY_HANDLE_MASK);
-    if (array > CONFIG_SDO_MAX_CONNECTION_ASND)
+    if (array >= CONFIG_SDO_MAX_CONNECTION_ASND)
         return kErrorSdoAsndInvalidHandle;
 
-    // set target nodeId to 0
+    nodeId = sdoAsndInstance_l.aSdoAsndConnection[array];
+    if (nodeId == 0)
+    {   // connection is already deleted
+        return kErrorOk;
+    }
+
+    // set target nodeId to 0 and return the entry to the free entries
+    sdoAsndInstance_l.aNodeIdToConnection[nodeId] = 0;
     sdoAsndInstance_l.aSdoAsndConnection[array] = 0;
+    sdoAsndInstance_l.aFreeConnection[sdoAsndInstance_l.freeConnectionCount++] = (UINT16)array;
 
-    return ret;
+    return kErrorOk;
 }
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -311,44 +296,25 @@ static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
 {
     tOplkError      ret = kErrorOk;
     UINT            count;
-    UINT*           pConnection;
     UINT            nodeId;
-    UINT            freeEntry = 0xFFFF;
     tSdoConHdl      sdoConHdl;
     tPlkFrame*      pFrame;
 
     pFrame = pFrameInfo_p->frame.pBuffer;
     nodeId = ami_getUint8Le(&pFrame->srcNodeId);
 
-    // search corresponding entry in control structure
-    count = 0;
-    pConnection = &sdoAsndInstance_l.aSdoAsndConnection[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_ASND)
+    if ((nodeId == C_ADR_INVALID) || (nodeId >= C_ADR_BROADCAST))
     {
-        if (nodeId == *pConnection)
-            break;
-        else if ((*pConnection == 0) && (freeEntry == 0xFFFF))
-        {   // free entry
-            freeEntry = count;
-        }
-
-        count++;
-        pConnection++;
+        DEBUG_LVL_SDO_TRACE("%s(): invalid source node ID %u\n", __func__, nodeId);
+        return ret;
     }
 
+    // get corresponding entry in control structure or a free one
+    count = allocConnection(nodeId);
     if (count == CONFIG_SDO_MAX_CONNECTION_ASND)
     {
-        if (freeEntry != 0xFFFF)
-        {
-            pConnection = &sdoAsndInstance_l.aSdoAsndConnection[freeEntry];
-            *pConnection = nodeId;
-            count = freeEntry;
-        }
-        else
-        {
-            DEBUG_LVL_SDO_TRACE("%s(): no free handle\n", __func__);
-            return ret;
-        }
+        DEBUG_LVL_SDO_TRACE("%s(): no free handle\n", __func__);
+        return ret;
     }
 
     sdoConHdl = (count | SDO_ASND_HANDLE);
@@ -359,6 +325,36 @@ static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get connection of a node
+
+The function returns the connection entry which is assigned to the given node.
+If no connection is assigned yet, a free entry is assigned to the node.
+
+\param[in]      nodeId_p            Node ID of the remote node.
+
+\return The function returns the index of the connection entry or
+        CONFIG_SDO_MAX_CONNECTION_ASND if no free entry is available.
+*/
+//------------------------------------------------------------------------------
+static UINT allocConnection(UINT nodeId_p)
+{
+    UINT    array;
+
+    if (sdoAsndInstance_l.aNodeIdToConnection[nodeId_p] != 0)
+        return sdoAsndInstance_l.aNodeIdToConnection[nodeId_p] - 1;
+
+    if (sdoAsndInstance_l.freeConnectionCount == 0)
+        return CONFIG_SDO_MAX_CONNECTION_ASND;
+
+    array = sdoAsndInstance_l.aFreeConnection[--sdoAsndInstance_l.freeConnectionCount];
+    sdoAsndInstance_l.aSdoAsndConnection[array] = nodeId_p;
+    sdoAsndInstance_l.aNodeIdToConnection[nodeId_p] = (UINT16)(array + 1);
+
+    return array;
+}
+
 /// \}
 
 #endif
@@ -74,10 +74,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #error "SDO command layer segment size to high (limit 1456 bytes)!"
 #endif
 
-#ifndef CONFIG_SDO_MAX_CONNECTION_COM
-#define CONFIG_SDO_MAX_CONNECTION_COM           5
-#endif
-
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -267,6 +263,8 @@ This structure describes a SDO command layer instance
 typedef struct
 {
     tSdoComCon          sdoComCon[CONFIG_SDO_MAX_CONNECTION_COM];   ///< Array to store command layer connections
+    UINT16              aSeqConFirstCom[CONFIG_SDO_MAX_CONNECTION_SEQ]; ///< First command layer connection index + 1 using each sequence layer connection
+    UINT16              aNextCom[CONFIG_SDO_MAX_CONNECTION_COM];    ///< Next command layer connection index + 1 using the same sequence layer connection
 #if defined(CONFIG_INCLUDE_SDOS)
     tSdoComConHdl       sdoObdConCounter;                           ///< OD connection handle counter for object accesses
     tComdLayerObdCb     pfnProcessObdWrite;                         ///< OD callback function for WriteByIndex processing
@@ -289,6 +287,9 @@ static tOplkError receiveCb(tSdoSeqConHdl sdoSeqConHdl_p,
                             UINT dataSize_p);
 static tOplkError conStateChangeCb(tSdoSeqConHdl sdoSeqConHdl_p,
                                    tAsySdoConState sdoConnectionState_p);
+static void       setSeqConHdl(tSdoComCon* pSdoComCon_p,
+                               tSdoSeqConHdl sdoSeqConHdl_p);
+static void       clearConnection(tSdoComCon* pSdoComCon_p);
 static tOplkError processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
                                             tSdoComConEvent sdoComConEvent_p,
                                             const tAsySdoCom* pSdoCom_p);
@@ -361,6 +362,8 @@ static tOplkError serverObdFinishCb(tSdoObdConHdl* pObdHdl_p);
 static tOplkError clientSend(tSdoComCon* pSdoComCon_p);
 static tOplkError clientProcessFrame(tSdoComConHdl sdoComConHdl_p,
                                      const tAsySdoCom* pSdoCom_p);
+static BOOL       clientCheckSubAbort(tSdoComCon* pSdoComCon_p,
+                                      const tAsySdoCom* pSdoCom_p);
 static tOplkError clientProcessStateWaitInit(tSdoComConHdl sdoComConHdl_p,
                                              tSdoComConEvent sdoComConEvent_p,
                                              const tAsySdoCom* pRecvdCmdLayer_p);
@@ -644,26 +647,48 @@ static tOplkError processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
     tSdoComCon*     pSdoComCon;
     tSdoComConHdl   hdlCount;
     tSdoComConHdl   hdlFree;
-
-    // get pointer to first element of the array
-    pSdoComCon = &sdoComInstance_l.sdoComCon[0];
-    hdlCount = 0;
-    hdlFree = 0xFFFF;
-    while (hdlCount < CONFIG_SDO_MAX_CONNECTION_COM)
+    UINT            seqIndex;
+    UINT            next;
+
+    // process all command layer connections of the sequence layer connection in
+    // ascending order, the chain is searched again after each call because
+    // processing can remove connections from it
+    seqIndex = sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK;
+    if (seqIndex < CONFIG_SDO_MAX_CONNECTION_SEQ)
     {
-        if (pSdoComCon->sdoSeqConHdl == sdoSeqConHdl_p)
-        {   // matching command layer handle found
-            ret = processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
-        }
-        else if ((pSdoComCon->sdoSeqConHdl == 0) && (hdlFree == 0xFFFF))
-            hdlFree = hdlCount;
+        next = sdoComInstance_l.aSeqConFirstCom[seqIndex];
+        while (next != 0)
+        {
+            hdlCount = next - 1;
+            if (sdoComInstance_l.sdoComCon[hdlCount].sdoSeqConHdl == sdoSeqConHdl_p)
+            {   // matching command layer handle found
+                ret = processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
+            }
 
-        pSdoComCon++;
-        hdlCount++;
+            next = sdoComInstance_l.aSeqConFirstCom[seqIndex];
+            while ((next != 0) && (next <= (hdlCount + 1)))
+                next = sdoComInstance_l.aNextCom[next - 1];
+        }
     }
 
     if (ret == kErrorSdoComNotResponsible)
     {   // no responsible command layer handle found
+        // get pointer to first element of the array
+        pSdoComCon = &sdoComInstance_l.sdoComCon[0];
+        hdlCount = 0;
+        hdlFree = 0xFFFF;
+        while (hdlCount < CONFIG_SDO_MAX_CONNECTION_COM)
+        {
+            if (pSdoComCon->sdoSeqConHdl == 0)
+            {
+                hdlFree = hdlCount;
+                break;
+            }
+
+            pSdoComCon++;
+            hdlCount++;
+        }
+
         if (hdlFree == 0xFFFF)
         {   // no free handle delete connection immediately
             // 2008/04/14 m.u./d.k. This connection actually does not exist.
@@ -673,16 +698,79 @@ static tOplkError processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
         }
         else
         {   // create new handle
-            hdlCount = hdlFree;
-            pSdoComCon = &sdoComInstance_l.sdoComCon[hdlCount];
-            pSdoComCon->sdoSeqConHdl = sdoSeqConHdl_p;
-            ret = processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
+            pSdoComCon = &sdoComInstance_l.sdoComCon[hdlFree];
+            setSeqConHdl(pSdoComCon, sdoSeqConHdl_p);
+            ret = processState(hdlFree, sdoComConEvent_p, pSdoCom_p);
         }
     }
 
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set sequence layer connection handle of a command layer connection
+
+The function sets the sequence layer connection handle of a command layer
+connection and keeps the chain of command layer connections of each sequence
+layer connection up to date. The chain is sorted by the command layer
+connection index. The handle must only be changed by this function.
+
+\param[in,out]  pSdoComCon_p        Pointer to command layer connection.
+\param[in]      sdoSeqConHdl_p      New sequence layer connection handle.
+*/
+//------------------------------------------------------------------------------
+static void setSeqConHdl(tSdoComCon* pSdoComCon_p, tSdoSeqConHdl sdoSeqConHdl_p)
+{
+    UINT16* pLink;
+    UINT    seqIndex;
+    UINT16  comIndex = (UINT16)(pSdoComCon_p - &sdoComInstance_l.sdoComCon[0]);
+
+    // remove connection from chain of old handle
+    seqIndex = pSdoComCon_p->sdoSeqConHdl & ~SDO_SEQ_HANDLE_MASK;
+    if ((pSdoComCon_p->sdoSeqConHdl != 0) && (seqIndex < CONFIG_SDO_MAX_CONNECTION_SEQ))
+    {
+        pLink = &sdoComInstance_l.aSeqConFirstCom[seqIndex];
+        while ((*pLink != 0) && (*pLink != (comIndex + 1)))
+            pLink = &sdoComInstance_l.aNextCom[*pLink - 1];
+
+        if (*pLink != 0)
+            *pLink = sdoComInstance_l.aNextCom[comIndex];
+
+        sdoComInstance_l.aNextCom[comIndex] = 0;
+    }
+
+    pSdoComCon_p->sdoSeqConHdl = sdoSeqConHdl_p;
+
+    // insert connection into chain of new handle
+    seqIndex = sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK;
+    if ((sdoSeqConHdl_p != 0) && (seqIndex < CONFIG_SDO_MAX_CONNECTION_SEQ))
+    {
+        pLink = &sdoComInstance_l.aSeqConFirstCom[seqIndex];
+        while ((*pLink != 0) && (*pLink < (comIndex + 1)))
+            pLink = &sdoComInstance_l.aNextCom[*pLink - 1];
+
+        sdoComInstance_l.aNextCom[comIndex] = *pLink;
+        *pLink = (UINT16)(comIndex + 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear command layer connection
+
+The function releases the sequence layer connection handle of a command layer
+connection and clears the control structure.
+
+\param[in,out]  pSdoComCon_p        Pointer to command layer connection.
+*/
+//------------------------------------------------------------------------------
+static void clearConnection(tSdoComCon* pSdoComCon_p)
+{
+    setSeqConHdl(pSdoComCon_p, 0);
+    OPLK_MEMSET(pSdoComCon_p, 0x00, sizeof(tSdoComCon));
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Process state kSdoComStateIdle
@@ -731,7 +819,7 @@ static tOplkError processStateIdle(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventTimeout:
         case kSdoComConEventConClosed:
             ret = sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);
-            OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+            clearConnection(pSdoComCon);
             break;
 
         default:
@@ -1369,15 +1457,11 @@ static tOplkError serverObdSearchConnection(tSdoComConHdl sdoObdConHdl_p,
                                             tSdoComCon** ppSdoComCon_p)
 {
     tSdoComCon*     pSdoComCon;
-    tSdoComConHdl   hdlCount;
 
-    // get pointer to first element of the array
-    pSdoComCon = &sdoComInstance_l.sdoComCon[0];
-    hdlCount = 0;
-
-    // get pointer to control structure of connection
-    while (hdlCount < CONFIG_SDO_MAX_CONNECTION_COM)
+    // the OD connection handle contains the index of the control structure
+    if (sdoObdConHdl_p != 0)
     {
+        pSdoComCon = &sdoComInstance_l.sdoComCon[(sdoObdConHdl_p - 1) % CONFIG_SDO_MAX_CONNECTION_COM];
         if (pSdoComCon->sdoObdConHdl == sdoObdConHdl_p)
         {   // matching command layer handle found
             if (pSdoComCon->sdoSeqConHdl == 0)
@@ -1386,8 +1470,6 @@ static tOplkError serverObdSearchConnection(tSdoComConHdl sdoObdConHdl_p,
             *ppSdoComCon_p = pSdoComCon;
             return kErrorOk;
         }
-        pSdoComCon++;
-        hdlCount++;
     }
 
     *ppSdoComCon_p = NULL;
@@ -1413,11 +1495,12 @@ static tOplkError serverSaveObdConnectionHdl(tSdoComCon* pSdoComCon_p,
                                              tSdoObdAccType sdoAccessType_p)
 {
     if (pSdoComCon_p->sdoObdConHdl == 0)
-    {   // set new handle
-        if (++sdoComInstance_l.sdoObdConCounter == 0)
-            ++sdoComInstance_l.sdoObdConCounter;
+    {   // set new handle, it contains the counter and the index of the control structure
+        if (++sdoComInstance_l.sdoObdConCounter >= ((tSdoComConHdl)~0U / CONFIG_SDO_MAX_CONNECTION_COM))
+            sdoComInstance_l.sdoObdConCounter = 0;
 
-        pSdoComCon_p->sdoObdConHdl = sdoComInstance_l.sdoObdConCounter;
+        pSdoComCon_p->sdoObdConHdl = (sdoComInstance_l.sdoObdConCounter * CONFIG_SDO_MAX_CONNECTION_COM) +
+                                     (tSdoComConHdl)(pSdoComCon_p - &sdoComInstance_l.sdoComCon[0]) + 1;
         pSdoComCon_p->sdoObdAccType = sdoAccessType_p;
         return kErrorOk;
     }
@@ -2021,7 +2104,7 @@ static tOplkError serverProcessStateServerSegmTrans(tSdoComConHdl sdoComConHdl_p
         case kSdoComConEventTimeout:
         case kSdoComConEventConClosed:
             ret = sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);
-            OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+            clearConnection(pSdoComCon);
             break;
 
         default:
@@ -2076,7 +2159,7 @@ static tOplkError serverObdFinishCb(tSdoObdConHdl* pObdHdl_p)
         assignSdoErrorCode(pObdHdl_p->plkError, &pSdoComCon->lastAbortCode);
         serverAbortTransfer(pSdoComCon, pSdoComCon->lastAbortCode);
         ret = sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);
-        OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+        clearConnection(pSdoComCon);
         goto Exit;
     }
 
@@ -2153,10 +2236,11 @@ static tOplkError clientSdoDefineConnection(tSdoComConHdl* pSdoComConHdl_p,
                                             UINT targetNodeId_p,
                                             tSdoType protType_p)
 {
-    tOplkError  ret;
-    UINT        count;
-    UINT        freeHdl;
-    tSdoComCon* pSdoComCon;
+    tOplkError      ret;
+    UINT            count;
+    UINT            freeHdl;
+    tSdoComCon*     pSdoComCon;
+    tSdoSeqConHdl   sdoSeqConHdl;
 
     if ((targetNodeId_p == C_ADR_INVALID) || (targetNodeId_p >= C_ADR_BROADCAST))
         return kErrorInvalidNodeId;
@@ -2194,15 +2278,19 @@ static tOplkError clientSdoDefineConnection(tSdoComConHdl* pSdoComConHdl_p,
     switch (protType_p)
     {
         case kSdoTypeUdp:
-            ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeUdp);
+            ret = sdoseq_initCon(&sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeUdp);
             if (ret != kErrorOk)
                 return ret;
+
+            setSeqConHdl(pSdoComCon, sdoSeqConHdl);
             break;
 
         case kSdoTypeAsnd:
-            ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeAsnd);
+            ret = sdoseq_initCon(&sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeAsnd);
             if (ret != kErrorOk)
                 return ret;
+
+            setSeqConHdl(pSdoComCon, sdoSeqConHdl);
             break;
 
         case kSdoTypePdo:       // SDO over PDO -> not supported
@@ -2256,6 +2344,8 @@ static tOplkError clientSdoInitTransferByIndex(const tSdoComTransParamByIndex* p
 
     if (pSdoComTransParam_p->sdoAccessType == kSdoAccessTypeRead)
         pSdoComCon->sdoServiceType = kSdoServiceReadByIndex;
+    else if (pSdoComTransParam_p->sdoAccessType == kSdoAccessTypeWriteMultiple)
+        pSdoComCon->sdoServiceType = kSdoServiceWriteMultiByIndex;
     else
         pSdoComCon->sdoServiceType = kSdoServiceWriteByIndex;
 
@@ -2313,7 +2403,7 @@ static tOplkError clientSdoUndefineConnection(tSdoComConHdl sdoComConHdl_p)
         }
     }
 
-    OPLK_MEMSET(pSdoComCon, 0x00, sizeof(tSdoComCon));
+    clearConnection(pSdoComCon);
 
     return ret;
 }
@@ -2355,6 +2445,8 @@ static tOplkError clientSdoGetState(tSdoComConHdl sdoComConHdl_p,
     pSdoComFinished_p->sdoComConHdl = sdoComConHdl_p;
     if (pSdoComCon->sdoServiceType == kSdoServiceWriteByIndex)
         pSdoComFinished_p->sdoAccessType = kSdoAccessTypeWrite;
+    else if (pSdoComCon->sdoServiceType == kSdoServiceWriteMultiByIndex)
+        pSdoComFinished_p->sdoAccessType = kSdoAccessTypeWriteMultiple;
     else
         pSdoComFinished_p->sdoAccessType = kSdoAccessTypeRead;
 
@@ -2463,8 +2555,9 @@ static tOplkError clientProcessStateWaitInit(tSdoComConHdl sdoComConHdl_p,
                                              tSdoComConEvent sdoComConEvent_p,
                                              const tAsySdoCom* pRecvdCmdLayer_p)
 {
-    tOplkError  ret = kErrorOk;
-    tSdoComCon* pSdoComCon;
+    tOplkError      ret = kErrorOk;
+    tSdoComCon*     pSdoComCon;
+    tSdoSeqConHdl   sdoSeqConHdl;
 
     UNUSED_PARAMETER(pRecvdCmdLayer_p);
 
@@ -2478,15 +2571,19 @@ static tOplkError clientProcessStateWaitInit(tSdoComConHdl sdoComConHdl_p,
         switch (pSdoComCon->sdoProtocolType)
         {
             case kSdoTypeUdp:
-                ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeUdp);
+                ret = sdoseq_initCon(&sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeUdp);
                 if (ret != kErrorOk)
                     return ret;
+
+                setSeqConHdl(pSdoComCon, sdoSeqConHdl);
                 break;
 
             case kSdoTypeAsnd:
-                ret = sdoseq_initCon(&pSdoComCon->sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeAsnd);
+                ret = sdoseq_initCon(&sdoSeqConHdl, pSdoComCon->nodeId, kSdoTypeAsnd);
                 if (ret != kErrorOk)
                     return ret;
+
+                setSeqConHdl(pSdoComCon, sdoSeqConHdl);
                 break;
 
             case kSdoTypePdo:   // Pdo -> not supported
@@ -2534,7 +2631,7 @@ static tOplkError clientProcessStateWaitInit(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventTimeout:
         case kSdoComConEventTransferAbort:
             sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);         // close sequence layer handle
-            pSdoComCon->sdoSeqConHdl |= SDO_SEQ_INVALID_HDL;
+            setSeqConHdl(pSdoComCon, pSdoComCon->sdoSeqConHdl | SDO_SEQ_INVALID_HDL);
             if (sdoComConEvent_p == kSdoComConEventTimeout)
                 pSdoComCon->lastAbortCode = SDO_AC_TIME_OUT;
             else
@@ -2618,6 +2715,14 @@ static tOplkError clientProcessStateConnected(tSdoComConHdl sdoComConHdl_p,
                     ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferRxAborted);
                     return ret;
                 }
+                else if (clientCheckSubAbort(pSdoComCon, pRecvdCmdLayer_p))
+                {
+                    // send acknowledge without any Command layer data
+                    sdoseq_sendData(pSdoComCon->sdoSeqConHdl, 0, (tPlkFrame*)NULL);
+                    pSdoComCon->transactionId++;
+                    ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferRxAborted);
+                    return ret;
+                }
                 else
                 {   // normal frame received
                     ret = clientProcessFrame(sdoComConHdl_p, pRecvdCmdLayer_p);
@@ -2645,7 +2750,7 @@ static tOplkError clientProcessStateConnected(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventConClosed:
             // connection closed by communication partner
             sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);         // close sequence layer handle
-            pSdoComCon->sdoSeqConHdl |= SDO_SEQ_INVALID_HDL;
+            setSeqConHdl(pSdoComCon, pSdoComCon->sdoSeqConHdl | SDO_SEQ_INVALID_HDL);
             pSdoComCon->sdoComState = kSdoComStateClientWaitInit;
             pSdoComCon->lastAbortCode = 0;
             ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferLowerLayerAbort);
@@ -2661,7 +2766,7 @@ static tOplkError clientProcessStateConnected(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventInitError:
         case kSdoComConEventTimeout:
             sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);         // close sequence layer handle
-            pSdoComCon->sdoSeqConHdl |= SDO_SEQ_INVALID_HDL;
+            setSeqConHdl(pSdoComCon, pSdoComCon->sdoSeqConHdl | SDO_SEQ_INVALID_HDL);
             pSdoComCon->sdoComState = kSdoComStateClientWaitInit;
             pSdoComCon->lastAbortCode = SDO_AC_TIME_OUT;
             ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferLowerLayerAbort);
@@ -2740,6 +2845,15 @@ static tOplkError clientProcessStateSegmTransfer(tSdoComConHdl sdoComConHdl_p,
                     ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferRxAborted);
                     return ret;
                 }
+                else if (clientCheckSubAbort(pSdoComCon, pRecvdCmdLayer_p))
+                {
+                    // send acknowledge without any Command layer data
+                    sdoseq_sendData(pSdoComCon->sdoSeqConHdl, 0, (tPlkFrame*)NULL);
+                    pSdoComCon->transactionId++;
+                    pSdoComCon->sdoComState = kSdoComStateClientConnected;
+                    ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferRxAborted);
+                    return ret;
+                }
                 else
                 {   // normal frame received
                     ret = clientProcessFrame(sdoComConHdl_p, pRecvdCmdLayer_p);
@@ -2761,7 +2875,7 @@ static tOplkError clientProcessStateSegmTransfer(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventConClosed:
             // connection closed by communication partner
             sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);         // close sequence layer handle
-            pSdoComCon->sdoSeqConHdl |= SDO_SEQ_INVALID_HDL;
+            setSeqConHdl(pSdoComCon, pSdoComCon->sdoSeqConHdl | SDO_SEQ_INVALID_HDL);
             pSdoComCon->sdoComState = kSdoComStateClientWaitInit;
             pSdoComCon->transactionId++;
             pSdoComCon->lastAbortCode = 0;
@@ -2780,7 +2894,7 @@ static tOplkError clientProcessStateSegmTransfer(tSdoComConHdl sdoComConHdl_p,
         case kSdoComConEventInitError:
         case kSdoComConEventTimeout:
             sdoseq_deleteCon(pSdoComCon->sdoSeqConHdl);         // close sequence layer handle
-            pSdoComCon->sdoSeqConHdl |= SDO_SEQ_INVALID_HDL;
+            setSeqConHdl(pSdoComCon, pSdoComCon->sdoSeqConHdl | SDO_SEQ_INVALID_HDL);
             pSdoComCon->sdoComState = kSdoComStateClientWaitInit;
             pSdoComCon->lastAbortCode = SDO_AC_TIME_OUT;
             ret = clientTransferFinished(sdoComConHdl_p, pSdoComCon, kSdoComTransferLowerLayerAbort);
@@ -2881,6 +2995,33 @@ static tOplkError clientSend(tSdoComCon* pSdoComCon_p)
                     }
                     break;
 
+                case kSdoServiceWriteMultiByIndex:
+                    // the data already contains the sub-transfer headers
+                    if (pSdoComCon_p->transferSize > SDO_CMD_SEGM_TX_MAX_SIZE)
+                    {   // segmented transfer -> variable part of header needed
+                        pSdoComCon_p->sdoTransferType = kSdoTransSegmented;
+                        ami_setUint16Le(&pCommandFrame->segmentSizeLe, SDO_CMD_SEGM_TX_MAX_SIZE);
+                        overwriteCmdFrameHdrFlags(pCommandFrame, SDO_CMDL_FLAG_SEGMINIT);
+                        ami_setUint32Le(&pCommandFrame->aCommandData[0], pSdoComCon_p->transferSize + SDO_CMDL_HDR_VAR_SIZE);
+                        pPayload = &pCommandFrame->aCommandData[SDO_CMDL_HDR_VAR_SIZE];
+                        sizeOfCmdFrame = SDO_CMDL_HDR_FIXED_SIZE + SDO_CMD_SEGM_TX_MAX_SIZE;
+
+                        payloadSize = SDO_CMD_SEGM_TX_MAX_SIZE - SDO_CMDL_HDR_VAR_SIZE;
+                        OPLK_MEMCPY(pPayload, pSdoComCon_p->pData, payloadSize);
+                        updateHdlTransfSize(pSdoComCon_p, payloadSize, FALSE);
+                    }
+                    else
+                    {   // expedited transfer
+                        pSdoComCon_p->sdoTransferType = kSdoTransExpedited;
+                        ami_setUint16Le(&pCommandFrame->segmentSizeLe, (WORD)pSdoComCon_p->transferSize);
+                        pPayload = &pCommandFrame->aCommandData[0];
+                        sizeOfCmdFrame = SDO_CMDL_HDR_FIXED_SIZE + pSdoComCon_p->transferSize;
+
+                        OPLK_MEMCPY(pPayload, pSdoComCon_p->pData, pSdoComCon_p->transferSize);
+                        updateHdlTransfSize(pSdoComCon_p, pSdoComCon_p->transferSize, TRUE);
+                    }
+                    break;
+
                 case kSdoServiceNIL:
                 default:
                     // invalid service requested
@@ -2892,6 +3033,7 @@ static tOplkError clientSend(tSdoComCon* pSdoComCon_p)
             switch (pSdoComCon_p->sdoServiceType)
             {
                 case kSdoServiceWriteByIndex:
+                case kSdoServiceWriteMultiByIndex:
                     // send next frame
                     if (pSdoComCon_p->sdoTransferType == kSdoTransSegmented)
                     {
@@ -3005,6 +3147,11 @@ static tOplkError clientProcessFrame(tSdoComConHdl sdoComConHdl_p,
                     // nothing more to do
                     break;
 
+                case kSdoServiceWriteMultiByIndex:
+                    // check if confirmation from server
+                    // aborted sub-transfers are handled by clientCheckSubAbort()
+                    break;
+
                 case kSdoServiceReadByIndex:
                     flags = ami_getUint8Le(&pSdoCom_p->flags);
                     flags &= SDO_CMDL_FLAG_SEGM_MASK;
@@ -3100,6 +3247,51 @@ static tOplkError clientProcessFrame(tSdoComConHdl sdoComConHdl_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Check for an aborted sub-transfer on a SDO client
+
+The function checks whether the response to a multiple write lists an aborted
+sub-transfer. The first aborted sub-transfer is stored as target and abort code
+of the connection. The caller finishes the transfer, thus the connection is not
+accessed after the transfer finished callback.
+
+\param[in,out]  pSdoComCon_p        Pointer to SDO command layer connection structure.
+\param[in]      pSdoCom_p           Pointer to received frame.
+
+\return The function returns TRUE if a sub-transfer was aborted, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL clientCheckSubAbort(tSdoComCon* pSdoComCon_p,
+                                const tAsySdoCom* pSdoCom_p)
+{
+    UINT8   flags;
+    UINT    segmentSize;
+    UINT    offset;
+
+    if ((pSdoComCon_p->sdoServiceType != kSdoServiceWriteMultiByIndex) ||
+        (ami_getUint8Le(&pSdoCom_p->commandId) != kSdoServiceWriteMultiByIndex))
+        return FALSE;
+
+    // the response lists the aborted sub-transfers, report the first one
+    segmentSize = ami_getUint16Le(&pSdoCom_p->segmentSizeLe);
+    for (offset = 0;
+         (offset + SDO_CMDL_WRITEMULTBYINDEX_ABORT_SIZE) <= segmentSize;
+         offset += SDO_CMDL_WRITEMULTBYINDEX_ABORT_SIZE)
+    {
+        flags = ami_getUint8Le(&pSdoCom_p->aCommandData[offset + 3]);
+        if ((flags & SDO_CMDL_WRITEMULTBYINDEX_FLAG_ABORT) == 0)
+            continue;
+
+        pSdoComCon_p->targetIndex = ami_getUint16Le(&pSdoCom_p->aCommandData[offset]);
+        pSdoComCon_p->targetSubIndex = ami_getUint8Le(&pSdoCom_p->aCommandData[offset + 2]);
+        pSdoComCon_p->lastAbortCode = ami_getUint32Le(&pSdoCom_p->aCommandData[offset + 4]);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Send an abort message
@@ -3190,6 +3382,8 @@ static tOplkError clientTransferFinished(tSdoComConHdl sdoComConHdl_p,
         sdoComFinished.sdoComConState = sdoComConState_p;
         if (pSdoComCon_p->sdoServiceType == kSdoServiceWriteByIndex)
             sdoComFinished.sdoAccessType = kSdoAccessTypeWrite;
+        else if (pSdoComCon_p->sdoServiceType == kSdoServiceWriteMultiByIndex)
+            sdoComFinished.sdoAccessType = kSdoAccessTypeWriteMultiple;
         else
             sdoComFinished.sdoAccessType = kSdoAccessTypeRead;
 
@@ -59,12 +59,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define SDO_HISTORY_SIZE                5
-
-#ifndef CONFIG_SDO_MAX_CONNECTION_SEQ
-#define CONFIG_SDO_MAX_CONNECTION_SEQ   5
-#endif
-
 #define SDO_SEQ_RETRY_COUNT             2                       // number of ack requests before close (final timeout)
 #define SDO_SEQ_CMDL_INACTIVE_THLD      2                       // number of seq. layer sub timeouts before close if command layer is not active
 #define SDO_SEQ_NUM_THRESHOLD           100                     // threshold which distinguishes between old and new sequence numbers
@@ -75,6 +69,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define SEQ_NUM_MASK                    0xFC
 
+// The history must not hold more frames than the sequence numbers which are
+// accepted as new acknowledges (SDO_SEQ_NUM_THRESHOLD).
+#define SDO_SEQ_MAX_HISTORY_SIZE        ((SDO_SEQ_NUM_THRESHOLD / 4) - 1)
+
+#if ((CONFIG_SDO_SEQ_HISTORY_SIZE < 2) || (CONFIG_SDO_SEQ_HISTORY_SIZE > SDO_SEQ_MAX_HISTORY_SIZE))
+#error "CONFIG_SDO_SEQ_HISTORY_SIZE is out of range!"
+#endif
+
 static const UINT32 SDO_SEQU_MAX_TIMEOUT_MS = (UINT32)86400000UL;   // [ms], 86400000 ms = 1 day
 
 //------------------------------------------------------------------------------
@@ -119,6 +121,36 @@ Data type for the enumerator \ref eSdoSeqEvent.
 */
 typedef UINT32 tSdoSeqEvent;
 
+/**
+\brief  SDO sequence layer history entry
+
+This structure defines one frame of the SDO sequence layer connection history.
+*/
+typedef struct
+{
+    UINT    frameSize;                                  ///< Size of the history frame
+    BOOL    fFirstTxFailed;                             ///< Flag tagging frame as unsent
+                                                        /**< Flag indicating that the first attempt to
+                                                             forward the frame to a lower layer send function
+                                                             failed due to buffer overflow e.g. and should be
+                                                             repeated later */
+    UINT8   aFrame[SDO_SEQ_TX_HISTORY_FRAME_SIZE];      ///< History frame
+} tSdoSeqHistoryEntry;
+
+/**
+\brief  SDO sequence layer history ring
+
+This structure is the header of a history ring buffer. The ring is allocated
+together with its entries, which directly follow the header. Released rings
+are kept in a pool for the next connection.
+*/
+typedef struct sSdoSeqHistoryRing tSdoSeqHistoryRing;
+struct sSdoSeqHistoryRing
+{
+    tSdoSeqHistoryRing*     pNext;                      ///< Next ring in the pool
+    UINT                    size;                       ///< Number of entries of the ring
+};
+
 /**
 \brief  SDO sequence layer connection history
 
@@ -126,16 +158,13 @@ This structure defines the SDO sequence layer connection history buffer.
 */
 typedef struct
 {
-    UINT8   freeEntries;    ///< Number of free history entries
-    UINT8   writeIndex;     ///< Index of the next free buffer entry
-    UINT8   ackIndex;       ///< Index of the next message which should become acknowledged
-    UINT8   readIndex;      ///< Index between ackIndex and writeIndex to the next message for retransmission
-    UINT8   aHistoryFrame[SDO_HISTORY_SIZE][SDO_SEQ_TX_HISTORY_FRAME_SIZE];    ///< Array of the history frames
-    UINT    aFrameSize[SDO_HISTORY_SIZE];           ///< Array of sizes of the history frames
-    BOOL    afFrameFirstTxFailed[SDO_HISTORY_SIZE]; ///< Array of flags tagging frame as unsent
-                                                    /**< Array of flags indicating that the first attempt to
-                                                         forward a frame to a lower layer send function failed
-                                                         due to buffer overflow e.g. and should be repeated later */
+    UINT8                   size;           ///< Number of history entries (window size)
+    UINT8                   freeEntries;    ///< Number of free history entries
+    UINT8                   writeIndex;     ///< Index of the next free buffer entry
+    UINT8                   ackIndex;       ///< Index of the next message which should become acknowledged
+    UINT8                   readIndex;      ///< Index between ackIndex and writeIndex to the next message for retransmission
+    tSdoSeqHistoryRing*     pRing;          ///< History ring buffer, only valid for used connections
+    tSdoSeqHistoryEntry*    pEntry;         ///< Array of the history entries in the ring buffer
 } tSdoSeqConHistory;
 
 /**
@@ -190,9 +219,19 @@ This structure defines a SDO sequence layer instance.
 typedef struct
 {
     tSdoSeqCon              aSdoSeqCon[CONFIG_SDO_MAX_CONNECTION_SEQ];  ///< Array of sequence layer connections
+    UINT16                  aFreeCon[CONFIG_SDO_MAX_CONNECTION_SEQ];    ///< Stack of free sequence layer connections
+    UINT                    freeConCount;                               ///< Number of free sequence layer connections
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+    UINT16                  aUdpConIndex[CONFIG_SDO_MAX_CONNECTION_UDP];    ///< Sequence layer connection index + 1 of each UDP connection
+#endif
+#if defined(CONFIG_INCLUDE_SDO_ASND)
+    UINT16                  aAsndConIndex[CONFIG_SDO_MAX_CONNECTION_ASND];  ///< Sequence layer connection index + 1 of each ASnd connection
+#endif
     tSdoComReceiveCb        pfnSdoComRecvCb;                            ///< Pointer to receive callback function
     tSdoComConCb            pfnSdoComConCb;                             ///< Pointer to connection callback function
     UINT32                  sdoSeqTimeout;                              ///< Configured Sequence layer sub-timeout
+    UINT                    historySize;                                ///< History size of new connections
+    tSdoSeqHistoryRing*     pFreeRing;                                  ///< Pool of released history rings
 
 #if (defined(WIN32) || defined(_WIN32))
     LPCRITICAL_SECTION      pCriticalSection;
@@ -253,6 +292,13 @@ static tOplkError sendToLowerLayer(const tSdoSeqCon* pSdoSeqCon_p,
 static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             const tAsySdoSeq* pSdoSeqData_p,
                             UINT dataSize_p);
+static UINT16*    getConIndexEntry(tSdoConHdl conHdl_p);
+static UINT       findConnection(tSdoConHdl conHdl_p);
+static UINT       addConnection(tSdoConHdl conHdl_p);
+static void       removeConnection(UINT handle_p);
+static tOplkError allocHistory(tSdoSeqCon* pSdoSeqCon_p);
+static void       freeHistory(tSdoSeqCon* pSdoSeqCon_p);
+static void       freeHistoryPool(void);
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p);
 static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
                                     const tPlkFrame* pFrame_p,
@@ -305,6 +351,7 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
                        tSdoComConCb pfnSdoComConCb_p)
 {
     tOplkError  ret = kErrorOk;
+    UINT        count;
 
     if (pfnSdoComRecvCb_p == NULL)
         return kErrorSdoSeqMissCb;
@@ -317,6 +364,20 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
         sdoSeqInstance_l.pfnSdoComConCb = pfnSdoComConCb_p;
 
     OPLK_MEMSET(&sdoSeqInstance_l.aSdoSeqCon[0], 0x00, sizeof(sdoSeqInstance_l.aSdoSeqCon));
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+    OPLK_MEMSET(&sdoSeqInstance_l.aUdpConIndex[0], 0x00, sizeof(sdoSeqInstance_l.aUdpConIndex));
+#endif
+#if defined(CONFIG_INCLUDE_SDO_ASND)
+    OPLK_MEMSET(&sdoSeqInstance_l.aAsndConIndex[0], 0x00, sizeof(sdoSeqInstance_l.aAsndConIndex));
+#endif
+
+    sdoSeqInstance_l.historySize = CONFIG_SDO_SEQ_HISTORY_SIZE;
+    sdoSeqInstance_l.pFreeRing = NULL;
+
+    // the lowest connection index is allocated first
+    sdoSeqInstance_l.freeConCount = 0;
+    for (count = CONFIG_SDO_MAX_CONNECTION_SEQ; count > 0; count--)
+        sdoSeqInstance_l.aFreeCon[sdoSeqInstance_l.freeConCount++] = (UINT16)(count - 1);
 
 #if (defined(WIN32) || defined(_WIN32))
     // create critical section for process function
@@ -369,9 +430,11 @@ tOplkError sdoseq_exit(void)
         if (pSdoSeqCon->conHandle != 0)
             timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
+        freeHistory(pSdoSeqCon);
         count++;
         pSdoSeqCon++;
     }
+    freeHistoryPool();
 
 #if (defined(WIN32) || defined(_WIN32))
     // delete critical section for process function
@@ -460,24 +523,11 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
     }
 
     // find existing connection to the same node or find empty entry for connection
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_SEQ;
-    pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[0];
-
-    while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
-    {
-        if (pSdoSeqCon->conHandle == conHandle)
-            break;
-
-        if (pSdoSeqCon->conHandle == 0)
-            freeCon = count;
-
-        count++;
-        pSdoSeqCon++;
-    }
+    count = findConnection(conHandle);
 
     if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
     {
+        freeCon = addConnection(conHandle);
         if (freeCon == CONFIG_SDO_MAX_CONNECTION_SEQ)
         {   // no free entry found
             switch (sdoType_p)
@@ -509,7 +559,6 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
         else
         {   // free entry found
             pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[freeCon];
-            pSdoSeqCon->conHandle = conHandle;
             pSdoSeqCon->useCount++;     // increment use counter
             count = freeCon;
         }
@@ -547,6 +596,8 @@ tOplkError sdoseq_sendData(tSdoSeqConHdl sdoSeqConHdl_p,
     UINT        handle;
 
     handle = (sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK);
+    if (handle >= CONFIG_SDO_MAX_CONNECTION_SEQ)
+        return kErrorSdoSeqInvalidHdl;
 
     // check if connection ready
     if (sdoSeqInstance_l.aSdoSeqCon[handle].sdoSeqState == kSdoSeqStateIdle)
@@ -612,13 +663,11 @@ tOplkError sdoseq_processEvent(const tEvent* pEvent_p)
     timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
     // get index number of control structure
-    count = 0;
-    while (&sdoSeqInstance_l.aSdoSeqCon[count] != pSdoSeqCon)
-    {
-        count++;
-        if (count > CONFIG_SDO_MAX_CONNECTION_SEQ)
-            return ret;
-    }
+    if ((pSdoSeqCon < &sdoSeqInstance_l.aSdoSeqCon[0]) ||
+        (pSdoSeqCon >= &sdoSeqInstance_l.aSdoSeqCon[CONFIG_SDO_MAX_CONNECTION_SEQ]))
+        return ret;
+
+    count = (UINT)(pSdoSeqCon - &sdoSeqInstance_l.aSdoSeqCon[0]);
 
     // process event and call process function if needed
     ret = processState(count, 0, NULL, NULL, kSdoSeqEventTimeout);
@@ -680,8 +729,8 @@ tOplkError sdoseq_deleteCon(tSdoSeqConHdl sdoSeqConHdl_p)
         timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
         // cleanup control structure
+        removeConnection(handle);
         OPLK_MEMSET(pSdoSeqCon, 0x00, sizeof(tSdoSeqCon));
-        pSdoSeqCon->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
     }
 
     return ret;
@@ -709,6 +758,36 @@ tOplkError sdoseq_setTimeout(UINT32 timeout_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set sequence layer history size
+
+The function sets the number of frames in the Tx history of new sequence layer
+connections. This is the number of segments which can be sent without waiting
+for an acknowledge. Existing connections keep their history size.
+
+\param[in]      historySize_p       Number of history frames to set.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdo_seq
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoseq_setHistorySize(UINT historySize_p)
+{
+    if ((historySize_p < 2) || (historySize_p > SDO_SEQ_MAX_HISTORY_SIZE))
+        return kErrorInvalidOperation;
+
+    if (historySize_p != sdoSeqInstance_l.historySize)
+    {
+        // pooled rings have the old size
+        freeHistoryPool();
+        sdoSeqInstance_l.historySize = historySize_p;
+    }
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -1192,6 +1271,7 @@ static tOplkError processStateConnected(tSdoSeqCon* pSdoSeqCon_p,
     tOplkError  ret = kErrorOk;
     UINT8       sendSeqNumCon;
     UINT8       recvSeqNumCon;
+    BOOL        fHistoryAcked;
 
     switch (event_p)
     {
@@ -1270,8 +1350,9 @@ static tOplkError processStateConnected(tSdoSeqCon* pSdoSeqCon_p,
                 case 3:
                 // connection valid
                 case 2:
+                    fHistoryAcked = checkHistoryAcked(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK);
                     if (checkConnectionAckValid(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK) ||
-                        checkHistoryAcked(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK))
+                        fHistoryAcked)
                     {
                         ret = setTimer(pSdoSeqCon_p, sdoSeqInstance_l.sdoSeqTimeout);
                         if (ret != kErrorOk)
@@ -1298,10 +1379,15 @@ static tOplkError processStateConnected(tSdoSeqCon* pSdoSeqCon_p,
                             return ret;
                     }
 
-                    // trigger segmented Tx before timeout does (speed-up transmission)
-                    ret = sendHistoryOldestSegm(pSdoSeqCon_p, recvSeqNumCon);
-                    if (ret != kErrorOk)
-                        return ret;
+                    // trigger segmented Tx before timeout does (speed-up transmission),
+                    // an acknowledge which confirms new frames is no trigger, because
+                    // the following frames of the window are still in transit
+                    if (!fHistoryAcked)
+                    {
+                        ret = sendHistoryOldestSegm(pSdoSeqCon_p, recvSeqNumCon);
+                        if (ret != kErrorOk)
+                            return ret;
+                    }
 
                     if (((pSdoSeqCon_p->sendSeqNum + 4) & SEQ_NUM_MASK) == (sendSeqNumCon & SEQ_NUM_MASK))
                     {   // next frame of sequence received (new command layer data)
@@ -1415,6 +1501,7 @@ static tOplkError processStateWaitAck(tSdoSeqCon* pSdoSeqCon_p,
     tOplkError  ret = kErrorOk;
     UINT8       sendSeqNumCon;
     UINT8       recvSeqNumCon;
+    BOOL        fHistoryAcked;
 
     DEBUG_LVL_SDO_TRACE("sdoseq: %s()\n", __func__);
 
@@ -1452,7 +1539,8 @@ static tOplkError processStateWaitAck(tSdoSeqCon* pSdoSeqCon_p,
 
             // normal frame
             case 2:
-                if (checkHistoryAcked(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK))
+                fHistoryAcked = checkHistoryAcked(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK);
+                if (fHistoryAcked)
                 {   // we came here only due to a full history buffer
                     // and one element is now acknowledged
 
@@ -1515,9 +1603,12 @@ static tOplkError processStateWaitAck(tSdoSeqCon* pSdoSeqCon_p,
                 }
 
                 // trigger segmented Tx before timeout does (speed-up transmission)
-                ret = sendHistoryOldestSegm(pSdoSeqCon_p, recvSeqNumCon);
-                if (ret != kErrorOk)
-                    return ret;
+                if (!fHistoryAcked)
+                {
+                    ret = sendHistoryOldestSegm(pSdoSeqCon_p, recvSeqNumCon);
+                    if (ret != kErrorOk)
+                        return ret;
+                }
                 break;
 
             // retransmission request (error response)
@@ -1747,13 +1838,15 @@ static tOplkError sendFrame(tSdoSeqCon* pSdoSeqCon_p,
                             tPlkFrame* pData_p,
                             BOOL fFrameInHistory_p)
 {
-    tOplkError  ret = kErrorOk;
-    tOplkError  retReplace = kErrorOk;
-    UINT8       aFrame[SDO_SEQ_FRAME_SIZE];
-    tPlkFrame*  pFrame;
-    tPlkFrame*  pFrameResend;
-    UINT        frameSizeResend;
-    UINT        freeEntries = 0;
+    tOplkError          ret = kErrorOk;
+    tOplkError          retReplace = kErrorOk;
+    UINT8               aFrame[SDO_SEQ_FRAME_SIZE];
+    tPlkFrame*          pFrame;
+    tPlkFrame*          pFrameResend;
+    UINT                frameSizeResend;
+    UINT                freeEntries = 0;
+    tSdoSeqConHistory*  pHistory;
+    UINT8               readIndex;
 
     if (pData_p == NULL)
     {   // set pointer to own frame
@@ -1801,6 +1894,12 @@ static tOplkError sendFrame(tSdoSeqCon* pSdoSeqCon_p,
                 }
                 if (ret != kErrorOk)
                     goto Exit;
+
+                // frame is passed to the lower layer, it must not be sent again
+                // with the following frames, only by a retransmission
+                pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+                readIndex = (pHistory->readIndex == 0) ? (pHistory->size - 1) : (pHistory->readIndex - 1);
+                pHistory->pEntry[readIndex].fFirstTxFailed = FALSE;
             }
             // read next frame
             ret = readFromHistory(pSdoSeqCon_p, &pFrameResend, &frameSizeResend, FALSE);
@@ -1887,14 +1986,9 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
 {
     tOplkError  ret = kErrorOk;
     UINT        count;
-    UINT        freeEntry;
-    tSdoSeqCon* pSdoSeqCon;
 
     do
     {
-        count = 0;
-        freeEntry = CONFIG_SDO_MAX_CONNECTION_SEQ;
-
 #if (defined(WIN32) || defined(_WIN32))
         EnterCriticalSection(sdoSeqInstance_l.pCriticalSectionReceive);
 #endif
@@ -1904,21 +1998,11 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             ((const UINT8*)pSdoSeqData_p)[0]);
 
         // search control structure for this connection
-        pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[count];
-        while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
-        {
-            if (pSdoSeqCon->conHandle == conHdl_p)
-                break;
-            else if ((pSdoSeqCon->conHandle == 0) && (freeEntry == CONFIG_SDO_MAX_CONNECTION_SEQ))
-                freeEntry = count;   // free entry
-
-            count++;
-            pSdoSeqCon++;
-        }
-
+        count = findConnection(conHdl_p);
         if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
         {   // new connection
-            if (freeEntry == CONFIG_SDO_MAX_CONNECTION_SEQ)
+            count = addConnection(conHdl_p);
+            if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
             {
                 ret = kErrorSdoSeqNoFreeHandle;
 #if (defined(WIN32) || defined(_WIN32))
@@ -1926,13 +2010,8 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
 #endif
                 return ret;
             }
-            else
-            {
-                pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[freeEntry];
-                pSdoSeqCon->conHandle = conHdl_p;    // save handle from lower layer
-                pSdoSeqCon->useCount++;
-                count = freeEntry;
-            }
+
+            sdoSeqInstance_l.aSdoSeqCon[count].useCount++;
         }
 
 #if (defined(WIN32) || defined(_WIN32))
@@ -1946,6 +2025,219 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get connection index entry of lower layer connection
+
+The function returns the entry of the lower layer connection in the lower layer
+index tables. The entry contains the index + 1 of the sequence layer connection
+which uses the lower layer connection, or 0 if it is unused.
+
+\param[in]      conHdl_p            SDO connection handle of the lower layer.
+
+\return The function returns a pointer to the index entry or NULL if the handle
+        is invalid.
+*/
+//------------------------------------------------------------------------------
+static UINT16* getConIndexEntry(tSdoConHdl conHdl_p)
+{
+    UINT    array = (conHdl_p & ~SDO_ASY_HANDLE_MASK);
+
+    switch (conHdl_p & SDO_ASY_HANDLE_MASK)
+    {
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+        case SDO_UDP_HANDLE:
+            if (array < CONFIG_SDO_MAX_CONNECTION_UDP)
+                return &sdoSeqInstance_l.aUdpConIndex[array];
+            break;
+#endif
+
+#if defined(CONFIG_INCLUDE_SDO_ASND)
+        case SDO_ASND_HANDLE:
+            if (array < CONFIG_SDO_MAX_CONNECTION_ASND)
+                return &sdoSeqInstance_l.aAsndConIndex[array];
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Find sequence layer connection
+
+The function searches the sequence layer connection which uses the given lower
+layer connection.
+
+\param[in]      conHdl_p            SDO connection handle of the lower layer.
+
+\return The function returns the index of the sequence layer connection or
+        CONFIG_SDO_MAX_CONNECTION_SEQ if no connection is found.
+*/
+//------------------------------------------------------------------------------
+static UINT findConnection(tSdoConHdl conHdl_p)
+{
+    UINT16* pConIndex = getConIndexEntry(conHdl_p);
+
+    if ((pConIndex == NULL) || (*pConIndex == 0))
+        return CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    return *pConIndex - 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add sequence layer connection
+
+The function takes a free sequence layer connection and assigns the given lower
+layer connection to it.
+
+\param[in]      conHdl_p            SDO connection handle of the lower layer.
+
+\return The function returns the index of the sequence layer connection or
+        CONFIG_SDO_MAX_CONNECTION_SEQ if no free connection is available.
+*/
+//------------------------------------------------------------------------------
+static UINT addConnection(tSdoConHdl conHdl_p)
+{
+    UINT16* pConIndex = getConIndexEntry(conHdl_p);
+    UINT    handle;
+
+    if ((pConIndex == NULL) || (sdoSeqInstance_l.freeConCount == 0))
+        return CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    handle = sdoSeqInstance_l.aFreeCon[sdoSeqInstance_l.freeConCount - 1];
+    if (allocHistory(&sdoSeqInstance_l.aSdoSeqCon[handle]) != kErrorOk)
+        return CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    sdoSeqInstance_l.freeConCount--;
+    sdoSeqInstance_l.aSdoSeqCon[handle].conHandle = conHdl_p;    // save handle from lower layer
+    *pConIndex = (UINT16)(handle + 1);
+
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove sequence layer connection
+
+The function releases the lower layer connection of a sequence layer connection
+and returns the sequence layer connection to the free connections. The control
+structure itself has to be cleaned up by the caller.
+
+\param[in]      handle_p            Index of the sequence layer connection.
+*/
+//------------------------------------------------------------------------------
+static void removeConnection(UINT handle_p)
+{
+    UINT16* pConIndex = getConIndexEntry(sdoSeqInstance_l.aSdoSeqCon[handle_p].conHandle);
+
+    if ((pConIndex == NULL) || (*pConIndex != (handle_p + 1)))
+        return;
+
+    *pConIndex = 0;
+    freeHistory(&sdoSeqInstance_l.aSdoSeqCon[handle_p]);
+    sdoSeqInstance_l.aFreeCon[sdoSeqInstance_l.freeConCount++] = (UINT16)handle_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate history buffer
+
+The function assigns a history ring buffer of the configured size to a
+connection. A ring of the pool is reused if available.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError allocHistory(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    tSdoSeqHistoryRing* pRing;
+
+    pRing = sdoSeqInstance_l.pFreeRing;
+    if (pRing != NULL)
+    {
+        sdoSeqInstance_l.pFreeRing = pRing->pNext;
+    }
+    else
+    {
+        pRing = (tSdoSeqHistoryRing*)OPLK_MALLOC(sizeof(tSdoSeqHistoryRing) +
+                                                 (sdoSeqInstance_l.historySize * sizeof(tSdoSeqHistoryEntry)));
+        if (pRing == NULL)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() Allocation of history failed!\n", __func__);
+            return kErrorNoResource;
+        }
+
+        pRing->size = sdoSeqInstance_l.historySize;
+    }
+
+    pRing->pNext = NULL;
+    pHistory->pRing = pRing;
+    pHistory->pEntry = (tSdoSeqHistoryEntry*)(pRing + 1);
+    pHistory->size = (UINT8)pRing->size;
+
+    return initHistory(pSdoSeqCon_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free history buffer
+
+The function releases the history ring buffer of a connection. Rings of the
+configured size are returned to the pool.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
+*/
+//------------------------------------------------------------------------------
+static void freeHistory(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    tSdoSeqHistoryRing* pRing = pHistory->pRing;
+
+    if (pRing == NULL)
+        return;
+
+    if (pRing->size == sdoSeqInstance_l.historySize)
+    {
+        pRing->pNext = sdoSeqInstance_l.pFreeRing;
+        sdoSeqInstance_l.pFreeRing = pRing;
+    }
+    else
+        OPLK_FREE(pRing);
+
+    pHistory->pRing = NULL;
+    pHistory->pEntry = NULL;
+    pHistory->size = 0;
+    pHistory->freeEntries = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free history pool
+
+The function frees all history ring buffers of the pool.
+*/
+//------------------------------------------------------------------------------
+static void freeHistoryPool(void)
+{
+    tSdoSeqHistoryRing* pRing;
+
+    while (sdoSeqInstance_l.pFreeRing != NULL)
+    {
+        pRing = sdoSeqInstance_l.pFreeRing;
+        sdoSeqInstance_l.pFreeRing = pRing->pNext;
+        OPLK_FREE(pRing);
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Initialize history buffer
@@ -1959,7 +2251,7 @@ The function initializes the history buffer of a SDO connection.
 //------------------------------------------------------------------------------
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p)
 {
-    pSdoSeqCon_p->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
+    pSdoSeqCon_p->sdoSeqConHistory.freeEntries = pSdoSeqCon_p->sdoSeqConHistory.size;
     pSdoSeqCon_p->sdoSeqConHistory.ackIndex = 0;
     pSdoSeqCon_p->sdoSeqConHistory.writeIndex = 0;
 
@@ -2000,16 +2292,16 @@ static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
     // check if a free entry is available
     if (pHistory->freeEntries > 0)
     {   // write message in free entry
-        pHistoryFrame = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->writeIndex];
+        pHistoryFrame = (tPlkFrame*)pHistory->pEntry[pHistory->writeIndex].aFrame;
 
         OPLK_MEMCPY(&pHistoryFrame->messageType,
                     &pFrame_p->messageType,
                     size_p + ASND_HEADER_SIZE);
-        pHistory->aFrameSize[pHistory->writeIndex] = size_p;
-        pHistory->afFrameFirstTxFailed[pHistory->writeIndex] = fTxFailed_p;
+        pHistory->pEntry[pHistory->writeIndex].frameSize = size_p;
+        pHistory->pEntry[pHistory->writeIndex].fFirstTxFailed = fTxFailed_p;
         pHistory->freeEntries--;
         pHistory->writeIndex++;
-        if (pHistory->writeIndex == SDO_HISTORY_SIZE)    // check if write-index ran over array-border
+        if (pHistory->writeIndex == pHistory->size)     // check if write-index ran over array-border
             pHistory->writeIndex = 0;
     }
     else
@@ -2091,21 +2383,21 @@ static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     // release all acknowledged frames from history buffer
 
     // check if there are entries in history
-    if (pHistory->freeEntries < SDO_HISTORY_SIZE)
+    if (pHistory->freeEntries < pHistory->size)
     {
         ackIndex = pHistory->ackIndex;
         do
         {
-            pHistoryFrame = (tPlkFrame*)pHistory->aHistoryFrame[ackIndex];
+            pHistoryFrame = (tPlkFrame*)pHistory->pEntry[ackIndex].aFrame;
 
             currentSeqNum = (pHistoryFrame->data.asnd.payload.sdoSequenceFrame.sendSeqNumCon & SEQ_NUM_MASK);
             if (((recvSeqNumber_p - currentSeqNum) & SEQ_NUM_MASK) < SDO_SEQ_NUM_THRESHOLD)
             {
-                pHistory->aFrameSize[ackIndex] = 0;
-                pHistory->afFrameFirstTxFailed[ackIndex] = FALSE;
+                pHistory->pEntry[ackIndex].frameSize = 0;
+                pHistory->pEntry[ackIndex].fFirstTxFailed = FALSE;
                 ackIndex++;
                 pHistory->freeEntries++;
-                if (ackIndex == SDO_HISTORY_SIZE)
+                if (ackIndex == pHistory->size)
                     ackIndex = 0;
             }
             else
@@ -2160,12 +2452,12 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     }
 
     // history buffer not empty and end of read iteration not yet reached
-    if ((pHistory->freeEntries < SDO_HISTORY_SIZE) &&
+    if ((pHistory->freeEntries < pHistory->size) &&
         ((pHistory->writeIndex != pHistory->readIndex) ||
          ((pHistory->freeEntries == 0) && fInitRead_p)))
     {
         // inform caller about unsent frame
-        if (pHistory->afFrameFirstTxFailed[pHistory->readIndex])
+        if (pHistory->pEntry[pHistory->readIndex].fFirstTxFailed)
         {
             // signal caller, that this frame has not been sent successfully yet
             ret = kErrorRetry;
@@ -2179,13 +2471,13 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                             (UINT16)pHistory->ackIndex);
         DEBUG_LVL_SDO_TRACE(", free entries = %u, next frame size = %u\n",
                             (UINT16)pHistory->freeEntries,
-                            pHistory->aFrameSize[pHistory->readIndex]);
+                            pHistory->pEntry[pHistory->readIndex].frameSize);
 
         // return pointer to stored frame
-        *ppFrame_p = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->readIndex];
-        *pSize_p = pHistory->aFrameSize[pHistory->readIndex];   // save size
+        *ppFrame_p = (tPlkFrame*)pHistory->pEntry[pHistory->readIndex].aFrame;
+        *pSize_p = pHistory->pEntry[pHistory->readIndex].frameSize; // save size
         pHistory->readIndex++;
-        if (pHistory->readIndex == SDO_HISTORY_SIZE)
+        if (pHistory->readIndex == pHistory->size)
             pHistory->readIndex = 0;
     }
     else
@@ -2434,7 +2726,7 @@ static BOOL checkHistoryAcked(const tSdoSeqCon* pSdoSeqCon_p,
 
     // get pointer to history buffer
     pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
-    pHistoryFrame = (const tPlkFrame*)pHistory->aHistoryFrame[pHistory->ackIndex];
+    pHistoryFrame = (const tPlkFrame*)pHistory->pEntry[pHistory->ackIndex].aFrame;
     currentSeqNum = (pHistoryFrame->data.asnd.payload.sdoSequenceFrame.sendSeqNumCon & SEQ_NUM_MASK);
     if (((recvSeqNumber_p - currentSeqNum) & SEQ_NUM_MASK) < SDO_SEQ_NUM_THRESHOLD)
     {   // acknowledges at least the oldest history frame
@@ -53,10 +53,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#ifndef CONFIG_SDO_MAX_CONNECTION_UDP
-#define CONFIG_SDO_MAX_CONNECTION_UDP  5
-#endif
-
 #if (TARGET_SYSTEM == _LINUX_)
 #include <arpa/inet.h>
 #else
@@ -98,6 +94,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
+// The connections are hashed by the last byte of the IP address, which is the
+// node ID within the POWERLINK network.
+#define SDO_UDP_HASH_SIZE           256
+#define SDO_UDP_HASH(ipAddr)        (ntohl(ipAddr) & (SDO_UDP_HASH_SIZE - 1))
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -106,6 +107,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef struct
 {
     tSdoUdpCon              aSdoUdpConnection[CONFIG_SDO_MAX_CONNECTION_UDP];
+    UINT16                  aNextConnection[CONFIG_SDO_MAX_CONNECTION_UDP];     // next connection index + 1 in the hash chain
+    UINT16                  aHashHead[SDO_UDP_HASH_SIZE];                       // first connection index + 1 of each hash chain
+    UINT16                  aFreeConnection[CONFIG_SDO_MAX_CONNECTION_UDP];     // stack of free connection indices
+    UINT                    freeConnectionCount;
     tSequLayerReceiveCb     pfnSdoAsySeqCb;
 } tSdoUdpInstance;
 
@@ -118,6 +123,9 @@ static tSdoUdpInstance      sdoUdpInstance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static UINT findConnection(ULONG ipAddr_p, ULONG port_p);
+static UINT addConnection(ULONG ipAddr_p, ULONG port_p);
+static void removeConnection(UINT array_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -139,9 +147,14 @@ The function initializes the SDO over UDP module.
 tOplkError sdoudp_init(tSequLayerReceiveCb pfnReceiveCb_p)
 {
     tOplkError  ret;
+    UINT        count;
 
     OPLK_MEMSET(&sdoUdpInstance_l, 0x00, sizeof(sdoUdpInstance_l));
 
+    // the lowest connection index is allocated first
+    for (count = CONFIG_SDO_MAX_CONNECTION_UDP; count > 0; count--)
+        sdoUdpInstance_l.aFreeConnection[sdoUdpInstance_l.freeConnectionCount++] = (UINT16)(count - 1);
+
     if (pfnReceiveCb_p != NULL)
         sdoUdpInstance_l.pfnSdoAsySeqCb = pfnReceiveCb_p;
     else
@@ -230,57 +243,46 @@ The function initializes a new connection.
 //------------------------------------------------------------------------------
 tOplkError sdoudp_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        count;
-    UINT        freeCon;
+    tOplkError  ret;
+    UINT        array;
     tSdoUdpCon* pSdoUdpCon;
 
     // Check parameter validity
     ASSERT(pSdoConHandle_p != NULL);
 
-    // get free entry in control structure
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_UDP;
-    pSdoUdpCon = &sdoUdpInstance_l.aSdoUdpConnection[0];
-
-    while (count < CONFIG_SDO_MAX_CONNECTION_UDP)
-    {
-        if ((pSdoUdpCon->ipAddr & htonl(0xFF)) == htonl(targetNodeId_p))
-        {   // existing connection to target node found -> set handle
-            *pSdoConHandle_p = (count | SDO_UDP_HANDLE);
-            return ret;
-        }
-        else if ((pSdoUdpCon->ipAddr == 0) && (pSdoUdpCon->port == 0))
-            freeCon = count;
+    sdoudp_criticalSection(TRUE);
 
-        count++;
-        pSdoUdpCon++;
+    // all connections of the hash chain belong to the target node
+    array = sdoUdpInstance_l.aHashHead[targetNodeId_p & (SDO_UDP_HASH_SIZE - 1)];
+    if (array != 0)
+    {   // existing connection to target node found -> set handle
+        sdoudp_criticalSection(FALSE);
+        *pSdoConHandle_p = ((array - 1) | SDO_UDP_HANDLE);
+        return kErrorOk;
     }
 
-    if (freeCon == CONFIG_SDO_MAX_CONNECTION_UDP)
-        ret = kErrorSdoUdpNoFreeHandle;
-    else
-    {
-        pSdoUdpCon = &sdoUdpInstance_l.aSdoUdpConnection[freeCon];
-        // save infos for connection
-        pSdoUdpCon->port = htons(C_SDO_EPL_PORT);
-        pSdoUdpCon->ipAddr = htonl(0xC0A86400 | targetNodeId_p);    // 192.168.100.targetNodeId_p
-
-        ret = sdoudp_arpQuery(pSdoUdpCon->ipAddr);
-        if (ret != kErrorOk)
-        {
-            // Reset connection handle
-            pSdoUdpCon->port = 0;
-            pSdoUdpCon->ipAddr = 0;
-
-            return ret;
-        }
+    // save infos for connection
+    array = addConnection(htonl(0xC0A86400 | targetNodeId_p),   // 192.168.100.targetNodeId_p
+                          htons(C_SDO_EPL_PORT));
+    sdoudp_criticalSection(FALSE);
+    if (array == CONFIG_SDO_MAX_CONNECTION_UDP)
+        return kErrorSdoUdpNoFreeHandle;
 
-        // set handle
-        *pSdoConHandle_p = (freeCon | SDO_UDP_HANDLE);
+    pSdoUdpCon = &sdoUdpInstance_l.aSdoUdpConnection[array];
+    ret = sdoudp_arpQuery(pSdoUdpCon->ipAddr);
+    if (ret != kErrorOk)
+    {
+        // Reset connection handle
+        sdoudp_criticalSection(TRUE);
+        removeConnection(array);
+        sdoudp_criticalSection(FALSE);
+        return ret;
     }
 
-    return ret;
+    // set handle
+    *pSdoConHandle_p = (array | SDO_UDP_HANDLE);
+
+    return kErrorOk;
 }
 
 //------------------------------------------------------------------------------
@@ -343,44 +345,21 @@ void sdoudp_receiveData(const tSdoUdpCon* pSdoUdpCon_p,
                         UINT dataSize_p)
 {
     tOplkError  ret;
-    INT         count;
-    INT         freeEntry;
+    UINT        count;
+    UINT        freeEntry;
     tSdoConHdl  sdoConHdl;
 
-    // get handle for higher layer
-    count = 0;
-    freeEntry = 0xFFFF;
-
     sdoudp_criticalSection(TRUE);
 
-    while (count < CONFIG_SDO_MAX_CONNECTION_UDP)
-    {
-        // check if this connection is already known
-        if ((sdoUdpInstance_l.aSdoUdpConnection[count].ipAddr == pSdoUdpCon_p->ipAddr) &&
-            (sdoUdpInstance_l.aSdoUdpConnection[count].port == pSdoUdpCon_p->port))
-        {
-            break;
-        }
-
-        if ((sdoUdpInstance_l.aSdoUdpConnection[count].ipAddr == 0) &&
-            (sdoUdpInstance_l.aSdoUdpConnection[count].port == 0) &&
-            (freeEntry == 0xFFFF))
-        {
-            freeEntry = count;
-        }
-
-        count++;
-    }
+    // get handle for higher layer
+    count = findConnection(pSdoUdpCon_p->ipAddr, pSdoUdpCon_p->port);
 
     if (count == CONFIG_SDO_MAX_CONNECTION_UDP)
     {
-        // connection unknown -> see if there is a free handle
-        if (freeEntry != 0xFFFF)
+        // connection unknown -> see if there is a free handle and save address infos
+        freeEntry = addConnection(pSdoUdpCon_p->ipAddr, pSdoUdpCon_p->port);
+        if (freeEntry != CONFIG_SDO_MAX_CONNECTION_UDP)
         {
-            // save address infos
-            sdoUdpInstance_l.aSdoUdpConnection[freeEntry].ipAddr = pSdoUdpCon_p->ipAddr;
-            sdoUdpInstance_l.aSdoUdpConnection[freeEntry].port = pSdoUdpCon_p->port;
-
             sdoudp_criticalSection(FALSE);
 
             // call callback
@@ -448,8 +427,9 @@ tOplkError sdoudp_delConnection(tSdoConHdl sdoConHandle_p)
         return kErrorSdoUdpInvalidHdl;
 
     // delete connection
-    sdoUdpInstance_l.aSdoUdpConnection[array].ipAddr = 0;
-    sdoUdpInstance_l.aSdoUdpConnection[array].port = 0;
+    sdoudp_criticalSection(TRUE);
+    removeConnection(array);
+    sdoudp_criticalSection(FALSE);
 
     return ret;
 }
@@ -460,6 +440,101 @@ tOplkError sdoudp_delConnection(tSdoConHdl sdoConHandle_p)
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Find connection
+
+The function searches the connection to the given remote address in the hash
+chain of the address.
+
+\param[in]      ipAddr_p            IP address in network byte order.
+\param[in]      port_p              Port in network byte order.
+
+\return The function returns the index of the connection or
+        CONFIG_SDO_MAX_CONNECTION_UDP if no connection is found.
+*/
+//------------------------------------------------------------------------------
+static UINT findConnection(ULONG ipAddr_p, ULONG port_p)
+{
+    UINT        array;
+    tSdoUdpCon* pSdoUdpCon;
+
+    array = sdoUdpInstance_l.aHashHead[SDO_UDP_HASH(ipAddr_p)];
+    while (array != 0)
+    {
+        pSdoUdpCon = &sdoUdpInstance_l.aSdoUdpConnection[array - 1];
+        if ((pSdoUdpCon->ipAddr == ipAddr_p) && (pSdoUdpCon->port == port_p))
+            return array - 1;
+
+        array = sdoUdpInstance_l.aNextConnection[array - 1];
+    }
+
+    return CONFIG_SDO_MAX_CONNECTION_UDP;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add connection
+
+The function takes a free connection entry, saves the remote address and
+inserts it into the hash chain of the address.
+
+\param[in]      ipAddr_p            IP address in network byte order.
+\param[in]      port_p              Port in network byte order.
+
+\return The function returns the index of the connection or
+        CONFIG_SDO_MAX_CONNECTION_UDP if no free entry is available.
+*/
+//------------------------------------------------------------------------------
+static UINT addConnection(ULONG ipAddr_p, ULONG port_p)
+{
+    UINT    array;
+    UINT    hash;
+
+    if (sdoUdpInstance_l.freeConnectionCount == 0)
+        return CONFIG_SDO_MAX_CONNECTION_UDP;
+
+    array = sdoUdpInstance_l.aFreeConnection[--sdoUdpInstance_l.freeConnectionCount];
+    sdoUdpInstance_l.aSdoUdpConnection[array].ipAddr = ipAddr_p;
+    sdoUdpInstance_l.aSdoUdpConnection[array].port = port_p;
+
+    hash = SDO_UDP_HASH(ipAddr_p);
+    sdoUdpInstance_l.aNextConnection[array] = sdoUdpInstance_l.aHashHead[hash];
+    sdoUdpInstance_l.aHashHead[hash] = (UINT16)(array + 1);
+
+    return array;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove connection
+
+The function removes a connection from its hash chain and returns the entry to
+the free entries. Nothing is done if the entry is not in use.
+
+\param[in]      array_p             Index of the connection.
+*/
+//------------------------------------------------------------------------------
+static void removeConnection(UINT array_p)
+{
+    tSdoUdpCon* pSdoUdpCon = &sdoUdpInstance_l.aSdoUdpConnection[array_p];
+    UINT16*     pLink;
+
+    if ((pSdoUdpCon->ipAddr == 0) && (pSdoUdpCon->port == 0))
+        return;
+
+    pLink = &sdoUdpInstance_l.aHashHead[SDO_UDP_HASH(pSdoUdpCon->ipAddr)];
+    while (*pLink != (array_p + 1))
+        pLink = &sdoUdpInstance_l.aNextConnection[*pLink - 1];
+
+    *pLink = sdoUdpInstance_l.aNextConnection[array_p];
+    sdoUdpInstance_l.aNextConnection[array_p] = 0;
+
+    pSdoUdpCon->ipAddr = 0;
+    pSdoUdpCon->port = 0;
+    sdoUdpInstance_l.aFreeConnection[sdoUdpInstance_l.freeConnectionCount++] = (UINT16)array_p;
+}
+
 /// \}
 
 #endif
@@ -5,7 +5,10 @@
 \brief  Implementation of user timer module for Linux userspace
 
 This file contains the implementation of the user timer module for Linux
-userspace. This implementation uses the posix timer interface.
+userspace. All timers are kept in a hierarchical timer wheel with millisecond
+resolution which is driven by a single timerfd. The timer entries are taken
+from preallocated pools, so setting, modifying and deleting a timer takes
+constant time.
 
 \ingroup module_timeru
 *******************************************************************************/
@@ -47,9 +50,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
 #include <pthread.h>
-#include <semaphore.h>
-#include <signal.h>
+#include <sys/timerfd.h>
 
 // Needed for debugging to extract thread ID on Linux
 #include <sys/syscall.h>
@@ -77,6 +81,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Every wheel level consists of 2^TIMERU_WHEEL_BITS slots. A slot of level n
+// covers 2^(n * TIMERU_WHEEL_BITS) ms, so five levels cover about 12 days.
+// Longer timeouts are parked in the last level and re-inserted when cascaded.
+#define TIMERU_WHEEL_BITS           6
+#define TIMERU_WHEEL_SLOTS          (1 << TIMERU_WHEEL_BITS)
+#define TIMERU_WHEEL_MASK           (TIMERU_WHEEL_SLOTS - 1)
+#define TIMERU_WHEEL_LEVELS         5
+#define TIMERU_WHEEL_RANGE          (1ULL << (TIMERU_WHEEL_BITS * TIMERU_WHEEL_LEVELS))
+
+#define TIMERU_NSEC_PER_MSEC        1000000ULL
 
 //------------------------------------------------------------------------------
 // local types
@@ -85,19 +99,34 @@ typedef struct sTimeruData tTimeruData;
 
 struct sTimeruData
 {
-    timer_t             timer;
     tTimerArg           timerArgument;
-    tTimeruData*        pNextTimer;
-    tTimeruData*        pPrevTimer;
+    UINT64              expiryMs;           ///< Absolute expiry time of the timer
+    tTimeruData*        pNextTimer;         ///< Next timer in wheel slot or free list
+    tTimeruData*        pPrevTimer;         ///< Previous timer in wheel slot
+    tTimeruData**       ppSlot;             ///< Wheel slot of the timer, NULL if not running
+};
+
+typedef struct sTimeruPool tTimeruPool;
+
+struct sTimeruPool
+{
+    tTimeruPool*        pNextPool;
+    tTimeruData         aTimer[TIMERU_MAX_ENTRIES];
 };
 
 typedef struct
 {
     pthread_t           processThread;
     pthread_mutex_t     mutex;
-    tTimeruData*        pFirstTimer;
-    tTimeruData*        pLastTimer;
-    tTimeruData*        pCurrentTimer;
+    int                 timerFd;                ///< timerfd which drives the wheel
+    BOOL                fStopThread;
+    UINT64              wheelTimeMs;            ///< Next wheel tick to be processed
+    UINT64              armedTimeMs;            ///< Tick the timerfd is armed for, 0 if disarmed
+    UINT                runningTimers;          ///< Number of timers in the wheel
+    UINT64              aSlotMap[TIMERU_WHEEL_LEVELS];  ///< Bitmap of non-empty slots per level
+    tTimeruData*        aapSlot[TIMERU_WHEEL_LEVELS][TIMERU_WHEEL_SLOTS];
+    tTimeruData*        pFreeTimer;             ///< List of unused timer entries
+    tTimeruPool*        pFirstPool;             ///< List of allocated timer pools
 } tTimeruInstance;
 
 //------------------------------------------------------------------------------
@@ -108,12 +137,18 @@ static tTimeruInstance timeruInstance_g;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static void         cbTimer(const tTimeruData* pData_p);
 static void*        processThread(void* pArgument_p);
-static void         addTimer(tTimeruData* pData_p);
-static void         removeTimer(tTimeruData* pData_p);
-static void         resetTimerList(void);
-static tTimeruData* getNextTimer(void);
+static void         processWheel(UINT64 nowMs_p);
+static void         cbTimer(tTimerHdl timerHdl_p, const tTimerArg* pArgument_p);
+static tTimeruData* allocTimer(void);
+static void         freeTimer(tTimeruData* pData_p);
+static void         startTimer(tTimeruData* pData_p, ULONG timeInMs_p);
+static void         linkTimer(tTimeruData* pData_p);
+static void         unlinkTimer(tTimeruData* pData_p);
+static void         cascadeSlot(UINT level_p, UINT slot_p);
+static UINT64       getNextTick(void);
+static void         armTimerFd(UINT64 tickMs_p);
+static UINT64       getCurrentTimeNs(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -134,17 +169,37 @@ tOplkError timeru_init(void)
 {
     struct sched_param  schedParam;
     int                 retVal;
+    tTimeruData*        pData;
 
     // reset instance structure
-    timeruInstance_g.processThread = 0;
-    timeruInstance_g.pFirstTimer = NULL;
-    timeruInstance_g.pLastTimer = NULL;
+    OPLK_MEMSET(&timeruInstance_g, 0, sizeof(timeruInstance_g));
+    timeruInstance_g.wheelTimeMs = getCurrentTimeNs() / TIMERU_NSEC_PER_MSEC;
+
+    timeruInstance_g.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timeruInstance_g.timerFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create timerfd! (%d)\n",
+                              __func__,
+                              errno);
+        return kErrorNoResource;
+    }
 
     if (pthread_mutex_init(&timeruInstance_g.mutex, NULL) != 0)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex!\n", __func__);
+        close(timeruInstance_g.timerFd);
+        return kErrorNoResource;
+    }
+
+    // preallocate the first timer pool
+    pData = allocTimer();
+    if (pData == NULL)
+    {
+        pthread_mutex_destroy(&timeruInstance_g.mutex);
+        close(timeruInstance_g.timerFd);
         return kErrorNoResource;
     }
+    freeTimer(pData);
 
     retVal = pthread_create(&timeruInstance_g.processThread,
                             NULL,
@@ -155,7 +210,8 @@ tOplkError timeru_init(void)
         DEBUG_LVL_ERROR_TRACE("%s() couldn't create timer thread! (%d)\n",
                               __func__,
                               retVal);
-        pthread_mutex_destroy(&timeruInstance_g.mutex);
+        timeruInstance_g.processThread = 0;
+        timeru_exit();
         return kErrorNoResource;
     }
 
@@ -188,32 +244,37 @@ The function shuts down the user timer instance.
 //------------------------------------------------------------------------------
 tOplkError timeru_exit(void)
 {
-    tTimeruData*    pTimer;
+    tTimeruPool*        pPool;
+    struct itimerspec   wakeTime;
 
     /* Check if the processThread exist */
     if (timeruInstance_g.processThread != 0)
     {
-        /* cancel thread */
-        pthread_cancel(timeruInstance_g.processThread);
+        // wake up the thread immediately to let it exit
+        timeruInstance_g.fStopThread = TRUE;
+        OPLK_MEMSET(&wakeTime, 0, sizeof(wakeTime));
+        wakeTime.it_value.tv_nsec = 1;
+        timerfd_settime(timeruInstance_g.timerFd, 0, &wakeTime, NULL);
         DEBUG_LVL_TIMERU_TRACE("%s() Waiting for thread to exit...\n", __func__);
 
         /* wait for thread to terminate */
         pthread_join(timeruInstance_g.processThread, NULL);
         DEBUG_LVL_TIMERU_TRACE("%s()Thread exited\n", __func__);
+        timeruInstance_g.processThread = 0;
     }
 
-    /* free up timer list */
-    resetTimerList();
-    while ((pTimer = getNextTimer()) != NULL)
+    /* free up timer pools */
+    while ((pPool = timeruInstance_g.pFirstPool) != NULL)
     {
-        removeTimer(pTimer);
-        OPLK_FREE(pTimer);
+        timeruInstance_g.pFirstPool = pPool->pNextPool;
+        OPLK_FREE(pPool);
     }
 
     pthread_mutex_destroy(&timeruInstance_g.mutex);
+    close(timeruInstance_g.timerFd);
 
-    timeruInstance_g.pFirstTimer = NULL;
-    timeruInstance_g.pLastTimer = NULL;
+    timeruInstance_g.pFreeTimer = NULL;
+    timeruInstance_g.runningTimers = 0;
 
     return kErrorOk;
 }
@@ -257,57 +318,30 @@ tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p,
                            ULONG timeInMs_p,
                            const tTimerArg* pArgument_p)
 {
-    tTimeruData*        pData;
-    struct itimerspec   relTime;
-    struct itimerspec   curTime;
-    struct sigevent     sev;
+    tTimeruData*    pData;
 
     if (pTimerHdl_p == NULL)
         return kErrorTimerInvalidHandle;
 
-    pData = (tTimeruData*)OPLK_MALLOC(sizeof(tTimeruData));
-    if (pData == NULL)
-        return kErrorNoResource;
-
-    OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
-
-    addTimer(pData);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
 
-    sev.sigev_notify = SIGEV_SIGNAL;
-    sev.sigev_signo = SIGRTMIN;
-    sev.sigev_value.sival_ptr = pData;
-    if (timer_create(CLOCK_MONOTONIC, &sev, &pData->timer) == -1)
+    pData = allocTimer();
+    if (pData == NULL)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() Error creating timer!\n", __func__);
-        OPLK_FREE(pData);
-        return kErrorNoResource;
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
+        return kErrorTimerNoTimerCreated;
     }
 
-    if (timeInMs_p >= 1000)
-    {
-        relTime.it_value.tv_sec = (timeInMs_p / 1000);
-        relTime.it_value.tv_nsec = (timeInMs_p % 1000) * 1000000;
-    }
-    else
-    {
-        relTime.it_value.tv_sec = 0;
-        relTime.it_value.tv_nsec = timeInMs_p * 1000000;
-    }
+    OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
+    startTimer(pData, timeInMs_p);
+
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     DEBUG_LVL_TIMERU_TRACE("%s() Set timer: %p, timeInMs_p=%ld\n",
                            __func__,
                            (void*)pData,
                            timeInMs_p);
 
-    relTime.it_interval.tv_sec = 0;
-    relTime.it_interval.tv_nsec = 0;
-
-    if (timer_settime(pData->timer, 0, &relTime, &curTime) < 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error timer_settime!\n", __func__);
-        return kErrorTimerNoTimerCreated;
-    }
-
     *pTimerHdl_p = (tTimerHdl)pData;
     return kErrorOk;
 }
@@ -332,8 +366,7 @@ tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
                               ULONG timeInMs_p,
                               const tTimerArg* pArgument_p)
 {
-    tTimeruData*        pData;
-    struct itimerspec   relTime, curTime;
+    tTimeruData*    pData;
 
     if (pTimerHdl_p == NULL)
         return kErrorTimerInvalidHandle;
@@ -344,36 +377,19 @@ tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
 
     pData = (tTimeruData*)*pTimerHdl_p;
 
-    if (timeInMs_p >= 1000)
-    {
-        relTime.it_value.tv_sec = (timeInMs_p / 1000);
-        relTime.it_value.tv_nsec = (timeInMs_p % 1000) * 1000000;
-    }
-    else
-    {
-        relTime.it_value.tv_sec = 0;
-        relTime.it_value.tv_nsec = timeInMs_p * 1000000;
-    }
-
     DEBUG_LVL_TIMERU_TRACE("%s() Modify timer:%08x timeInMs_p=%ld\n",
                            __func__,
                            *pTimerHdl_p,
                            timeInMs_p);
 
-    relTime.it_interval.tv_sec = 0;
-    relTime.it_interval.tv_nsec = 0;
-    if (timer_settime(pData->timer, 0, &relTime, &curTime) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error timer_settime!\n", __func__);
-        return kErrorTimerNoTimerCreated;
-    }
-
-    // copy the TimerArg after the timer is restarted,
-    // so that a timer occurred immediately before timer_settime
-    // won't use the new timerArg and
-    // therefore the old timer cannot be distinguished from the new one.
-    // But if the new timer is too fast, it may get lost.
+    // The timer argument is exchanged together with the timeout. An expiry
+    // which was already reported carries the old argument, therefore the old
+    // timer can be distinguished from the new one.
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    unlinkTimer(pData);
     OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
+    startTimer(pData, timeInMs_p);
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     return kErrorOk;
 }
@@ -406,9 +422,10 @@ tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
 
     pData = (tTimeruData*)*pTimerHdl_p;
 
-    timer_delete(pData->timer);
-    removeTimer(pData);
-    OPLK_FREE(pData);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    unlinkTimer(pData);
+    freeTimer(pData);
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     // uninitialize handle
     *pTimerHdl_p = 0;
@@ -432,7 +449,7 @@ This function checks if a timer is active (is running).
 BOOL timeru_isActive(tTimerHdl timerHdl_p)
 {
     const tTimeruData*  pData;
-    struct itimerspec   remaining;
+    BOOL                fActive;
 
     // check handle itself, i.e. was the handle initialized before
     if (timerHdl_p == 0)
@@ -441,13 +458,11 @@ BOOL timeru_isActive(tTimerHdl timerHdl_p)
     }
     pData = (const tTimeruData*)timerHdl_p;
 
-    // check if timer is running
-    timer_gettime(pData->timer, &remaining);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    fActive = (pData->ppSlot != NULL);
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
-    if ((remaining.it_value.tv_sec == 0) && (remaining.it_value.tv_nsec == 0))
-        return FALSE;
-    else
-        return TRUE;
+    return fActive;
 }
 
 //============================================================================//
@@ -461,7 +476,8 @@ BOOL timeru_isActive(tTimerHdl timerHdl_p)
 \brief  Timer thread function
 
 This function implements the timer thread function which will be started as
-thread and is responsible for processing expired timers.
+thread and is responsible for processing expired timers. It sleeps on the
+timerfd which is armed for the next wheel tick containing timers.
 
 \param[in,out]  pArgument_p         Thread argument. Not used!
 
@@ -470,63 +486,139 @@ thread and is responsible for processing expired timers.
 //------------------------------------------------------------------------------
 static void* processThread(void* pArgument_p)
 {
-    tTimeruData*    pTimer;
-    sigset_t        awaitedSignal;
-    siginfo_t       signalInfo;
+    UINT64      expirations;
+    ssize_t     readSize;
 
     UNUSED_PARAMETER(pArgument_p);
 
     DEBUG_LVL_TIMERU_TRACE("%s() ThreadId:%d\n", __func__, syscall(SYS_gettid));
 
-    sigemptyset(&awaitedSignal);
-    sigaddset(&awaitedSignal, SIGRTMIN);
-    pthread_sigmask(SIG_BLOCK, &awaitedSignal, NULL);
+    while (!timeruInstance_g.fStopThread)
+    {
+        readSize = read(timeruInstance_g.timerFd, &expirations, sizeof(expirations));
+        if ((readSize < 0) && (errno != EINTR) && (errno != EAGAIN))
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() reading timerfd failed (%d)\n",
+                                  __func__,
+                                  errno);
+            break;
+        }
+
+        if (timeruInstance_g.fStopThread)
+            break;
+
+        processWheel(getCurrentTimeNs() / TIMERU_NSEC_PER_MSEC);
+    }
 
-    /* loop forever until thread will be canceled */
-    while (1)
+    DEBUG_LVL_TIMERU_TRACE("%s() Exiting!\n", __func__);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process timer wheel
+
+This function advances the timer wheel up to the given time. It cascades the
+timers of the upper levels and reports all expired timers. Only the ticks
+returned by getNextTick() are processed, all others are skipped. Afterwards,
+the timerfd is armed for the next tick which has to be processed.
+
+The timer events are posted without holding the mutex, so the event handlers
+may modify the timers.
+
+\param[in]      nowMs_p             Current time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static void processWheel(UINT64 nowMs_p)
+{
+    tTimeruData*    pData;
+    tTimerHdl       timerHdl;
+    tTimerArg       timerArgument;
+    UINT64          tickMs;
+    UINT            slot;
+    UINT            level;
+
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+
+    timeruInstance_g.armedTimeMs = 0;
+
+    for (;;)
     {
-        if (sigwaitinfo(&awaitedSignal, &signalInfo) > 0)
+        tickMs = getNextTick();
+        if ((tickMs == 0) || (tickMs > nowMs_p))
+        {   // nothing to do until now
+            if (timeruInstance_g.wheelTimeMs <= nowMs_p)
+                timeruInstance_g.wheelTimeMs = nowMs_p + 1;
+            break;
+        }
+
+        timeruInstance_g.wheelTimeMs = tickMs;
+        slot = (UINT)(tickMs & TIMERU_WHEEL_MASK);
+
+        // move the timers of the upper level slots which start now
+        if (slot == 0)
         {
-            pTimer = (tTimeruData*)signalInfo.si_value.sival_ptr;
-            if (pTimer != NULL)
-                /* call callback function of timer */
-                cbTimer(pTimer);
-            else
+            for (level = 1; level < TIMERU_WHEEL_LEVELS; level++)
             {
-                DEBUG_LVL_ERROR_TRACE("%s() sival_ptr==NULL code=%d\n",
-                                      __func__,
-                                      signalInfo.si_code);
+                UINT upperSlot = (UINT)((tickMs >> (level * TIMERU_WHEEL_BITS)) & TIMERU_WHEEL_MASK);
+
+                cascadeSlot(level, upperSlot);
+                if (upperSlot != 0)
+                    break;
             }
         }
+
+        // report the expired timers
+        while ((pData = timeruInstance_g.aapSlot[0][slot]) != NULL)
+        {
+            unlinkTimer(pData);
+
+            timerHdl = (tTimerHdl)pData;
+            OPLK_MEMCPY(&timerArgument, &pData->timerArgument, sizeof(tTimerArg));
+
+            pthread_mutex_unlock(&timeruInstance_g.mutex);
+            cbTimer(timerHdl, &timerArgument);
+            pthread_mutex_lock(&timeruInstance_g.mutex);
+
+            // the wheel was restarted by startTimer() while it was empty
+            if (timeruInstance_g.wheelTimeMs != tickMs)
+                break;
+        }
+
+        if (timeruInstance_g.wheelTimeMs == tickMs)
+            timeruInstance_g.wheelTimeMs = tickMs + 1;
     }
 
-    DEBUG_LVL_TIMERU_TRACE("%s() Exiting!\n", __func__);
-    return NULL;
+    tickMs = getNextTick();
+    if (tickMs != 0)
+        armTimerFd(tickMs);
+
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Timer callback function
 
-This function is registered if a timer is started and therefore will be called
-by the timer when it expires.
+This function is called if a timer expires. It posts the timer event to the
+event sink of the timer.
 
-\param[in]      pData_p             The user defined parameter supplied when starting
-                                    the timer.
+\param[in]      timerHdl_p          Handle of the expired timer.
+\param[in]      pArgument_p         Argument of the expired timer.
 */
 //------------------------------------------------------------------------------
-static void cbTimer(const tTimeruData* pData_p)
+static void cbTimer(tTimerHdl timerHdl_p, const tTimerArg* pArgument_p)
 {
     tEvent          event;
     tTimerEventArg  timerEventArg;
 
     // call event function
-    timerEventArg.timerHdl.handle = (tTimerHdl)pData_p;
+    timerEventArg.timerHdl.handle = timerHdl_p;
     OPLK_MEMCPY(&timerEventArg.argument,
-                &pData_p->timerArgument.argument,
+                &pArgument_p->argument,
                 sizeof(timerEventArg.argument));
 
-    event.eventSink = pData_p->timerArgument.eventSink;
+    event.eventSink = pArgument_p->eventSink;
     event.eventType = kEventTypeTimer;
     OPLK_MEMSET(&event.netTime, 0x00, sizeof(tNetTime));
     event.eventArg.pEventArg = &timerEventArg;
@@ -537,105 +629,309 @@ static void cbTimer(const tTimeruData* pData_p)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Add a timer to the timer list
+\brief  Allocate a timer entry
 
-This function adds a new timer to the timer list.
+This function takes a timer entry from the free list. If the list is empty,
+a further pool of \ref TIMERU_MAX_ENTRIES entries is allocated. The mutex must
+be locked by the caller.
 
-\param[in,out]  pData_p             Pointer to the timer structure.
+\return The function returns a pointer to the timer entry or NULL if no memory
+        is available.
 */
 //------------------------------------------------------------------------------
-static void addTimer(tTimeruData* pData_p)
+static tTimeruData* allocTimer(void)
 {
-    tTimeruData*    pTimerData;
-
-    pthread_mutex_lock(&timeruInstance_g.mutex);
+    tTimeruData*    pData;
+    tTimeruPool*    pPool;
+    UINT            index;
 
-    if (timeruInstance_g.pFirstTimer == NULL)
+    if (timeruInstance_g.pFreeTimer == NULL)
     {
-        timeruInstance_g.pFirstTimer = pData_p;
-        timeruInstance_g.pLastTimer = pData_p;
-        pData_p->pPrevTimer = NULL;
-        pData_p->pNextTimer = NULL;
+        pPool = (tTimeruPool*)OPLK_MALLOC(sizeof(tTimeruPool));
+        if (pPool == NULL)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() couldn't allocate timer pool!\n", __func__);
+            return NULL;
+        }
+
+        if (timeruInstance_g.pFirstPool != NULL)
+        {
+            DEBUG_LVL_TIMERU_TRACE("%s() All timers in use, increase TIMERU_MAX_ENTRIES!\n",
+                                   __func__);
+        }
+
+        pPool->pNextPool = timeruInstance_g.pFirstPool;
+        timeruInstance_g.pFirstPool = pPool;
+
+        for (index = 0; index < TIMERU_MAX_ENTRIES; index++)
+            freeTimer(&pPool->aTimer[index]);
     }
-    else
+
+    pData = timeruInstance_g.pFreeTimer;
+    timeruInstance_g.pFreeTimer = pData->pNextTimer;
+    pData->pNextTimer = NULL;
+
+    return pData;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a timer entry
+
+This function puts a timer entry back to the free list. The mutex must be locked
+by the caller.
+
+\param[in,out]  pData_p             Pointer to the timer entry.
+*/
+//------------------------------------------------------------------------------
+static void freeTimer(tTimeruData* pData_p)
+{
+    pData_p->ppSlot = NULL;
+    pData_p->pPrevTimer = NULL;
+    pData_p->pNextTimer = timeruInstance_g.pFreeTimer;
+    timeruInstance_g.pFreeTimer = pData_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start a timer
+
+This function calculates the expiry time of a timer and inserts it into the
+timer wheel. The timerfd is re-armed if the timer expires before the currently
+armed tick. The mutex must be locked by the caller.
+
+\param[in,out]  pData_p             Pointer to the timer entry.
+\param[in]      timeInMs_p          Timeout in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static void startTimer(tTimeruData* pData_p, ULONG timeInMs_p)
+{
+    UINT64  tickMs;
+    UINT64  nowNs = getCurrentTimeNs();
+
+    // an empty wheel can be moved to the current time without processing
+    if (timeruInstance_g.runningTimers == 0)
+        timeruInstance_g.wheelTimeMs = nowNs / TIMERU_NSEC_PER_MSEC;
+
+    // round up to the next millisecond, a timer must never expire too early
+    pData_p->expiryMs = (nowNs + (timeInMs_p * TIMERU_NSEC_PER_MSEC) +
+                         TIMERU_NSEC_PER_MSEC - 1) / TIMERU_NSEC_PER_MSEC;
+
+    linkTimer(pData_p);
+
+    tickMs = getNextTick();
+    if ((timeruInstance_g.armedTimeMs == 0) || (tickMs < timeruInstance_g.armedTimeMs))
+        armTimerFd(tickMs);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link a timer into the wheel
+
+This function inserts a timer into the wheel slot which matches its expiry time.
+Timers which expire within the next 2^TIMERU_WHEEL_BITS ticks are inserted into
+level 0, later ones into the level whose slot covers the expiry time. The mutex
+must be locked by the caller.
+
+\param[in,out]  pData_p             Pointer to the timer entry.
+*/
+//------------------------------------------------------------------------------
+static void linkTimer(tTimeruData* pData_p)
+{
+    UINT64          expiryMs = pData_p->expiryMs;
+    UINT64          delta;
+    UINT            level;
+    UINT            slot;
+    tTimeruData**   ppSlot;
+
+    if (expiryMs < timeruInstance_g.wheelTimeMs)
+        expiryMs = timeruInstance_g.wheelTimeMs;
+
+    delta = expiryMs - timeruInstance_g.wheelTimeMs;
+    if (delta >= TIMERU_WHEEL_RANGE)
+    {   // park timer in the last slot, it is re-inserted after cascading
+        expiryMs = timeruInstance_g.wheelTimeMs + TIMERU_WHEEL_RANGE - 1;
+        delta = TIMERU_WHEEL_RANGE - 1;
+    }
+
+    for (level = 0; level < (TIMERU_WHEEL_LEVELS - 1); level++)
     {
-        pTimerData = timeruInstance_g.pLastTimer;
-        pTimerData->pNextTimer = pData_p;
-        pData_p->pPrevTimer = pTimerData;
-        pData_p->pNextTimer = NULL;
-        timeruInstance_g.pLastTimer = pData_p;
+        if (delta < (1ULL << ((level + 1) * TIMERU_WHEEL_BITS)))
+            break;
     }
 
-    pthread_mutex_unlock(&timeruInstance_g.mutex);
+    slot = (UINT)((expiryMs >> (level * TIMERU_WHEEL_BITS)) & TIMERU_WHEEL_MASK);
+    ppSlot = &timeruInstance_g.aapSlot[level][slot];
+
+    pData_p->ppSlot = ppSlot;
+    pData_p->pPrevTimer = NULL;
+    pData_p->pNextTimer = *ppSlot;
+    if (*ppSlot != NULL)
+        (*ppSlot)->pPrevTimer = pData_p;
+    *ppSlot = pData_p;
+
+    timeruInstance_g.aSlotMap[level] |= (1ULL << slot);
+    timeruInstance_g.runningTimers++;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Remove a timer from the timer list
+\brief  Unlink a timer from the wheel
 
-This function removes a new timer from the timer list.
+This function removes a timer from its wheel slot. Nothing is done if the
+timer is not running. The mutex must be locked by the caller.
 
-\param[in,out]  pData_p             Pointer to the timer structure.
+\param[in,out]  pData_p             Pointer to the timer entry.
 */
 //------------------------------------------------------------------------------
-static void removeTimer(tTimeruData* pData_p)
+static void unlinkTimer(tTimeruData* pData_p)
 {
-    tTimeruData*    pTimerData;
+    tTimeruData**   ppSlot = pData_p->ppSlot;
+    UINT            index;
 
-    pthread_mutex_lock(&timeruInstance_g.mutex);
+    if (ppSlot == NULL)
+        return;
 
-    if (pData_p->pPrevTimer == NULL)          // first one
+    if (pData_p->pPrevTimer != NULL)
+        pData_p->pPrevTimer->pNextTimer = pData_p->pNextTimer;
+    else
+        *ppSlot = pData_p->pNextTimer;
+
+    if (pData_p->pNextTimer != NULL)
+        pData_p->pNextTimer->pPrevTimer = pData_p->pPrevTimer;
+
+    if (*ppSlot == NULL)
     {
-        timeruInstance_g.pFirstTimer = pData_p->pNextTimer;
-        pTimerData = pData_p->pNextTimer;
-        if (pTimerData != NULL)
-            pTimerData->pPrevTimer = NULL;
+        index = (UINT)(ppSlot - &timeruInstance_g.aapSlot[0][0]);
+        timeruInstance_g.aSlotMap[index / TIMERU_WHEEL_SLOTS] &= ~(1ULL << (index % TIMERU_WHEEL_SLOTS));
     }
-    else if (pData_p->pNextTimer == NULL)     // last one
+
+    pData_p->ppSlot = NULL;
+    pData_p->pNextTimer = NULL;
+    pData_p->pPrevTimer = NULL;
+    timeruInstance_g.runningTimers--;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cascade a wheel slot
+
+This function re-inserts all timers of an upper level slot into the wheel. It is
+called when the wheel time reaches the start of the slot, so the timers move to
+the lower levels. The mutex must be locked by the caller.
+
+\param[in]      level_p             Level of the slot.
+\param[in]      slot_p              Index of the slot.
+*/
+//------------------------------------------------------------------------------
+static void cascadeSlot(UINT level_p, UINT slot_p)
+{
+    tTimeruData*    pData;
+
+    while ((pData = timeruInstance_g.aapSlot[level_p][slot_p]) != NULL)
     {
-        timeruInstance_g.pLastTimer = pData_p->pPrevTimer;
-        pTimerData = pData_p->pPrevTimer;
-        pTimerData->pNextTimer = NULL;
+        unlinkTimer(pData);
+        linkTimer(pData);
     }
-    else
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get next wheel tick to be processed
+
+This function determines the next wheel tick at which timers expire or have to
+be cascaded. A slot of level n is due at the first multiple of its slot length
+which is not yet processed and whose slot index matches. The earliest due slot
+of each level is found with the slot bitmap. The mutex must be locked by the
+caller.
+
+\return The function returns the tick in milliseconds or 0 if no timer is
+        running.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getNextTick(void)
+{
+    UINT64  wheelTimeMs = timeruInstance_g.wheelTimeMs;
+    UINT64  nextTickMs = 0;
+    UINT64  tickMs;
+    UINT64  slotNumber;
+    UINT64  slotMap;
+    UINT    rotation;
+    UINT    shift;
+    UINT    level;
+
+    if (timeruInstance_g.runningTimers == 0)
+        return 0;
+
+    for (level = 0; level < TIMERU_WHEEL_LEVELS; level++)
     {
-        pData_p->pPrevTimer->pNextTimer = pData_p->pNextTimer;
-        pData_p->pNextTimer->pPrevTimer = pData_p->pPrevTimer;
+        slotMap = timeruInstance_g.aSlotMap[level];
+        if (slotMap == 0)
+            continue;
+
+        // first slot of this level which has not been processed yet
+        shift = level * TIMERU_WHEEL_BITS;
+        slotNumber = wheelTimeMs >> shift;
+        if ((wheelTimeMs & ((1ULL << shift) - 1)) != 0)
+            slotNumber++;
+
+        rotation = (UINT)(slotNumber & TIMERU_WHEEL_MASK);
+        if (rotation != 0)
+            slotMap = (slotMap >> rotation) | (slotMap << (TIMERU_WHEEL_SLOTS - rotation));
+
+        tickMs = (slotNumber + __builtin_ctzll(slotMap)) << shift;
+        if ((nextTickMs == 0) || (tickMs < nextTickMs))
+            nextTickMs = tickMs;
     }
 
-    pthread_mutex_unlock(&timeruInstance_g.mutex);
+    return nextTickMs;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Reset the timer list
+\brief  Arm timerfd
+
+This function arms the timerfd to expire at the given wheel tick. The mutex must
+be locked by the caller.
 
-This function resets the timer list.
+\param[in]      tickMs_p            Wheel tick in milliseconds.
 */
 //------------------------------------------------------------------------------
-static void resetTimerList(void)
+static void armTimerFd(UINT64 tickMs_p)
 {
-    timeruInstance_g.pCurrentTimer = timeruInstance_g.pFirstTimer;
+    struct itimerspec   wakeTime;
+    UINT64              wakeTimeNs = tickMs_p * TIMERU_NSEC_PER_MSEC;
+
+    wakeTime.it_value.tv_sec = (time_t)(wakeTimeNs / 1000000000ULL);
+    wakeTime.it_value.tv_nsec = (long)(wakeTimeNs % 1000000000ULL);
+    wakeTime.it_interval.tv_sec = 0;
+    wakeTime.it_interval.tv_nsec = 0;
+
+    if (timerfd_settime(timeruInstance_g.timerFd, TFD_TIMER_ABSTIME, &wakeTime, NULL) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Error timerfd_settime! (%d)\n", __func__, errno);
+        return;
+    }
+
+    timeruInstance_g.armedTimeMs = tickMs_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get next timer from the list
+\brief  Get current time
 
-This function gets the next timer from the timer list.
+This function returns the current time of the monotonic clock.
 
-\return     The function returns a pointer to the next timer in the timer list.
+\return The function returns the time in nanoseconds.
 */
 //------------------------------------------------------------------------------
-static tTimeruData* getNextTimer(void)
+static UINT64 getCurrentTimeNs(void)
 {
-    tTimeruData*    pTimer;
+    struct timespec currentTime;
 
-    pTimer = timeruInstance_g.pCurrentTimer;
-    if (pTimer != NULL)
-        timeruInstance_g.pCurrentTimer = pTimer->pNextTimer;
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
 
-    return pTimer;
+    return ((UINT64)currentTime.tv_sec * 1000000000ULL) + (UINT64)currentTime.tv_nsec;
 }
 
 /// \}
@@ -2,10 +2,11 @@
 ********************************************************************************
 \file   timesyncucal-bsdsem.c
 
-\brief  Sync implementation for the user CAL timesync module using BSD semaphores
+\brief  Sync implementation for the user CAL timesync module using POSIX shared memory
 
 This file contains a sync implementation for the user CAL timesync module. It
-uses BSD semaphores for synchronisation.
+waits on a doorbell and reads the newest sync event from a sync record in POSIX
+shared memory. Sync events which were missed by the application are counted.
 
 \ingroup module_timesyncucal
 *******************************************************************************/
@@ -44,10 +45,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/timesync.h>
 #include <user/timesyncucal.h>
 
-#include <errno.h>
+#include <common/doorbell.h>
+
+#include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
-#include <semaphore.h>
+#include <sys/mman.h>
 #include <time.h>
 
 //============================================================================//
@@ -74,19 +77,39 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define TIMESYNC_WAIT_INTERVAL      1000    // Wait interval if waiting forever [ms]
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief User CAL timesync instance
+
+The structure contains all necessary information needed by the user CAL
+timesync module.
+*/
+typedef struct
+{
+    int                     fd;                     ///< Shared memory file descriptor
+    tTimesyncSyncRecord*    pSyncRecord;            ///< Pointer to the shared sync record
+    tDoorbell*              pDoorbell;              ///< Doorbell rung by the kernel layer on sync events
+    tTimesyncSyncInfo       syncInfo;               ///< Sync event returned by the last wait
+    BOOL                    fSyncInfoValid;         ///< A sync event was received
+    UINT32                  missedSyncEvents;       ///< Sync events missed before the last received one
+    UINT32                  totalMissedSyncEvents;  ///< Total number of missed sync events
+} tTimesyncucalInstance;
+
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static sem_t*           syncSem_l;
+static tTimesyncucalInstance    instance_l = { .fd = -1 };
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static void   readSyncRecord(tTimesyncSyncInfo* pSyncInfo_p);
+static UINT64 getTimeMs(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -107,16 +130,39 @@ The function initializes the user CAL timesync module
 //------------------------------------------------------------------------------
 tOplkError timesyncucal_init(tSyncCb pfnSyncCb_p)
 {
+    tOplkError  ret;
+
     UNUSED_PARAMETER(pfnSyncCb_p);
 
-    syncSem_l = sem_open(TIMESYNC_SYNC_BSDSEM, O_CREAT, S_IRWXG, 1);
-    if (syncSem_l == SEM_FAILED)
+    OPLK_MEMSET(&instance_l, 0, sizeof(tTimesyncucalInstance));
+
+    // The sync record and the doorbell are created by the kernel layer
+    instance_l.fd = shm_open(TIMESYNC_SYNC_SHM, O_RDWR, 0);
+    if (instance_l.fd < 0)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() creating sem failed!\n", __func__);
+        DEBUG_LVL_ERROR_TRACE("%s() shm_open failed!\n", __func__);
         return kErrorNoResource;
     }
 
+    instance_l.pSyncRecord = (tTimesyncSyncRecord*)mmap(NULL, sizeof(tTimesyncSyncRecord),
+                                                        PROT_READ, MAP_SHARED, instance_l.fd, 0);
+    if (instance_l.pSyncRecord == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap failed!\n", __func__);
+        instance_l.pSyncRecord = NULL;
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    ret = doorbell_open(TIMESYNC_SYNC_DOORBELL, &instance_l.pDoorbell);
+    if (ret != kErrorOk)
+        goto Exit;
+
     return kErrorOk;
+
+Exit:
+    timesyncucal_exit();
+    return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -130,14 +176,30 @@ The function cleans up the user CAL timesync module
 //------------------------------------------------------------------------------
 void timesyncucal_exit(void)
 {
-    sem_close(syncSem_l);
+    doorbell_close(instance_l.pDoorbell);
+    instance_l.pDoorbell = NULL;
+
+    if (instance_l.pSyncRecord != NULL)
+    {
+        munmap(instance_l.pSyncRecord, sizeof(tTimesyncSyncRecord));
+        instance_l.pSyncRecord = NULL;
+    }
+
+    if (instance_l.fd >= 0)
+    {
+        close(instance_l.fd);
+        instance_l.fd = -1;
+    }
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Wait for a sync event
 
-The function waits for a sync event.
+The function waits for the next sync event. If the application missed sync
+events, only the newest one is returned and the missed events are counted.
+The information of the received sync event can be read with
+timesyncucal_getSyncInfo().
 
 \param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
                                     forever.
@@ -151,35 +213,90 @@ The function waits for a sync event.
 //------------------------------------------------------------------------------
 tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p)
 {
-    int                 semRet;
-    struct timespec     currentTime;
-    struct timespec     semTimeout;
+    tTimesyncSyncInfo   syncInfo;
+    UINT64              startTime;
+    UINT64              elapsedTime;
+    UINT32              timeoutMs;
+
+    if ((instance_l.pSyncRecord == NULL) || (instance_l.pDoorbell == NULL))
+        return kErrorGeneralError;
 
-    if (timeout_p != 0)
+    startTime = getTimeMs();
+    timeoutMs = (UINT32)((timeout_p + 999) / 1000);
+
+    for (;;)
     {
-        if (timeout_p >= 1000000)
+        if (doorbell_wait(instance_l.pDoorbell,
+                          (timeout_p != 0) ? timeoutMs : TIMESYNC_WAIT_INTERVAL,
+                          NULL))
         {
-            semTimeout.tv_sec = (timeout_p / 1000000);
-            semTimeout.tv_nsec = (timeout_p % 1000000) * 1000;
+            // The doorbell coalesces sync events, the record always contains
+            // the newest one.
+            readSyncRecord(&syncInfo);
+            if (!instance_l.fSyncInfoValid ||
+                (syncInfo.syncEventCount != instance_l.syncInfo.syncEventCount))
+                break;
+
+            // The record was already read after the doorbell was rung for the
+            // previous sync event, wait for the next one.
         }
-        else
+
+        if (timeout_p != 0)
         {
-            semTimeout.tv_sec = 0;
-            semTimeout.tv_nsec = timeout_p * 1000;
+            elapsedTime = getTimeMs() - startTime;
+            if (elapsedTime >= timeoutMs)
+                return kErrorGeneralError;
+
+            timeoutMs -= (UINT32)elapsedTime;
+            startTime += elapsedTime;
         }
-        clock_gettime(CLOCK_REALTIME, &currentTime);
-        TIMESPECADD(&semTimeout, &currentTime);
-        semRet = sem_timedwait(syncSem_l, &semTimeout);
     }
-    else
+
+    if (instance_l.fSyncInfoValid)
     {
-        semRet = sem_wait(syncSem_l);
+        instance_l.missedSyncEvents = syncInfo.syncEventCount - instance_l.syncInfo.syncEventCount - 1;
+        instance_l.totalMissedSyncEvents += instance_l.missedSyncEvents;
     }
 
-    if (semRet == 0)
-        return kErrorOk;
-    else
-        return kErrorGeneralError;
+    instance_l.syncInfo = syncInfo;
+    instance_l.fSyncInfoValid = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get sync event information
+
+The function returns the information of the sync event which was received by
+the last call of timesyncucal_waitSyncEvent().
+
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    Sync event information is returned.
+\retval kErrorInvalidOperation      No sync event was received yet.
+
+\ingroup module_timesyncucal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncucal_getSyncInfo(tOplkApiSyncInfo* pSyncInfo_p)
+{
+    // Check parameter validity
+    ASSERT(pSyncInfo_p != NULL);
+
+    if (!instance_l.fSyncInfoValid)
+        return kErrorInvalidOperation;
+
+    pSyncInfo_p->syncEventCount = instance_l.syncInfo.syncEventCount;
+    pSyncInfo_p->cycleCount = instance_l.syncInfo.cycleCount;
+    pSyncInfo_p->missedSyncEvents = instance_l.missedSyncEvents;
+    pSyncInfo_p->totalMissedSyncEvents = instance_l.totalMissedSyncEvents;
+    pSyncInfo_p->netTime = instance_l.syncInfo.socTime.netTime;
+    pSyncInfo_p->relTime = instance_l.syncInfo.socTime.relTime;
+    pSyncInfo_p->fValidRelTime = (instance_l.syncInfo.socTime.fRelTimeValid != 0);
+
+    return kErrorOk;
 }
 
 //============================================================================//
@@ -188,4 +305,45 @@ tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p)
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read the sync record
+
+The function reads a consistent copy of the sync record. If the kernel layer
+updates the record while it is read, the read is repeated.
+
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+*/
+//------------------------------------------------------------------------------
+static void readSyncRecord(tTimesyncSyncInfo* pSyncInfo_p)
+{
+    const tTimesyncSyncRecord*  pSyncRecord = instance_l.pSyncRecord;
+    UINT32                      sequence;
+
+    do
+    {
+        sequence = __atomic_load_n(&pSyncRecord->sequence, __ATOMIC_ACQUIRE);
+        OPLK_MEMCPY(pSyncInfo_p, &pSyncRecord->syncInfo, sizeof(tTimesyncSyncInfo));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (((sequence & 1) != 0) ||
+             (sequence != __atomic_load_n(&pSyncRecord->sequence, __ATOMIC_RELAXED)));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+The function returns the current time of the monotonic clock.
+
+\return The function returns the time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeMs(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000ULL) + (UINT64)(curTime.tv_nsec / 1000000);
+}
+
 /// \}
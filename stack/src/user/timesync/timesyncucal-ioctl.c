@@ -155,6 +155,28 @@ tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p)
     return kErrorGeneralError;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get sync event information
+
+The function returns the information of the sync event which was received by
+the last call of timesyncucal_waitSyncEvent().
+
+\param[out]     pSyncInfo_p         Pointer to store the sync event information.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesyncucal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncucal_getSyncInfo(tOplkApiSyncInfo* pSyncInfo_p)
+{
+    UNUSED_PARAMETER(pSyncInfo_p);
+
+    // This CAL is not supporting that feature
+    return kErrorApiNotSupported;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -0,0 +1,391 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for circular buffer library
+
+This file contains the unit test functions for the circular buffer library. The
+tests run on a locked buffer, on a buffer with a lock-free consumer and on a
+lock-free single producer buffer. The buffer modes are selected by the buffer
+IDs, see CONFIG_CIRCBUF_LOCKFREE_QUEUES in the CMake file of the test.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <CUnit/CUnit.h>
+
+#include "test-circbuf.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_BUFFER_SIZE            1024
+#define TEST_MAX_BLOCK_SIZE         64
+#define TEST_ROUNDS                 10
+
+#define TEST_BENCHMARK_BUFFER_SIZE  4096
+#define TEST_BENCHMARK_BLOCKS       200000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief  Circular buffer mode under test
+*/
+typedef struct
+{
+    UINT8           bufferId;
+    BOOL            fLockFree;
+    BOOL            fSingleProducer;
+    const char*     pName;
+} tTestBufferMode;
+
+/**
+\brief  Header of a benchmark data block
+*/
+typedef struct
+{
+    UINT32          sequence;
+    UINT32          size;
+    UINT64          writeTimeNs;
+} tTestBlockHeader;
+
+/**
+\brief  State of the benchmark consumer thread
+*/
+typedef struct
+{
+    tCircBufInstance*   pInstance;
+    UINT32              errorCount;
+    UINT64              latencySumNs;
+    UINT64              maxLatencyNs;
+} tTestConsumer;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void  fillBlock(UINT8* pData_p, size_t size_p, UINT32 sequence_p);
+static BOOL  checkBlock(const UINT8* pData_p, size_t size_p, UINT32 sequence_p);
+static void* consumerThread(void* pArg_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const tTestBufferMode aBufferMode_l[] =
+{
+    { TEST_CIRCBUF_ID_LOCKED,           FALSE,  FALSE,  "locked" },
+    { TEST_CIRCBUF_ID_LOCKFREE,         TRUE,   FALSE,  "lock-free consumer" },
+    { TEST_CIRCBUF_ID_SINGLE_PRODUCER,  TRUE,   TRUE,   "single producer" },
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test circbuf_writeData() and circbuf_readData()
+
+The function fills each buffer with blocks of varying size until it is full
+and reads them back. Several rounds are done, so the blocks wrap around at the
+end of the buffer.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_writeRead(void)
+{
+    tCircBufInstance*   pInstance;
+    UINT8               aData[TEST_MAX_BLOCK_SIZE];
+    size_t              size;
+    size_t              readSize;
+    UINT32              writeSequence;
+    UINT32              readSequence;
+    UINT                round;
+    UINT                mode;
+
+    for (mode = 0; mode < tabentries(aBufferMode_l); mode++)
+    {
+        CU_ASSERT_EQUAL(circbuf_alloc(aBufferMode_l[mode].bufferId, TEST_BUFFER_SIZE, &pInstance),
+                        kCircBufOk);
+        if (pInstance == NULL)
+            continue;
+
+#if defined(CIRCBUF_LOCKFREE_SUPPORT)
+        CU_ASSERT_EQUAL(pInstance->pCircBufHeader->fLockFree != FALSE,
+                        aBufferMode_l[mode].fLockFree != FALSE);
+        CU_ASSERT_EQUAL(pInstance->pCircBufHeader->fSingleProducer != FALSE,
+                        aBufferMode_l[mode].fSingleProducer != FALSE);
+#endif
+
+        CU_ASSERT_EQUAL(circbuf_readData(pInstance, aData, sizeof(aData), &readSize),
+                        kCircBufNoReadableData);
+
+        writeSequence = 0;
+        readSequence = 0;
+        for (round = 0; round < TEST_ROUNDS; round++)
+        {
+            for (;;)
+            {
+                size = 1 + (writeSequence % TEST_MAX_BLOCK_SIZE);
+                fillBlock(aData, size, writeSequence);
+                if (circbuf_writeData(pInstance, aData, size) != kCircBufOk)
+                    break;
+                writeSequence++;
+            }
+
+            CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), writeSequence - readSequence);
+
+            while (circbuf_readData(pInstance, aData, sizeof(aData), &readSize) == kCircBufOk)
+            {
+                CU_ASSERT_EQUAL(readSize, 1 + (readSequence % TEST_MAX_BLOCK_SIZE));
+                CU_ASSERT_TRUE(checkBlock(aData, readSize, readSequence));
+                readSequence++;
+            }
+
+            CU_ASSERT_EQUAL(readSequence, writeSequence);
+            CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 0);
+        }
+
+        CU_ASSERT_EQUAL(circbuf_free(pInstance), kCircBufOk);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark locked and lock-free buffers
+
+The function passes TEST_BENCHMARK_BLOCKS blocks of varying size from the
+test thread to a consumer thread through each buffer. It prints the throughput
+and the latency between writing and reading a block for each buffer mode.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_benchmark(void)
+{
+    tTestConsumer       consumer;
+    pthread_t           consumerThreadId;
+    UINT8               aData[TEST_MAX_BLOCK_SIZE];
+    tTestBlockHeader*   pBlockHeader = (tTestBlockHeader*)aData;
+    size_t              size;
+    UINT64              startTimeNs;
+    UINT64              runTimeNs;
+    UINT32              sequence;
+    UINT                mode;
+    int                 ret;
+
+    for (mode = 0; mode < tabentries(aBufferMode_l); mode++)
+    {
+        memset(&consumer, 0, sizeof(consumer));
+        CU_ASSERT_EQUAL(circbuf_alloc(aBufferMode_l[mode].bufferId, TEST_BENCHMARK_BUFFER_SIZE,
+                                      &consumer.pInstance),
+                        kCircBufOk);
+        if (consumer.pInstance == NULL)
+            continue;
+
+        startTimeNs = stub_getTimeNs();
+        ret = pthread_create(&consumerThreadId, NULL, consumerThread, &consumer);
+        CU_ASSERT_EQUAL(ret, 0);
+        if (ret != 0)
+        {
+            circbuf_free(consumer.pInstance);
+            continue;
+        }
+
+        for (sequence = 0; sequence < TEST_BENCHMARK_BLOCKS; sequence++)
+        {
+            size = sizeof(tTestBlockHeader) + (sequence % (TEST_MAX_BLOCK_SIZE - sizeof(tTestBlockHeader)));
+            fillBlock(aData, size, sequence);
+            pBlockHeader->writeTimeNs = stub_getTimeNs();
+            while (circbuf_writeData(consumer.pInstance, aData, size) == kCircBufBufferFull)
+                sched_yield();
+        }
+
+        pthread_join(consumerThreadId, NULL);
+        runTimeNs = stub_getTimeNs() - startTimeNs;
+
+        CU_ASSERT_EQUAL(consumer.errorCount, 0);
+        CU_ASSERT_EQUAL(circbuf_getDataCount(consumer.pInstance), 0);
+        CU_ASSERT_EQUAL(circbuf_free(consumer.pInstance), kCircBufOk);
+
+        printf("\n%u blocks, %s: %lu ns per block, latency %lu ns average, %lu ns maximum",
+               TEST_BENCHMARK_BLOCKS,
+               aBufferMode_l[mode].pName,
+               (unsigned long)(runTimeNs / TEST_BENCHMARK_BLOCKS),
+               (unsigned long)(consumer.latencySumNs / TEST_BENCHMARK_BLOCKS),
+               (unsigned long)consumer.maxLatencyNs);
+    }
+
+    printf("\n");
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill a test data block
+
+The function fills a data block with a pattern derived from its sequence
+number. Blocks large enough to hold a tTestBlockHeader start with the header.
+
+\param[out]     pData_p             Pointer to the data block.
+\param[in]      size_p              Size of the data block.
+\param[in]      sequence_p          Sequence number of the data block.
+*/
+//------------------------------------------------------------------------------
+static void fillBlock(UINT8* pData_p, size_t size_p, UINT32 sequence_p)
+{
+    tTestBlockHeader    header;
+    size_t              index;
+
+    for (index = 0; index < size_p; index++)
+        pData_p[index] = (UINT8)(sequence_p + index);
+
+    if (size_p >= sizeof(tTestBlockHeader))
+    {
+        header.sequence = sequence_p;
+        header.size = (UINT32)size_p;
+        header.writeTimeNs = 0;
+        memcpy(pData_p, &header, sizeof(header));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check a test data block
+
+The function checks a data block which was filled by fillBlock(). The write
+time stored in the header is not checked.
+
+\param[in]      pData_p             Pointer to the data block.
+\param[in]      size_p              Size of the data block.
+\param[in]      sequence_p          Expected sequence number of the data block.
+
+\return The function returns TRUE if the data block is correct.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkBlock(const UINT8* pData_p, size_t size_p, UINT32 sequence_p)
+{
+    tTestBlockHeader    header;
+    size_t              index = 0;
+
+    if (size_p >= sizeof(tTestBlockHeader))
+    {
+        memcpy(&header, pData_p, sizeof(header));
+        if ((header.sequence != sequence_p) || (header.size != size_p))
+            return FALSE;
+
+        index = sizeof(tTestBlockHeader);
+    }
+
+    for (; index < size_p; index++)
+    {
+        if (pData_p[index] != (UINT8)(sequence_p + index))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark consumer thread
+
+The thread reads TEST_BENCHMARK_BLOCKS blocks from the buffer, checks them and
+records the latency between writing and reading each block.
+
+\param[in,out]  pArg_p              Pointer to the consumer state.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* consumerThread(void* pArg_p)
+{
+    tTestConsumer*      pConsumer = (tTestConsumer*)pArg_p;
+    UINT8               aData[TEST_MAX_BLOCK_SIZE];
+    tTestBlockHeader    header;
+    size_t              readSize;
+    UINT64              latencyNs;
+    UINT32              sequence = 0;
+    tCircBufError       ret;
+
+    while (sequence < TEST_BENCHMARK_BLOCKS)
+    {
+        ret = circbuf_readData(pConsumer->pInstance, aData, sizeof(aData), &readSize);
+        if (ret == kCircBufNoReadableData)
+        {
+            sched_yield();
+            continue;
+        }
+
+        latencyNs = stub_getTimeNs();
+        if ((ret != kCircBufOk) || !checkBlock(aData, readSize, sequence))
+        {
+            pConsumer->errorCount++;
+            break;
+        }
+
+        memcpy(&header, aData, sizeof(header));
+        latencyNs -= header.writeTimeNs;
+        pConsumer->latencySumNs += latencyNs;
+        if (latencyNs > pConsumer->maxLatencyNs)
+            pConsumer->maxLatencyNs = latencyNs;
+
+        sequence++;
+    }
+
+    return NULL;
+}
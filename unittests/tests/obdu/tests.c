@@ -0,0 +1,296 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for object dictionary module
+
+This file contains the unit test functions for the object dictionary module.
+The tests use the CiA302-4 MN object dictionary. The index lookup is checked
+against a linear search of the OD partitions. The lookup benchmark uses the
+configuration of the MN library (CONFIG_OBD_USE_INDEX_TABLE in oplkcfg.h), so
+the index table and the search path are compared by building the test with
+both settings.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <CUnit/CUnit.h>
+
+#include <obdcreate/obdcreate.h>
+
+#include "test-obdu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MAX_LOOKUPS            65536
+#define TEST_BENCHMARK_ROUNDS       100
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief  Index and sub-index of an object used by the lookup benchmark
+*/
+typedef struct
+{
+    UINT16          index;
+    UINT8           subIndex;
+} tTestLookup;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static const tObdEntry* searchObject(UINT index_p);
+static const tObdEntry* searchPart(const tObdEntry* pObdEntry_p, UINT index_p);
+static UINT             collectLookups(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam    obdInitParam_l;
+static tTestLookup      aLookup_l[TEST_MAX_LOOKUPS];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the object dictionary
+
+The function creates the object dictionary and initializes the OD module.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError test_initObd(void)
+{
+    tOplkError  ret;
+
+    ret = obdcreate_initObd(&obdInitParam_l);
+    if (ret != kErrorOk)
+        return ret;
+
+    return obdu_init(&obdInitParam_l, stub_cbObdAccess);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test obdu_getAccessType()
+
+The function looks up sub-index 0 of every index and checks that exactly the
+indices contained in the OD partitions are found. For each object in the OD,
+the access type of every sub-index entry is checked.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_getAccessType(void)
+{
+    const tObdEntry*    pObdEntry;
+    tObdAccess          access;
+    tOplkError          ret;
+    UINT                index;
+    UINT                subEntry;
+    UINT                mismatchCount = 0;
+
+    for (index = 0; index < OBD_TABLE_INDEX_END; index++)
+    {
+        pObdEntry = searchObject(index);
+        ret = obdu_getAccessType(index, 0, &access);
+        if ((ret == kErrorOk) != (pObdEntry != NULL))
+            mismatchCount++;
+
+        if (pObdEntry == NULL)
+            continue;
+
+        for (subEntry = 0; subEntry < pObdEntry->count; subEntry++)
+        {
+            // sub-index entries of arrays cover all sub-indices above 0
+            if ((pObdEntry->pSubIndex[subEntry].access & kObdAccArray) != 0)
+                break;
+
+            ret = obdu_getAccessType(index, pObdEntry->pSubIndex[subEntry].subIndex, &access);
+            if ((ret != kErrorOk) || (access != pObdEntry->pSubIndex[subEntry].access))
+                mismatchCount++;
+        }
+    }
+
+    CU_ASSERT_EQUAL(mismatchCount, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark object lookup
+
+The function calls obdu_getObjectDataPtr() for all existing index and
+sub-index pairs of the OD and prints the time per lookup.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_lookupBenchmark(void)
+{
+    UINT        lookupCount;
+    UINT        round;
+    UINT        lookup;
+    UINT64      startTimeNs;
+    UINT64      lookupTimeNs;
+
+    lookupCount = collectLookups();
+    CU_ASSERT_NOT_EQUAL(lookupCount, 0);
+    if (lookupCount == 0)
+        return;
+
+    startTimeNs = stub_getTimeNs();
+    for (round = 0; round < TEST_BENCHMARK_ROUNDS; round++)
+    {
+        for (lookup = 0; lookup < lookupCount; lookup++)
+            obdu_getObjectDataPtr(aLookup_l[lookup].index, aLookup_l[lookup].subIndex);
+    }
+    lookupTimeNs = stub_getTimeNs() - startTimeNs;
+
+    printf("\n%u sub-indices, %s: %lu ns per lookup\n",
+           lookupCount,
+           (CONFIG_OBD_USE_INDEX_TABLE != FALSE) ? "index table" : "search",
+           (unsigned long)(lookupTimeNs / ((UINT64)lookupCount * TEST_BENCHMARK_ROUNDS)));
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Search an object in the OD partitions
+
+The function searches an index linearly in all OD partitions. It is used as
+reference for the lookup of the OD module.
+
+\param[in]      index_p             Index to search.
+
+\return The function returns the index entry or NULL if the index does not
+        exist.
+*/
+//------------------------------------------------------------------------------
+static const tObdEntry* searchObject(UINT index_p)
+{
+    const tObdEntry*    pObdEntry;
+
+    pObdEntry = searchPart(obdInitParam_l.pGenericPart, index_p);
+    if (pObdEntry == NULL)
+        pObdEntry = searchPart(obdInitParam_l.pManufacturerPart, index_p);
+    if (pObdEntry == NULL)
+        pObdEntry = searchPart(obdInitParam_l.pDevicePart, index_p);
+
+    return pObdEntry;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Search an object in an OD partition
+
+\param[in]      pObdEntry_p         First index entry of the partition.
+\param[in]      index_p             Index to search.
+
+\return The function returns the index entry or NULL if the index does not
+        exist in the partition.
+*/
+//------------------------------------------------------------------------------
+static const tObdEntry* searchPart(const tObdEntry* pObdEntry_p, UINT index_p)
+{
+    for (; pObdEntry_p->index != OBD_TABLE_INDEX_END; pObdEntry_p++)
+    {
+        if (pObdEntry_p->index == index_p)
+            return pObdEntry_p;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Collect the lookups of the benchmark
+
+The function stores all existing index and sub-index pairs of the OD in the
+lookup table of the benchmark.
+
+\return The function returns the number of stored lookups.
+*/
+//------------------------------------------------------------------------------
+static UINT collectLookups(void)
+{
+    tObdAccess  access;
+    UINT        index;
+    UINT        subIndex;
+    UINT        lookupCount = 0;
+
+    for (index = 0; index < OBD_TABLE_INDEX_END; index++)
+    {
+        if (searchObject(index) == NULL)
+            continue;
+
+        for (subIndex = 0; subIndex <= 0xFF; subIndex++)
+        {
+            if (obdu_getAccessType(index, subIndex, &access) != kErrorOk)
+                continue;
+
+            if (lookupCount >= TEST_MAX_LOOKUPS)
+                return lookupCount;
+
+            aLookup_l[lookupCount].index = (UINT16)index;
+            aLookup_l[lookupCount].subIndex = (UINT8)subIndex;
+            lookupCount++;
+        }
+    }
+
+    return lookupCount;
+}
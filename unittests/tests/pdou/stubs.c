@@ -0,0 +1,462 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for user PDO module unit tests
+
+This file contains all stubs needed by the unit tests of the user PDO module.
+The object dictionary stub provides TEST_PDO_CHANNELS RPDO and TPDO channels
+which all use the same mapping per direction. The mapped objects are registered
+by the tests.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+#include <time.h>
+
+#include <oplk/oplkinc.h>
+#include <oplk/debugstr.h>
+#include <common/target.h>
+#include <user/obdu.h>
+#include <user/pdoucal.h>
+
+#include "test-pdou.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_OBJECT_COUNT           256
+#define STUB_MAPP_OBJECT_COUNT      254
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    UINT        index;
+    UINT        subIndex;
+    tObdType    type;
+    tObdSize    size;
+    void*       pVar;
+} tStubObject;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static const tStubObject* findObject(UINT index_p, UINT subIndex_p);
+static tOplkError readValue(void* pDstData_p, tObdSize* pSize_p, const void* pSrcData_p, tObdSize size_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tStubObject  aObject_l[STUB_OBJECT_COUNT];
+static UINT         objectCount_l = 0;
+static UINT64       aRxMapping_l[STUB_MAPP_OBJECT_COUNT];
+static UINT8        rxMappObjectCount_l = 0;
+static UINT64       aTxMapping_l[STUB_MAPP_OBJECT_COUNT];
+static UINT8        txMappObjectCount_l = 0;
+static UINT8        aRxPdoBuffer_l[TEST_PDO_CHANNELS][TEST_PDO_SIZE];
+static UINT8        aTxPdoBuffer_l[TEST_PDO_CHANNELS][TEST_PDO_SIZE];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_resetOd(void)
+{
+    objectCount_l = 0;
+    rxMappObjectCount_l = 0;
+    txMappObjectCount_l = 0;
+}
+
+void stub_addObject(UINT index_p, UINT subIndex_p, tObdType type_p, tObdSize size_p, void* pVar_p)
+{
+    tStubObject*    pObject;
+
+    if (objectCount_l >= STUB_OBJECT_COUNT)
+        return;
+
+    pObject = &aObject_l[objectCount_l++];
+    pObject->index = index_p;
+    pObject->subIndex = subIndex_p;
+    pObject->type = type_p;
+    pObject->size = size_p;
+    pObject->pVar = pVar_p;
+}
+
+void stub_setMapping(BOOL fTxPdo_p, const UINT64* paObjectMapping_p, UINT mappObjectCount_p)
+{
+    if (mappObjectCount_p > STUB_MAPP_OBJECT_COUNT)
+        mappObjectCount_p = STUB_MAPP_OBJECT_COUNT;
+
+    if (fTxPdo_p)
+    {
+        memcpy(aTxMapping_l, paObjectMapping_p, mappObjectCount_p * sizeof(UINT64));
+        txMappObjectCount_l = (UINT8)mappObjectCount_p;
+    }
+    else
+    {
+        memcpy(aRxMapping_l, paObjectMapping_p, mappObjectCount_p * sizeof(UINT64));
+        rxMappObjectCount_l = (UINT8)mappObjectCount_p;
+    }
+}
+
+UINT8* stub_getRxPdoBuffer(UINT channelId_p)
+{
+    return aRxPdoBuffer_l[channelId_p];
+}
+
+UINT8* stub_getTxPdoBuffer(UINT channelId_p)
+{
+    return aTxPdoBuffer_l[channelId_p];
+}
+
+UINT64 stub_getTimeNs(void)
+{
+    struct timespec currentTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    return ((UINT64)currentTime.tv_sec * 1000000000ULL) + (UINT64)currentTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+// object dictionary
+//------------------------------------------------------------------------------
+tOplkError obdu_readEntry(UINT index_p,
+                          UINT subIndex_p,
+                          void* pDstData_p,
+                          tObdSize* pSize_p)
+{
+    UINT            pdoId = index_p & 0x00FF;
+    UINT8           value8;
+    UINT16          payloadLimit = TEST_PDO_SIZE;
+    const UINT64*   paMapping;
+    UINT8           mappObjectCount;
+
+    switch (index_p & 0xFF00)
+    {
+        case 0x1400:    // PDO_RxCommParam_XXh_REC
+        case 0x1800:    // PDO_TxCommParam_XXh_REC
+            if (pdoId >= TEST_PDO_CHANNELS)
+                return kErrorObdIndexNotExist;
+
+            if (subIndex_p == 0x01)
+                value8 = (UINT8)(pdoId + 1);    // NodeID_U8
+            else if (subIndex_p == 0x02)
+                value8 = 0;                     // MappingVersion_U8
+            else
+                return kErrorObdSubindexNotExist;
+
+            return readValue(pDstData_p, pSize_p, &value8, sizeof(value8));
+
+        case 0x1600:    // PDO_RxMappParam_XXh_AU64
+        case 0x1A00:    // PDO_TxMappParam_XXh_AU64
+            if (pdoId >= TEST_PDO_CHANNELS)
+                return kErrorObdIndexNotExist;
+
+            if ((index_p & 0xFF00) == 0x1A00)
+            {
+                paMapping = aTxMapping_l;
+                mappObjectCount = txMappObjectCount_l;
+            }
+            else
+            {
+                paMapping = aRxMapping_l;
+                mappObjectCount = rxMappObjectCount_l;
+            }
+
+            if (subIndex_p == 0)
+                return readValue(pDstData_p, pSize_p, &mappObjectCount, sizeof(mappObjectCount));
+
+            if (subIndex_p > mappObjectCount)
+                return kErrorObdSubindexNotExist;
+
+            return readValue(pDstData_p, pSize_p, &paMapping[subIndex_p - 1], sizeof(UINT64));
+
+        default:
+            break;
+    }
+
+    switch (index_p)
+    {
+        case 0x1F8B:    // NMT_MNPReqPayloadLimitList_AU16
+        case 0x1F8D:    // NMT_PResPayloadLimitList_AU16
+            if (subIndex_p == 0)
+            {
+                value8 = 254;
+                return readValue(pDstData_p, pSize_p, &value8, sizeof(value8));
+            }
+
+            return readValue(pDstData_p, pSize_p, &payloadLimit, sizeof(payloadLimit));
+
+        case 0x1F98:    // NMT_CycleTiming_REC
+            if ((subIndex_p != 0x04) && (subIndex_p != 0x05))
+                return kErrorObdSubindexNotExist;
+
+            return readValue(pDstData_p, pSize_p, &payloadLimit, sizeof(payloadLimit));
+
+        default:
+            return kErrorObdIndexNotExist;
+    }
+}
+
+void* obdu_getObjectDataPtr(UINT index_p, UINT subIndex_p)
+{
+    const tStubObject*  pObject = findObject(index_p, subIndex_p);
+
+    return (pObject != NULL) ? pObject->pVar : NULL;
+}
+
+tObdSize obdu_getDataSize(UINT index_p, UINT subIndex_p)
+{
+    const tStubObject*  pObject = findObject(index_p, subIndex_p);
+
+    return (pObject != NULL) ? pObject->size : 0;
+}
+
+tOplkError obdu_isNumerical(UINT index_p, UINT subIndex_p, BOOL* pfEntryNumerical_p)
+{
+    const tStubObject*  pObject = findObject(index_p, subIndex_p);
+
+    if (pObject == NULL)
+        return kErrorObdIndexNotExist;
+
+    *pfEntryNumerical_p = ((pObject->type != kObdTypeVString) &&
+                           (pObject->type != kObdTypeOString) &&
+                           (pObject->type != kObdTypeDomain));
+
+    return kErrorOk;
+}
+
+tOplkError obdu_getType(UINT index_p, UINT subIndex_p, tObdType* pType_p)
+{
+    const tStubObject*  pObject = findObject(index_p, subIndex_p);
+
+    if (pObject == NULL)
+        return kErrorObdIndexNotExist;
+
+    *pType_p = pObject->type;
+
+    return kErrorOk;
+}
+
+tOplkError obdu_getAccessType(UINT index_p,
+                              UINT subIndex_p,
+                              tObdAccess* pAccessType_p)
+{
+    if (findObject(index_p, subIndex_p) == NULL)
+        return kErrorObdIndexNotExist;
+
+    *pAccessType_p = kObdAccVPRW;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+// PDO CAL
+//------------------------------------------------------------------------------
+tOplkError pdoucal_init(void)
+{
+    return kErrorOk;
+}
+
+tOplkError pdoucal_exit(void)
+{
+    return kErrorOk;
+}
+
+tOplkError pdoucal_postPdokChannelAlloc(const tPdoAllocationParam* pAllocationParam_p)
+{
+    UNUSED_PARAMETER(pAllocationParam_p);
+
+    return kErrorOk;
+}
+
+tOplkError pdoucal_postConfigureChannel(const tPdoChannelConf* pChannelConf_p)
+{
+    UNUSED_PARAMETER(pChannelConf_p);
+
+    return kErrorOk;
+}
+
+tOplkError pdoucal_postSetupPdoBuffers(size_t rxPdoMemSize_p,
+                                       size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+
+    return kErrorOk;
+}
+
+tOplkError pdoucal_initPdoMem(const tPdoChannelSetup* pPdoChannels_p,
+                              size_t rxPdoMemSize_p,
+                              size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(pPdoChannels_p);
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+
+    return kErrorOk;
+}
+
+void pdoucal_cleanupPdoMem(void)
+{
+}
+
+UINT8* pdoucal_getTxPdoAdrs(UINT channelId_p)
+{
+    return aTxPdoBuffer_l[channelId_p];
+}
+
+tOplkError pdoucal_setTxPdo(UINT channelId_p,
+                            UINT8* pPdo_p,
+                            WORD pdoSize_p)
+{
+    UNUSED_PARAMETER(channelId_p);
+    UNUSED_PARAMETER(pPdo_p);
+    UNUSED_PARAMETER(pdoSize_p);
+
+    return kErrorOk;
+}
+
+tOplkError pdoucal_getRxPdo(UINT8** ppPdo_p,
+                            UINT channelId_p,
+                            WORD pdoSize_p)
+{
+    UNUSED_PARAMETER(pdoSize_p);
+
+    *ppPdo_p = aRxPdoBuffer_l[channelId_p];
+
+    return kErrorOk;
+}
+
+UINT8* pdoucal_getRxPdoAdrs(UINT channelId_p)
+{
+    return aRxPdoBuffer_l[channelId_p];
+}
+
+//------------------------------------------------------------------------------
+// target
+//------------------------------------------------------------------------------
+tOplkError target_createMutex(const char* mutexName_p,
+                              OPLK_MUTEX_T* pMutex_p)
+{
+    UNUSED_PARAMETER(mutexName_p);
+
+    memset(pMutex_p, 0, sizeof(*pMutex_p));
+
+    return kErrorOk;
+}
+
+void target_destroyMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+}
+
+tOplkError target_lockMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+
+    return kErrorOk;
+}
+
+void target_unlockMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+}
+
+void target_msleep(UINT32 milliSeconds_p)
+{
+    UNUSED_PARAMETER(milliSeconds_p);
+}
+
+//------------------------------------------------------------------------------
+// debug strings
+//------------------------------------------------------------------------------
+const char* debugstr_getRetValStr(tOplkError oplkError_p)
+{
+    UNUSED_PARAMETER(oplkError_p);
+
+    return "";
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+static const tStubObject* findObject(UINT index_p, UINT subIndex_p)
+{
+    UINT    objectId;
+
+    for (objectId = 0; objectId < objectCount_l; objectId++)
+    {
+        if ((aObject_l[objectId].index == index_p) &&
+            (aObject_l[objectId].subIndex == subIndex_p))
+            return &aObject_l[objectId];
+    }
+
+    return NULL;
+}
+
+static tOplkError readValue(void* pDstData_p, tObdSize* pSize_p, const void* pSrcData_p, tObdSize size_p)
+{
+    if (*pSize_p < size_p)
+        return kErrorObdValueLengthError;
+
+    memcpy(pDstData_p, pSrcData_p, size_p);
+    *pSize_p = size_p;
+
+    return kErrorOk;
+}
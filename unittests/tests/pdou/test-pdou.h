@@ -0,0 +1,82 @@
+/**
+********************************************************************************
+\file   test-pdou.h
+
+\brief  Definitions for unit tests of user PDO module
+
+The file contains the definitions for the unit tests of the user PDO module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_pdou_H_
+#define _INC_test_pdou_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplkinc.h>
+#include <user/pdou.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_PDO_CHANNELS           32          ///< Number of RPDO and TPDO channels
+#define TEST_PDO_SIZE               256         ///< Size of the PDO buffer of a channel
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_setupMapping(void);
+void test_pdou_copyRxPdoToPi(void);
+void test_pdou_copyTxPdoFromPi(void);
+void test_pdou_copyBitRuns(void);
+void test_pdou_copyBenchmark(void);
+
+void stub_resetOd(void);
+void stub_addObject(UINT index_p, UINT subIndex_p, tObdType type_p, tObdSize size_p, void* pVar_p);
+void stub_setMapping(BOOL fTxPdo_p, const UINT64* paObjectMapping_p, UINT mappObjectCount_p);
+UINT8* stub_getRxPdoBuffer(UINT channelId_p);
+UINT8* stub_getTxPdoBuffer(UINT channelId_p);
+UINT64 stub_getTimeNs(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_pdou_H_ */
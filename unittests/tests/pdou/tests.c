@@ -0,0 +1,689 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for user PDO module
+
+This file contains the unit test functions for the user PDO module. The copy
+functions are checked against a reference implementation which copies each
+mapped object separately depending on its type, as the PDO module did before
+the mappings were compiled into copy programs.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <common/ami.h>
+#include <user/obdu.h>
+
+#include "test-pdou.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_OBJECT_COUNT           56
+#define TEST_BENCHMARK_CYCLES       10000
+
+#define TEST_RX_OBJECT_INDEX        0x6000
+#define TEST_TX_OBJECT_INDEX        0x6200
+
+#define TEST_BIT_RUN_SIZE           40          ///< Size of the array of a BOOLEAN run
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief  Process image of a PDO direction
+
+The variables up to aU64 are laid out like the PDO, so the copy program can
+merge them into a single memcpy step. The 24 bit values and the BOOLEAN values
+need a conversion.
+*/
+typedef struct
+{
+    UINT8       aU8[16];
+    UINT16      aU16[8];
+    UINT32      aU32[8];
+    UINT64      aU64[4];
+    UINT32      aU24[4];
+    UINT8       aBool[16];
+} tTestProcessImage;
+
+/**
+\brief  Process image of a BOOLEAN run
+
+The run is mapped behind the leading variables, so it starts at the bit offset
+given by their number. The trailing variables fill up the last byte of the run.
+No group fills its array, therefore the copy program doesn't merge the groups.
+*/
+typedef struct
+{
+    UINT8       aLead[8];
+    UINT8       aRun[TEST_BIT_RUN_SIZE];
+    UINT8       aTrail[8];
+} tTestBitImage;
+
+/**
+\brief  Mapped test object
+*/
+typedef struct
+{
+    void*       pVar;
+    tObdType    type;
+    UINT        bitOffset;
+    UINT        bitSize;
+} tTestObject;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void setupObjects(UINT index_p,
+                         tTestProcessImage* pPi_p,
+                         tTestObject* paObject_p,
+                         UINT64* paObjectMapping_p);
+static void addObjectGroup(UINT index_p,
+                           void* pVar_p,
+                           tObdType type_p,
+                           UINT varSize_p,
+                           UINT bitSize_p,
+                           UINT count_p);
+static void buildMapping(UINT index_p, tTestObject* paObject_p, UINT64* paObjectMapping_p);
+static tOplkError reconfigurePdos(void);
+static void setupBitObjects(UINT index_p,
+                            tTestBitImage* pImage_p,
+                            UINT bitOffset_p,
+                            UINT bitCount_p,
+                            tTestObject* paObject_p,
+                            UINT64* paObjectMapping_p);
+static void checkBitRun(UINT bitOffset_p, UINT bitCount_p);
+static void referenceCopyFromPdo(const UINT8* pPdo_p, const tTestObject* paObject_p);
+static void referenceCopyToPdo(UINT8* pPdo_p, const tTestObject* paObject_p);
+static void fillPattern(UINT8* pData_p, size_t size_p, UINT seed_p);
+static void fillProcessImage(tTestProcessImage* pPi_p, UINT seed_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTestProcessImage    rxPi_l;
+static tTestProcessImage    txPi_l;
+static tTestObject          aRxObject_l[TEST_OBJECT_COUNT];
+static tTestObject          aTxObject_l[TEST_OBJECT_COUNT];
+static UINT64               aObjectMapping_l[TEST_OBJECT_COUNT];
+static UINT                 objectCount_l;
+static UINT8                aReferencePdo_l[TEST_PDO_CHANNELS][TEST_PDO_SIZE];
+static tTestBitImage        rxBitImage_l;
+static tTestBitImage        txBitImage_l;
+
+// Lengths of the BOOLEAN runs, including runs shorter than a byte and runs
+// which end just before or after a byte or vector boundary
+static const UINT           aBitCount_l[] = {1, 3, 7, 8, 9, 15, 16, 17, 23, 31, 33};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Setup the PDO mapping of the tests
+
+The function registers the test objects in the object dictionary stub and maps
+them to all RPDO and TPDO channels.
+*/
+//------------------------------------------------------------------------------
+void test_setupMapping(void)
+{
+    stub_resetOd();
+
+    setupObjects(TEST_RX_OBJECT_INDEX, &rxPi_l, aRxObject_l, aObjectMapping_l);
+    stub_setMapping(FALSE, aObjectMapping_l, objectCount_l);
+
+    setupObjects(TEST_TX_OBJECT_INDEX, &txPi_l, aTxObject_l, aObjectMapping_l);
+    stub_setMapping(TRUE, aObjectMapping_l, objectCount_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test pdou_copyRxPdoToPi()
+
+The test fills the RPDO buffers with a pattern and compares the process image
+after pdou_copyRxPdoToPi() with the one of the reference implementation.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyRxPdoToPi(void)
+{
+    tTestProcessImage   referencePi;
+    UINT                channelId;
+
+    // only the last channel determines the resulting process image
+    for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+        fillPattern(stub_getRxPdoBuffer(channelId), TEST_PDO_SIZE, channelId);
+
+    memset(&rxPi_l, 0, sizeof(rxPi_l));
+    referenceCopyFromPdo(stub_getRxPdoBuffer(TEST_PDO_CHANNELS - 1), aRxObject_l);
+    referencePi = rxPi_l;
+
+    memset(&rxPi_l, 0, sizeof(rxPi_l));
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPi(), kErrorOk);
+    CU_ASSERT_EQUAL(memcmp(&rxPi_l, &referencePi, sizeof(rxPi_l)), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test pdou_copyTxPdoFromPi()
+
+The test fills the process image with a pattern and compares the TPDO buffers
+after pdou_copyTxPdoFromPi() with the ones of the reference implementation.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyTxPdoFromPi(void)
+{
+    UINT    channelId;
+
+    fillProcessImage(&txPi_l, 5);
+
+    for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+    {
+        memset(aReferencePdo_l[channelId], 0, TEST_PDO_SIZE);
+        memset(stub_getTxPdoBuffer(channelId), 0, TEST_PDO_SIZE);
+        referenceCopyToPdo(aReferencePdo_l[channelId], aTxObject_l);
+    }
+
+    CU_ASSERT_EQUAL(pdou_copyTxPdoFromPi(), kErrorOk);
+
+    for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+        CU_ASSERT_EQUAL(memcmp(stub_getTxPdoBuffer(channelId), aReferencePdo_l[channelId], TEST_PDO_SIZE), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the copy of BOOLEAN runs
+
+The test maps runs of BOOLEAN objects of various lengths at every bit offset
+within a byte. It compares the packed and unpacked runs of the copy programs
+with the bitwise copy of the reference implementation. The default mapping is
+restored afterwards.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyBitRuns(void)
+{
+    UINT    bitOffset;
+    UINT    countId;
+
+    for (bitOffset = 0; bitOffset < 8; bitOffset++)
+    {
+        for (countId = 0; countId < (sizeof(aBitCount_l) / sizeof(aBitCount_l[0])); countId++)
+            checkBitRun(bitOffset, aBitCount_l[countId]);
+    }
+
+    test_setupMapping();
+    CU_ASSERT_EQUAL(reconfigurePdos(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark the PDO copy functions
+
+The test copies all RPDO and TPDO channels \ref TEST_BENCHMARK_CYCLES times with
+the reference implementation and with the copy programs of the PDO module. It
+prints the average time per cycle.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyBenchmark(void)
+{
+    UINT64  startTimeNs;
+    UINT64  rxReferenceTimeNs;
+    UINT64  rxProgramTimeNs;
+    UINT64  txReferenceTimeNs;
+    UINT64  txProgramTimeNs;
+    UINT    cycle;
+    UINT    channelId;
+
+    startTimeNs = stub_getTimeNs();
+    for (cycle = 0; cycle < TEST_BENCHMARK_CYCLES; cycle++)
+    {
+        for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+            referenceCopyFromPdo(stub_getRxPdoBuffer(channelId), aRxObject_l);
+    }
+    rxReferenceTimeNs = stub_getTimeNs() - startTimeNs;
+
+    startTimeNs = stub_getTimeNs();
+    for (cycle = 0; cycle < TEST_BENCHMARK_CYCLES; cycle++)
+        CU_ASSERT_EQUAL(pdou_copyRxPdoToPi(), kErrorOk);
+    rxProgramTimeNs = stub_getTimeNs() - startTimeNs;
+
+    startTimeNs = stub_getTimeNs();
+    for (cycle = 0; cycle < TEST_BENCHMARK_CYCLES; cycle++)
+    {
+        for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+            referenceCopyToPdo(aReferencePdo_l[channelId], aTxObject_l);
+    }
+    txReferenceTimeNs = stub_getTimeNs() - startTimeNs;
+
+    startTimeNs = stub_getTimeNs();
+    for (cycle = 0; cycle < TEST_BENCHMARK_CYCLES; cycle++)
+        CU_ASSERT_EQUAL(pdou_copyTxPdoFromPi(), kErrorOk);
+    txProgramTimeNs = stub_getTimeNs() - startTimeNs;
+
+    printf("\n%u channels with %u objects: RPDO per object %lu ns, copy program %lu ns per cycle\n",
+           TEST_PDO_CHANNELS,
+           objectCount_l,
+           (unsigned long)(rxReferenceTimeNs / TEST_BENCHMARK_CYCLES),
+           (unsigned long)(rxProgramTimeNs / TEST_BENCHMARK_CYCLES));
+    printf("%u channels with %u objects: TPDO per object %lu ns, copy program %lu ns per cycle\n",
+           TEST_PDO_CHANNELS,
+           objectCount_l,
+           (unsigned long)(txReferenceTimeNs / TEST_BENCHMARK_CYCLES),
+           (unsigned long)(txProgramTimeNs / TEST_BENCHMARK_CYCLES));
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Setup the test objects of a PDO direction
+
+The function registers the variables of the process image as objects of the
+given index and builds the object mapping. All objects are mapped without gaps
+in the order of the process image.
+
+\param[in]      index_p             Object index of the variables.
+\param[in]      pPi_p               Pointer to the process image.
+\param[out]     paObject_p          Pointer to store the mapped objects.
+\param[out]     paObjectMapping_p   Pointer to store the object mapping entries.
+*/
+//------------------------------------------------------------------------------
+static void setupObjects(UINT index_p,
+                         tTestProcessImage* pPi_p,
+                         tTestObject* paObject_p,
+                         UINT64* paObjectMapping_p)
+{
+    objectCount_l = 0;
+    addObjectGroup(index_p, pPi_p->aU8, kObdTypeUInt8, sizeof(pPi_p->aU8[0]), 8, 16);
+    addObjectGroup(index_p, pPi_p->aU16, kObdTypeUInt16, sizeof(pPi_p->aU16[0]), 16, 8);
+    addObjectGroup(index_p, pPi_p->aU32, kObdTypeUInt32, sizeof(pPi_p->aU32[0]), 32, 8);
+    addObjectGroup(index_p, pPi_p->aU64, kObdTypeUInt64, sizeof(pPi_p->aU64[0]), 64, 4);
+    addObjectGroup(index_p, pPi_p->aU24, kObdTypeUInt24, sizeof(pPi_p->aU24[0]), 24, 4);
+    addObjectGroup(index_p, pPi_p->aBool, kObdTypeBool, sizeof(pPi_p->aBool[0]), 1, 16);
+
+    buildMapping(index_p, paObject_p, paObjectMapping_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build the object mapping
+
+The function builds the object mapping of all registered objects. The objects
+are mapped without gaps in the order of registration.
+
+\param[in]      index_p             Object index of the variables.
+\param[out]     paObject_p          Pointer to store the mapped objects.
+\param[out]     paObjectMapping_p   Pointer to store the object mapping entries.
+*/
+//------------------------------------------------------------------------------
+static void buildMapping(UINT index_p, tTestObject* paObject_p, UINT64* paObjectMapping_p)
+{
+    UINT    objectId;
+    UINT    bitOffset = 0;
+
+    for (objectId = 0; objectId < objectCount_l; objectId++)
+    {
+        paObject_p[objectId].pVar = obdu_getObjectDataPtr(index_p, objectId + 1);
+        obdu_getType(index_p, objectId + 1, &paObject_p[objectId].type);
+        paObject_p[objectId].bitOffset = bitOffset;
+        paObject_p[objectId].bitSize = (paObject_p[objectId].type == kObdTypeBool) ?
+                                        1 : (obdu_getDataSize(index_p, objectId + 1) * 8);
+
+        paObjectMapping_p[objectId] = (UINT64)index_p |
+                                      ((UINT64)(objectId + 1) << 16) |
+                                      ((UINT64)bitOffset << 32) |
+                                      ((UINT64)paObject_p[objectId].bitSize << 48);
+        bitOffset += paObject_p[objectId].bitSize;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add a group of objects of the same type
+
+\param[in]      index_p             Object index of the variables.
+\param[in]      pVar_p              Pointer to the first variable.
+\param[in]      type_p              Object type of the variables.
+\param[in]      varSize_p           Size of a variable in bytes.
+\param[in]      bitSize_p           Size of an object in the PDO in bits.
+\param[in]      count_p             Number of variables.
+*/
+//------------------------------------------------------------------------------
+static void addObjectGroup(UINT index_p,
+                           void* pVar_p,
+                           tObdType type_p,
+                           UINT varSize_p,
+                           UINT bitSize_p,
+                           UINT count_p)
+{
+    UINT    varId;
+
+    for (varId = 0; varId < count_p; varId++)
+    {
+        objectCount_l++;
+        stub_addObject(index_p,
+                       objectCount_l,
+                       type_p,
+                       (bitSize_p < 8) ? 1 : (bitSize_p / 8),
+                       (UINT8*)pVar_p + (varId * varSize_p));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reconfigure the PDO channels
+
+The function forwards the current mapping of the object dictionary stub to the
+PDO module.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError reconfigurePdos(void)
+{
+    tEventNmtStateChange    nmtStateChange;
+
+    nmtStateChange.newNmtState = kNmtGsResetConfiguration;
+    nmtStateChange.oldNmtState = kNmtGsResetCommunication;
+    nmtStateChange.nmtEvent = kNmtEventEnterResetConfig;
+
+    return pdou_cbNmtStateChange(nmtStateChange);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Setup the test objects of a BOOLEAN run
+
+\param[in]      index_p             Object index of the variables.
+\param[in]      pImage_p            Pointer to the process image of the run.
+\param[in]      bitOffset_p         Bit offset of the run in the PDO.
+\param[in]      bitCount_p          Length of the run.
+\param[out]     paObject_p          Pointer to store the mapped objects.
+\param[out]     paObjectMapping_p   Pointer to store the object mapping entries.
+*/
+//------------------------------------------------------------------------------
+static void setupBitObjects(UINT index_p,
+                            tTestBitImage* pImage_p,
+                            UINT bitOffset_p,
+                            UINT bitCount_p,
+                            tTestObject* paObject_p,
+                            UINT64* paObjectMapping_p)
+{
+    UINT    trailCount = (8 - ((bitOffset_p + bitCount_p) & 0x7)) & 0x7;
+
+    objectCount_l = 0;
+    addObjectGroup(index_p, pImage_p->aLead, kObdTypeBool, sizeof(pImage_p->aLead[0]), 1, bitOffset_p);
+    addObjectGroup(index_p, pImage_p->aRun, kObdTypeBool, sizeof(pImage_p->aRun[0]), 1, bitCount_p);
+    addObjectGroup(index_p, pImage_p->aTrail, kObdTypeBool, sizeof(pImage_p->aTrail[0]), 1, trailCount);
+
+    buildMapping(index_p, paObject_p, paObjectMapping_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check the copy of a BOOLEAN run
+
+The function maps a BOOLEAN run to all RPDO and TPDO channels and compares the
+results of the copy programs with the ones of the reference implementation.
+The TPDO buffers are filled with a pattern beforehand, so that bits behind the
+mapped objects must be preserved.
+
+\param[in]      bitOffset_p         Bit offset of the run in the PDO.
+\param[in]      bitCount_p          Length of the run.
+*/
+//------------------------------------------------------------------------------
+static void checkBitRun(UINT bitOffset_p, UINT bitCount_p)
+{
+    tTestBitImage   referenceImage;
+    UINT            channelId;
+    UINT            index;
+
+    stub_resetOd();
+
+    setupBitObjects(TEST_RX_OBJECT_INDEX, &rxBitImage_l, bitOffset_p, bitCount_p, aRxObject_l, aObjectMapping_l);
+    stub_setMapping(FALSE, aObjectMapping_l, objectCount_l);
+
+    setupBitObjects(TEST_TX_OBJECT_INDEX, &txBitImage_l, bitOffset_p, bitCount_p, aTxObject_l, aObjectMapping_l);
+    stub_setMapping(TRUE, aObjectMapping_l, objectCount_l);
+
+    CU_ASSERT_EQUAL(reconfigurePdos(), kErrorOk);
+
+    // RPDO
+    for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+        fillPattern(stub_getRxPdoBuffer(channelId), TEST_PDO_SIZE, channelId + bitCount_p);
+
+    memset(&rxBitImage_l, 0, sizeof(rxBitImage_l));
+    referenceCopyFromPdo(stub_getRxPdoBuffer(TEST_PDO_CHANNELS - 1), aRxObject_l);
+    referenceImage = rxBitImage_l;
+
+    memset(&rxBitImage_l, 0, sizeof(rxBitImage_l));
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPi(), kErrorOk);
+    CU_ASSERT_EQUAL(memcmp(&rxBitImage_l, &referenceImage, sizeof(rxBitImage_l)), 0);
+
+    // TPDO
+    fillPattern((UINT8*)&txBitImage_l, sizeof(txBitImage_l), bitOffset_p + bitCount_p);
+    for (index = 0; index < sizeof(txBitImage_l); index++)
+    {
+        if ((index % 5) == 0)
+            ((UINT8*)&txBitImage_l)[index] = 0;
+    }
+
+    for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+    {
+        fillPattern(aReferencePdo_l[channelId], TEST_PDO_SIZE, channelId);
+        fillPattern(stub_getTxPdoBuffer(channelId), TEST_PDO_SIZE, channelId);
+        referenceCopyToPdo(aReferencePdo_l[channelId], aTxObject_l);
+    }
+
+    CU_ASSERT_EQUAL(pdou_copyTxPdoFromPi(), kErrorOk);
+
+    for (channelId = 0; channelId < TEST_PDO_CHANNELS; channelId++)
+        CU_ASSERT_EQUAL(memcmp(stub_getTxPdoBuffer(channelId), aReferencePdo_l[channelId], TEST_PDO_SIZE), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reference copy from PDO
+
+The function copies each mapped object from the PDO buffer separately
+depending on its type.
+
+\param[in]      pPdo_p              Pointer to the PDO buffer.
+\param[in]      paObject_p          Pointer to the mapped objects.
+*/
+//------------------------------------------------------------------------------
+static void referenceCopyFromPdo(const UINT8* pPdo_p, const tTestObject* paObject_p)
+{
+    UINT            objectId;
+    const UINT8*    pData;
+
+    for (objectId = 0; objectId < objectCount_l; objectId++, paObject_p++)
+    {
+        pData = pPdo_p + (paObject_p->bitOffset >> 3);
+
+        switch (paObject_p->type)
+        {
+            case kObdTypeBool:
+                *((UINT8*)paObject_p->pVar) = (*pData >> (paObject_p->bitOffset & 0x7)) & 0x01;
+                break;
+
+            case kObdTypeUInt8:
+                *((UINT8*)paObject_p->pVar) = ami_getUint8Le(pData);
+                break;
+
+            case kObdTypeUInt16:
+                *((UINT16*)paObject_p->pVar) = ami_getUint16Le(pData);
+                break;
+
+            case kObdTypeUInt24:
+                *((UINT32*)paObject_p->pVar) = ami_getUint24Le(pData);
+                break;
+
+            case kObdTypeUInt32:
+                *((UINT32*)paObject_p->pVar) = ami_getUint32Le(pData);
+                break;
+
+            case kObdTypeUInt64:
+                *((UINT64*)paObject_p->pVar) = ami_getUint64Le(pData);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reference copy to PDO
+
+The function copies each mapped object to the PDO buffer separately depending
+on its type.
+
+\param[out]     pPdo_p              Pointer to the PDO buffer.
+\param[in]      paObject_p          Pointer to the mapped objects.
+*/
+//------------------------------------------------------------------------------
+static void referenceCopyToPdo(UINT8* pPdo_p, const tTestObject* paObject_p)
+{
+    UINT    objectId;
+    UINT8*  pData;
+
+    for (objectId = 0; objectId < objectCount_l; objectId++, paObject_p++)
+    {
+        pData = pPdo_p + (paObject_p->bitOffset >> 3);
+
+        switch (paObject_p->type)
+        {
+            case kObdTypeBool:
+                if (*((const UINT8*)paObject_p->pVar) != 0)
+                    *pData |= (UINT8)(1 << (paObject_p->bitOffset & 0x7));
+                else
+                    *pData &= (UINT8)~(1 << (paObject_p->bitOffset & 0x7));
+                break;
+
+            case kObdTypeUInt8:
+                ami_setUint8Le(pData, *((const UINT8*)paObject_p->pVar));
+                break;
+
+            case kObdTypeUInt16:
+                ami_setUint16Le(pData, *((const UINT16*)paObject_p->pVar));
+                break;
+
+            case kObdTypeUInt24:
+                ami_setUint24Le(pData, *((const UINT32*)paObject_p->pVar));
+                break;
+
+            case kObdTypeUInt32:
+                ami_setUint32Le(pData, *((const UINT32*)paObject_p->pVar));
+                break;
+
+            case kObdTypeUInt64:
+                ami_setUint64Le(pData, *((const UINT64*)paObject_p->pVar));
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill buffer with a pattern
+
+\param[out]     pData_p             Pointer to the buffer.
+\param[in]      size_p              Size of the buffer.
+\param[in]      seed_p              Seed of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillPattern(UINT8* pData_p, size_t size_p, UINT seed_p)
+{
+    size_t  index;
+
+    for (index = 0; index < size_p; index++)
+        pData_p[index] = (UINT8)((index * 37) + (seed_p * 11) + 3);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill process image with a pattern
+
+The function fills the process image with a pattern which keeps the 24 bit
+values in their range and sets the BOOLEAN values to arbitrary non-zero values.
+
+\param[out]     pPi_p               Pointer to the process image.
+\param[in]      seed_p              Seed of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillProcessImage(tTestProcessImage* pPi_p, UINT seed_p)
+{
+    UINT    index;
+
+    fillPattern((UINT8*)pPi_p, sizeof(*pPi_p), seed_p);
+
+    for (index = 0; index < (sizeof(pPi_p->aU24) / sizeof(pPi_p->aU24[0])); index++)
+        pPi_p->aU24[index] &= 0x00FFFFFF;
+
+    for (index = 0; index < sizeof(pPi_p->aBool); index++)
+        pPi_p->aBool[index] = ((index % 3) == 0) ? 0 : (UINT8)(index + 1);
+}
@@ -0,0 +1,384 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for SDO sequence layer unit tests
+
+This file contains all stubs needed by the unit tests of the SDO sequence
+layer. The ASnd stubs simulate a POWERLINK link which transfers one frame in
+each direction per cycle and a remote SDO server which acknowledges the
+received segments.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+
+#include <oplk/oplkinc.h>
+#include <user/sdoal.h>
+#include <user/sdoasnd.h>
+#include <user/sdoudp.h>
+#include <user/timeru.h>
+
+#include "test-sdoseq.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_QUEUE_SIZE             64
+#define STUB_SEQ_NUM_MASK           0xFC
+#define STUB_CON_MASK               0x03
+#define STUB_SEQ_HEADER_SIZE        4
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    UINT8   recvSeqNumCon;
+    UINT8   sendSeqNumCon;
+    UINT    dataSize;
+    UINT    dueCycle;
+} tStubFrame;
+
+typedef struct
+{
+    tStubFrame  aFrame[STUB_QUEUE_SIZE];
+    UINT        readIndex;
+    UINT        count;
+} tStubQueue;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL pushFrame(tStubQueue* pQueue_p, UINT8 recvSeqNumCon_p, UINT8 sendSeqNumCon_p,
+                      UINT dataSize_p, UINT dueCycle_p);
+static void peerReceive(const tStubFrame* pFrame_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSequLayerReceiveCb  pfnReceiveCb_l = NULL;
+static tStubQueue           txQueue_l;                  // frames sent by the sequence layer
+static tStubQueue           peerQueue_l;                // frames sent by the remote node
+static UINT                 cycle_l = 0;
+static UINT                 latencyCycles_l = 1;
+static UINT                 peerTxCycle_l = 0;
+static BOOL                 fPeerConnected_l = FALSE;
+static BOOL                 fPeerAckPending_l = FALSE;
+static UINT8                peerRecvSeqNum_l = 0;       // last in-order sequence number received by the remote node
+static UINT                 receivedSegmentCount_l = 0;
+static UINT                 duplicateSegmentCount_l = 0;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tOplkError sdoasnd_init(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    pfnReceiveCb_l = pfnReceiveCb_p;
+    return kErrorOk;
+}
+
+tOplkError sdoasnd_exit(void)
+{
+    pfnReceiveCb_l = NULL;
+    return kErrorOk;
+}
+
+tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
+{
+    UNUSED_PARAMETER(targetNodeId_p);
+
+    *pSdoConHandle_p = SDO_ASND_HANDLE;
+    return kErrorOk;
+}
+
+tOplkError sdoasnd_sendData(tSdoConHdl sdoConHandle_p, tPlkFrame* pSrcData_p, UINT32 dataSize_p)
+{
+    const tAsySdoSeq*   pSeqFrame = &pSrcData_p->data.asnd.payload.sdoSequenceFrame;
+
+    UNUSED_PARAMETER(sdoConHandle_p);
+
+    if (!pushFrame(&txQueue_l, pSeqFrame->recvSeqNumCon, pSeqFrame->sendSeqNumCon, dataSize_p, cycle_l))
+        return kErrorDllAsyncTxBufferFull;
+
+    return kErrorOk;
+}
+
+tOplkError sdoasnd_deleteCon(tSdoConHdl sdoConHandle_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    return kErrorOk;
+}
+
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+tOplkError sdoudp_init(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    UNUSED_PARAMETER(pfnReceiveCb_p);
+    return kErrorOk;
+}
+
+tOplkError sdoudp_exit(void)
+{
+    return kErrorOk;
+}
+
+tOplkError sdoudp_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
+{
+    UNUSED_PARAMETER(pSdoConHandle_p);
+    UNUSED_PARAMETER(targetNodeId_p);
+    return kErrorSdoUdpNoFreeHandle;
+}
+
+tOplkError sdoudp_sendData(tSdoConHdl sdoConHandle_p, tPlkFrame* pSrcData_p, UINT32 dataSize_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    UNUSED_PARAMETER(pSrcData_p);
+    UNUSED_PARAMETER(dataSize_p);
+    return kErrorSdoUdpInvalidHdl;
+}
+
+tOplkError sdoudp_delConnection(tSdoConHdl sdoConHandle_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    return kErrorOk;
+}
+#endif
+
+tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p, ULONG timeMs_p, const tTimerArg* pArgument_p)
+{
+    UNUSED_PARAMETER(timeMs_p);
+    UNUSED_PARAMETER(pArgument_p);
+
+    // timeouts are not simulated
+    *pTimerHdl_p = 1;
+    return kErrorOk;
+}
+
+tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p, ULONG timeMs_p, const tTimerArg* pArgument_p)
+{
+    return timeru_setTimer(pTimerHdl_p, timeMs_p, pArgument_p);
+}
+
+tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    if (pTimerHdl_p != NULL)
+        *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+void stub_resetLink(UINT latencyCycles_p)
+{
+    memset(&txQueue_l, 0, sizeof(txQueue_l));
+    memset(&peerQueue_l, 0, sizeof(peerQueue_l));
+    cycle_l = 1;
+    latencyCycles_l = latencyCycles_p;
+    peerTxCycle_l = 0;
+    fPeerConnected_l = FALSE;
+    fPeerAckPending_l = FALSE;
+    peerRecvSeqNum_l = 0;
+    receivedSegmentCount_l = 0;
+    duplicateSegmentCount_l = 0;
+}
+
+void stub_runCycle(void)
+{
+    tStubFrame  frame;
+    UINT8       aBuffer[sizeof(tAsySdoSeq)];
+    tAsySdoSeq* pSeqFrame = (tAsySdoSeq*)aBuffer;
+
+    // deliver the frames of the remote node which arrived until now
+    while ((peerQueue_l.count > 0) && (peerQueue_l.aFrame[peerQueue_l.readIndex].dueCycle <= cycle_l))
+    {
+        frame = peerQueue_l.aFrame[peerQueue_l.readIndex];
+        peerQueue_l.readIndex = (peerQueue_l.readIndex + 1) % STUB_QUEUE_SIZE;
+        peerQueue_l.count--;
+
+        memset(aBuffer, 0, sizeof(aBuffer));
+        pSeqFrame->recvSeqNumCon = frame.recvSeqNumCon;
+        pSeqFrame->sendSeqNumCon = frame.sendSeqNumCon;
+        if (pfnReceiveCb_l != NULL)
+            pfnReceiveCb_l(SDO_ASND_HANDLE, pSeqFrame, frame.dataSize);
+    }
+
+    // transmit one frame of the sequence layer in the asynchronous phase
+    if (txQueue_l.count > 0)
+    {
+        frame = txQueue_l.aFrame[txQueue_l.readIndex];
+        txQueue_l.readIndex = (txQueue_l.readIndex + 1) % STUB_QUEUE_SIZE;
+        txQueue_l.count--;
+        peerReceive(&frame);
+    }
+
+    // the remote node acknowledges in its own asynchronous slot
+    if (fPeerAckPending_l && (peerTxCycle_l != cycle_l))
+    {
+        pushFrame(&peerQueue_l, peerRecvSeqNum_l | 0x02, 0x02, STUB_SEQ_HEADER_SIZE,
+                  cycle_l + latencyCycles_l);
+        peerTxCycle_l = cycle_l;
+        fPeerAckPending_l = FALSE;
+    }
+
+    cycle_l++;
+}
+
+BOOL stub_isPeerConnected(void)
+{
+    return fPeerConnected_l;
+}
+
+UINT stub_getReceivedSegmentCount(void)
+{
+    return receivedSegmentCount_l;
+}
+
+UINT stub_getDuplicateSegmentCount(void)
+{
+    return duplicateSegmentCount_l;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add frame to a link queue
+
+\param[in,out]  pQueue_p            Queue to add the frame to.
+\param[in]      recvSeqNumCon_p     Receive sequence number and connection state.
+\param[in]      sendSeqNumCon_p     Send sequence number and connection state.
+\param[in]      dataSize_p          Size of the sequence layer frame.
+\param[in]      dueCycle_p          Cycle in which the frame is delivered.
+
+\return The function returns TRUE if the frame was added.
+*/
+//------------------------------------------------------------------------------
+static BOOL pushFrame(tStubQueue* pQueue_p, UINT8 recvSeqNumCon_p, UINT8 sendSeqNumCon_p,
+                      UINT dataSize_p, UINT dueCycle_p)
+{
+    tStubFrame* pFrame;
+
+    if (pQueue_p->count == STUB_QUEUE_SIZE)
+        return FALSE;
+
+    pFrame = &pQueue_p->aFrame[(pQueue_p->readIndex + pQueue_p->count) % STUB_QUEUE_SIZE];
+    pFrame->recvSeqNumCon = recvSeqNumCon_p;
+    pFrame->sendSeqNumCon = sendSeqNumCon_p;
+    pFrame->dataSize = dataSize_p;
+    pFrame->dueCycle = dueCycle_p;
+    pQueue_p->count++;
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process frame on the remote node
+
+The function implements the sequence layer of the remote SDO server. It answers
+the connection initialization and acknowledges received segments.
+
+\param[in]      pFrame_p            Frame received by the remote node.
+*/
+//------------------------------------------------------------------------------
+static void peerReceive(const tStubFrame* pFrame_p)
+{
+    UINT8   sendSeqNumCon = pFrame_p->sendSeqNumCon;
+
+    switch (sendSeqNumCon & STUB_CON_MASK)
+    {
+        case 1:
+            // initialization request -> answer with rcon = 1 and scon = 1
+            fPeerConnected_l = FALSE;
+            pushFrame(&peerQueue_l, sendSeqNumCon, 0x01, STUB_SEQ_HEADER_SIZE, cycle_l + latencyCycles_l);
+            peerTxCycle_l = cycle_l;
+            break;
+
+        case 2:
+        case 3:
+            if (!fPeerConnected_l)
+            {   // initialization acknowledge -> connection established
+                fPeerConnected_l = TRUE;
+                peerRecvSeqNum_l = sendSeqNumCon & STUB_SEQ_NUM_MASK;
+                pushFrame(&peerQueue_l, sendSeqNumCon, 0x02, STUB_SEQ_HEADER_SIZE, cycle_l + latencyCycles_l);
+                peerTxCycle_l = cycle_l;
+                break;
+            }
+
+            if (pFrame_p->dataSize > STUB_SEQ_HEADER_SIZE)
+            {
+                if (((peerRecvSeqNum_l + 4) & STUB_SEQ_NUM_MASK) == (sendSeqNumCon & STUB_SEQ_NUM_MASK))
+                {   // next segment
+                    peerRecvSeqNum_l = sendSeqNumCon & STUB_SEQ_NUM_MASK;
+                    receivedSegmentCount_l++;
+                    fPeerAckPending_l = TRUE;
+                }
+                else
+                {   // repeated frames are ignored like in the SDO server
+                    duplicateSegmentCount_l++;
+                }
+            }
+
+            // acknowledge request
+            if ((sendSeqNumCon & STUB_CON_MASK) == 3)
+                fPeerAckPending_l = TRUE;
+            break;
+
+        default:
+            fPeerConnected_l = FALSE;
+            break;
+    }
+}
@@ -0,0 +1,329 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests for SDO sequence layer
+
+This file contains the unit tests for the SDO sequence layer. The throughput
+test performs segmented domain downloads over the simulated link of the stubs
+and reports the achieved data rate for different history sizes.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <oplk/frame.h>
+#include <user/sdoal.h>
+
+#include "test-sdoseq.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_SEGMENT_DATA_SIZE      (SDO_MAX_TX_FRAME_SIZE - 58)
+#define TEST_SEGMENT_SIZE           (SDO_CMDL_HDR_FIXED_SIZE + TEST_SEGMENT_DATA_SIZE)
+#define TEST_CYCLE_TIME_US          1000
+#define TEST_TIMEOUT_MS             5000
+#define TEST_TRANSFER_SEGMENTS      20
+#define TEST_BULK_SEGMENTS          1000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError comReceiveCb(tSdoSeqConHdl sdoSeqConHdl_p,
+                               const tAsySdoCom* pAsySdoCom_p,
+                               UINT dataSize_p);
+static tOplkError comConCb(tSdoSeqConHdl sdoSeqConHdl_p,
+                           tAsySdoConState asySdoConState_p);
+static UINT runTransfer(UINT historySize_p, UINT latencyCycles_p, UINT segmentCount_p);
+static void sendNextSegment(tSdoSeqConHdl sdoSeqConHdl_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT segmentsToSend_l = 0;
+static UINT segmentsSent_l = 0;
+static BOOL fConnected_l = FALSE;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test sdoseq_setHistorySize()
+*/
+//------------------------------------------------------------------------------
+void test_sdoseq_setHistorySize(void)
+{
+    CU_ASSERT_EQUAL(sdoseq_init(comReceiveCb, comConCb), kErrorOk);
+
+    CU_ASSERT_EQUAL(sdoseq_setHistorySize(1), kErrorInvalidOperation);
+    CU_ASSERT_EQUAL(sdoseq_setHistorySize(25), kErrorInvalidOperation);
+    CU_ASSERT_EQUAL(sdoseq_setHistorySize(2), kErrorOk);
+    CU_ASSERT_EQUAL(sdoseq_setHistorySize(24), kErrorOk);
+    CU_ASSERT_EQUAL(sdoseq_setHistorySize(CONFIG_SDO_SEQ_HISTORY_SIZE), kErrorOk);
+
+    CU_ASSERT_EQUAL(sdoseq_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test segmented transfer
+*/
+//------------------------------------------------------------------------------
+void test_sdoseq_transfer(void)
+{
+    UINT    cycles;
+
+    cycles = runTransfer(CONFIG_SDO_SEQ_HISTORY_SIZE, 1, TEST_TRANSFER_SEGMENTS);
+
+    CU_ASSERT_NOT_EQUAL(cycles, 0);
+    CU_ASSERT_EQUAL(stub_getReceivedSegmentCount(), TEST_TRANSFER_SEGMENTS);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test transfer throughput with different history sizes
+
+The test downloads a large domain with different history sizes and link
+latencies. The throughput must not decrease if the history size is raised and
+must approach one segment per cycle if the history covers the round trip time.
+*/
+//------------------------------------------------------------------------------
+void test_sdoseq_historyThroughput(void)
+{
+    static const UINT   aHistorySize[] = {2, 3, 5, 10, 20};
+    static const UINT   aLatency[] = {1, 4, 8};
+    UINT                latencyIndex;
+    UINT                sizeIndex;
+    UINT                cycles;
+    UINT                lastCycles;
+    UINT                kBytesPerSec;
+
+    for (latencyIndex = 0; latencyIndex < tabentries(aLatency); latencyIndex++)
+    {
+        lastCycles = 0;
+        for (sizeIndex = 0; sizeIndex < tabentries(aHistorySize); sizeIndex++)
+        {
+            cycles = runTransfer(aHistorySize[sizeIndex], aLatency[latencyIndex], TEST_BULK_SEGMENTS);
+            CU_ASSERT_NOT_EQUAL(cycles, 0);
+            CU_ASSERT_EQUAL(stub_getReceivedSegmentCount(), TEST_BULK_SEGMENTS);
+            if (cycles == 0)
+                continue;
+
+            kBytesPerSec = (UINT)(((UINT64)TEST_BULK_SEGMENTS * TEST_SEGMENT_DATA_SIZE * 1000) /
+                                  ((UINT64)cycles * TEST_CYCLE_TIME_US));
+            printf("\n    history %2u, latency %u cycles: %5u cycles, %4u kB/s, %u retransmissions",
+                   aHistorySize[sizeIndex], aLatency[latencyIndex], cycles, kBytesPerSec,
+                   stub_getDuplicateSegmentCount());
+
+            if (lastCycles != 0)
+                CU_ASSERT_TRUE(cycles <= lastCycles);
+            lastCycles = cycles;
+        }
+
+        // largest history: less than 10 % overhead compared to one segment per cycle
+        CU_ASSERT_TRUE(lastCycles < (TEST_BULK_SEGMENTS + TEST_BULK_SEGMENTS / 10));
+    }
+    printf("\n");
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run a segmented transfer
+
+The function opens a sequence layer connection with the given history size
+and transfers the given number of segments over the simulated link.
+
+\param[in]      historySize_p       History size of the connection.
+\param[in]      latencyCycles_p     Latency of the link in cycles.
+\param[in]      segmentCount_p      Number of segments to transfer.
+
+\return The function returns the number of cycles needed for the transfer or
+        0 if the transfer did not complete.
+*/
+//------------------------------------------------------------------------------
+static UINT runTransfer(UINT historySize_p, UINT latencyCycles_p, UINT segmentCount_p)
+{
+    tSdoSeqConHdl   sdoSeqConHdl;
+    UINT            cycle;
+    UINT            cycleLimit = (segmentCount_p + 10) * (latencyCycles_p + 2) * 4;
+
+    segmentsToSend_l = segmentCount_p;
+    segmentsSent_l = 0;
+    fConnected_l = FALSE;
+
+    stub_resetLink(latencyCycles_p);
+
+    if (sdoseq_init(comReceiveCb, comConCb) != kErrorOk)
+        return 0;
+
+    sdoseq_setTimeout(TEST_TIMEOUT_MS);
+    if (sdoseq_setHistorySize(historySize_p) != kErrorOk)
+    {
+        sdoseq_exit();
+        return 0;
+    }
+
+    if (sdoseq_initCon(&sdoSeqConHdl, 1, kSdoTypeAsnd) != kErrorOk)
+    {
+        sdoseq_exit();
+        return 0;
+    }
+
+    for (cycle = 1; cycle <= cycleLimit; cycle++)
+    {
+        stub_runCycle();
+        if (fConnected_l && (stub_getReceivedSegmentCount() == segmentCount_p))
+            break;
+    }
+
+    sdoseq_deleteCon(sdoSeqConHdl);
+    sdoseq_exit();
+
+    return (cycle > cycleLimit) ? 0 : cycle;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send next segment
+
+The function sends the next segment of the transfer if the sequence layer is
+ready to accept it.
+
+\param[in]      sdoSeqConHdl_p      Handle of the sequence layer connection.
+*/
+//------------------------------------------------------------------------------
+static void sendNextSegment(tSdoSeqConHdl sdoSeqConHdl_p)
+{
+    UINT8       aFrame[SDO_MAX_TX_FRAME_SIZE];
+    tPlkFrame*  pFrame = (tPlkFrame*)aFrame;
+
+    if (segmentsSent_l >= segmentsToSend_l)
+        return;
+
+    memset(aFrame, 0, sizeof(aFrame));
+    segmentsSent_l++;
+    if (sdoseq_sendData(sdoSeqConHdl_p, TEST_SEGMENT_SIZE, pFrame) != kErrorOk)
+        segmentsSent_l--;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Command layer receive callback
+
+\param[in]      sdoSeqConHdl_p      Handle of the sequence layer connection.
+\param[in]      pAsySdoCom_p        Pointer to the received command layer data.
+\param[in]      dataSize_p          Size of the received data.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError comReceiveCb(tSdoSeqConHdl sdoSeqConHdl_p,
+                               const tAsySdoCom* pAsySdoCom_p,
+                               UINT dataSize_p)
+{
+    UNUSED_PARAMETER(sdoSeqConHdl_p);
+    UNUSED_PARAMETER(pAsySdoCom_p);
+    UNUSED_PARAMETER(dataSize_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Command layer connection state callback
+
+The function simulates the segmented download of the command layer. A new
+segment is sent as soon as the sequence layer signals that it is able to
+accept further data.
+
+\param[in]      sdoSeqConHdl_p      Handle of the sequence layer connection.
+\param[in]      asySdoConState_p    State of the sequence layer connection.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError comConCb(tSdoSeqConHdl sdoSeqConHdl_p,
+                           tAsySdoConState asySdoConState_p)
+{
+    switch (asySdoConState_p)
+    {
+        case kAsySdoConStateConnected:
+            fConnected_l = TRUE;
+            sendNextSegment(sdoSeqConHdl_p);
+            break;
+
+        case kAsySdoConStateAckReceived:
+        case kAsySdoConStateFrameSent:
+            sendNextSegment(sdoSeqConHdl_p);
+            break;
+
+        default:
+            break;
+    }
+
+    return kErrorOk;
+}
@@ -0,0 +1,150 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for user timer module unit tests
+
+This file contains all stubs needed by the unit tests of the user timer module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <pthread.h>
+
+#include <oplk/oplkinc.h>
+#include <oplk/event.h>
+#include <user/eventu.h>
+
+#include "test-timeru.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static pthread_mutex_t  eventMutex_l = PTHREAD_MUTEX_INITIALIZER;
+static UINT             timerEventCount_l = 0;
+static tTimerEventArg   lastTimerEvent_l;
+static UINT64           lastTimerEventTimeNs_l = 0;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tOplkError eventu_postEvent(const tEvent* pEvent_p)
+{
+    UINT64  timeNs = stub_getTimeNs();
+
+    if (pEvent_p->eventType != kEventTypeTimer)
+        return kErrorOk;
+
+    pthread_mutex_lock(&eventMutex_l);
+    timerEventCount_l++;
+    lastTimerEvent_l = *(const tTimerEventArg*)pEvent_p->eventArg.pEventArg;
+    lastTimerEventTimeNs_l = timeNs;
+    pthread_mutex_unlock(&eventMutex_l);
+
+    return kErrorOk;
+}
+
+void stub_resetTimerEvents(void)
+{
+    pthread_mutex_lock(&eventMutex_l);
+    timerEventCount_l = 0;
+    lastTimerEventTimeNs_l = 0;
+    pthread_mutex_unlock(&eventMutex_l);
+}
+
+UINT stub_getTimerEventCount(void)
+{
+    UINT    count;
+
+    pthread_mutex_lock(&eventMutex_l);
+    count = timerEventCount_l;
+    pthread_mutex_unlock(&eventMutex_l);
+
+    return count;
+}
+
+void stub_getLastTimerEvent(tTimerEventArg* pTimerEventArg_p, UINT64* pTimeNs_p)
+{
+    pthread_mutex_lock(&eventMutex_l);
+    *pTimerEventArg_p = lastTimerEvent_l;
+    *pTimeNs_p = lastTimerEventTimeNs_l;
+    pthread_mutex_unlock(&eventMutex_l);
+}
+
+UINT64 stub_getTimeNs(void)
+{
+    struct timespec currentTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    return ((UINT64)currentTime.tv_sec * 1000000000ULL) + (UINT64)currentTime.tv_nsec;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
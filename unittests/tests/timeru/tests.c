@@ -0,0 +1,264 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for user timer module
+
+This file contains the unit test functions for the user timer module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2016, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include "test-timeru.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MANY_TIMERS            10000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void sleepMs(UINT timeMs_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTimerHdl    aTimerHdl_l[TEST_MANY_TIMERS];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test timeru_setTimer()
+*/
+//------------------------------------------------------------------------------
+void test_timeru_setTimer(void)
+{
+    tTimerHdl       timerHdl = 0;
+    tTimerArg       timerArg;
+    tTimerEventArg  timerEventArg;
+    UINT64          startTimeNs;
+    UINT64          eventTimeNs;
+
+    stub_resetTimerEvents();
+
+    timerArg.eventSink = kEventSinkNmtMnu;
+    timerArg.argument.value = 0x1234;
+
+    startTimeNs = stub_getTimeNs();
+    CU_ASSERT_EQUAL(timeru_setTimer(&timerHdl, 50, &timerArg), kErrorOk);
+    CU_ASSERT_TRUE(timeru_isActive(timerHdl));
+
+    sleepMs(200);
+
+    CU_ASSERT_EQUAL(stub_getTimerEventCount(), 1);
+    CU_ASSERT_FALSE(timeru_isActive(timerHdl));
+
+    stub_getLastTimerEvent(&timerEventArg, &eventTimeNs);
+    CU_ASSERT_EQUAL(timerEventArg.timerHdl.handle, timerHdl);
+    CU_ASSERT_EQUAL(timerEventArg.argument.value, 0x1234);
+    CU_ASSERT_TRUE((eventTimeNs - startTimeNs) >= 50000000ULL);
+
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdl), kErrorOk);
+
+    CU_ASSERT_EQUAL(timeru_setTimer(NULL, 50, &timerArg), kErrorTimerInvalidHandle);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test timeru_modifyTimer()
+*/
+//------------------------------------------------------------------------------
+void test_timeru_modifyTimer(void)
+{
+    tTimerHdl       timerHdl = 0;
+    tTimerArg       timerArg;
+    tTimerEventArg  timerEventArg;
+    UINT64          startTimeNs;
+    UINT64          eventTimeNs;
+
+    stub_resetTimerEvents();
+
+    timerArg.eventSink = kEventSinkNmtMnu;
+    timerArg.argument.value = 1;
+    CU_ASSERT_EQUAL(timeru_setTimer(&timerHdl, 20, &timerArg), kErrorOk);
+
+    timerArg.argument.value = 2;
+    startTimeNs = stub_getTimeNs();
+    CU_ASSERT_EQUAL(timeru_modifyTimer(&timerHdl, 150, &timerArg), kErrorOk);
+
+    sleepMs(80);
+    CU_ASSERT_EQUAL(stub_getTimerEventCount(), 0);
+    CU_ASSERT_TRUE(timeru_isActive(timerHdl));
+
+    sleepMs(200);
+    CU_ASSERT_EQUAL(stub_getTimerEventCount(), 1);
+
+    stub_getLastTimerEvent(&timerEventArg, &eventTimeNs);
+    CU_ASSERT_EQUAL(timerEventArg.timerHdl.handle, timerHdl);
+    CU_ASSERT_EQUAL(timerEventArg.argument.value, 2);
+    CU_ASSERT_TRUE((eventTimeNs - startTimeNs) >= 150000000ULL);
+
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdl), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test timeru_deleteTimer()
+*/
+//------------------------------------------------------------------------------
+void test_timeru_deleteTimer(void)
+{
+    tTimerHdl       timerHdl = 0;
+    tTimerArg       timerArg;
+
+    stub_resetTimerEvents();
+
+    timerArg.eventSink = kEventSinkNmtMnu;
+    timerArg.argument.value = 0;
+    CU_ASSERT_EQUAL(timeru_setTimer(&timerHdl, 50, &timerArg), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdl), kErrorOk);
+    CU_ASSERT_EQUAL(timerHdl, 0);
+
+    sleepMs(150);
+    CU_ASSERT_EQUAL(stub_getTimerEventCount(), 0);
+
+    // deleting an invalid handle is allowed
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdl), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(NULL), kErrorTimerInvalidHandle);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test arming and cancelling many timers
+
+The test arms, modifies and cancels \ref TEST_MANY_TIMERS timers with timeouts
+spread over several wheel levels. It prints the average time per operation.
+*/
+//------------------------------------------------------------------------------
+void test_timeru_armCancelMany(void)
+{
+    tTimerArg   timerArg;
+    UINT64      startTimeNs;
+    UINT64      armTimeNs;
+    UINT64      modifyTimeNs;
+    UINT64      cancelTimeNs;
+    UINT        index;
+
+    stub_resetTimerEvents();
+
+    timerArg.eventSink = kEventSinkNmtMnu;
+
+    startTimeNs = stub_getTimeNs();
+    for (index = 0; index < TEST_MANY_TIMERS; index++)
+    {
+        timerArg.argument.value = index;
+        CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl_l[index], 1000 + (index % 5000), &timerArg), kErrorOk);
+    }
+    armTimeNs = stub_getTimeNs() - startTimeNs;
+
+    startTimeNs = stub_getTimeNs();
+    for (index = 0; index < TEST_MANY_TIMERS; index++)
+    {
+        timerArg.argument.value = index;
+        CU_ASSERT_EQUAL(timeru_modifyTimer(&aTimerHdl_l[index], 2000 + (index % 70000), &timerArg), kErrorOk);
+    }
+    modifyTimeNs = stub_getTimeNs() - startTimeNs;
+
+    startTimeNs = stub_getTimeNs();
+    for (index = 0; index < TEST_MANY_TIMERS; index++)
+        CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl_l[index]), kErrorOk);
+    cancelTimeNs = stub_getTimeNs() - startTimeNs;
+
+    printf("\n%u timers: arm %lu ns, modify %lu ns, cancel %lu ns per timer\n",
+           TEST_MANY_TIMERS,
+           (unsigned long)(armTimeNs / TEST_MANY_TIMERS),
+           (unsigned long)(modifyTimeNs / TEST_MANY_TIMERS),
+           (unsigned long)(cancelTimeNs / TEST_MANY_TIMERS));
+
+    sleepMs(100);
+    CU_ASSERT_EQUAL(stub_getTimerEventCount(), 0);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Sleep for the given time
+
+\param[in]      timeMs_p            Time to sleep in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static void sleepMs(UINT timeMs_p)
+{
+    struct timespec sleepTime;
+
+    sleepTime.tv_sec = timeMs_p / 1000;
+    sleepTime.tv_nsec = (timeMs_p % 1000) * 1000000L;
+
+    while (nanosleep(&sleepTime, &sleepTime) != 0)
+        ;
+}